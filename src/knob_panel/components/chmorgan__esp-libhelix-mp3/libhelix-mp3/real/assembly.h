@@ -475,6 +475,48 @@ static __inline int CLZ(int x)
     return __builtin_clz(x);
 }
 
+#elif defined(__GNUC__)
+
+/* Portable C, for the host builds of the project (host/CMakeLists.txt) */
+
+typedef long long Word64;
+
+static __inline int MULSHIFT32(int x, int y)
+{
+    return (int)(((Word64)x * y) >> 32);
+}
+
+static __inline int FASTABS(int x)
+{
+    int sign;
+
+    sign = x >> (sizeof(int) * 8 - 1);
+    x ^= sign;
+    x -= sign;
+
+    return x;
+}
+
+static __inline int CLZ(int x)
+{
+    return x ? __builtin_clz(x) : (sizeof(int) * 8);
+}
+
+static __inline Word64 MADD64(Word64 sum, int x, int y)
+{
+    return sum + (Word64)x * y;
+}
+
+static __inline Word64 SHL64(Word64 x, int n)
+{
+    return x << n;
+}
+
+static __inline Word64 SAR64(Word64 x, int n)
+{
+    return x >> n;
+}
+
 #else
 
 #error Unsupported platform in assembly.h
@@ -3,8 +3,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
 #include "button_gpio.h"
 #include "esp_sleep.h"
 
@@ -87,23 +90,28 @@ esp_err_t button_gpio_set_intr(int gpio_num, gpio_int_type_t intr_type, gpio_isr
     return ESP_OK;
 }
 
-esp_err_t button_gpio_intr_control(int gpio_num, bool enable)
+/*
+ * Disabled from the power save interrupt handler, which runs while the flash is written (the ISR
+ * service is installed with ESP_INTR_FLAG_IRAM): through the LL layer, the GPIO driver is in
+ * flash. Enabled from the scan task only.
+ */
+esp_err_t IRAM_ATTR button_gpio_intr_control(int gpio_num, bool enable)
 {
     if (enable) {
         gpio_intr_enable(gpio_num);
     } else {
-        gpio_intr_disable(gpio_num);
+        gpio_ll_intr_disable(&GPIO, gpio_num);
     }
     return ESP_OK;
 }
 
-esp_err_t button_gpio_enable_gpio_wakeup(uint32_t gpio_num, uint8_t active_level, bool enable)
+esp_err_t IRAM_ATTR button_gpio_enable_gpio_wakeup(uint32_t gpio_num, uint8_t active_level, bool enable)
 {
-    esp_err_t ret;
+    esp_err_t ret = ESP_OK;
     if (enable) {
         ret = gpio_wakeup_enable(gpio_num, active_level == 0 ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
     } else {
-        ret = gpio_wakeup_disable(gpio_num);
+        gpio_ll_wakeup_disable(&GPIO, gpio_num);
     }
     return ret;
 }
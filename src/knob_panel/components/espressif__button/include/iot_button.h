@@ -326,27 +326,30 @@ esp_err_t iot_button_set_param(button_handle_t btn_handle, button_param_t param,
 uint8_t iot_button_get_key_level(button_handle_t btn_handle);
 
 /**
- * @brief resume button timer, if button timer is stopped. Make sure iot_button_create() is called before calling this API.
+ * @brief resume the scan of the buttons, if it is stopped. Make sure iot_button_create() is called before calling this API.
  *
  * @return
  *     - ESP_OK on success
- *     - ESP_ERR_INVALID_STATE   timer state is invalid.
+ *     - ESP_ERR_INVALID_STATE   scan state is invalid.
  */
 esp_err_t iot_button_resume(void);
 
 /**
- * @brief stop button timer, if button timer is running. Make sure iot_button_create() is called before calling this API.
+ * @brief stop the scan of the buttons, if it is running. Make sure iot_button_create() is called before calling this API.
+ *
+ * @note The buttons are scanned by the tick of input_scan.h, which keeps running for the other inputs (the knob).
  *
  * @return
  *     - ESP_OK on success
- *     - ESP_ERR_INVALID_STATE   timer state is invalid
+ *     - ESP_ERR_INVALID_STATE   scan state is invalid
  */
 esp_err_t iot_button_stop(void);
 
 #if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
 /**
  * @brief Register a callback function for power saving.
- *        The config->enter_power_save_cb function will be called when all keys stop working.
+ *        The config->enter_power_save_cb function will be called when all keys stop working,
+ *        and the other inputs of the shared scan tick (input_scan.h) with them.
  *
  * @param config Button power save config
  * @return
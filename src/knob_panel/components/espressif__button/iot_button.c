@@ -10,12 +10,12 @@
 #include "freertos/task.h"
 #include "freertos/timers.h"
 #include "driver/gpio.h"
-#include "esp_timer.h"
 #include "esp_log.h"
 #if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
 #include "esp_pm.h"
 #endif
 #include "iot_button.h"
+#include "input_scan.h"
 #include "sdkconfig.h"
 
 static const char *TAG = "button";
@@ -78,18 +78,13 @@ typedef struct Button {
     button_cb_info_t     *cb_info[BUTTON_EVENT_MAX];
     size_t               size[BUTTON_EVENT_MAX];
     int                  count[2];
-    struct Button        *next;
 } button_dev_t;
 
-//button handle list head.
-static button_dev_t *g_head_handle = NULL;
-static esp_timer_handle_t g_button_timer_handle = NULL;
-static bool g_is_timer_running = false;
-#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
-static button_power_save_config_t power_save_usr_cfg = {0};
-#endif
+//buttons are scanned by the input scan tick, shared with the knob
+static uint16_t g_button_num = 0;
+static bool g_is_paused = false;
 
-#define TICKS_INTERVAL    CONFIG_BUTTON_PERIOD_TIME_MS
+#define TICKS_INTERVAL    CONFIG_INPUT_SCAN_PERIOD_TIME_MS
 #define DEBOUNCE_TICKS    CONFIG_BUTTON_DEBOUNCE_TICKS //MAX 8
 #define SHORT_TICKS       (CONFIG_BUTTON_SHORT_PRESS_TIME_MS /TICKS_INTERVAL)
 #define LONG_TICKS        (CONFIG_BUTTON_LONG_PRESS_TIME_MS /TICKS_INTERVAL)
@@ -316,49 +311,32 @@ static void button_handler(button_dev_t *btn)
     }
 }
 
-static void button_cb(void *args)
+/**
+  * @brief  Scan of the input scan tick: busy until the button is released and debounced
+  */
+static bool button_scan(void *arg)
 {
-    button_dev_t *target;
-    /*!< When all buttons enter the BUTTON_NONE_PRESS state, the system enters low-power mode */
-#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
-    bool enter_power_save_flag = true;
-#endif
-    for (target = g_head_handle; target; target = target->next) {
-        button_handler(target);
-#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
-        if (!(target->enable_power_save && target->debounce_cnt == 0 && target->event == BUTTON_NONE_PRESS)) {
-            enter_power_save_flag = false;
-        }
-#endif
-    }
-#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
-    if (enter_power_save_flag) {
-        /*!< Stop esp timer for power save */
-        if (g_is_timer_running) {
-            esp_timer_stop(g_button_timer_handle);
-            g_is_timer_running = false;
-        }
-        for (target = g_head_handle; target; target = target->next) {
-            if (target->type == BUTTON_TYPE_GPIO && target->enable_power_save) {
-                button_gpio_intr_control((int)(target->hardware_data), true);
-                button_gpio_enable_gpio_wakeup((uint32_t)(target->hardware_data), target->active_level, true);
-            }
-        }
-        /*!< Notify the user that the Button has entered power save mode by calling this callback function. */
-        if (power_save_usr_cfg.enter_power_save_cb) {
-            power_save_usr_cfg.enter_power_save_cb(power_save_usr_cfg.usr_data);
-        }
-    }
-#endif
+    button_dev_t *btn = (button_dev_t *)arg;
+    button_handler(btn);
+    return !(btn->debounce_cnt == 0 && btn->event == BUTTON_NONE_PRESS);
 }
 
 #if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
+/**
+  * @brief  All the inputs are at rest: wake up on the active level of the button
+  */
+static bool button_sleep(void *arg)
+{
+    button_dev_t *btn = (button_dev_t *)arg;
+    button_gpio_intr_control((int)(btn->hardware_data), true);
+    button_gpio_enable_gpio_wakeup((uint32_t)(btn->hardware_data), btn->active_level, true);
+    /*!< Pressed meanwhile: the level interrupt fires at once and starts the tick */
+    return false;
+}
+
 static void IRAM_ATTR button_power_save_isr_handler(void* arg)
 {
-    if (!g_is_timer_running) {
-        esp_timer_start_periodic(g_button_timer_handle, TICKS_INTERVAL * 1000U);
-        g_is_timer_running = true;
-    }
+    input_scan_wake();
     button_gpio_intr_control((int)arg, false);
     /*!< disable gpio wakeup not need active level*/
     button_gpio_enable_gpio_wakeup((uint32_t)arg, 0, false);
@@ -379,19 +357,6 @@ static button_dev_t *button_create_com(uint8_t active_level, uint8_t (*hal_get_k
     btn->long_press_ticks = long_press_ticks;
     btn->short_press_ticks = short_press_ticks;
 
-    /** Add handle to list */
-    btn->next = g_head_handle;
-    g_head_handle = btn;
-
-    if (!g_button_timer_handle) {
-        esp_timer_create_args_t button_timer = {0};
-        button_timer.arg = NULL;
-        button_timer.callback = button_cb;
-        button_timer.dispatch_method = ESP_TIMER_TASK;
-        button_timer.name = "button_timer";
-        esp_timer_create(&button_timer, &g_button_timer_handle);
-    }
-
     return btn;
 }
 
@@ -399,32 +364,12 @@ static esp_err_t button_delete_com(button_dev_t *btn)
 {
     BTN_CHECK(NULL != btn, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
 
-    button_dev_t **curr;
-    for (curr = &g_head_handle; *curr;) {
-        button_dev_t *entry = *curr;
-        if (entry == btn) {
-            *curr = entry->next;
-            free(entry);
-        } else {
-            curr = &entry->next;
-        }
-    }
-
-    /* count button number */
-    uint16_t number = 0;
-    button_dev_t *target = g_head_handle;
-    while (target) {
-        target = target->next;
-        number++;
-    }
-    ESP_LOGD(TAG, "remain btn number=%d", number);
-
-    if (0 == number && g_is_timer_running) { /**<  if all button is deleted, stop the timer */
-        esp_timer_stop(g_button_timer_handle);
-        esp_timer_delete(g_button_timer_handle);
-        g_button_timer_handle = NULL;
-        g_is_timer_running = false;
-    }
+    /** Not scanned any more, the input scan timer goes with the last input */
+    esp_err_t ret = input_scan_remove(btn);
+    BTN_CHECK(ESP_OK == ret, "Button not registered", ret);
+    free(btn);
+    g_button_num--;
+    ESP_LOGD(TAG, "remain btn number=%d", g_button_num);
     return ESP_OK;
 }
 
@@ -487,10 +432,21 @@ button_handle_t iot_button_create(const button_config_t *config)
     }
     BTN_CHECK(NULL != btn, "button create failed", NULL);
     btn->type = config->type;
-    if (!btn->enable_power_save && !g_is_timer_running) {
-        esp_timer_start_periodic(g_button_timer_handle, TICKS_INTERVAL * 1000U);
-        g_is_timer_running = true;
+
+    /** Scanned from now on, a button without power save keeps the tick running */
+    input_scan_sleep_fn_t sleep = NULL;
+#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
+    if (btn->type == BUTTON_TYPE_GPIO && btn->enable_power_save) {
+        sleep = button_sleep;
+    }
+#endif
+    ret = input_scan_add(button_scan, sleep, btn);
+    if (ESP_OK != ret) {
+        free(btn);
+        BTN_CHECK(false, "button scan add failed", NULL);
     }
+    g_button_num++;
+    input_scan_pause(button_scan, g_is_paused);
     return (button_handle_t)btn;
 }
 
@@ -788,34 +744,33 @@ uint8_t iot_button_get_key_level(button_handle_t btn_handle)
 
 esp_err_t iot_button_resume(void)
 {
-    BTN_CHECK(g_button_timer_handle, "Button timer handle is invalid", ESP_ERR_INVALID_STATE);
-    BTN_CHECK(!g_is_timer_running, "Button timer is already running", ESP_ERR_INVALID_STATE);
+    BTN_CHECK(g_button_num, "No button registered", ESP_ERR_INVALID_STATE);
+    BTN_CHECK(g_is_paused, "Button scan is already running", ESP_ERR_INVALID_STATE);
 
-    esp_err_t err = esp_timer_start_periodic(g_button_timer_handle, TICKS_INTERVAL * 1000U);
-    BTN_CHECK(ESP_OK == err, "Button timer start failed", ESP_FAIL);
-    g_is_timer_running = true;
+    input_scan_pause(button_scan, false);
+    g_is_paused = false;
     return ESP_OK;
 }
 
 esp_err_t iot_button_stop(void)
 {
-    BTN_CHECK(g_button_timer_handle, "Button timer handle is invalid", ESP_ERR_INVALID_STATE);
-    BTN_CHECK(g_is_timer_running, "Button timer is not running", ESP_ERR_INVALID_STATE);
+    BTN_CHECK(g_button_num, "No button registered", ESP_ERR_INVALID_STATE);
+    BTN_CHECK(!g_is_paused, "Button scan is not running", ESP_ERR_INVALID_STATE);
 
-    esp_err_t err = esp_timer_stop(g_button_timer_handle);
-    BTN_CHECK(ESP_OK == err, "Button timer stop failed", ESP_FAIL);
-    g_is_timer_running = false;
+    /** The tick goes on for the other inputs of the input scan */
+    input_scan_pause(button_scan, true);
+    g_is_paused = true;
     return ESP_OK;
 }
 
 #if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
 esp_err_t iot_button_register_power_save_cb(const button_power_save_config_t *config)
 {
-    BTN_CHECK(g_head_handle, "No button registered", ESP_ERR_INVALID_STATE);
+    BTN_CHECK(g_button_num, "No button registered", ESP_ERR_INVALID_STATE);
     BTN_CHECK(config->enter_power_save_cb, "Enter power save callback is invalid", ESP_ERR_INVALID_ARG);
 
-    power_save_usr_cfg.enter_power_save_cb = config->enter_power_save_cb;
-    power_save_usr_cfg.usr_data = config->usr_data;
+    /** Called when the tick stops, the knob at rest as well */
+    input_scan_set_idle_cb(config->enter_power_save_cb, config->usr_data);
     return ESP_OK;
 }
 #endif
@@ -83,12 +83,16 @@ static const button_config_t bsp_encoder_btn_config = {
     .type = BUTTON_TYPE_GPIO,
     .gpio_button_config.active_level = false,
     .gpio_button_config.gpio_num = BSP_BTN_PRESS,
+#if CONFIG_GPIO_BUTTON_SUPPORT_POWER_SAVE
+    .gpio_button_config.enable_power_save = (CONFIG_BSP_DISPLAY_IDLE_THRESHOLD_MS > 0),
+#endif
 };
 
 static const knob_config_t bsp_encoder_a_b_config = {
     .default_direction = 0,
     .gpio_encoder_a = BSP_ENCODER_A,
     .gpio_encoder_b = BSP_ENCODER_B,
+    .enable_power_save = (CONFIG_BSP_DISPLAY_IDLE_THRESHOLD_MS > 0),
 };
 
 esp_err_t bsp_led_init()
@@ -228,9 +232,15 @@ static lv_disp_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
             .mirror_x = true,
             .mirror_y = false,
         },
+        .visible_span_cb = esp_lcd_gc9a01_get_visible_span,
         .flags = {
             .buff_dma = cfg->flags.buff_dma,
             .buff_spiram = cfg->flags.buff_spiram,
+#if CONFIG_BSP_LCD_CIRCULAR_VIEWPORT
+            .circular_viewport = true,
+#endif
+            /* The assets follow LV_COLOR_16_SWAP (main/CMakeLists.txt), only the flushed strips need it */
+            .swap_bytes = (BSP_LCD_BIGENDIAN && !LV_COLOR_16_SWAP),
         }
     };
 
@@ -242,7 +252,12 @@ static lv_indev_t *bsp_display_indev_init(lv_disp_t *disp)
     const lvgl_port_encoder_cfg_t encoder = {
         .disp = disp,
         .encoder_a_b = &bsp_encoder_a_b_config,
-        .encoder_enter = &bsp_encoder_btn_config
+        .encoder_enter = &bsp_encoder_btn_config,
+        .accel = {
+            .slow_ms = CONFIG_BSP_KNOB_ACCEL_SLOW_MS,
+            .fast_ms = CONFIG_BSP_KNOB_ACCEL_FAST_MS,
+            .max_gain = CONFIG_BSP_KNOB_ACCEL_MAX_GAIN,
+        },
     };
 
     return lvgl_port_add_encoder(&encoder);
@@ -271,7 +286,11 @@ static esp_err_t bsp_display_brightness_init(void)
         .duty_resolution = LCD_LEDC_DUTY_RES,
         .timer_num = LEDC_TIMER_1,
         .freq_hz = 5000,
+#if CONFIG_PM_ENABLE
+        .clk_cfg = LEDC_USE_RC_FAST_CLK     /* Keeps the backlight on in light sleep */
+#else
         .clk_cfg = LEDC_AUTO_CLK
+#endif
     };
 
     BSP_ERROR_CHECK_RETURN_ERR(ledc_timer_config(&LCD_backlight_timer));
@@ -338,10 +357,16 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
     ESP_LOGD(TAG, "Install LCD driver");
+    const gc9a01_vendor_config_t vendor_config = {
+        .flags = {
+            .ramwr_continue = 1, // LVGL strips of an area follow each other
+        },
+    };
     const esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = BSP_LCD_RST, // Shared with Touch reset
         .color_space = BSP_LCD_COLOR_SPACE,
         .bits_per_pixel = BSP_LCD_BITS_PER_PIXEL,
+        .vendor_config = (void *) &vendor_config,
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_gc9a01(*ret_io, &panel_config, ret_panel), err, TAG, "New panel failed");
 
@@ -383,6 +408,7 @@ lv_disp_t *bsp_display_start(void)
             .buff_spiram = false,
         }
     };
+    cfg.lvgl_port_cfg.idle_threshold_ms = CONFIG_BSP_DISPLAY_IDLE_THRESHOLD_MS;
     return bsp_display_start_with_config(&cfg);
 }
 
@@ -416,3 +442,8 @@ void bsp_display_unlock(void)
 {
     lvgl_port_unlock();
 }
+
+void bsp_display_wake(void)
+{
+    lvgl_port_wake();
+}
@@ -132,6 +132,14 @@ bool bsp_display_lock(uint32_t timeout_ms);
  */
 void bsp_display_unlock(void);
 
+/**
+ * @brief Wake up the LVGL task after changing the UI from another task
+ *
+ * With CONFIG_BSP_DISPLAY_IDLE_THRESHOLD_MS the LVGL task may sleep with the LVGL tick stopped,
+ * see lvgl_port_wake(). Call it after bsp_display_unlock().
+ */
+void bsp_display_wake(void);
+
 /**
  * @brief Rotate screen
  *
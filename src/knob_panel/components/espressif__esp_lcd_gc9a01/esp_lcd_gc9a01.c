@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <sys/cdefs.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -21,6 +22,9 @@
 
 static const char *TAG = "gc9a01";
 
+#define GC9A01_CMD_RAMWRC           (0x3C)  // Write Memory Continue
+#define GC9A01_FRAME_MEMORY_SIZE    (240)   // Rows (and columns) of the frame memory
+
 static esp_err_t panel_gc9a01_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel);
@@ -31,6 +35,13 @@ static esp_err_t panel_gc9a01_swap_xy(esp_lcd_panel_t *panel, bool swap_axes);
 static esp_err_t panel_gc9a01_set_gap(esp_lcd_panel_t *panel, int x_gap, int y_gap);
 static esp_err_t panel_gc9a01_disp_on_off(esp_lcd_panel_t *panel, bool off);
 
+typedef struct {
+    int x_start;    // Programmed column range, -1 if not known
+    int x_end;
+    int y_next;     // Row the memory write pointer stands at after the last window, -1 if not known
+    int y_end;      // End of the programmed row range
+} gc9a01_window_t;
+
 typedef struct {
     esp_lcd_panel_t base;
     esp_lcd_panel_io_handle_t io;
@@ -43,8 +54,15 @@ typedef struct {
     uint8_t colmod_val; // save current value of LCD_CMD_COLMOD register
     const gc9a01_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    struct {
+        unsigned int ramwr_continue: 1;
+    } flags;
+    gc9a01_window_t window;
+    esp_lcd_gc9a01_bus_stats_t stats;
 } gc9a01_panel_t;
 
+static void panel_gc9a01_forget_window(gc9a01_panel_t *gc9a01);
+
 esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
 {
     esp_err_t ret = ESP_OK;
@@ -108,7 +126,9 @@ esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp
     if (panel_dev_config->vendor_config) {
         gc9a01->init_cmds = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds;
         gc9a01->init_cmds_size = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds_size;
+        gc9a01->flags.ramwr_continue = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->flags.ramwr_continue;
     }
+    panel_gc9a01_forget_window(gc9a01);
     gc9a01->base.del = panel_gc9a01_del;
     gc9a01->base.reset = panel_gc9a01_reset;
     gc9a01->base.init = panel_gc9a01_init;
@@ -157,6 +177,7 @@ static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel)
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     esp_lcd_panel_io_handle_t io = gc9a01->io;
 
+    panel_gc9a01_forget_window(gc9a01);
     // perform hardware reset
     if (gc9a01->reset_gpio_num >= 0) {
         gpio_set_level(gc9a01->reset_gpio_num, gc9a01->reset_level);
@@ -224,6 +245,7 @@ static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel)
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     esp_lcd_panel_io_handle_t io = gc9a01->io;
 
+    panel_gc9a01_forget_window(gc9a01);
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0), TAG, "send command failed");
     vTaskDelay(pdMS_TO_TICKS(100));
@@ -284,22 +306,98 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     y_start += gc9a01->y_gap;
     y_end += gc9a01->y_gap;
 
-    // define an area of frame memory where MCU can access
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]) {
-        (x_start >> 8) & 0xFF,
-        x_start & 0xFF,
-        ((x_end - 1) >> 8) & 0xFF,
-        (x_end - 1) & 0xFF,
-    }, 4), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]) {
-        (y_start >> 8) & 0xFF,
-        y_start & 0xFF,
-        ((y_end - 1) >> 8) & 0xFF,
-        (y_end - 1) & 0xFF,
-    }, 4), TAG, "send command failed");
+    // the window is only known again once all commands went out
+    const gc9a01_window_t window = gc9a01->window;
+    panel_gc9a01_forget_window(gc9a01);
+
+    int ramwr_cmd = LCD_CMD_RAMWR;
+    int row_end = y_end;
+    if (gc9a01->flags.ramwr_continue && x_start == window.x_start && x_end == window.x_end &&
+            y_start == window.y_next && y_end <= window.y_end) {
+        // strip right below the previous one, the memory write pointer already stands on its first pixel
+        ramwr_cmd = GC9A01_CMD_RAMWRC;
+        row_end = window.y_end;
+    } else {
+        // define an area of frame memory where MCU can access, columns are kept from the previous window
+        if (x_start != window.x_start || x_end != window.x_end) {
+            ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]) {
+                (x_start >> 8) & 0xFF,
+                x_start & 0xFF,
+                ((x_end - 1) >> 8) & 0xFF,
+                (x_end - 1) & 0xFF,
+            }, 4), TAG, "send command failed");
+            gc9a01->stats.transactions++;
+            gc9a01->stats.cmd_bytes += 1 + 4;
+        }
+        // open the rows down to the end of the frame memory, so the next strip can continue the write
+        if (gc9a01->flags.ramwr_continue && row_end < GC9A01_FRAME_MEMORY_SIZE) {
+            row_end = GC9A01_FRAME_MEMORY_SIZE;
+        }
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]) {
+            (y_start >> 8) & 0xFF,
+            y_start & 0xFF,
+            ((row_end - 1) >> 8) & 0xFF,
+            (row_end - 1) & 0xFF,
+        }, 4), TAG, "send command failed");
+        gc9a01->stats.transactions++;
+        gc9a01->stats.cmd_bytes += 1 + 4;
+    }
     // transfer frame buffer
     size_t len = (x_end - x_start) * (y_end - y_start) * gc9a01->fb_bits_per_pixel / 8;
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(io, LCD_CMD_RAMWR, color_data, len), TAG, "send color failed");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(io, ramwr_cmd, color_data, len), TAG, "send color failed");
+    gc9a01->stats.windows++;
+    gc9a01->stats.transactions++;
+    gc9a01->stats.cmd_bytes += 1;
+    gc9a01->stats.color_bytes += len;
+
+    gc9a01->window.x_start = x_start;
+    gc9a01->window.x_end = x_end;
+    gc9a01->window.y_next = y_end;
+    gc9a01->window.y_end = row_end;
+
+    return ESP_OK;
+}
+
+static void panel_gc9a01_forget_window(gc9a01_panel_t *gc9a01)
+{
+    gc9a01->window.x_start = -1;
+    gc9a01->window.x_end = -1;
+    gc9a01->window.y_next = -1;
+    gc9a01->window.y_end = -1;
+}
+
+esp_err_t esp_lcd_gc9a01_get_bus_stats(esp_lcd_panel_handle_t panel, esp_lcd_gc9a01_bus_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(panel && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
+
+    *stats = gc9a01->stats;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_gc9a01_reset_bus_stats(esp_lcd_panel_handle_t panel)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
+
+    memset(&gc9a01->stats, 0, sizeof(gc9a01->stats));
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_gc9a01_get_visible_span(int y, int *x_start, int *x_end)
+{
+    const int radius = GC9A01_PANEL_DIAMETER / 2;
+    ESP_RETURN_ON_FALSE(x_start && x_end && (y >= 0) && (y < GC9A01_PANEL_DIAMETER), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    // distance from the centre to the nearest edge of the row
+    const int dy = (y < radius) ? (radius - 1 - y) : (y - radius);
+    const int sq = radius * radius - dy * dy;
+    int half = 0;
+    while (half * half < sq) {
+        half++;
+    }
+    *x_start = radius - half;
+    *x_end = radius + half;
 
     return ESP_OK;
 }
@@ -332,6 +430,7 @@ static esp_err_t panel_gc9a01_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
     } else {
         gc9a01->madctl_val &= ~LCD_CMD_MY_BIT;
     }
+    panel_gc9a01_forget_window(gc9a01);
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
         gc9a01->madctl_val
     }, 1), TAG, "send command failed");
@@ -347,6 +446,7 @@ static esp_err_t panel_gc9a01_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
     } else {
         gc9a01->madctl_val &= ~LCD_CMD_MV_BIT;
     }
+    panel_gc9a01_forget_window(gc9a01);
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
         gc9a01->madctl_val
     }, 1), TAG, "send command failed");
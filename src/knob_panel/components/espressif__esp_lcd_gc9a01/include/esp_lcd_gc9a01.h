@@ -40,8 +40,24 @@ typedef struct {
                                                  *   Please refer to `vendor_specific_init_default` in source file.
                                                  */
     uint16_t init_cmds_size;                    /*<! Number of commands in above array */
+    struct {
+        unsigned int ramwr_continue: 1;         /*<! Send a strip right below the previous one with Write Memory Continue (3Ch) only,
+                                                 *   without setting the window again
+                                                 */
+    } flags;
 } gc9a01_vendor_config_t;
 
+/**
+ * @brief Bus traffic of `esp_lcd_panel_draw_bitmap()` since the panel was created or the stats were reset
+ *
+ */
+typedef struct {
+    uint32_t windows;       /*<! Number of drawn bitmaps */
+    uint32_t transactions;  /*<! Number of commands sent, CASET/RASET are skipped when they are already set */
+    uint32_t cmd_bytes;     /*<! Command and parameter bytes */
+    uint64_t color_bytes;   /*<! Pixel data bytes */
+} esp_lcd_gc9a01_bus_stats_t;
+
 /**
  * @brief Create LCD panel for model GC9A01
  *
@@ -57,6 +73,49 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Get the bus traffic of the drawn bitmaps
+ *
+ * @note  Divide by the number of refreshed frames (e.g. `lvgl_port_get_flush_stats()`) to get the traffic per frame.
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_gc9a01()`
+ * @param[out] stats Returned traffic counters
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_gc9a01_get_bus_stats(esp_lcd_panel_handle_t panel, esp_lcd_gc9a01_bus_stats_t *stats);
+
+/**
+ * @brief Reset the bus traffic counters
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_gc9a01()`
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_gc9a01_reset_bus_stats(esp_lcd_panel_handle_t panel);
+
+/**
+ * @brief Diameter of the visible disc of the round GC9A01 panel in pixels
+ */
+#define GC9A01_PANEL_DIAMETER   (240)
+
+/**
+ * @brief Get the visible part of a row of the round GC9A01 panel
+ *
+ * @note  Only the disc inscribed in the 240x240 frame memory is visible, pixels in the corners are never shown.
+ *        A pixel is reported as visible if any part of it lies inside the disc.
+ *
+ * @param[in] y Row in panel coordinates
+ * @param[out] x_start First visible column of the row
+ * @param[out] x_end Column after the last visible one
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the row is outside of the panel
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_gc9a01_get_visible_span(int y, int *x_start, int *x_end);
+
 /**
  * @brief LCD panel bus configuration structure
  *
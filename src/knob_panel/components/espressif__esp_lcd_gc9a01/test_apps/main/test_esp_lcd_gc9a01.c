@@ -112,6 +112,80 @@ TEST_CASE("test gc9a01 to draw color bar with SPI interface", "[gc9a01][spi]")
     TEST_ESP_OK(spi_bus_free(TEST_LCD_HOST));
 }
 
+TEST_CASE("test gc9a01 to draw strips with write memory continue", "[gc9a01][spi]")
+{
+    const spi_bus_config_t buscfg = GC9A01_PANEL_BUS_SPI_CONFIG(TEST_PIN_NUM_LCD_PCLK, TEST_PIN_NUM_LCD_DATA0,
+                                    TEST_LCD_H_RES * 80 * TEST_LCD_BIT_PER_PIXEL / 8);
+    TEST_ESP_OK(spi_bus_initialize(TEST_LCD_HOST, &buscfg, SPI_DMA_CH_AUTO));
+
+    esp_lcd_panel_io_handle_t io_handle = NULL;
+    const esp_lcd_panel_io_spi_config_t io_config = GC9A01_PANEL_IO_SPI_CONFIG(TEST_PIN_NUM_LCD_CS, TEST_PIN_NUM_LCD_DC,
+            test_notify_refresh_ready, NULL);
+    TEST_ESP_OK(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)TEST_LCD_HOST, &io_config, &io_handle));
+
+    esp_lcd_panel_handle_t panel_handle = NULL;
+    const gc9a01_vendor_config_t vendor_config = {
+        .flags = {
+            .ramwr_continue = 1,
+        },
+    };
+    const esp_lcd_panel_dev_config_t panel_config = {
+        .reset_gpio_num = TEST_PIN_NUM_LCD_RST,
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+        .color_space = ESP_LCD_COLOR_SPACE_BGR,
+#else
+        .rgb_endian = LCD_RGB_ENDIAN_BGR,
+#endif
+        .bits_per_pixel = TEST_LCD_BIT_PER_PIXEL,
+        .vendor_config = (void *) &vendor_config,
+    };
+    TEST_ESP_OK(esp_lcd_new_panel_gc9a01(io_handle, &panel_config, &panel_handle));
+    TEST_ESP_OK(esp_lcd_panel_reset(panel_handle));
+    TEST_ESP_OK(esp_lcd_panel_init(panel_handle));
+    TEST_ESP_OK(esp_lcd_panel_invert_color(panel_handle, true));
+    TEST_ESP_OK(esp_lcd_panel_mirror(panel_handle, true, false));
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    TEST_ESP_OK(esp_lcd_panel_disp_off(panel_handle, false));
+#else
+    TEST_ESP_OK(esp_lcd_panel_disp_on_off(panel_handle, true));
+#endif
+
+    // The colour bars are full-width strips one below the other, only the first one sets the window
+    TEST_ESP_OK(esp_lcd_gc9a01_reset_bus_stats(panel_handle));
+    test_draw_bitmap(panel_handle);
+    esp_lcd_gc9a01_bus_stats_t stats;
+    TEST_ESP_OK(esp_lcd_gc9a01_get_bus_stats(panel_handle, &stats));
+    TEST_ASSERT_EQUAL(TEST_LCD_BIT_PER_PIXEL, stats.windows);
+    TEST_ASSERT_EQUAL(2 + TEST_LCD_BIT_PER_PIXEL, stats.transactions);
+    TEST_ASSERT_EQUAL(2 * 5 + TEST_LCD_BIT_PER_PIXEL, stats.cmd_bytes);
+    vTaskDelay(pdMS_TO_TICKS(TEST_DELAY_TIME_MS));
+
+    TEST_ESP_OK(esp_lcd_panel_del(panel_handle));
+    TEST_ESP_OK(esp_lcd_panel_io_del(io_handle));
+    TEST_ESP_OK(spi_bus_free(TEST_LCD_HOST));
+}
+
+TEST_CASE("test gc9a01 visible span of the round panel", "[gc9a01][span]")
+{
+    int x_start = 0;
+    int x_end = 0;
+    int visible = 0;
+
+    for (int y = 0; y < TEST_LCD_V_RES; y++) {
+        TEST_ESP_OK(esp_lcd_gc9a01_get_visible_span(y, &x_start, &x_end));
+        TEST_ASSERT_TRUE(x_start >= 0 && x_start < x_end && x_end <= TEST_LCD_H_RES);
+        // The disc is symmetric
+        TEST_ASSERT_EQUAL(TEST_LCD_H_RES, x_start + x_end);
+        visible += x_end - x_start;
+    }
+    TEST_ESP_OK(esp_lcd_gc9a01_get_visible_span(TEST_LCD_V_RES / 2, &x_start, &x_end));
+    TEST_ASSERT_EQUAL(0, x_start);
+    TEST_ASSERT_EQUAL(TEST_LCD_H_RES, x_end);
+    // Roughly pi/4 of the square is visible
+    TEST_ASSERT_INT_WITHIN(TEST_LCD_H_RES * TEST_LCD_V_RES / 50, TEST_LCD_H_RES * TEST_LCD_V_RES * 785 / 1000, visible);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_lcd_gc9a01_get_visible_span(TEST_LCD_V_RES, &x_start, &x_end));
+}
+
 // Some resources are lazy allocated in the LCD driver, the threadhold is left for that case
 #define TEST_MEMORY_LEAK_THRESHOLD (-300)
 
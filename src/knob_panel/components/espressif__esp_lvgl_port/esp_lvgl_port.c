@@ -15,6 +15,11 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_planner.h"
+#include "esp_lvgl_port_viewport.h"
+#include "esp_lvgl_port_encoder.h"
+#include "esp_lvgl_port_latency.h"
+#include "esp_lvgl_port_swap.h"
 
 #include "lvgl.h"
 
@@ -73,8 +78,25 @@ typedef struct {
 typedef struct lvgl_port_ctx_s {
     SemaphoreHandle_t   lvgl_mux;
     esp_timer_handle_t  tick_timer;
+    TaskHandle_t        task;
     bool                running;
     int                 task_max_sleep_ms;
+    int                 idle_threshold_ms;
+    struct {
+        int64_t         window_start;   /* Start of the current one second window */
+        uint32_t        count;          /* Wakeups in the current window */
+        uint32_t        per_sec;        /* Wakeups in the last complete window */
+    } wakeups;
+    struct {
+        volatile bool   active;         /* LVGL tick stopped, the task waits for a deadline or input */
+        bool            deadline;       /* The task woke up because the deadline passed */
+        int64_t         start;          /* Start of the current idle period */
+        int64_t         tick_at;        /* Time the LVGL tick was last brought up to date */
+        int64_t         tick_rem_us;    /* Part of the idle time shorter than one LVGL tick */
+        int64_t         stats_start;    /* Time the statistics were reset */
+        lvgl_port_idle_stats_t stats;
+    } idle;
+    lvgl_port_latency_t latency;        /* Trace of the encoder input up to the panel */
 #ifdef ESP_LVGL_PORT_USB_HOST_HID_COMPONENT
     lvgl_port_usb_hid_ctx_t hid_ctx;
 #endif
@@ -85,6 +107,19 @@ typedef struct {
     esp_lcd_panel_handle_t    panel_handle; /* LCD panel handle */
     lvgl_port_rotation_cfg_t  rotation;     /* Default values of the screen rotation */
     lv_disp_drv_t             disp_drv;     /* LVGL display driver */
+    lv_disp_t                 *disp;        /* LVGL display of the driver */
+    uint32_t                  buffer_size;  /* Allocated size of each draw buffer in pixels */
+    SemaphoreHandle_t         flush_done;   /* Given when the panel IO finished the last flush */
+    lvgl_port_viewport_t      viewport;     /* Visible part of a round panel */
+    bool                      swap_bytes;   /* LVGL renders in the native byte order, the flush swaps */
+    struct {
+        int64_t           segment_start;    /* Start of the current render segment */
+        int64_t           wait_pending;     /* Time spent in wait_cb since segment_start */
+        int64_t           transfer_start;   /* Time the last flush was handed to the panel */
+        volatile uint32_t transfer_time;    /* Duration of the last transfer, written from ISR */
+        bool              transfer_pending; /* Last transfer not yet accounted in stats */
+        lvgl_port_flush_stats_t stats;
+    } perf;
 } lvgl_port_display_ctx_t;
 
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
@@ -99,7 +134,7 @@ typedef struct {
     knob_handle_t   knob_handle; /* Encoder knob handlers */
     button_handle_t btn_handle; /* Encoder button handlers */
     lv_indev_drv_t  indev_drv;  /* LVGL input device driver */
-    bool btn_enter; /* Encoder button enter state */
+    lvgl_port_encoder_input_t input; /* Knob and button events not read by LVGL yet */
 } lvgl_port_encoder_ctx_t;
 #endif
 
@@ -133,20 +168,32 @@ static int lvgl_port_timer_period_ms = 5;
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
 static void lvgl_port_task_deinit(void);
+static void lvgl_port_count_wakeup(void);
+static bool lvgl_port_idle_enter(uint32_t *sleep_ms);
+static void lvgl_port_idle_wakeup(void);
+static void lvgl_port_idle_end(void);
+static void lvgl_port_latency_check_done(void);
 
 // LVGL callbacks
 #if LVGL_PORT_HANDLE_FLUSH_READY
 static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 #endif
 static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_flush_wait_callback(lv_disp_drv_t *drv);
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv);
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area);
+static void lvgl_port_flush_stats_commit(lvgl_port_display_ctx_t *disp_ctx);
 static void lvgl_port_update_callback(lv_disp_drv_t *drv);
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
 #endif
 #ifdef ESP_LVGL_PORT_KNOB_COMPONENT
 static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_encoder_read_timer_callback(lv_timer_t *timer);
 static void lvgl_port_encoder_btn_down_handler(void *arg, void *arg2);
 static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2);
+static void lvgl_port_encoder_knob_left_handler(void *arg, void *data);
+static void lvgl_port_encoder_knob_right_handler(void *arg, void *data);
 #endif
 #ifdef ESP_LVGL_PORT_BUTTON_COMPONENT
 static void lvgl_port_navigation_buttons_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
@@ -184,14 +231,17 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     if (lvgl_port_ctx.task_max_sleep_ms == 0) {
         lvgl_port_ctx.task_max_sleep_ms = 500;
     }
+    lvgl_port_ctx.idle_threshold_ms = cfg->idle_threshold_ms;
+    lvgl_port_ctx.idle.stats_start = esp_timer_get_time();
+    lvgl_port_latency_init(&lvgl_port_ctx.latency);
     lvgl_port_ctx.lvgl_mux = xSemaphoreCreateRecursiveMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL mutex fail!");
 
     BaseType_t res;
     if (cfg->task_affinity < 0) {
-        res = xTaskCreate(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, NULL);
+        res = xTaskCreate(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.task);
     } else {
-        res = xTaskCreatePinnedToCore(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, NULL, cfg->task_affinity);
+        res = xTaskCreatePinnedToCore(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.task, cfg->task_affinity);
     }
     ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create LVGL task fail!");
 
@@ -220,8 +270,12 @@ esp_err_t lvgl_port_stop(void)
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
     if (lvgl_port_ctx.tick_timer != NULL) {
+        /* The idle governor restarts the tick when it ends, end it first */
+        lvgl_port_lock(0);
+        lvgl_port_idle_end();
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
+        lvgl_port_unlock();
     }
 
     return ret;
@@ -252,6 +306,7 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     lv_disp_t *disp = NULL;
     lv_color_t *buf1 = NULL;
     lv_color_t *buf2 = NULL;
+    lv_disp_draw_buf_t *disp_buf = NULL;
     assert(disp_cfg != NULL);
     assert(disp_cfg->io_handle != NULL);
     assert(disp_cfg->panel_handle != NULL);
@@ -260,13 +315,16 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     assert(disp_cfg->vres > 0);
 
     /* Display context */
-    lvgl_port_display_ctx_t *disp_ctx = malloc(sizeof(lvgl_port_display_ctx_t));
+    lvgl_port_display_ctx_t *disp_ctx = calloc(1, sizeof(lvgl_port_display_ctx_t));
     ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
     disp_ctx->io_handle = disp_cfg->io_handle;
     disp_ctx->panel_handle = disp_cfg->panel_handle;
     disp_ctx->rotation.swap_xy = disp_cfg->rotation.swap_xy;
     disp_ctx->rotation.mirror_x = disp_cfg->rotation.mirror_x;
     disp_ctx->rotation.mirror_y = disp_cfg->rotation.mirror_y;
+    disp_ctx->buffer_size = disp_cfg->buffer_size;
+    disp_ctx->flush_done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(disp_ctx->flush_done, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for flush semaphore allocation!");
 
     uint32_t buff_caps = MALLOC_CAP_DEFAULT;
     if (disp_cfg->flags.buff_dma && disp_cfg->flags.buff_spiram) {
@@ -285,10 +343,11 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
         buf2 = heap_caps_malloc(disp_cfg->buffer_size * sizeof(lv_color_t), buff_caps);
         ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
     }
-    lv_disp_draw_buf_t *disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
+    disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
     ESP_GOTO_ON_FALSE(disp_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL display buffer allocation!");
 
     /* initialize LVGL draw buffers */
+    /* With two buffers smaller than the screen LVGL renders the next strip while the previous one is being sent */
     lv_disp_draw_buf_init(disp_buf, buf1, buf2, disp_cfg->buffer_size);
 
     ESP_LOGD(TAG, "Register display driver to LVGL");
@@ -296,6 +355,7 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     disp_ctx->disp_drv.hor_res = disp_cfg->hres;
     disp_ctx->disp_drv.ver_res = disp_cfg->vres;
     disp_ctx->disp_drv.flush_cb = lvgl_port_flush_callback;
+    disp_ctx->disp_drv.render_start_cb = lvgl_port_render_start_callback;
     disp_ctx->disp_drv.drv_update_cb = lvgl_port_update_callback;
     disp_ctx->disp_drv.draw_buf = disp_buf;
     disp_ctx->disp_drv.user_data = disp_ctx;
@@ -306,8 +366,22 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
         .on_color_trans_done = lvgl_port_flush_ready_callback,
     };
     esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, &disp_ctx->disp_drv);
+    /* Block the LVGL task instead of spinning while the other buffer is still in flight */
+    disp_ctx->disp_drv.wait_cb = lvgl_port_flush_wait_callback;
 #endif
 
+    /* Round panel, split invalidated areas to skip the invisible corners */
+    if (disp_cfg->flags.circular_viewport && !disp_cfg->monochrome) {
+        ESP_GOTO_ON_ERROR(lvgl_port_viewport_init(&disp_ctx->viewport, disp_cfg->hres, disp_cfg->vres, disp_cfg->visible_span_cb),
+                          err, TAG, "Circular viewport init failed!");
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+        ESP_LOGD(TAG, "Circular viewport: %d bands, %d of %d pixels", disp_ctx->viewport.band_cnt,
+                 (int)lvgl_port_viewport_get_size(&disp_ctx->viewport), (int)(disp_cfg->hres * disp_cfg->vres));
+    }
+
+    /* The panel takes the colours in the other byte order than LVGL renders them */
+    disp_ctx->swap_bytes = disp_cfg->flags.swap_bytes && !disp_cfg->monochrome;
+
     /* Monochrome display settings */
     if (disp_cfg->monochrome) {
         /* When using monochromatic display, there must be used full bufer! */
@@ -318,6 +392,7 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     }
 
     disp = lv_disp_drv_register(&disp_ctx->disp_drv);
+    disp_ctx->disp = disp;
 
 err:
     if (ret != ESP_OK) {
@@ -327,7 +402,13 @@ err:
         if (buf2) {
             free(buf2);
         }
+        if (disp_buf) {
+            free(disp_buf);
+        }
         if (disp_ctx) {
+            if (disp_ctx->flush_done) {
+                vSemaphoreDelete(disp_ctx->flush_done);
+            }
             free(disp_ctx);
         }
     }
@@ -359,11 +440,123 @@ esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
         }
     }
 
+    if (disp_ctx->flush_done) {
+        vSemaphoreDelete(disp_ctx->flush_done);
+    }
     free(disp_ctx);
 
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_set_strip_height(lv_disp_t *disp, uint32_t lines)
+{
+    assert(disp);
+    lv_disp_drv_t *disp_drv = disp->driver;
+    assert(disp_drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+    assert(disp_ctx);
+
+    ESP_RETURN_ON_FALSE(!disp_drv->full_refresh, ESP_ERR_NOT_SUPPORTED, TAG, "Display is refreshed in full!");
+    const uint32_t size = lines * lv_disp_get_hor_res(disp);
+    ESP_RETURN_ON_FALSE(lines > 0 && size <= disp_ctx->buffer_size, ESP_ERR_INVALID_ARG, TAG, "Strip of %d lines does not fit into the draw buffer!", (int)lines);
+
+    /* LVGL reads the size at the start of every refresh, the buffers stay allocated */
+    disp_drv->draw_buf->size = size;
+
+    return ESP_OK;
+}
+
+uint32_t lvgl_port_get_strip_height(lv_disp_t *disp)
+{
+    assert(disp);
+    assert(disp->driver);
+
+    return disp->driver->draw_buf->size / lv_disp_get_hor_res(disp);
+}
+
+esp_err_t lvgl_port_get_flush_stats(lv_disp_t *disp, lvgl_port_flush_stats_t *stats)
+{
+    assert(disp);
+    assert(disp->driver);
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx);
+
+    /* The last transfer is accounted with the next flush */
+    *stats = disp_ctx->perf.stats;
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_flush_stats(lv_disp_t *disp)
+{
+    assert(disp);
+    assert(disp->driver);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx);
+
+    memset(&disp_ctx->perf.stats, 0, sizeof(disp_ctx->perf.stats));
+}
+
+uint32_t lvgl_port_get_wakeups_per_sec(void)
+{
+    const int64_t window = esp_timer_get_time() - lvgl_port_ctx.wakeups.window_start;
+
+    /* Without wakeups the window is not closed, it is long enough on its own */
+    if (window >= 2 * 1000000LL) {
+        return lvgl_port_ctx.wakeups.count * 1000000LL / window;
+    }
+    return lvgl_port_ctx.wakeups.per_sec;
+}
+
+esp_err_t lvgl_port_get_idle_stats(lvgl_port_idle_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock(0);
+    const int64_t now = esp_timer_get_time();
+    *stats = lvgl_port_ctx.idle.stats;
+    /* The current idle period goes on, only its time so far is counted */
+    if (lvgl_port_ctx.idle.active) {
+        stats->idle_us += now - lvgl_port_ctx.idle.start;
+    }
+    stats->active_us = now - lvgl_port_ctx.idle.stats_start - stats->idle_us;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_idle_stats(void)
+{
+    lvgl_port_lock(0);
+    memset(&lvgl_port_ctx.idle.stats, 0, sizeof(lvgl_port_ctx.idle.stats));
+    lvgl_port_ctx.idle.stats_start = esp_timer_get_time();
+    /* The current idle period counts from here on */
+    if (lvgl_port_ctx.idle.active) {
+        lvgl_port_ctx.idle.start = lvgl_port_ctx.idle.stats_start;
+    }
+    lvgl_port_unlock();
+}
+
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock(0);
+    lvgl_port_latency_check_done();
+    *stats = lvgl_port_ctx.latency.stats;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_latency_stats(void)
+{
+    lvgl_port_lock(0);
+    memset(&lvgl_port_ctx.latency.stats, 0, sizeof(lvgl_port_ctx.latency.stats));
+    lvgl_port_unlock();
+}
+
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
 {
@@ -433,10 +626,14 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
         ESP_GOTO_ON_FALSE(encoder_ctx->btn_handle, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
     }
 
+    /* The callbacks may come as soon as they are registered */
+    lvgl_port_encoder_input_init(&encoder_ctx->input, &encoder_cfg->accel);
+
     ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_DOWN, lvgl_port_encoder_btn_down_handler, encoder_ctx));
     ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_UP, lvgl_port_encoder_btn_up_handler, encoder_ctx));
-
-    encoder_ctx->btn_enter = false;
+    /* One call per detent, with the time of the edge */
+    ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_LEFT, lvgl_port_encoder_knob_left_handler, encoder_ctx));
+    ESP_ERROR_CHECK(iot_knob_register_cb(encoder_ctx->knob_handle, KNOB_RIGHT, lvgl_port_encoder_knob_right_handler, encoder_ctx));
 
     /* Register a encoder input device */
     lv_indev_drv_init(&encoder_ctx->indev_drv);
@@ -446,6 +643,11 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
     encoder_ctx->indev_drv.user_data = encoder_ctx;
     indev = lv_indev_drv_register(&encoder_ctx->indev_drv);
 
+    /* Trace when the event callbacks of the screen return */
+    if (indev) {
+        indev->driver->read_timer->timer_cb = lvgl_port_encoder_read_timer_callback;
+    }
+
 err:
     if (ret != ESP_OK) {
         if (encoder_ctx->knob_handle != NULL) {
@@ -667,11 +869,23 @@ void lvgl_port_unlock(void)
     xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
 }
 
+void lvgl_port_wake(void)
+{
+    if (lvgl_port_ctx.idle.active) {
+        xTaskNotifyGive(lvgl_port_ctx.task);
+    }
+}
+
 void lvgl_port_flush_ready(lv_disp_t *disp)
 {
     assert(disp);
     assert(disp->driver);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    assert(disp_ctx);
+
+    disp_ctx->perf.transfer_time = (uint32_t)(esp_timer_get_time() - disp_ctx->perf.transfer_start);
     lv_disp_flush_ready(disp->driver);
+    xSemaphoreGive(disp_ctx->flush_done);
 }
 
 
@@ -680,6 +894,174 @@ void lvgl_port_flush_ready(lv_disp_t *disp)
 * Private functions
 *******************************************************************************/
 
+static void lvgl_port_count_wakeup(void)
+{
+    const int64_t now = esp_timer_get_time();
+
+    lvgl_port_ctx.wakeups.count++;
+    if (now - lvgl_port_ctx.wakeups.window_start >= 1000000) {
+        lvgl_port_ctx.wakeups.per_sec = lvgl_port_ctx.wakeups.count * 1000000LL / (now - lvgl_port_ctx.wakeups.window_start);
+        lvgl_port_ctx.wakeups.count = 0;
+        lvgl_port_ctx.wakeups.window_start = now;
+    }
+}
+
+/* Time until the next LVGL timer which is not paused, LV_NO_TIMER_READY if there is none */
+static uint32_t lvgl_port_timer_next_ms(void)
+{
+    uint32_t next = LV_NO_TIMER_READY;
+
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) {
+        if (!timer->paused) {
+            const uint32_t elapsed = lv_tick_elaps(timer->last_run);
+            next = LV_MIN(next, timer->period > elapsed ? timer->period - elapsed : 0);
+        }
+    }
+
+    return next;
+}
+
+/* Read timers of the encoders, the governor pauses them while the knob is at rest */
+static void lvgl_port_idle_pause_input(bool pause)
+{
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (indev->driver->read_cb != lvgl_port_encoder_read) {
+            continue;
+        }
+        if (pause) {
+            lv_timer_pause(indev->driver->read_timer);
+        } else {
+            lv_timer_resume(indev->driver->read_timer);
+            lv_timer_ready(indev->driver->read_timer);
+        }
+    }
+#endif
+}
+
+static bool lvgl_port_idle_input_pending(void)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+#ifdef ESP_LVGL_PORT_KNOB_COMPONENT
+        if (indev->driver->read_cb == lvgl_port_encoder_read) {
+            const lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev->driver->user_data;
+            /* An event LVGL did not read yet, or the button is held (long press) */
+            if (lvgl_port_encoder_input_pending(&ctx->input)) {
+                return true;
+            }
+            continue;
+        }
+#endif
+        /* Other input devices are polled, they keep the task awake */
+        return true;
+    }
+
+    return false;
+}
+
+/* Add the time the LVGL tick was stopped to it */
+static void lvgl_port_idle_tick_catch_up(void)
+{
+    const int64_t now = esp_timer_get_time();
+    const int64_t tick_us = now - lvgl_port_ctx.idle.tick_at + lvgl_port_ctx.idle.tick_rem_us;
+
+    lv_tick_inc(tick_us / 1000);
+    lvgl_port_ctx.idle.tick_rem_us = tick_us % 1000;
+    lvgl_port_ctx.idle.tick_at = now;
+}
+
+/* Called with the LVGL mutex held, after lv_timer_handler(). The tick stays stopped from one idle period to the next */
+static bool lvgl_port_idle_enter(uint32_t *sleep_ms)
+{
+    const bool stopped = lvgl_port_ctx.idle.active;
+
+    /* Not stopped by the governor, lvgl_port_stop() */
+    if ((lvgl_port_ctx.idle_threshold_ms <= 0) || (!stopped && !esp_timer_is_active(lvgl_port_ctx.tick_timer))) {
+        return false;
+    }
+
+    /* Set first, input arriving from now on notifies the task */
+    lvgl_port_ctx.idle.active = true;
+    bool paused = stopped;
+    if (!lvgl_port_idle_input_pending()) {
+        lvgl_port_idle_pause_input(true);
+        paused = true;
+        const uint32_t next = lvgl_port_timer_next_ms();
+        if (next >= (uint32_t)lvgl_port_ctx.idle_threshold_ms) {
+            const int64_t now = esp_timer_get_time();
+            if (!stopped) {
+                esp_timer_stop(lvgl_port_ctx.tick_timer);
+                lvgl_port_ctx.idle.tick_at = now;
+            }
+            lvgl_port_ctx.idle.start = now;
+            lvgl_port_ctx.idle.deadline = false;
+            lvgl_port_ctx.idle.stats.entries++;
+            *sleep_ms = next;
+            return true;
+        }
+    }
+
+    /* Busy, LVGL needs its tick back */
+    if (paused) {
+        lvgl_port_idle_pause_input(false);
+    }
+    if (stopped) {
+        lvgl_port_idle_tick_catch_up();
+        esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_timer_period_ms * 1000);
+    }
+    lvgl_port_ctx.idle.active = false;
+    /* Drop a notification which arrived meanwhile, the task polls anyway */
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    return false;
+}
+
+/* Called with the LVGL mutex held, before lv_timer_handler(): the task woke up from an idle period */
+static void lvgl_port_idle_wakeup(void)
+{
+    if (!lvgl_port_ctx.idle.active) {
+        return;
+    }
+
+    /* The tick is still stopped, lvgl_port_idle_enter() restarts it if LVGL has something to do */
+    lvgl_port_idle_tick_catch_up();
+    const int64_t idle_us = lvgl_port_ctx.idle.tick_at - lvgl_port_ctx.idle.start;
+    lvgl_port_ctx.idle.stats.idle_us += idle_us;
+    lvgl_port_ctx.idle.stats.longest_ms = LV_MAX(lvgl_port_ctx.idle.stats.longest_ms, (uint32_t)(idle_us / 1000));
+    if (lvgl_port_ctx.idle.deadline) {
+        lvgl_port_ctx.idle.stats.deadline_wakeups++;
+    } else {
+        lvgl_port_ctx.idle.stats.event_wakeups++;
+    }
+    lvgl_port_ctx.idle.start = lvgl_port_ctx.idle.tick_at;
+}
+
+/* Called with the LVGL mutex held, the tick is left stopped for lvgl_port_stop() */
+static void lvgl_port_idle_end(void)
+{
+    if (!lvgl_port_ctx.idle.active) {
+        return;
+    }
+
+    lvgl_port_idle_wakeup();
+    lvgl_port_idle_pause_input(false);
+    lvgl_port_ctx.idle.active = false;
+}
+
+/* The last transfer of a frame ended once the panel IO marked the flush ready */
+static void lvgl_port_latency_check_done(void)
+{
+    if (!lvgl_port_latency_flushed(&lvgl_port_ctx.latency)) {
+        return;
+    }
+    for (lv_disp_t *disp = lv_disp_get_next(NULL); disp; disp = lv_disp_get_next(disp)) {
+        const lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+        if (disp_ctx->perf.transfer_pending && !disp->driver->draw_buf->flushing) {
+            lvgl_port_latency_done(&lvgl_port_ctx.latency, (uint32_t)(disp_ctx->perf.transfer_start + disp_ctx->perf.transfer_time));
+        }
+    }
+}
+
 static void lvgl_port_task(void *arg)
 {
     uint32_t task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
@@ -687,10 +1069,23 @@ static void lvgl_port_task(void *arg)
     ESP_LOGI(TAG, "Starting LVGL task");
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
+        bool idle = false;
         if (lvgl_port_lock(0)) {
+            lvgl_port_idle_wakeup();
             task_delay_ms = lv_timer_handler();
+            lvgl_port_latency_check_done();
+            idle = lvgl_port_idle_enter(&task_delay_ms);
             lvgl_port_unlock();
         }
+        lvgl_port_count_wakeup();
+        if (idle) {
+            /* No periodic timer is left, the CPU can stay in light sleep until the deadline or input */
+            const TickType_t ticks = (task_delay_ms == LV_NO_TIMER_READY) ? portMAX_DELAY : pdMS_TO_TICKS(task_delay_ms);
+            if (ulTaskNotifyTake(pdTRUE, ticks) == 0) {
+                lvgl_port_ctx.idle.deadline = true;
+            }
+            continue;
+        }
         if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms)) {
             task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
         } else if (task_delay_ms < 1) {
@@ -720,10 +1115,15 @@ static void lvgl_port_task_deinit(void)
 #if LVGL_PORT_HANDLE_FLUSH_READY
 static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
 {
+    BaseType_t need_yield = pdFALSE;
     lv_disp_drv_t *disp_drv = (lv_disp_drv_t *)user_ctx;
     assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+
+    disp_ctx->perf.transfer_time = (uint32_t)(esp_timer_get_time() - disp_ctx->perf.transfer_start);
     lv_disp_flush_ready(disp_drv);
-    return false;
+    xSemaphoreGiveFromISR(disp_ctx->flush_done, &need_yield);
+    return (need_yield == pdTRUE);
 }
 #endif
 
@@ -737,8 +1137,85 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
     const int offsetx2 = area->x2;
     const int offsety1 = area->y1;
     const int offsety2 = area->y2;
+
+    /* Part of the rendering in the stats */
+    if (disp_ctx->swap_bytes) {
+        lvgl_port_swap_bytes(color_map, lv_area_get_size(area));
+    }
+
+    /* The previous transfer is finished here (LVGL waited for it), so it can be accounted */
+    const int64_t now = esp_timer_get_time();
+    if (disp_ctx->perf.transfer_pending) {
+        lvgl_port_latency_done(&lvgl_port_ctx.latency, (uint32_t)(disp_ctx->perf.transfer_start + disp_ctx->perf.transfer_time));
+    }
+    const int64_t render_time = now - disp_ctx->perf.segment_start - disp_ctx->perf.wait_pending;
+    if (disp_ctx->perf.transfer_pending) {
+        /* Part of this render segment ran while the previous strip was still on the bus */
+        const int64_t transfer_end = disp_ctx->perf.transfer_start + disp_ctx->perf.transfer_time;
+        const int64_t overlap = transfer_end - disp_ctx->perf.segment_start - disp_ctx->perf.wait_pending;
+        if (overlap > 0) {
+            disp_ctx->perf.stats.overlap_us += LV_MIN(overlap, render_time);
+        }
+    }
+    lvgl_port_flush_stats_commit(disp_ctx);
+    disp_ctx->perf.stats.render_us += render_time;
+    disp_ctx->perf.stats.flushes++;
+    disp_ctx->perf.stats.flushed_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+    if (lv_disp_flush_is_last(drv)) {
+        disp_ctx->perf.stats.frames++;
+    }
+    lvgl_port_latency_flush(&lvgl_port_ctx.latency, (uint32_t)now, lv_disp_flush_is_last(drv));
+
+    disp_ctx->perf.transfer_start = now;
+    disp_ctx->perf.transfer_pending = true;
     // copy a buffer's content to a specific area of the display
     esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
+
+    /* LVGL continues with the next strip in the other buffer */
+    disp_ctx->perf.segment_start = esp_timer_get_time();
+    disp_ctx->perf.wait_pending = 0;
+}
+
+static void lvgl_port_flush_wait_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    const int64_t start = esp_timer_get_time();
+
+    /* Time limited, the flush may also be finished by a direct lv_disp_flush_ready() call */
+    xSemaphoreTake(disp_ctx->flush_done, pdMS_TO_TICKS(10));
+
+    const int64_t waited = esp_timer_get_time() - start;
+    disp_ctx->perf.wait_pending += waited;
+    disp_ctx->perf.stats.wait_us += waited;
+}
+
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+
+    /* Plan the flushed windows, LVGL renders the areas left unjoined */
+    if (!drv->full_refresh) {
+        disp_ctx->perf.stats.merged_areas += lvgl_port_planner_merge_areas(disp_ctx->disp, LVGL_PORT_WINDOW_COST,
+                                             disp_ctx->viewport.bands, disp_ctx->viewport.band_cnt);
+    }
+
+    disp_ctx->perf.segment_start = esp_timer_get_time();
+    disp_ctx->perf.wait_pending = 0;
+    lvgl_port_latency_render(&lvgl_port_ctx.latency, (uint32_t)disp_ctx->perf.segment_start);
+}
+
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    lvgl_port_viewport_round_area(&disp_ctx->viewport, drv, area);
+}
+
+static void lvgl_port_flush_stats_commit(lvgl_port_display_ctx_t *disp_ctx)
+{
+    if (disp_ctx->perf.transfer_pending) {
+        disp_ctx->perf.stats.transfer_us += disp_ctx->perf.transfer_time;
+        disp_ctx->perf.transfer_pending = false;
+    }
 }
 
 static void lvgl_port_update_callback(lv_disp_drv_t *drv)
@@ -829,22 +1306,22 @@ static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *
 #ifdef ESP_LVGL_PORT_KNOB_COMPONENT
 static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
 {
-    static int32_t last_v = 0;
-
     assert(indev_drv);
     lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev_drv->user_data;
     assert(ctx);
 
-    int32_t invd = iot_knob_get_count_value(ctx->knob_handle);
-    knob_event_t event = iot_knob_get_event(ctx->knob_handle);
-
-    if (last_v ^ invd) {
-        last_v = invd;
-        data->enc_diff = (KNOB_LEFT == event) ? (-1) : ((KNOB_RIGHT == event) ? (1) : (0));
-    } else {
-        data->enc_diff = 0;
+    /* The events since the last read, in order: LVGL sends one key per step */
+    uint32_t event_us;
+    if (lvgl_port_encoder_input_read(&ctx->input, data, &event_us)) {
+        lvgl_port_latency_input(&lvgl_port_ctx.latency, event_us, (uint32_t)esp_timer_get_time());
     }
-    data->state = (true == ctx->btn_enter) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void lvgl_port_encoder_read_timer_callback(lv_timer_t *timer)
+{
+    /* Reads the encoder, LVGL calls the event callbacks of the screen */
+    lv_indev_read_timer_cb(timer);
+    lvgl_port_latency_handled(&lvgl_port_ctx.latency, (uint32_t)esp_timer_get_time());
 }
 
 static void lvgl_port_encoder_btn_down_handler(void *arg, void *arg2)
@@ -854,9 +1331,10 @@ static void lvgl_port_encoder_btn_down_handler(void *arg, void *arg2)
     if (ctx && button) {
         /* ENTER */
         if (button == ctx->btn_handle) {
-            ctx->btn_enter = true;
+            lvgl_port_encoder_input_push(&ctx->input, LVGL_PORT_ENCODER_PRESS, 0, (uint32_t)esp_timer_get_time());
         }
     }
+    lvgl_port_wake();
 }
 
 static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2)
@@ -866,9 +1344,26 @@ static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2)
     if (ctx && button) {
         /* ENTER */
         if (button == ctx->btn_handle) {
-            ctx->btn_enter = false;
+            lvgl_port_encoder_input_push(&ctx->input, LVGL_PORT_ENCODER_RELEASE, 0, (uint32_t)esp_timer_get_time());
         }
     }
+    lvgl_port_wake();
+}
+
+static void lvgl_port_encoder_knob_detent(knob_handle_t knob, lvgl_port_encoder_ctx_t *ctx, int dir)
+{
+    lvgl_port_encoder_input_push(&ctx->input, LVGL_PORT_ENCODER_ROTATE, dir, iot_knob_get_event_time(knob));
+    lvgl_port_wake();
+}
+
+static void lvgl_port_encoder_knob_left_handler(void *arg, void *data)
+{
+    lvgl_port_encoder_knob_detent((knob_handle_t)arg, (lvgl_port_encoder_ctx_t *)data, -1);
+}
+
+static void lvgl_port_encoder_knob_right_handler(void *arg, void *data)
+{
+    lvgl_port_encoder_knob_detent((knob_handle_t)arg, (lvgl_port_encoder_ctx_t *)data, 1);
 }
 #endif
 
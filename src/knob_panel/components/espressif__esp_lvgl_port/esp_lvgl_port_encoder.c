@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_lvgl_port_encoder.h"
+
+/*
+ * Gain for detents `interval_us` apart, linear in the detents per second between the slow turn
+ * and the flick: 1 + (max - 1) * (1 / i - 1 / s) / (1 / f - 1 / s) = 1 + (max - 1) * f * (s - i) / (i * (s - f))
+ */
+static uint16_t encoder_accel_gain(const lvgl_port_encoder_accel_t *acc, uint32_t interval_us)
+{
+    if ((acc->max_gain <= LVGL_PORT_ENCODER_GAIN_ONE) || (interval_us >= acc->slow_us)) {
+        return LVGL_PORT_ENCODER_GAIN_ONE;
+    }
+    if (interval_us <= acc->fast_us) {
+        return acc->max_gain;
+    }
+
+    const uint64_t num = (uint64_t)(acc->max_gain - LVGL_PORT_ENCODER_GAIN_ONE) * acc->fast_us * (acc->slow_us - interval_us);
+    const uint64_t den = (uint64_t)interval_us * (acc->slow_us - acc->fast_us);
+    return LVGL_PORT_ENCODER_GAIN_ONE + (uint16_t)(num / den);
+}
+
+void lvgl_port_encoder_accel_init(lvgl_port_encoder_accel_t *acc, const lvgl_port_encoder_accel_cfg_t *cfg)
+{
+    memset(acc, 0, sizeof(*acc));
+    acc->max_gain = LVGL_PORT_ENCODER_GAIN_ONE;
+    acc->gain = LVGL_PORT_ENCODER_GAIN_ONE;
+    if (cfg && (cfg->max_gain > 1) && (cfg->slow_ms > cfg->fast_ms)) {
+        acc->slow_us = cfg->slow_ms * 1000;
+        acc->fast_us = cfg->fast_ms * 1000;
+        acc->max_gain = cfg->max_gain * LVGL_PORT_ENCODER_GAIN_ONE;
+    }
+}
+
+void lvgl_port_encoder_accel_detent(lvgl_port_encoder_accel_t *acc, int dir, uint32_t time_us)
+{
+    dir = (dir > 0) ? 1 : -1;
+    const uint32_t interval_us = time_us - acc->last_us;
+
+    if ((dir != acc->dir) || (interval_us >= acc->slow_us)) {
+        acc->interval_us = acc->slow_us;
+        acc->frac = 0;
+    } else {
+        /* Half of the last interval: a flick reaches its speed in a few detents, one uneven
+         * detent does not change the gain much */
+        acc->interval_us = (acc->interval_us + interval_us) / 2;
+    }
+    acc->dir = dir;
+    acc->last_us = time_us;
+
+    acc->gain = encoder_accel_gain(acc, acc->interval_us);
+    const uint32_t total = acc->frac + acc->gain;
+    acc->steps += dir * (int32_t)(total / LVGL_PORT_ENCODER_GAIN_ONE);
+    acc->frac = total % LVGL_PORT_ENCODER_GAIN_ONE;
+}
+
+int32_t lvgl_port_encoder_accel_take(lvgl_port_encoder_accel_t *acc)
+{
+    const int32_t steps = acc->steps;
+    acc->steps = 0;
+    return steps;
+}
+
+void lvgl_port_encoder_input_init(lvgl_port_encoder_input_t *in, const lvgl_port_encoder_accel_cfg_t *cfg)
+{
+    memset(in, 0, sizeof(*in));
+    atomic_init(&in->head, 0);
+    atomic_init(&in->tail, 0);
+    atomic_init(&in->carry, 0);
+    atomic_init(&in->carry_us, 0);
+    lvgl_port_encoder_accel_init(&in->accel, cfg);
+}
+
+/* Queue an event if fewer than `room` are waiting */
+static bool encoder_input_put(lvgl_port_encoder_input_t *in, uint8_t type, int16_t delta, uint32_t time_us, unsigned room)
+{
+    const unsigned head = atomic_load_explicit(&in->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&in->tail, memory_order_acquire) >= room) {
+        return false;
+    }
+    in->ring[head % LVGL_PORT_ENCODER_RING_SIZE] = (lvgl_port_encoder_event_t) {
+        .time_us = time_us,
+        .type = type,
+        .delta = delta,
+    };
+    atomic_store_explicit(&in->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool lvgl_port_encoder_input_push(lvgl_port_encoder_input_t *in, lvgl_port_encoder_event_type_t type, int delta, uint32_t time_us)
+{
+    const unsigned room = LVGL_PORT_ENCODER_RING_SIZE - ((LVGL_PORT_ENCODER_ROTATE == type) ? LVGL_PORT_ENCODER_BTN_RESERVE : 0);
+
+    /* Detents of the carry first, nothing may overtake them */
+    const int carry = atomic_exchange(&in->carry, 0);
+    if (carry) {
+        const int16_t part = LV_CLAMP(INT16_MIN, carry, INT16_MAX);
+        if (!encoder_input_put(in, LVGL_PORT_ENCODER_ROTATE, part, atomic_load(&in->carry_us), room)) {
+            atomic_fetch_add(&in->carry, carry);
+        } else if (carry != part) {
+            atomic_fetch_add(&in->carry, carry - part);
+        }
+    }
+
+    if ((0 == atomic_load(&in->carry)) &&
+            encoder_input_put(in, type, LV_CLAMP(INT16_MIN, delta, INT16_MAX), time_us, room)) {
+        return true;
+    }
+    if (LVGL_PORT_ENCODER_ROTATE == type) {
+        atomic_store(&in->carry_us, time_us);
+        atomic_fetch_add(&in->carry, delta);
+        return true;
+    }
+    in->dropped++;
+    return false;
+}
+
+static void encoder_input_detents(lvgl_port_encoder_input_t *in, int delta, uint32_t time_us)
+{
+    const int dir = (delta > 0) ? 1 : -1;
+    for (; delta; delta -= dir) {
+        lvgl_port_encoder_accel_detent(&in->accel, dir, time_us);
+    }
+}
+
+uint32_t lvgl_port_encoder_input_read(lvgl_port_encoder_input_t *in, lv_indev_data_t *data, uint32_t *event_us)
+{
+    const unsigned first = atomic_load_explicit(&in->tail, memory_order_relaxed);
+    unsigned tail = first;
+    bool steps = false;
+
+    if (event_us && (tail != atomic_load_explicit(&in->head, memory_order_acquire))) {
+        *event_us = in->ring[tail % LVGL_PORT_ENCODER_RING_SIZE].time_us;
+    }
+
+    while (tail != atomic_load_explicit(&in->head, memory_order_acquire)) {
+        const lvgl_port_encoder_event_t *ev = &in->ring[tail % LVGL_PORT_ENCODER_RING_SIZE];
+        if (LVGL_PORT_ENCODER_ROTATE == ev->type) {
+            encoder_input_detents(in, ev->delta, ev->time_us);
+            steps = true;
+            tail++;
+            continue;
+        }
+        /* A button event on a read of its own, after the detents before it */
+        if (!steps) {
+            in->pressed = (LVGL_PORT_ENCODER_PRESS == ev->type);
+            tail++;
+        }
+        break;
+    }
+    atomic_store_explicit(&in->tail, tail, memory_order_release);
+
+    /* The detents which did not fit are newer than everything in the ring */
+    uint32_t taken = tail - first;
+    bool left = (tail != atomic_load_explicit(&in->head, memory_order_acquire));
+    if (!left) {
+        const int carry = atomic_exchange(&in->carry, 0);
+        if (carry) {
+            const uint32_t carry_us = atomic_load(&in->carry_us);
+            encoder_input_detents(in, carry, carry_us);
+            if (event_us && !taken) {
+                *event_us = carry_us;
+            }
+            taken++;
+        }
+    }
+
+    const int32_t diff = lvgl_port_encoder_accel_take(&in->accel);
+    data->enc_diff = LV_CLAMP(INT16_MIN, diff, INT16_MAX);
+    data->state = in->pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->continue_reading = left;
+    return taken;
+}
+
+bool lvgl_port_encoder_input_pending(const lvgl_port_encoder_input_t *in)
+{
+    return in->pressed || (0 != atomic_load(&in->carry)) ||
+           (atomic_load(&in->tail) != atomic_load(&in->head));
+}
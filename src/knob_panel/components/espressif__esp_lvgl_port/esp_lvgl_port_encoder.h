@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port: input events and steps of the encoder (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "esp_lvgl_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Gain of one step per detent, the gains are in 1/256th of a step */
+#define LVGL_PORT_ENCODER_GAIN_ONE      (256)
+
+/* Input events kept between two reads of LVGL, a power of two */
+#ifndef LVGL_PORT_ENCODER_RING_SIZE
+#define LVGL_PORT_ENCODER_RING_SIZE     (64)
+#endif
+
+/* Places of the ring only the button may take, the detents of a long flick do not crowd it out */
+#define LVGL_PORT_ENCODER_BTN_RESERVE   (4)
+
+/**
+ * @brief Steps of the detents of one encoder, not read by LVGL yet
+ *
+ * Not thread safe: the read callback of LVGL adds the detents it takes from the input events and
+ * takes the steps.
+ */
+typedef struct {
+    uint32_t slow_us;       /* lvgl_port_encoder_accel_cfg_t in microseconds */
+    uint32_t fast_us;
+    uint16_t max_gain;      /* Gain of a flick, LVGL_PORT_ENCODER_GAIN_ONE for no acceleration */
+    int8_t   dir;           /* Direction of the turn, 0 before the first detent */
+    uint32_t last_us;       /* Time of the last detent */
+    uint32_t interval_us;   /* Time between the detents of the turn, smoothed */
+    uint16_t gain;          /* Gain of the last detent */
+    uint16_t frac;          /* Part of a step carried to the next detent, in 1/256th */
+    int32_t  steps;         /* Steps for LVGL */
+} lvgl_port_encoder_accel_t;
+
+/**
+ * @brief Start without steps
+ *
+ * @param acc Steps of the encoder
+ * @param cfg Acceleration, NULL or all zero for one step per detent
+ */
+void lvgl_port_encoder_accel_init(lvgl_port_encoder_accel_t *acc, const lvgl_port_encoder_accel_cfg_t *cfg);
+
+/**
+ * @brief Add the steps of a detent
+ *
+ * A detent in the other direction, or after a pause of `slow_ms`, starts a new turn: at one step,
+ * the fraction left by the previous turn is dropped. Every detent adds one step at least.
+ *
+ * @param acc     Steps of the encoder
+ * @param dir     Direction, > 0 for right
+ * @param time_us Time of the detent
+ */
+void lvgl_port_encoder_accel_detent(lvgl_port_encoder_accel_t *acc, int dir, uint32_t time_us);
+
+/**
+ * @brief Take the steps added since the last call
+ *
+ * @param acc Steps of the encoder
+ * @return Steps, > 0 for right
+ */
+int32_t lvgl_port_encoder_accel_take(lvgl_port_encoder_accel_t *acc);
+
+/**
+ * @brief Kind of an input event
+ */
+typedef enum {
+    LVGL_PORT_ENCODER_ROTATE = 0,   /*!< Detents of the knob, `delta` of them */
+    LVGL_PORT_ENCODER_PRESS,        /*!< Button pressed */
+    LVGL_PORT_ENCODER_RELEASE,      /*!< Button released */
+} lvgl_port_encoder_event_type_t;
+
+/**
+ * @brief One input event, in the order they happened
+ */
+typedef struct {
+    uint32_t time_us;       /* Time it happened, the time of the edge for a detent */
+    uint8_t  type;          /* lvgl_port_encoder_event_type_t */
+    int16_t  delta;         /* Detents, > 0 for right */
+} lvgl_port_encoder_event_t;
+
+/**
+ * @brief Input of one encoder, from the knob and button callbacks to LVGL
+ *
+ * Single producer, single consumer and no lock: the callbacks of iot_knob and iot_button all
+ * run in the esp_timer task and only write `head` and the carry, the read callback of LVGL only
+ * writes `tail` and the rest. Detents which find the ring full are added to the carry, LVGL
+ * reads them once the ring is empty: no detent is lost, a button event is only lost with
+ * LVGL_PORT_ENCODER_BTN_RESERVE of them waiting already (counted in `dropped`).
+ */
+typedef struct {
+    lvgl_port_encoder_event_t ring[LVGL_PORT_ENCODER_RING_SIZE];
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_int  carry;      /* Detents which did not fit in the ring */
+    atomic_uint carry_us;   /* Time of the last of them */
+    uint32_t    dropped;    /* Button events which did not fit in the ring */
+    bool        pressed;    /* Button state last read by LVGL */
+    lvgl_port_encoder_accel_t accel;
+} lvgl_port_encoder_input_t;
+
+/**
+ * @brief Start with an empty ring and the button released
+ *
+ * @param in  Input of the encoder
+ * @param cfg Acceleration, NULL or all zero for one step per detent
+ */
+void lvgl_port_encoder_input_init(lvgl_port_encoder_input_t *in, const lvgl_port_encoder_accel_cfg_t *cfg);
+
+/**
+ * @brief Queue an input event, from the knob and button callbacks only
+ *
+ * @param in      Input of the encoder
+ * @param type    lvgl_port_encoder_event_type_t
+ * @param delta   Detents of LVGL_PORT_ENCODER_ROTATE, > 0 for right
+ * @param time_us Time it happened
+ * @return false if a button event was dropped, the ring was full
+ */
+bool lvgl_port_encoder_input_push(lvgl_port_encoder_input_t *in, lvgl_port_encoder_event_type_t type, int delta, uint32_t time_us);
+
+/**
+ * @brief Fill the data of a read of LVGL, from the read callback of the encoder only
+ *
+ * Takes the events in order: the detents up to the next button event become `enc_diff` through
+ * the acceleration, a button event becomes `state` on its own read. `continue_reading` is set as
+ * long as events are left, LVGL reads again at once and gets them all, a press and release
+ * between two reads included.
+ *
+ * @param in       Input of the encoder
+ * @param data     Data of the read
+ * @param event_us Set to the time of the oldest event taken, may be NULL
+ * @return Number of events taken
+ */
+uint32_t lvgl_port_encoder_input_read(lvgl_port_encoder_input_t *in, lv_indev_data_t *data, uint32_t *event_us);
+
+/**
+ * @brief Check for input LVGL has to read, from the LVGL task
+ *
+ * @param in Input of the encoder
+ * @return true if events are waiting or the button is held (long press)
+ */
+bool lvgl_port_encoder_input_pending(const lvgl_port_encoder_input_t *in);
+
+#ifdef __cplusplus
+}
+#endif
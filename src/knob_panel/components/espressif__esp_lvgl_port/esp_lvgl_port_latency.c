@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_lvgl_port_latency.h"
+
+static const char *const s_stage_names[LVGL_PORT_LATENCY_STAGES] = {
+    "read", "handle", "wait", "render", "flush", "total",
+};
+
+static void latency_hist_add(lvgl_port_latency_hist_t *hist, uint32_t us)
+{
+    uint32_t bucket = 0;
+    while ((bucket < LVGL_PORT_LATENCY_BUCKETS - 1) && (us > LVGL_PORT_LATENCY_BUCKET_US(bucket))) {
+        bucket++;
+    }
+    hist->buckets[bucket]++;
+    hist->count++;
+    hist->sum_us += us;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+}
+
+/* Move the inputs at `from` on, with the time they got there */
+static void latency_advance(lvgl_port_latency_t *lat, lvgl_port_latency_point_t from, uint32_t now_us)
+{
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES; i++) {
+        lvgl_port_latency_sample_t *sample = &lat->samples[i];
+        if (sample->point == from) {
+            sample->point = from + 1;
+            if (from + 1 < LVGL_PORT_LATENCY_LAST_FLUSHED) {
+                sample->time_us[from + 1] = now_us;
+            }
+        }
+    }
+}
+
+/* Inputs handled long ago changed nothing on the screen, the next frame does not answer them */
+static void latency_expire(lvgl_port_latency_t *lat, uint32_t now_us)
+{
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES; i++) {
+        lvgl_port_latency_sample_t *sample = &lat->samples[i];
+        if ((LVGL_PORT_LATENCY_HANDLED == sample->point) &&
+                (now_us - sample->time_us[LVGL_PORT_LATENCY_HANDLED] >= LVGL_PORT_LATENCY_TIMEOUT_US)) {
+            sample->point = LVGL_PORT_LATENCY_FREE;
+            lat->stats.unanswered++;
+        }
+    }
+}
+
+void lvgl_port_latency_init(lvgl_port_latency_t *lat)
+{
+    memset(lat, 0, sizeof(*lat));
+}
+
+void lvgl_port_latency_input(lvgl_port_latency_t *lat, uint32_t event_us, uint32_t now_us)
+{
+    latency_expire(lat, now_us);
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES; i++) {
+        lvgl_port_latency_sample_t *sample = &lat->samples[i];
+        if (LVGL_PORT_LATENCY_FREE == sample->point) {
+            sample->point = LVGL_PORT_LATENCY_READ_DONE;
+            sample->time_us[0] = event_us;
+            sample->time_us[LVGL_PORT_LATENCY_READ_DONE] = now_us;
+            return;
+        }
+    }
+    lat->stats.dropped++;
+}
+
+void lvgl_port_latency_handled(lvgl_port_latency_t *lat, uint32_t now_us)
+{
+    latency_advance(lat, LVGL_PORT_LATENCY_READ_DONE, now_us);
+}
+
+void lvgl_port_latency_render(lvgl_port_latency_t *lat, uint32_t now_us)
+{
+    /* Called for every strip, only the first one of a frame finds handled inputs */
+    latency_expire(lat, now_us);
+    latency_advance(lat, LVGL_PORT_LATENCY_HANDLED, now_us);
+}
+
+void lvgl_port_latency_flush(lvgl_port_latency_t *lat, uint32_t now_us, bool last)
+{
+    latency_advance(lat, LVGL_PORT_LATENCY_RENDERING, now_us);
+    if (last) {
+        latency_advance(lat, LVGL_PORT_LATENCY_FLUSHING, now_us);
+    }
+}
+
+void lvgl_port_latency_done(lvgl_port_latency_t *lat, uint32_t done_us)
+{
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES; i++) {
+        lvgl_port_latency_sample_t *sample = &lat->samples[i];
+        if (LVGL_PORT_LATENCY_LAST_FLUSHED != sample->point) {
+            continue;
+        }
+        /* Stage n runs from point n to point n + 1, the last one up to the end of the transfer */
+        for (int stage = 0; stage < LVGL_PORT_LATENCY_TOTAL; stage++) {
+            const uint32_t end = (stage + 1 < LVGL_PORT_LATENCY_LAST_FLUSHED) ? sample->time_us[stage + 1] : done_us;
+            latency_hist_add(&lat->stats.stages[stage], end - sample->time_us[stage]);
+        }
+        latency_hist_add(&lat->stats.stages[LVGL_PORT_LATENCY_TOTAL], done_us - sample->time_us[0]);
+        sample->point = LVGL_PORT_LATENCY_FREE;
+    }
+}
+
+bool lvgl_port_latency_flushed(const lvgl_port_latency_t *lat)
+{
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES; i++) {
+        if (LVGL_PORT_LATENCY_LAST_FLUSHED == lat->samples[i].point) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t lvgl_port_latency_percentile(const lvgl_port_latency_hist_t *hist, uint32_t percent)
+{
+    if (0 == hist->count) {
+        return 0;
+    }
+
+    /* Rank of the percentile, rounded up: the median of 3 is the 2nd */
+    const uint64_t rank = ((uint64_t)hist->count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LVGL_PORT_LATENCY_BUCKETS - 1; i++) {
+        seen += hist->buckets[i];
+        if ((seen >= rank) && (seen > 0)) {
+            return (LVGL_PORT_LATENCY_BUCKET_US(i) < hist->max_us) ? LVGL_PORT_LATENCY_BUCKET_US(i) : hist->max_us;
+        }
+    }
+    return hist->max_us;
+}
+
+void lvgl_port_print_latency_stats(const lvgl_port_latency_stats_t *stats)
+{
+    printf("%-8s %6s %8s %8s %8s %8s %8s |", "latency", "count", "mean_us", "p50_us", "p90_us", "p99_us", "max_us");
+    for (uint32_t i = 0; i < LVGL_PORT_LATENCY_BUCKETS; i++) {
+        const uint32_t us = LVGL_PORT_LATENCY_BUCKET_US(i);
+        char label[8];
+        if (i + 1 == LVGL_PORT_LATENCY_BUCKETS) {
+            snprintf(label, sizeof(label), "more");
+        } else if (us < 1000) {
+            snprintf(label, sizeof(label), "%" PRIu32 "u", us);
+        } else if (us < 1000 * 1000) {
+            snprintf(label, sizeof(label), "%" PRIu32 "m", us / 1000);
+        } else {
+            snprintf(label, sizeof(label), "%" PRIu32 "s", us / (1000 * 1000));
+        }
+        printf(" %5s", label);
+    }
+    printf("\n");
+
+    for (int stage = 0; stage < LVGL_PORT_LATENCY_STAGES; stage++) {
+        const lvgl_port_latency_hist_t *hist = &stats->stages[stage];
+        printf("%-8s %6" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " |", s_stage_names[stage],
+               hist->count, hist->count ? (uint32_t)(hist->sum_us / hist->count) : 0,
+               lvgl_port_latency_percentile(hist, 50), lvgl_port_latency_percentile(hist, 90),
+               lvgl_port_latency_percentile(hist, 99), hist->max_us);
+        for (uint32_t i = 0; i < LVGL_PORT_LATENCY_BUCKETS; i++) {
+            printf(" %5" PRIu32, hist->buckets[i]);
+        }
+        printf("\n");
+    }
+    printf("%" PRIu32 " unanswered, %" PRIu32 " dropped\n", stats->unanswered, stats->dropped);
+}
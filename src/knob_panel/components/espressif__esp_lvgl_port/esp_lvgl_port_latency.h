@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port: latency trace of the encoder input (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_lvgl_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Inputs traced at the same time, a turn read by LVGL in every read period needs two or three */
+#define LVGL_PORT_LATENCY_SAMPLES       (8)
+
+/* An input without a frame started within this time changed nothing on the screen */
+#define LVGL_PORT_LATENCY_TIMEOUT_US    (1000 * 1000)
+
+/**
+ * @brief Point of the trace an input reached
+ */
+typedef enum {
+    LVGL_PORT_LATENCY_FREE = 0,
+    LVGL_PORT_LATENCY_READ_DONE,        /* Taken by the read callback of LVGL */
+    LVGL_PORT_LATENCY_HANDLED,          /* The event callbacks returned */
+    LVGL_PORT_LATENCY_RENDERING,        /* The rendering of a frame started */
+    LVGL_PORT_LATENCY_FLUSHING,         /* The first strip of the frame was flushed */
+    LVGL_PORT_LATENCY_LAST_FLUSHED,     /* The last strip was flushed, its transfer runs */
+} lvgl_port_latency_point_t;
+
+/**
+ * @brief One input in flight, the times of the points it reached
+ */
+typedef struct {
+    uint8_t  point;                                 /* lvgl_port_latency_point_t */
+    uint32_t time_us[LVGL_PORT_LATENCY_LAST_FLUSHED]; /* Time of the event, then of the points up to FLUSHING */
+} lvgl_port_latency_sample_t;
+
+/**
+ * @brief Latency trace of the encoders
+ *
+ * Not thread safe, all calls from the LVGL task. The times are given by the caller: the port
+ * takes them from esp_timer, the host backend from its simulated clock.
+ */
+typedef struct {
+    lvgl_port_latency_sample_t samples[LVGL_PORT_LATENCY_SAMPLES];
+    lvgl_port_latency_stats_t  stats;
+} lvgl_port_latency_t;
+
+/**
+ * @brief Start without inputs in flight and empty statistics
+ *
+ * @param lat Latency trace
+ */
+void lvgl_port_latency_init(lvgl_port_latency_t *lat);
+
+/**
+ * @brief An input taken by the read callback of LVGL
+ *
+ * @param lat      Latency trace
+ * @param event_us Time of the oldest event taken
+ * @param now_us   Time of the read
+ */
+void lvgl_port_latency_input(lvgl_port_latency_t *lat, uint32_t event_us, uint32_t now_us);
+
+/**
+ * @brief The read timer of an encoder returned, with the event callbacks it called
+ *
+ * @param lat    Latency trace
+ * @param now_us Current time
+ */
+void lvgl_port_latency_handled(lvgl_port_latency_t *lat, uint32_t now_us);
+
+/**
+ * @brief LVGL starts rendering, from the render_start_cb of the display
+ *
+ * @param lat    Latency trace
+ * @param now_us Current time
+ */
+void lvgl_port_latency_render(lvgl_port_latency_t *lat, uint32_t now_us);
+
+/**
+ * @brief A strip is flushed, from the flush_cb of the display
+ *
+ * @param lat    Latency trace
+ * @param now_us Current time
+ * @param last   Last strip of the frame (lv_disp_flush_is_last())
+ */
+void lvgl_port_latency_flush(lvgl_port_latency_t *lat, uint32_t now_us, bool last);
+
+/**
+ * @brief The transfer of the last strip of a frame ended, the inputs it answers are counted
+ *
+ * @param lat     Latency trace
+ * @param done_us End of the transfer (on_color_trans_done)
+ */
+void lvgl_port_latency_done(lvgl_port_latency_t *lat, uint32_t done_us);
+
+/**
+ * @brief Check for inputs waiting for the end of a transfer
+ *
+ * @param lat Latency trace
+ * @return true if lvgl_port_latency_done() has inputs to count
+ */
+bool lvgl_port_latency_flushed(const lvgl_port_latency_t *lat);
+
+#ifdef __cplusplus
+}
+#endif
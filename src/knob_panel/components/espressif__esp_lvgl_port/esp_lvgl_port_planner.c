@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_lvgl_port_planner.h"
+
+/* The area does not reach out of the visible bands */
+static bool planner_in_band(const lv_area_t *area, const lv_area_t *bands, uint8_t band_cnt)
+{
+    if (band_cnt == 0) {
+        return true;
+    }
+    for (uint8_t i = 0; i < band_cnt; i++) {
+        if (_lv_area_is_in(area, &bands[i], 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t lvgl_port_planner_merge_areas(lv_disp_t *disp, uint32_t window_cost, const lv_area_t *bands, uint8_t band_cnt)
+{
+    uint32_t merged = 0;
+
+    /* Merge the pair with the biggest gain first, until no merge pays off */
+    while (true) {
+        int best_i = -1;
+        int best_j = -1;
+        int32_t best_gain = 0;
+        lv_area_t best_area;
+
+        for (int i = 0; i < disp->inv_p; i++) {
+            if (disp->inv_area_joined[i]) {
+                continue;
+            }
+            const int32_t size_i = lv_area_get_size(&disp->inv_areas[i]);
+            for (int j = i + 1; j < disp->inv_p; j++) {
+                if (disp->inv_area_joined[j]) {
+                    continue;
+                }
+                lv_area_t bbox;
+                bbox.x1 = LV_MIN(disp->inv_areas[i].x1, disp->inv_areas[j].x1);
+                bbox.y1 = LV_MIN(disp->inv_areas[i].y1, disp->inv_areas[j].y1);
+                bbox.x2 = LV_MAX(disp->inv_areas[i].x2, disp->inv_areas[j].x2);
+                bbox.y2 = LV_MAX(disp->inv_areas[i].y2, disp->inv_areas[j].y2);
+                /* A box over two bands would cover the invisible corners between them */
+                if (!planner_in_band(&bbox, bands, band_cnt)) {
+                    continue;
+                }
+
+                /* Overlapping pixels are rendered and sent twice by separate windows */
+                const int32_t gain = size_i + (int32_t)lv_area_get_size(&disp->inv_areas[j]) + (int32_t)window_cost -
+                                     (int32_t)lv_area_get_size(&bbox);
+                if (gain > best_gain) {
+                    best_gain = gain;
+                    best_i = i;
+                    best_j = j;
+                    best_area = bbox;
+                }
+            }
+        }
+
+        if (best_i < 0) {
+            break;
+        }
+        /* The later area is kept, LVGL already picked the last unjoined one to end the frame */
+        disp->inv_areas[best_j] = best_area;
+        disp->inv_area_joined[best_i] = 1;
+        merged++;
+    }
+
+    return merged;
+}
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port: flush planner (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fixed cost of one more window (object tree walk in LVGL, CASET/RASET/RAMWR on the bus) in pixels, measured with host/bench_round */
+#define LVGL_PORT_WINDOW_COST   (1024)
+
+/**
+ * @brief Merge the invalidated areas of a display where one window is cheaper than two
+ *
+ * Two areas are replaced by their bounding box when the bounding box has fewer pixels
+ * than both areas plus the cost of the extra window. LVGL only joins areas when the
+ * bounding box is smaller than both, so small areas close to each other are kept apart.
+ * With bands, only areas of the same band are merged, the box never covers pixels
+ * outside of the viewport. Call from the render_start_cb of the display: the merged
+ * box replaces the later area, so the last area LVGL picked stays unjoined.
+ *
+ * @param disp        Display
+ * @param window_cost Cost of one window in pixels
+ * @param bands       Rectangles covering the visible area (lvgl_port_viewport_t), NULL if band_cnt is 0
+ * @param band_cnt    Number of bands, 0 for the whole display
+ * @return Number of areas merged into another one
+ */
+uint32_t lvgl_port_planner_merge_areas(lv_disp_t *disp, uint32_t window_cost, const lv_area_t *bands, uint8_t band_cnt);
+
+#ifdef __cplusplus
+}
+#endif
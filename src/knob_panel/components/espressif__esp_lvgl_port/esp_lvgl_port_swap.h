@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port: byte swap of the flushed RGB565 strip (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Swap the two bytes of every RGB565 colour of a strip, in place
+ *
+ * Used by the flush when LVGL renders in the native byte order (LV_COLOR_16_SWAP off) for a
+ * big-endian panel. Two pixels are swapped per 32-bit word.
+ *
+ * @param buf Strip rendered by LVGL
+ * @param px  Number of pixels
+ */
+static inline void lvgl_port_swap_bytes(lv_color_t *buf, uint32_t px)
+{
+    uint8_t *p = (uint8_t *)buf;
+    uint32_t i = 0;
+
+    for (; i + 2 <= px; i += 2, p += 4) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        v = ((v & 0xff00ff00U) >> 8) | ((v & 0x00ff00ffU) << 8);
+        memcpy(p, &v, sizeof(v));
+    }
+    if (i < px) {
+        const uint8_t b = p[0];
+        p[0] = p[1];
+        p[1] = b;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
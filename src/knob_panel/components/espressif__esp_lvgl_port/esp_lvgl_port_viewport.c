@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_lvgl_port_viewport.h"
+
+/* Disc inscribed into the display, a pixel is visible if any part of it lies inside */
+static void viewport_disc_span(lv_coord_t hres, lv_coord_t vres, int y, int *x_start, int *x_end)
+{
+    const int diameter = LV_MIN(hres, vres);
+    const int radius = diameter / 2;
+    const int x_center = hres / 2;
+
+    y -= (vres - diameter) / 2;
+    if (y < 0 || y >= diameter) {
+        *x_start = 0;
+        *x_end = 0;
+        return;
+    }
+
+    const int dy = (y < radius) ? (radius - 1 - y) : (y - radius);
+    const int sq = radius * radius - dy * dy;
+    int half = 0;
+    while (half * half < sq) {
+        half++;
+    }
+    *x_start = x_center - half;
+    *x_end = x_center + half;
+}
+
+esp_err_t lvgl_port_viewport_init(lvgl_port_viewport_t *vp, lv_coord_t hres, lv_coord_t vres, lvgl_port_viewport_span_cb_t span_cb)
+{
+    esp_err_t ret = ESP_OK;
+    const int rows = vres;
+    const int max_bands = LVGL_PORT_VIEWPORT_MAX_BANDS;
+
+    memset(vp, 0, sizeof(lvgl_port_viewport_t));
+
+    int16_t *span = malloc(rows * 2 * sizeof(int16_t));
+    uint32_t *cost = malloc((max_bands + 1) * (rows + 1) * sizeof(uint32_t));
+    uint16_t *split = malloc((max_bands + 1) * (rows + 1) * sizeof(uint16_t));
+    if (span == NULL || cost == NULL || split == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto err;
+    }
+
+    /* Visible part of every row, invisible rows get an empty span */
+    int first = -1;
+    int last = -1;
+    for (int y = 0; y < rows; y++) {
+        int x_start = 0;
+        int x_end = hres;
+        if (span_cb == NULL) {
+            viewport_disc_span(hres, vres, y, &x_start, &x_end);
+        } else if (span_cb(y, &x_start, &x_end) != ESP_OK) {
+            x_start = 0;
+            x_end = hres;
+        }
+        x_start = LV_CLAMP(0, x_start, hres);
+        x_end = LV_CLAMP(0, x_end, hres);
+        span[y * 2] = x_start;
+        span[y * 2 + 1] = x_end;
+        if (x_start < x_end) {
+            first = (first < 0) ? y : first;
+            last = y;
+        }
+    }
+    if (first < 0) {
+        goto err;
+    }
+
+    /*
+     * Split rows [first, last] into at most max_bands bands with the lowest cost,
+     * cost of a band is its bounding box plus the fixed cost of a window.
+     */
+    const int n = last - first + 1;
+#define COST(k, e)  cost[(k) * (rows + 1) + (e)]
+#define SPLIT(k, e) split[(k) * (rows + 1) + (e)]
+    for (int k = 0; k <= max_bands; k++) {
+        for (int e = 0; e <= n; e++) {
+            COST(k, e) = UINT32_MAX;
+        }
+    }
+    COST(0, 0) = 0;
+    for (int k = 1; k <= max_bands; k++) {
+        for (int e = 1; e <= n; e++) {
+            int lo = hres;
+            int hi = 0;
+            for (int s = e - 1; s >= 0; s--) {
+                const int y = first + s;
+                if (span[y * 2] < span[y * 2 + 1]) {
+                    lo = LV_MIN(lo, span[y * 2]);
+                    hi = LV_MAX(hi, span[y * 2 + 1]);
+                }
+                if (COST(k - 1, s) == UINT32_MAX) {
+                    continue;
+                }
+                const uint32_t band = (uint32_t)(e - s) * LV_MAX(hi - lo, 0) + LVGL_PORT_WINDOW_COST;
+                if (COST(k - 1, s) + band < COST(k, e)) {
+                    COST(k, e) = COST(k - 1, s) + band;
+                    SPLIT(k, e) = s;
+                }
+            }
+        }
+    }
+
+    int best_k = 1;
+    for (int k = 2; k <= max_bands; k++) {
+        if (COST(k, n) < COST(best_k, n)) {
+            best_k = k;
+        }
+    }
+
+    /* Walk back the splits, starting with the last band */
+    int e = n;
+    for (int k = best_k; k > 0; k--) {
+        const int s = SPLIT(k, e);
+        lv_area_t *band = &vp->bands[k - 1];
+        band->x1 = hres;
+        band->x2 = -1;
+        for (int y = first + s; y < first + e; y++) {
+            if (span[y * 2] < span[y * 2 + 1]) {
+                band->x1 = LV_MIN(band->x1, span[y * 2]);
+                band->x2 = LV_MAX(band->x2, span[y * 2 + 1] - 1);
+            }
+        }
+        band->y1 = first + s;
+        band->y2 = first + e - 1;
+        e = s;
+    }
+    vp->band_cnt = best_k;
+#undef COST
+#undef SPLIT
+
+err:
+    free(span);
+    free(cost);
+    free(split);
+    return ret;
+}
+
+void lvgl_port_viewport_round_area(lvgl_port_viewport_t *vp, lv_disp_drv_t *drv, lv_area_t *area)
+{
+    if (vp->band_cnt == 0 || vp->splitting) {
+        return;
+    }
+
+    lv_disp_t *disp = lv_disp_get_next(NULL);
+    while (disp && disp->driver != drv) {
+        disp = lv_disp_get_next(disp);
+    }
+    /* LVGL also rounds while rendering to size the strips, split only invalidated areas */
+    if (disp == NULL || disp->rendering_in_progress) {
+        return;
+    }
+
+    /* Completely inside of one band, nothing to split */
+    for (int i = 0; i < vp->band_cnt; i++) {
+        if (_lv_area_is_in(area, &vp->bands[i], 0)) {
+            return;
+        }
+    }
+
+    lv_area_t part;
+    lv_area_t last_part;
+    bool split = false;
+    vp->splitting = true;
+    for (int i = 0; i < vp->band_cnt; i++) {
+        if (_lv_area_intersect(&part, area, &vp->bands[i])) {
+            _lv_inv_area(disp, &part);
+            last_part = part;
+            split = true;
+        }
+    }
+    vp->splitting = false;
+
+    if (split) {
+        /* Already saved (or covered by a saved area), LVGL skips it */
+        *area = last_part;
+    } else if (disp->inv_p > 0) {
+        /* Nothing visible, replace with an area which is already saved */
+        *area = disp->inv_areas[0];
+    } else {
+        /* Nothing visible and nothing to hide it behind, shrink to a single pixel */
+        area->x1 = area->x2 = vp->bands[0].x1;
+        area->y1 = area->y2 = vp->bands[0].y1;
+    }
+}
+
+uint32_t lvgl_port_viewport_get_size(const lvgl_port_viewport_t *vp)
+{
+    uint32_t size = 0;
+    for (int i = 0; i < vp->band_cnt; i++) {
+        size += lv_area_get_size(&vp->bands[i]);
+    }
+    return size;
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port: viewport of non-rectangular displays (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_planner.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Every band is one invalidated area, keep well below LV_INV_BUF_SIZE */
+#define LVGL_PORT_VIEWPORT_MAX_BANDS    (8)
+
+/**
+ * @brief Visible part of a row, same as lvgl_port_visible_span_cb_t
+ */
+typedef esp_err_t (*lvgl_port_viewport_span_cb_t)(int y, int *x_start, int *x_end);
+
+/**
+ * @brief Viewport of a display
+ *
+ * The visible area is covered by horizontal bands. Invalidated areas are split along the bands,
+ * so the pixels outside of the visible area are neither rendered nor flushed.
+ */
+typedef struct {
+    lv_area_t bands[LVGL_PORT_VIEWPORT_MAX_BANDS];  /* Rectangles covering the visible area */
+    uint8_t   band_cnt;                             /* Number of bands, 0 if the viewport is disabled */
+    bool      splitting;                            /* Set while the split parts are being invalidated */
+} lvgl_port_viewport_t;
+
+/**
+ * @brief Plan the bands covering the visible area
+ *
+ * @param vp      Viewport
+ * @param hres    Horizontal resolution
+ * @param vres    Vertical resolution
+ * @param span_cb Visible part of a row, NULL for the disc inscribed into the display
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_viewport_init(lvgl_port_viewport_t *vp, lv_coord_t hres, lv_coord_t vres, lvgl_port_viewport_span_cb_t span_cb);
+
+/**
+ * @brief Split an invalidated area along the bands, to be called from the rounder_cb
+ *
+ * The parts inside of the bands are invalidated separately and `area` is replaced by one of them,
+ * so LVGL drops it as a duplicate.
+ *
+ * @param vp   Viewport
+ * @param drv  Display driver which invalidates the area
+ * @param area Invalidated area
+ */
+void lvgl_port_viewport_round_area(lvgl_port_viewport_t *vp, lv_disp_drv_t *drv, lv_area_t *area);
+
+/**
+ * @brief Number of pixels of the bands
+ *
+ * @param vp Viewport
+ * @return Number of pixels which are rendered on a full screen refresh
+ */
+uint32_t lvgl_port_viewport_get_size(const lvgl_port_viewport_t *vp);
+
+#ifdef __cplusplus
+}
+#endif
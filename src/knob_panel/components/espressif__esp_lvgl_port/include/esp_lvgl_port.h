@@ -49,6 +49,7 @@ typedef struct {
     int task_affinity;      /*!< LVGL task pinned to core (-1 is no affinity) */
     int task_max_sleep_ms;  /*!< Maximum sleep in LVGL task */
     int timer_period_ms;    /*!< LVGL timer tick period in ms */
+    int idle_threshold_ms;  /*!< Stop the LVGL tick when nothing is due for this long (0 to always poll) */
 } lvgl_port_cfg_t;
 
 /**
@@ -60,6 +61,16 @@ typedef struct {
     bool mirror_y; /*!< LCD Screen mirrored Y (in esp_lcd driver) */
 } lvgl_port_rotation_cfg_t;
 
+/**
+ * @brief Get the visible part of a display row
+ *
+ * @param[in]  y       Row
+ * @param[out] x_start First visible column of the row
+ * @param[out] x_end   Column after the last visible one
+ * @return ESP_OK if the span is valid
+ */
+typedef esp_err_t (*lvgl_port_visible_span_cb_t)(int y, int *x_start, int *x_end);
+
 /**
  * @brief Configuration display structure
  */
@@ -72,13 +83,92 @@ typedef struct {
     uint32_t    vres;           /*!< LCD display vertical resolution */
     bool        monochrome;     /*!< True, if display is monochrome and using 1bit for 1px */
     lvgl_port_rotation_cfg_t rotation;    /*!< Default values of the screen rotation */
+    lvgl_port_visible_span_cb_t visible_span_cb;  /*!< Visible part of a row for the circular viewport, NULL for the inscribed disc */
 
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int circular_viewport: 1; /*!< Round panel, pixels outside of the visible disc are not rendered nor flushed */
+        unsigned int swap_bytes: 1;  /*!< Swap the bytes of the RGB565 colours in the flush: a big-endian panel with LV_COLOR_16_SWAP off */
     } flags;
 } lvgl_port_display_cfg_t;
 
+/**
+ * @brief Flush statistics of one display
+ *
+ * @note With two draw buffers smaller than the screen, LVGL renders the next strip while
+ * the previous one is transferred, `overlap_us` shows how much of the rendering was hidden that way.
+ */
+typedef struct {
+    uint32_t frames;        /*!< Number of refresh cycles completely handed to the panel */
+    uint32_t flushes;       /*!< Number of flushed strips */
+    uint64_t flushed_bytes; /*!< Bytes handed to the panel IO */
+    uint64_t render_us;     /*!< Time LVGL spent rendering strips */
+    uint64_t transfer_us;   /*!< Time the panel IO spent transferring strips */
+    uint64_t wait_us;       /*!< Time LVGL was blocked waiting for a free draw buffer */
+    uint64_t overlap_us;    /*!< Rendering time which ran in parallel with a transfer */
+    uint32_t merged_areas;  /*!< Invalidated areas merged into a bounding box because one window was cheaper */
+} lvgl_port_flush_stats_t;
+
+/**
+ * @brief Residency statistics of the idle governor
+ *
+ * @note With `idle_threshold_ms` set, the LVGL task stops the LVGL tick when no LVGL timer or
+ * animation is due within the threshold and the encoders are at rest. It sleeps until the next
+ * deadline, a knob or button event, or lvgl_port_wake() from another task. With esp_pm light sleep
+ * and knob/button power save, nothing wakes up the CPU meanwhile.
+ */
+typedef struct {
+    uint32_t entries;           /*!< Times the tick was stopped */
+    uint64_t idle_us;           /*!< Time spent with the tick stopped */
+    uint64_t active_us;         /*!< Time the tick was running */
+    uint32_t longest_ms;        /*!< Longest idle period */
+    uint32_t deadline_wakeups;  /*!< Idle periods ended by the next LVGL timer */
+    uint32_t event_wakeups;     /*!< Idle periods ended by input or lvgl_port_wake() */
+} lvgl_port_idle_stats_t;
+
+/**
+ * @brief Stages of the latency of an input, from the knob or button to the panel
+ */
+typedef enum {
+    LVGL_PORT_LATENCY_READ = 0,     /*!< From the knob or button event to the read of LVGL */
+    LVGL_PORT_LATENCY_HANDLE,       /*!< From the read to the return of the event callbacks of the screen */
+    LVGL_PORT_LATENCY_WAIT,         /*!< From there to the start of the rendering of the next frame */
+    LVGL_PORT_LATENCY_RENDER,       /*!< From the start of the rendering to the first flush of the frame */
+    LVGL_PORT_LATENCY_FLUSH,        /*!< From the first flush to the end of the transfer of the last one (on_color_trans_done) */
+    LVGL_PORT_LATENCY_TOTAL,        /*!< From the event to the end of the transfer */
+    LVGL_PORT_LATENCY_STAGES,
+} lvgl_port_latency_stage_t;
+
+/* Buckets of a latency histogram, bucket i counts the times up to LVGL_PORT_LATENCY_BUCKET_US(i) */
+#define LVGL_PORT_LATENCY_BUCKETS       (16)
+#define LVGL_PORT_LATENCY_BUCKET_US(i)  (128UL << (i))
+
+/**
+ * @brief Latency histogram of one stage
+ *
+ * @note The buckets double in width, the last one also counts everything longer.
+ */
+typedef struct {
+    uint32_t count;                             /*!< Inputs traced */
+    uint32_t max_us;                            /*!< Longest time */
+    uint64_t sum_us;                            /*!< Sum of the times */
+    uint32_t buckets[LVGL_PORT_LATENCY_BUCKETS];
+} lvgl_port_latency_hist_t;
+
+/**
+ * @brief Latency statistics of the knob and button of the encoders
+ *
+ * @note Every read of LVGL which takes knob or button events is traced from the oldest of them
+ * through the event callbacks of the screen to the end of the transfer of the next frame. An input
+ * which changes nothing on the screen is `unanswered` once no frame started within a second.
+ */
+typedef struct {
+    lvgl_port_latency_hist_t stages[LVGL_PORT_LATENCY_STAGES];
+    uint32_t unanswered;    /*!< Inputs without a frame after them */
+    uint32_t dropped;       /*!< Inputs not traced, too many were in flight */
+} lvgl_port_latency_stats_t;
+
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 /**
  * @brief Configuration touch structure
@@ -89,14 +179,34 @@ typedef struct {
 } lvgl_port_touch_cfg_t;
 #endif
 
+/**
+ * @brief Acceleration of an encoder
+ *
+ * The steps of a detent grow with the speed of the knob, from 1 for detents `slow_ms` apart
+ * or more up to `max_gain` for detents `fast_ms` apart or less, in proportion to the detents
+ * per second in between. The fraction of a step left over carries to the next detent of the
+ * same direction. All zero: one step per detent.
+ */
+typedef struct {
+    uint16_t slow_ms;       /*!< Time between two detents of a slow turn */
+    uint16_t fast_ms;       /*!< Time between two detents of a flick */
+    uint8_t  max_gain;      /*!< Steps per detent of a flick */
+} lvgl_port_encoder_accel_cfg_t;
+
 #ifdef ESP_LVGL_PORT_KNOB_COMPONENT
 /**
  * @brief Configuration of the encoder structure
+ *
+ * @note The detents and button changes are queued with their time until LVGL reads them, in the
+ * order they happened. The steps of the detents up to a button change come at once as `enc_diff`:
+ * LVGL sends one LV_KEY_LEFT/LV_KEY_RIGHT per step. A press and release between two reads make a
+ * click.
  */
 typedef struct {
     lv_disp_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
     const knob_config_t *encoder_a_b;
     const button_config_t *encoder_enter;  /*!< Navigation button for enter */
+    lvgl_port_encoder_accel_cfg_t accel;   /*!< Acceleration of the knob */
 } lvgl_port_encoder_cfg_t;
 #endif
 
@@ -141,6 +251,7 @@ typedef struct {
         .task_affinity = -1,      \
         .task_max_sleep_ms = 500, \
         .timer_period_ms = 5,     \
+        .idle_threshold_ms = 0,   \
     }
 
 /**
@@ -187,6 +298,106 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg);
  */
 esp_err_t lvgl_port_remove_disp(lv_disp_t *disp);
 
+/**
+ * @brief Set height of the strips rendered into the draw buffers
+ *
+ * @note The draw buffers are not reallocated, the strip must fit into the `buffer_size` used in lvgl_port_add_disp.
+ * With `double_buffer` enabled, the strips are rendered and flushed in ping-pong.
+ * The LVGL mutex must be taken when calling this function.
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param lines Strip height in lines
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the strip does not fit into the draw buffer
+ *      - ESP_ERR_NOT_SUPPORTED     if the display is refreshed in full (monochrome)
+ */
+esp_err_t lvgl_port_set_strip_height(lv_disp_t *disp, uint32_t lines);
+
+/**
+ * @brief Get height of the strips rendered into the draw buffers
+ *
+ * @param disp LVGL display handle (returned from lvgl_port_add_disp)
+ * @return Strip height in lines
+ */
+uint32_t lvgl_port_get_strip_height(lv_disp_t *disp);
+
+/**
+ * @brief Get flush statistics of the display
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ */
+esp_err_t lvgl_port_get_flush_stats(lv_disp_t *disp, lvgl_port_flush_stats_t *stats);
+
+/**
+ * @brief Reset flush statistics of the display
+ *
+ * @param disp LVGL display handle (returned from lvgl_port_add_disp)
+ */
+void lvgl_port_reset_flush_stats(lv_disp_t *disp);
+
+/**
+ * @brief Get how often the LVGL task woke up to run lv_timer_handler()
+ *
+ * @note Counted over the last complete second. The task sleeps until the next LVGL timer is due,
+ * every timer which polls often wakes it up even when nothing changes on the screen.
+ *
+ * @return Wakeups per second
+ */
+uint32_t lvgl_port_get_wakeups_per_sec(void);
+
+/**
+ * @brief Get the residency statistics of the idle governor
+ *
+ * @note The current idle period counts with its time so far, it is not ended.
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ */
+esp_err_t lvgl_port_get_idle_stats(lvgl_port_idle_stats_t *stats);
+
+/**
+ * @brief Reset the residency statistics of the idle governor
+ */
+void lvgl_port_reset_idle_stats(void);
+
+/**
+ * @brief Get the latency statistics of the encoders
+ *
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ */
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats);
+
+/**
+ * @brief Reset the latency statistics of the encoders, the inputs in flight are still traced
+ */
+void lvgl_port_reset_latency_stats(void);
+
+/**
+ * @brief Get a percentile of a latency histogram
+ *
+ * @param hist    Histogram of one stage
+ * @param percent Percentile, 50 for the median
+ * @return Upper bound of the bucket of the percentile, at most `max_us`, 0 without inputs
+ */
+uint32_t lvgl_port_latency_percentile(const lvgl_port_latency_hist_t *hist, uint32_t percent);
+
+/**
+ * @brief Print the latency statistics to the console, one histogram per stage
+ *
+ * @param stats Statistics (from lvgl_port_get_latency_stats)
+ */
+void lvgl_port_print_latency_stats(const lvgl_port_latency_stats_t *stats);
+
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 /**
  * @brief Add LCD touch as an input device
@@ -301,6 +512,15 @@ bool lvgl_port_lock(uint32_t timeout_ms);
  */
 void lvgl_port_unlock(void);
 
+/**
+ * @brief Wake up the LVGL task when the idle governor stopped the LVGL tick
+ *
+ * @note Call it after changing the UI from another task, else LVGL only renders the change at its
+ * next deadline. Knob and button input of the port wakes up the task on its own. Taking the LVGL
+ * lock does not.
+ */
+void lvgl_port_wake(void);
+
 /**
  * @brief Notify LVGL, that data was flushed to LCD display
  *
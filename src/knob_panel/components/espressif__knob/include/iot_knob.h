@@ -95,6 +95,16 @@ esp_err_t iot_knob_unregister_cb(knob_handle_t knob_handle, knob_event_t event);
  */
 knob_event_t iot_knob_get_event(knob_handle_t knob_handle);
 
+/**
+ * @brief Get the time of the detent of the event being called back
+ *
+ * @note Only valid in the event callbacks, which may run some time after the detent
+ *
+ * @param knob_handle A knob handle to register
+ * @return uint32_t Time of the edge which completed the detent, in microseconds of esp_timer_get_time()
+ */
+uint32_t iot_knob_get_event_time(knob_handle_t knob_handle);
+
 /**
  * @brief Get knob count value
  *
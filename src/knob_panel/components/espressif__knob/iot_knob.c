@@ -0,0 +1,288 @@
+/*
+ * SPDX-FileCopyrightText: 2016-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "input_scan.h"
+#include "iot_knob.h"
+#include "knob_gpio.h"
+#include "knob_quadrature.h"
+
+static const char *TAG = "Knob";
+
+#define KNOB_CHECK(a, str, ret_val)                          \
+    if (!(a))                                                     \
+    {                                                             \
+        ESP_LOGE(TAG, "%s(%d): %s", __FUNCTION__, __LINE__, str); \
+        return (ret_val);                                         \
+    }
+
+#define KNOB_CHECK_GOTO(a, str, label) if(!(a)) { \
+        ESP_LOGE(TAG,"%s:%d (%s):%s", __FILE__, __LINE__, __FUNCTION__, str); \
+        goto label; \
+    }
+
+#define CALL_EVENT_CB(ev)   if(knob->cb[ev])knob->cb[ev](knob, knob->usr_data[ev])
+
+typedef struct Knob {
+    bool          enable_power_save;                           /*<! Enable power save function */
+    knob_event_t  event;                                       /*!< Current event */
+    uint32_t      event_time_us;                               /*!< Time of the detent being called back */
+    knob_quad_t   quad;                                        /*!< Decoder, holds the count */
+    portMUX_TYPE  lock;                                        /*!< Count changed by the interrupt or cleared by a task */
+    uint8_t (*hal_knob_level)(void *hardware_data);            /*!< Get current level */
+    void          *encoder_a;                                  /*!< Encoder A phase gpio number */
+    void          *encoder_b;                                  /*!< Encoder B phase gpio number */
+    void          *usr_data[KNOB_EVENT_MAX];                   /*!< User data for event */
+    knob_cb_t     cb[KNOB_EVENT_MAX];                          /*!< Event callback */
+} knob_dev_t;
+
+/* The event callbacks are called by the input scan tick, shared with the button */
+static uint16_t s_knob_num = 0;
+static bool s_is_running = true;                               /*!< The pin interrupts are enabled */
+
+#define HIGH_LIMIT        CONFIG_KNOB_HIGH_LIMIT
+#define LOW_LIMIT         CONFIG_KNOB_LOW_LIMIT
+
+/*
+ * Interrupt on the level the pin does not have: it fires once per edge, and right away
+ * for an edge which came while the handler ran. The same level wakes up from light sleep.
+ */
+static void IRAM_ATTR knob_arm_pin(knob_dev_t *knob, void *pin, uint8_t level)
+{
+    if (knob->enable_power_save) {
+        knob_gpio_wake_up_control((uint32_t)pin, !level, true);
+    } else {
+        knob_gpio_set_intr((uint32_t)pin, level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+}
+
+static void IRAM_ATTR knob_isr_handler(void *arg)
+{
+    knob_dev_t *knob = (knob_dev_t *)arg;
+    const uint8_t level_a = knob->hal_knob_level(knob->encoder_a);
+    const uint8_t level_b = knob->hal_knob_level(knob->encoder_b);
+
+    knob_arm_pin(knob, knob->encoder_a, level_a);
+    knob_arm_pin(knob, knob->encoder_b, level_b);
+    /* The event is set by knob_scan() with each callback, the steps only queue here */
+    portENTER_CRITICAL_ISR(&knob->lock);
+    const bool counted = knob_quad_edge(&knob->quad, level_a, level_b, (uint32_t)esp_timer_get_time(), NULL);
+    portEXIT_CRITICAL_ISR(&knob->lock);
+    if (counted) {
+        /* Nothing to do while the tick runs, its next scan drains all the steps */
+        input_scan_wake();
+    }
+}
+
+/* Event callbacks of the steps decoded by the interrupt, in the esp_timer task of the input scan */
+static bool knob_scan(void *arg)
+{
+    knob_dev_t *knob = (knob_dev_t *)arg;
+    knob_quad_step_t step;
+    bool fast = false;
+
+    while (knob_quad_pop(&knob->quad, &step)) {
+        fast = (step.time_us - knob->event_time_us < INPUT_SCAN_PERIOD_US);
+        knob->event_time_us = step.time_us;
+        /* iot_knob_get_event() in a callback gives the event being called back */
+        knob->event = step.dir > 0 ? KNOB_RIGHT : KNOB_LEFT;
+        CALL_EVENT_CB(knob->event);
+        if (KNOB_QUAD_NONE == step.limit) {
+            continue;
+        }
+        if (KNOB_QUAD_HIGH == step.limit) {
+            knob->event = KNOB_H_LIM;
+        } else if (KNOB_QUAD_LOW == step.limit) {
+            knob->event = KNOB_L_LIM;
+        } else {
+            knob->event = KNOB_ZERO;
+        }
+        CALL_EVENT_CB(knob->event);
+    }
+    /*
+     * Detents coming faster than the tick keep it running and are taken a few at a time, a slow
+     * turn starts it from the interrupt for every detent
+     */
+    return fast;
+}
+
+/* The pin interrupts stay armed, a detent decoded after the scan needs one more */
+static bool knob_sleep(void *arg)
+{
+    knob_dev_t *knob = (knob_dev_t *)arg;
+    return atomic_load(&knob->quad.head) != atomic_load(&knob->quad.tail);
+}
+
+/* Decode from the current levels and enable the interrupts of the pins */
+static void knob_start(void *arg)
+{
+    knob_dev_t *knob = (knob_dev_t *)arg;
+    const uint8_t level_a = knob->hal_knob_level(knob->encoder_a);
+    const uint8_t level_b = knob->hal_knob_level(knob->encoder_b);
+
+    knob_quad_sync(&knob->quad, level_a, level_b);
+    knob_arm_pin(knob, knob->encoder_a, level_a);
+    knob_arm_pin(knob, knob->encoder_b, level_b);
+    knob_gpio_intr_control((uint32_t)knob->encoder_a, true);
+    knob_gpio_intr_control((uint32_t)knob->encoder_b, true);
+}
+
+static void knob_stop(void *arg)
+{
+    knob_dev_t *knob = (knob_dev_t *)arg;
+    knob_gpio_intr_control((uint32_t)knob->encoder_a, false);
+    knob_gpio_intr_control((uint32_t)knob->encoder_b, false);
+}
+
+knob_handle_t iot_knob_create(const knob_config_t *config)
+{
+    KNOB_CHECK(NULL != config, "config pointer can't be NULL!", NULL)
+    KNOB_CHECK(config->gpio_encoder_a != config->gpio_encoder_b, "encoder A can't be the same as encoder B", NULL);
+
+    knob_dev_t *knob = (knob_dev_t *)calloc(1, sizeof(knob_dev_t));
+    KNOB_CHECK(NULL != knob, "alloc knob failed", NULL);
+
+    esp_err_t ret = ESP_OK;
+    ret = knob_gpio_init(config->gpio_encoder_a);
+    KNOB_CHECK(ESP_OK == ret, "encoder A gpio init failed", NULL);
+    ret = knob_gpio_init(config->gpio_encoder_b);
+    KNOB_CHECK_GOTO(ESP_OK == ret, "encoder B gpio init failed", _encoder_deinit);
+
+    knob->hal_knob_level = knob_gpio_get_key_level;
+    knob->encoder_a = (void *)(long)config->gpio_encoder_a;
+    knob->encoder_b = (void *)(long)config->gpio_encoder_b;
+    knob->enable_power_save = config->enable_power_save;
+    knob->event = KNOB_NONE;
+    portMUX_INITIALIZE(&knob->lock);
+    knob_quad_init(&knob->quad, knob->hal_knob_level(knob->encoder_a), knob->hal_knob_level(knob->encoder_b),
+                   config->default_direction, HIGH_LIMIT, LOW_LIMIT);
+
+    /* Both pins decode in the same handler, the interrupts are enabled by knob_start() */
+    ret = knob_gpio_init_intr(config->gpio_encoder_a, GPIO_INTR_DISABLE, knob_isr_handler, knob);
+    KNOB_CHECK_GOTO(ESP_OK == ret, "encoder A interrupt init failed", _encoder_deinit);
+    ret = knob_gpio_init_intr(config->gpio_encoder_b, GPIO_INTR_DISABLE, knob_isr_handler, knob);
+    KNOB_CHECK_GOTO(ESP_OK == ret, "encoder B interrupt init failed", _encoder_deinit);
+    if (config->enable_power_save) {
+        ret = knob_gpio_wake_up_init(config->gpio_encoder_a, !knob->hal_knob_level(knob->encoder_a));
+        KNOB_CHECK_GOTO(ESP_OK == ret, "encoder A wake up gpio init failed", _encoder_deinit);
+        ret = knob_gpio_wake_up_init(config->gpio_encoder_b, !knob->hal_knob_level(knob->encoder_b));
+        KNOB_CHECK_GOTO(ESP_OK == ret, "encoder B wake up gpio init failed", _encoder_deinit);
+    }
+
+    ret = input_scan_add(knob_scan, knob_sleep, knob);
+    KNOB_CHECK_GOTO(ESP_OK == ret, "knob scan add failed", _encoder_deinit);
+    s_knob_num++;
+    if (s_is_running) {
+        knob_start(knob);
+    }
+
+    ESP_LOGI(TAG, "Iot Knob Config Succeed, encoder A:%d, encoder B:%d, direction:%d, Version: %d.%d.%d", config->gpio_encoder_a, config->gpio_encoder_b, config->default_direction, KNOB_VER_MAJOR, KNOB_VER_MINOR, KNOB_VER_PATCH);
+    return (knob_handle_t)knob;
+
+_encoder_deinit:
+    knob_gpio_deinit(config->gpio_encoder_b);
+    knob_gpio_deinit(config->gpio_encoder_a);
+    free(knob);
+    return NULL;
+}
+
+esp_err_t iot_knob_delete(knob_handle_t knob_handle)
+{
+    esp_err_t ret = ESP_OK;
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *)knob_handle;
+    knob_stop(knob);
+    ret = knob_gpio_deinit((uint32_t)knob->encoder_a);
+    KNOB_CHECK(ESP_OK == ret, "knob deinit failed", ESP_FAIL);
+    ret = knob_gpio_deinit((uint32_t)knob->encoder_b);
+    KNOB_CHECK(ESP_OK == ret, "knob deinit failed", ESP_FAIL);
+    /* The input scan timer goes with the last input */
+    ret = input_scan_remove(knob);
+    KNOB_CHECK(ESP_OK == ret, "knob not registered", ESP_FAIL);
+    free(knob);
+    s_knob_num--;
+    ESP_LOGD(TAG, "remain knob number=%d", s_knob_num);
+
+    return ESP_OK;
+}
+
+esp_err_t iot_knob_register_cb(knob_handle_t knob_handle, knob_event_t event, knob_cb_t cb, void *usr_data)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    KNOB_CHECK(event < KNOB_EVENT_MAX, "event is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    knob->cb[event] = cb;
+    knob->usr_data[event] = usr_data;
+    return ESP_OK;
+}
+
+esp_err_t iot_knob_unregister_cb(knob_handle_t knob_handle, knob_event_t event)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    KNOB_CHECK(event < KNOB_EVENT_MAX, "event is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    knob->cb[event] = NULL;
+    knob->usr_data[event] = NULL;
+    return ESP_OK;
+}
+
+knob_event_t iot_knob_get_event(knob_handle_t knob_handle)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    return knob->event;
+}
+
+uint32_t iot_knob_get_event_time(knob_handle_t knob_handle)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", 0);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    return knob->event_time_us;
+}
+
+int iot_knob_get_count_value(knob_handle_t knob_handle)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    return knob->quad.count;
+}
+
+esp_err_t iot_knob_clear_count_value(knob_handle_t knob_handle)
+{
+    KNOB_CHECK(NULL != knob_handle, "Pointer of handle is invalid", ESP_ERR_INVALID_ARG);
+    knob_dev_t *knob = (knob_dev_t *) knob_handle;
+    /* The C3 has one core: the critical section masks the GPIO interrupt, so the clear
+     * never lands inside its read-modify-write of the count */
+    portENTER_CRITICAL(&knob->lock);
+    knob->quad.count = 0;
+    portEXIT_CRITICAL(&knob->lock);
+    return ESP_OK;
+}
+
+esp_err_t iot_knob_resume(void)
+{
+    KNOB_CHECK(s_knob_num, "no knob created", ESP_ERR_INVALID_STATE);
+    KNOB_CHECK(!s_is_running, "knob is already running", ESP_ERR_INVALID_STATE);
+
+    input_scan_foreach(knob_scan, knob_start);
+    s_is_running = true;
+    return ESP_OK;
+}
+
+esp_err_t iot_knob_stop(void)
+{
+    KNOB_CHECK(s_knob_num, "no knob created", ESP_ERR_INVALID_STATE);
+    KNOB_CHECK(s_is_running, "knob is not running", ESP_ERR_INVALID_STATE);
+
+    input_scan_foreach(knob_scan, knob_stop);
+    s_is_running = false;
+    return ESP_OK;
+}
@@ -4,14 +4,19 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_sleep.h"
 #include "esp_check.h"
 #include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
 #include "knob_gpio.h"
 
 static const char *TAG = "knob gpio";
 
+static bool s_isr_service_installed = false;
+
 esp_err_t knob_gpio_init(uint32_t gpio_num)
 {
     gpio_config_t gpio_cfg = {
@@ -27,29 +32,36 @@ esp_err_t knob_gpio_init(uint32_t gpio_num)
 
 esp_err_t knob_gpio_deinit(uint32_t gpio_num)
 {
+    if (s_isr_service_installed) {
+        gpio_isr_handler_remove(gpio_num);
+    }
     return gpio_reset_pin(gpio_num);
 }
 
-uint8_t knob_gpio_get_key_level(void *gpio_num)
+/*
+ * The interrupt handler reads and arms the pins through the LL layer: the GPIO driver functions
+ * are in flash (CONFIG_GPIO_CTRL_FUNC_IN_IRAM covers gpio_get_level() only) and the handler
+ * runs while the flash is written, the ISR service is installed with ESP_INTR_FLAG_IRAM.
+ */
+uint8_t IRAM_ATTR knob_gpio_get_key_level(void *gpio_num)
 {
-    return (uint8_t)gpio_get_level((uint32_t)gpio_num);
+    return (uint8_t)gpio_ll_get_level(&GPIO, (uint32_t)gpio_num);
 }
 
 esp_err_t knob_gpio_init_intr(uint32_t gpio_num, gpio_int_type_t intr_type, gpio_isr_t isr_handler, void *args)
 {
-    static bool isr_service_installed = false;
     gpio_set_intr_type(gpio_num, intr_type);
-    if (!isr_service_installed) {
+    if (!s_isr_service_installed) {
         gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
-        isr_service_installed = true;
+        s_isr_service_installed = true;
     }
-    gpio_isr_handler_add(gpio_num, isr_handler, args);
-    return ESP_OK;
+    return gpio_isr_handler_add(gpio_num, isr_handler, args);
 }
 
-esp_err_t knob_gpio_set_intr(uint32_t gpio_num, gpio_int_type_t intr_type)
+esp_err_t IRAM_ATTR knob_gpio_set_intr(uint32_t gpio_num, gpio_int_type_t intr_type)
 {
-    return gpio_set_intr_type(gpio_num, intr_type);
+    gpio_ll_set_intr_type(&GPIO, gpio_num, intr_type);
+    return ESP_OK;
 }
 
 esp_err_t knob_gpio_intr_control(uint32_t gpio_num, bool enable)
@@ -62,15 +74,16 @@ esp_err_t knob_gpio_intr_control(uint32_t gpio_num, bool enable)
     return ESP_OK;
 }
 
-esp_err_t knob_gpio_wake_up_control(uint32_t gpio_num, uint8_t wake_up_level, bool enable)
+/* What gpio_wakeup_enable() and gpio_wakeup_disable() do on a chip without RTC IO */
+esp_err_t IRAM_ATTR knob_gpio_wake_up_control(uint32_t gpio_num, uint8_t wake_up_level, bool enable)
 {
-    esp_err_t ret;
     if (enable) {
-        ret = gpio_wakeup_enable(gpio_num, wake_up_level == 0 ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+        gpio_ll_set_intr_type(&GPIO, gpio_num, wake_up_level == 0 ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+        gpio_ll_wakeup_enable(&GPIO, gpio_num);
     } else {
-        ret = gpio_wakeup_disable(gpio_num);
+        gpio_ll_wakeup_disable(&GPIO, gpio_num);
     }
-    return ret;
+    return ESP_OK;
 }
 
 esp_err_t knob_gpio_wake_up_init(uint32_t gpio_num, uint8_t wake_up_level)
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "knob_quadrature.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_attr.h"
+#else
+#define IRAM_ATTR
+#define DRAM_ATTR
+#endif
+
+#define KNOB_QUAD_SKIP      2           /* Not a Gray code transition: both pins changed */
+
+/*
+ * Quarter steps from one state (A << 1) | B to the next, indexed by (old << 2) | new.
+ * Gray code: 00 -> 10 -> 11 -> 01 -> 00 when A leads. In DRAM, the handler runs while the flash is written.
+ */
+static const DRAM_ATTR int8_t s_quad_table[16] = {
+    /* old 00 */  0, -1,  1, KNOB_QUAD_SKIP,
+    /* old 01 */  1,  0, KNOB_QUAD_SKIP, -1,
+    /* old 10 */ -1, KNOB_QUAD_SKIP,  0,  1,
+    /* old 11 */ KNOB_QUAD_SKIP,  1, -1,  0,
+};
+
+void knob_quad_init(knob_quad_t *quad, uint8_t level_a, uint8_t level_b, bool reverse, int high_limit, int low_limit)
+{
+    memset(quad, 0, sizeof(*quad));
+    quad->state = ((level_a & 1) << 1) | (level_b & 1);
+    quad->last_dir = 1;
+    quad->reverse = reverse ? -1 : 1;
+    quad->high_limit = high_limit;
+    quad->low_limit = low_limit;
+    atomic_init(&quad->head, 0);
+    atomic_init(&quad->tail, 0);
+}
+
+void knob_quad_sync(knob_quad_t *quad, uint8_t level_a, uint8_t level_b)
+{
+    quad->state = ((level_a & 1) << 1) | (level_b & 1);
+    quad->quarter = 0;
+}
+
+/* Count one detent and queue it for the event callbacks */
+static void IRAM_ATTR knob_quad_count(knob_quad_t *quad, int8_t dir, uint32_t time_us, knob_quad_step_t *step)
+{
+    knob_quad_step_t s = {
+        .time_us = time_us,
+        .dir = dir * quad->reverse,
+        .limit = KNOB_QUAD_NONE,
+    };
+    int count = quad->count + s.dir;
+    if (count >= quad->high_limit) {
+        s.limit = KNOB_QUAD_HIGH;
+        count = 0;
+    } else if (count <= quad->low_limit) {
+        s.limit = KNOB_QUAD_LOW;
+        count = 0;
+    } else if (0 == count) {
+        s.limit = KNOB_QUAD_ZERO;
+    }
+    quad->count = count;
+
+    const unsigned head = atomic_load_explicit(&quad->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&quad->tail, memory_order_acquire) < KNOB_QUAD_RING_SIZE) {
+        quad->ring[head % KNOB_QUAD_RING_SIZE] = s;
+        atomic_store_explicit(&quad->head, head + 1, memory_order_release);
+    } else {
+        quad->dropped++;
+    }
+    if (step) {
+        *step = s;
+    }
+}
+
+bool IRAM_ATTR knob_quad_edge(knob_quad_t *quad, uint8_t level_a, uint8_t level_b, uint32_t time_us, knob_quad_step_t *step)
+{
+    const uint8_t state = ((level_a & 1) << 1) | (level_b & 1);
+    int8_t delta = s_quad_table[(quad->state << 2) | state];
+
+    quad->state = state;
+    if (KNOB_QUAD_SKIP == delta) {
+        /* The way the last detent went: a quarter step back may just be a contact bouncing */
+        quad->skipped++;
+        delta = 2 * quad->last_dir;
+    }
+    quad->quarter += delta;
+
+    /* Detents are where both pins have the same level, a skipped edge may have passed one */
+    if ((state >> 1) != (state & 1)) {
+        return false;
+    }
+    const int8_t detents = quad->quarter / 2;
+    quad->quarter = 0;
+    if (0 == detents) {
+        return false;
+    }
+    quad->last_dir = detents > 0 ? 1 : -1;
+    for (int8_t i = 0; i != detents; i += quad->last_dir) {
+        knob_quad_count(quad, quad->last_dir, time_us, step);
+    }
+    return true;
+}
+
+bool knob_quad_pop(knob_quad_t *quad, knob_quad_step_t *step)
+{
+    const unsigned tail = atomic_load_explicit(&quad->tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&quad->head, memory_order_acquire)) {
+        return false;
+    }
+    *step = quad->ring[tail % KNOB_QUAD_RING_SIZE];
+    atomic_store_explicit(&quad->tail, tail + 1, memory_order_release);
+    return true;
+}
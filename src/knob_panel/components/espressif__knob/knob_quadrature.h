@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Knob: quadrature decoder fed from the GPIO interrupt (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Steps kept for the task which calls the event callbacks, a power of two */
+#ifndef KNOB_QUAD_RING_SIZE
+#define KNOB_QUAD_RING_SIZE     32
+#endif
+
+/**
+ * @brief Limit reached by a step, the count is set back to 0 at KNOB_QUAD_HIGH and KNOB_QUAD_LOW
+ */
+typedef enum {
+    KNOB_QUAD_NONE = 0,
+    KNOB_QUAD_HIGH,                     /*!< Count reached the high limit */
+    KNOB_QUAD_LOW,                      /*!< Count reached the low limit */
+    KNOB_QUAD_ZERO,                     /*!< Count back to 0 */
+} knob_quad_limit_t;
+
+/**
+ * @brief One detent
+ */
+typedef struct {
+    uint32_t time_us;                   /*!< Time of the edge which completed it */
+    int8_t dir;                         /*!< 1: count increased, -1: decreased */
+    uint8_t limit;                      /*!< knob_quad_limit_t */
+} knob_quad_step_t;
+
+/**
+ * @brief Decoder of one knob
+ *
+ * The interrupt handler is the only writer of everything but `tail`, which the task reading
+ * the steps owns.
+ */
+typedef struct {
+    uint8_t state;                      /*!< (A << 1) | B at the last edge */
+    int8_t quarter;                     /*!< Quarter steps since the last detent */
+    int8_t last_dir;                    /*!< Direction of the last detent */
+    int8_t reverse;                     /*!< -1: counts down when A leads */
+    int high_limit;
+    int low_limit;
+    volatile int count;
+    uint32_t skipped;                   /*!< Edges where both pins changed, counted in the last direction */
+    uint32_t dropped;                   /*!< Steps counted but not queued, the ring was full */
+    knob_quad_step_t ring[KNOB_QUAD_RING_SIZE];
+    atomic_uint head;
+    atomic_uint tail;
+} knob_quad_t;
+
+/**
+ * @brief Start decoding from the current levels of the pins
+ *
+ * @param quad Decoder
+ * @param level_a Level of encoder A
+ * @param level_b Level of encoder B
+ * @param reverse Count down when A leads (default_direction of knob_config_t)
+ * @param high_limit The count goes back to 0 when it reaches it
+ * @param low_limit The count goes back to 0 when it reaches it
+ */
+void knob_quad_init(knob_quad_t *quad, uint8_t level_a, uint8_t level_b, bool reverse, int high_limit, int low_limit);
+
+/**
+ * @brief Continue from the current levels of the pins, after the interrupts were disabled
+ *
+ * @param quad Decoder
+ * @param level_a Level of encoder A
+ * @param level_b Level of encoder B
+ */
+void knob_quad_sync(knob_quad_t *quad, uint8_t level_a, uint8_t level_b);
+
+/**
+ * @brief Decode an edge, from the interrupt handler of the pins
+ *
+ * The pins are read in the handler, after the edge: a handler which comes late may see both
+ * pins changed, the two quarter steps are then taken the way of the last detent. The detents are
+ * where A and B have the same level and are counted when the knob reaches one, two quarter
+ * steps each from the previous one. Contact bounce goes back and forth and cancels out.
+ *
+ * @param quad Decoder
+ * @param level_a Level of encoder A
+ * @param level_b Level of encoder B
+ * @param time_us Time of the edge
+ * @param step Set to the last detent counted, may be NULL
+ * @return true if one or more detents were counted
+ */
+bool knob_quad_edge(knob_quad_t *quad, uint8_t level_a, uint8_t level_b, uint32_t time_us, knob_quad_step_t *step);
+
+/**
+ * @brief Take the oldest detent not read yet, from one task only
+ *
+ * @param quad Decoder
+ * @param step Filled with the detent
+ * @return true if there was one
+ */
+bool knob_quad_pop(knob_quad_t *quad, knob_quad_step_t *step);
+
+#ifdef __cplusplus
+}
+#endif
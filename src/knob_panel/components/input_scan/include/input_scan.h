@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Input scan: one periodic tick shared by the button and knob drivers
+ *
+ * The drivers register an input with a scan function, called every CONFIG_INPUT_SCAN_PERIOD_TIME_MS
+ * in the esp_timer task, and a sleep function. The tick runs while an input is busy. When all of
+ * them are at rest the sleep functions arm the wake-up interrupts of their pins and the tick
+ * stops until an interrupt calls input_scan_wake(): the drivers go idle together.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Period of the tick while an input is busy */
+#define INPUT_SCAN_PERIOD_US    (CONFIG_INPUT_SCAN_PERIOD_TIME_MS * 1000U)
+
+/**
+ * @brief Scan of an input, once per tick
+ *
+ * @param arg Argument given to input_scan_add()
+ * @return true while the input needs the next tick (pressed, debouncing, events to call back)
+ */
+typedef bool (*input_scan_fn_t)(void *arg);
+
+/**
+ * @brief The tick stops: arm the interrupt which calls input_scan_wake()
+ *
+ * @param arg Argument given to input_scan_add()
+ * @return true if the input got busy meanwhile and needs the tick again
+ */
+typedef bool (*input_scan_sleep_fn_t)(void *arg);
+
+/**
+ * @brief Ticks of the shared scan
+ */
+typedef struct {
+    uint32_t ticks;         /*!< Scans, each one wakes up the esp_timer task */
+    uint32_t wakeups;       /*!< Starts of the tick after it had stopped */
+} input_scan_stats_t;
+
+/**
+ * @brief Register an input, the tick starts if it was stopped
+ *
+ * @param scan Scan function
+ * @param sleep Sleep function, NULL for an input which has to be scanned all the time
+ * @param arg Argument of the functions, identifies the input
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_NO_MEM   all the slots are taken
+ *     - ESP_FAIL         the timer could not be created
+ */
+esp_err_t input_scan_add(input_scan_fn_t scan, input_scan_sleep_fn_t sleep, void *arg);
+
+/**
+ * @brief Unregister an input, the timer is deleted with the last one
+ *
+ * @param arg Argument the input was registered with
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_NOT_FOUND   not registered
+ */
+esp_err_t input_scan_remove(void *arg);
+
+/**
+ * @brief Stop or continue scanning the inputs of a driver, the others keep their tick
+ *
+ * @param scan Scan function the inputs were registered with
+ * @param paused true to stop scanning them
+ */
+void input_scan_pause(input_scan_fn_t scan, bool paused);
+
+/**
+ * @brief Start the tick if it stopped, from the interrupts armed by the sleep functions
+ *
+ * @note May be called from an ISR
+ */
+void input_scan_wake(void);
+
+/**
+ * @brief Call a function for every input registered with a scan function
+ *
+ * @param scan Scan function the inputs were registered with
+ * @param fn Called with the argument of every input
+ */
+void input_scan_foreach(input_scan_fn_t scan, void (*fn)(void *arg));
+
+/**
+ * @brief Set a callback for when the tick stops, all the inputs at rest
+ *
+ * @param cb Callback, NULL for none
+ * @param arg Argument of the callback
+ */
+void input_scan_set_idle_cb(void (*cb)(void *arg), void *arg);
+
+/**
+ * @brief Get the statistics of the tick since the first input was registered
+ *
+ * @param stats Filled with the statistics
+ */
+void input_scan_get_stats(input_scan_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
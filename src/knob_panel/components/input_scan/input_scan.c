@@ -0,0 +1,104 @@
+/* SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "input_scan.h"
+#include "input_scan_sched.h"
+
+static const char *TAG = "input scan";
+
+#define SCAN_CHECK(a, str, ret_val)                               \
+    if (!(a)) {                                                   \
+        ESP_LOGE(TAG, "%s(%d): %s", __FUNCTION__, __LINE__, str); \
+        return (ret_val);                                         \
+    }
+
+static input_scan_sched_t s_sched;
+static esp_timer_handle_t s_scan_timer = NULL;  /*!< One shot, armed again by every tick which is not the last */
+static void (*s_idle_cb)(void *arg);
+static void *s_idle_arg;
+
+static void input_scan_timer_cb(void *arg)
+{
+    if (input_scan_sched_tick(&s_sched)) {
+        esp_timer_start_once(s_scan_timer, INPUT_SCAN_PERIOD_US);
+    } else if (!atomic_load(&s_sched.running) && s_idle_cb) {
+        /*!< Not started again by an interrupt meanwhile: everything at rest */
+        s_idle_cb(s_idle_arg);
+    }
+}
+
+esp_err_t input_scan_add(input_scan_fn_t scan, input_scan_sleep_fn_t sleep, void *arg)
+{
+    SCAN_CHECK(NULL != scan, "Scan function is invalid", ESP_ERR_INVALID_ARG);
+
+    if (!s_scan_timer) {
+        input_scan_sched_init(&s_sched);
+        esp_timer_create_args_t scan_timer = {0};
+        scan_timer.arg = NULL;
+        scan_timer.callback = input_scan_timer_cb;
+        scan_timer.dispatch_method = ESP_TIMER_TASK;
+        scan_timer.name = "input_scan";
+        esp_err_t ret = esp_timer_create(&scan_timer, &s_scan_timer);
+        SCAN_CHECK(ESP_OK == ret, "Scan timer create failed", ESP_FAIL);
+    }
+    SCAN_CHECK(input_scan_sched_add(&s_sched, scan, sleep, arg), "All inputs taken", ESP_ERR_NO_MEM);
+
+    /*!< Scanned at once, the tick stops again if it is at rest */
+    input_scan_wake();
+    return ESP_OK;
+}
+
+esp_err_t input_scan_remove(void *arg)
+{
+    SCAN_CHECK(input_scan_sched_remove(&s_sched, arg), "Input not registered", ESP_ERR_NOT_FOUND);
+    ESP_LOGD(TAG, "remain input number=%d", s_sched.count);
+
+    if (0 == s_sched.count && s_scan_timer) {  /**<  if all inputs are removed, delete the timer */
+        esp_timer_stop(s_scan_timer);
+        esp_timer_delete(s_scan_timer);
+        s_scan_timer = NULL;
+        atomic_store(&s_sched.running, false);
+    }
+    return ESP_OK;
+}
+
+void input_scan_pause(input_scan_fn_t scan, bool paused)
+{
+    input_scan_sched_pause(&s_sched, scan, paused);
+    if (!paused) {
+        input_scan_wake();
+    }
+}
+
+void IRAM_ATTR input_scan_wake(void)
+{
+    if (s_scan_timer && input_scan_sched_wake(&s_sched)) {
+        esp_timer_start_once(s_scan_timer, 0);
+    }
+}
+
+void input_scan_foreach(input_scan_fn_t scan, void (*fn)(void *arg))
+{
+    for (int i = 0; i < s_sched.count; i++) {
+        if (s_sched.slots[i].scan == scan) {
+            fn(s_sched.slots[i].arg);
+        }
+    }
+}
+
+void input_scan_set_idle_cb(void (*cb)(void *arg), void *arg)
+{
+    s_idle_cb = cb;
+    s_idle_arg = arg;
+}
+
+void input_scan_get_stats(input_scan_stats_t *stats)
+{
+    *stats = s_sched.stats;
+}
@@ -0,0 +1,78 @@
+/* SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "input_scan_sched.h"
+
+void input_scan_sched_init(input_scan_sched_t *sched)
+{
+    memset(sched, 0, sizeof(*sched));
+    atomic_init(&sched->running, false);
+}
+
+bool input_scan_sched_add(input_scan_sched_t *sched, input_scan_fn_t scan, input_scan_sleep_fn_t sleep, void *arg)
+{
+    if (sched->count >= INPUT_SCAN_SLOTS) {
+        return false;
+    }
+    input_scan_slot_t *slot = &sched->slots[sched->count];
+    slot->scan = scan;
+    slot->sleep = sleep;
+    slot->arg = arg;
+    slot->paused = false;
+    sched->count++;
+    return true;
+}
+
+bool input_scan_sched_remove(input_scan_sched_t *sched, void *arg)
+{
+    for (int i = 0; i < sched->count; i++) {
+        if (sched->slots[i].arg == arg) {
+            memmove(&sched->slots[i], &sched->slots[i + 1], (sched->count - i - 1) * sizeof(sched->slots[0]));
+            sched->count--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void input_scan_sched_pause(input_scan_sched_t *sched, input_scan_fn_t scan, bool paused)
+{
+    for (int i = 0; i < sched->count; i++) {
+        if (sched->slots[i].scan == scan) {
+            sched->slots[i].paused = paused;
+        }
+    }
+}
+
+bool input_scan_sched_tick(input_scan_sched_t *sched)
+{
+    bool busy = false;
+
+    sched->stats.ticks++;
+    for (int i = 0; i < sched->count; i++) {
+        const input_scan_slot_t *slot = &sched->slots[i];
+        if (slot->paused) {
+            continue;
+        }
+        /* Every input is scanned, even once one is known to be busy */
+        busy |= slot->scan(slot->arg);
+        busy |= (NULL == slot->sleep);
+    }
+    if (busy) {
+        return true;
+    }
+
+    /* From here an interrupt starts the tick again, an input busy since its scan needs one more */
+    atomic_store(&sched->running, false);
+    bool pending = false;
+    for (int i = 0; i < sched->count; i++) {
+        const input_scan_slot_t *slot = &sched->slots[i];
+        if (!slot->paused) {
+            pending |= slot->sleep(slot->arg);
+        }
+    }
+    return pending && !atomic_exchange(&sched->running, true);
+}
@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Input scan: inputs and state of the shared tick, without the timer (private)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "input_scan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Inputs scanned by the tick: one knob and its button, or a few buttons */
+#ifndef INPUT_SCAN_SLOTS
+#define INPUT_SCAN_SLOTS        8
+#endif
+
+/**
+ * @brief One registered input
+ */
+typedef struct {
+    input_scan_fn_t scan;
+    input_scan_sleep_fn_t sleep;        /*!< NULL: keeps the tick running */
+    void *arg;
+    bool paused;
+} input_scan_slot_t;
+
+/**
+ * @brief Inputs of the tick, in the order they were registered
+ *
+ * The slots are changed by the tasks registering the inputs and read by the tick. `running` is
+ * set by whoever starts the timer, from the tick or an interrupt, and only cleared by the tick.
+ */
+typedef struct {
+    input_scan_slot_t slots[INPUT_SCAN_SLOTS];
+    uint8_t count;
+    atomic_bool running;                /*!< The timer is armed or its callback runs */
+    input_scan_stats_t stats;
+} input_scan_sched_t;
+
+/**
+ * @brief Start without inputs, the tick stopped
+ *
+ * @param sched Scheduler
+ */
+void input_scan_sched_init(input_scan_sched_t *sched);
+
+/**
+ * @brief Register an input
+ *
+ * @param sched Scheduler
+ * @param scan Scan function
+ * @param sleep Sleep function, may be NULL
+ * @param arg Argument of the functions
+ * @return false if all the slots are taken
+ */
+bool input_scan_sched_add(input_scan_sched_t *sched, input_scan_fn_t scan, input_scan_sleep_fn_t sleep, void *arg);
+
+/**
+ * @brief Unregister an input, the others keep their order
+ *
+ * @param sched Scheduler
+ * @param arg Argument the input was registered with
+ * @return false if it was not registered
+ */
+bool input_scan_sched_remove(input_scan_sched_t *sched, void *arg);
+
+/**
+ * @brief Stop or continue scanning the inputs of a scan function
+ *
+ * @param sched Scheduler
+ * @param scan Scan function
+ * @param paused true to stop scanning them
+ */
+void input_scan_sched_pause(input_scan_sched_t *sched, input_scan_fn_t scan, bool paused);
+
+/**
+ * @brief Claim the start of the tick
+ *
+ * Inline: called from the interrupts of the pins, which run from IRAM.
+ *
+ * @param sched Scheduler
+ * @return true if the tick was stopped: the caller starts the timer at once
+ */
+static inline bool input_scan_sched_wake(input_scan_sched_t *sched)
+{
+    if (atomic_exchange(&sched->running, true)) {
+        return false;
+    }
+    /* Only the one which set `running` gets here until the tick stops again */
+    sched->stats.wakeups++;
+    return true;
+}
+
+/**
+ * @brief One tick: scan every input, stop when all are at rest
+ *
+ * An input which gets busy while the sleep functions run, after its scan, is scanned again: the
+ * tick goes on unless an interrupt already started it.
+ *
+ * @param sched Scheduler
+ * @return true if the caller arms the timer for the next tick, false if the tick stopped
+ */
+bool input_scan_sched_tick(input_scan_sched_t *sched);
+
+#ifdef __cplusplus
+}
+#endif
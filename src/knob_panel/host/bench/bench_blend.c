@@ -0,0 +1,234 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Blend micro-benchmark.
+ *
+ * Blends fills and maps into a 48-line strip with lv_draw_sw_blend_basic(), the way LVGL
+ * draws widgets and images: with opacity, with an anti-aliased alpha mask and with both. Built
+ * twice, `bench_blend` with the byte-swapped colours of the firmware (LV_COLOR_16_SWAP) and
+ * `bench_blend_noswap` with LVGL rendering in the native byte order. `img_*` draw the same
+ * image through lv_draw_img(), in the TRUE_COLOR_ALPHA format of the LVGL image converter and
+ * as RGB565A8 from tools/img_rgb565a8.py. `flush_swap` is the byte swap the flush of
+ * esp_lvgl_port does on the strip when LVGL renders natively for the big-endian panel
+ * (`swap_bytes` of lvgl_port_display_cfg_t).
+ *
+ * Usage: bench_blend [--iterations N] [--json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "lvgl.h"
+#include "draw/sw/lv_draw_sw.h"
+#include "esp_lvgl_port_swap.h"
+
+#define STRIP_W             (240)
+#define STRIP_H             (48)
+#define STRIP_PX            (STRIP_W * STRIP_H)
+
+typedef struct {
+    const char *name;
+    bool map;
+    lv_opa_t opa;
+    bool mask;
+    const lv_img_dsc_t *img;
+    bool swap;
+} blend_case_t;
+
+static lv_color_t s_bg[STRIP_PX];
+static lv_color_t s_src[STRIP_PX];
+static lv_opa_t s_mask[STRIP_PX];
+static lv_color_t s_dest[STRIP_PX];
+static uint8_t s_img_argb_map[STRIP_PX * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t s_img_rgb565a8_map[STRIP_PX * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static lv_img_dsc_t s_img_argb = {
+    .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA,
+    .header.w = STRIP_W,
+    .header.h = STRIP_H,
+    .data_size = sizeof(s_img_argb_map),
+    .data = s_img_argb_map,
+};
+
+static lv_img_dsc_t s_img_rgb565a8 = {
+    .header.cf = LV_IMG_CF_RGB565A8,
+    .header.w = STRIP_W,
+    .header.h = STRIP_H,
+    .data_size = sizeof(s_img_rgb565a8_map),
+    .data = s_img_rgb565a8_map,
+};
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_disp_flush_ready(drv);
+}
+
+/* Gradients for the colours, discs with anti-aliased edges for the mask */
+static void fill_inputs(void)
+{
+    for (int y = 0; y < STRIP_H; y++) {
+        for (int x = 0; x < STRIP_W; x++) {
+            const int i = y * STRIP_W + x;
+            s_bg[i] = lv_color_make(x, 255 - y * 4, 128 + x / 2);
+            s_src[i] = lv_color_make(255 - x, x / 2 + y, y * 5);
+
+            const float dx = (x % 60) - 29.5f;
+            const float dy = y - 23.5f;
+            const float edge = 22.0f - sqrtf(dx * dx + dy * dy);
+            s_mask[i] = edge >= 1.0f ? LV_OPA_COVER : edge <= -1.0f ? LV_OPA_TRANSP : (lv_opa_t)((edge + 1.0f) * 127.5f);
+
+            /* Same pixels as images, interleaved and planar */
+            memcpy(&s_img_argb_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &s_src[i], sizeof(lv_color_t));
+            s_img_argb_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 2] = s_mask[i];
+            memcpy(&s_img_rgb565a8_map[i * sizeof(lv_color_t)], &s_src[i], sizeof(lv_color_t));
+            s_img_rgb565a8_map[STRIP_PX * sizeof(lv_color_t) + i] = s_mask[i];
+        }
+    }
+}
+
+static void blend_once(lv_draw_ctx_t *draw_ctx, const blend_case_t *c, const lv_area_t *area)
+{
+    if (c->swap) {
+        lvgl_port_swap_bytes(s_dest, STRIP_PX);
+        return;
+    }
+    if (c->img) {
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+        img_dsc.opa = c->opa;
+        lv_draw_img(draw_ctx, &img_dsc, area, c->img);
+        return;
+    }
+
+    lv_draw_sw_blend_dsc_t dsc;
+    memset(&dsc, 0, sizeof(dsc));
+    dsc.blend_area = area;
+    dsc.opa = c->opa;
+    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+    dsc.color = lv_color_make(0x20, 0xa0, 0xf0);
+    dsc.src_buf = c->map ? s_src : NULL;
+    if (c->mask) {
+        dsc.mask_buf = s_mask;
+        dsc.mask_area = area;
+        dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    }
+    lv_draw_sw_blend_basic(draw_ctx, &dsc);
+}
+
+/* Nanoseconds per pixel of the fastest iteration, the host is rarely quiet */
+static double bench(lv_draw_ctx_t *draw_ctx, const blend_case_t *c, const lv_area_t *area, uint32_t iterations)
+{
+    int64_t best = INT64_MAX;
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(s_dest, s_bg, sizeof(s_dest));
+        const int64_t start = now_ns();
+        blend_once(draw_ctx, c, area);
+        const int64_t ns = now_ns() - start;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    return (double)best / STRIP_PX;
+}
+
+static void print_row(const char *name, double ns, double ref_ns, bool json, bool last)
+{
+    if (json) {
+        printf("  {\"case\": \"%s\", \"swap\": %d, \"ns_per_px\": %.3f, \"relative\": %.2f}%s\n",
+               name, LV_COLOR_16_SWAP, ns, ns / ref_ns, last ? "" : ",");
+    } else {
+        printf("%-16s %-4d %9.3f %9.2f\n", name, LV_COLOR_16_SWAP, ns, ns / ref_ns);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const blend_case_t cases[] = {
+        {"fill_opa",        false, LV_OPA_50,    false},
+        {"fill_mask",       false, LV_OPA_COVER, true},
+        {"fill_mask_opa",   false, LV_OPA_70,    true},
+        {"map_opa",         true,  LV_OPA_50,    false},
+        {"map_mask",        true,  LV_OPA_COVER, true},
+        {"map_mask_opa",    true,  LV_OPA_70,    true},
+        {"img_argb",        true,  LV_OPA_COVER, true,  &s_img_argb},
+        {"img_rgb565a8",    true,  LV_OPA_COVER, true,  &s_img_rgb565a8},
+        {"flush_swap",      false, LV_OPA_COVER, false, NULL, true},
+    };
+    uint32_t iterations = 2000;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--iterations N] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+
+    /* The draw context of a display renders into the strip */
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, s_dest, NULL, STRIP_PX);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = STRIP_W;
+    disp_drv.ver_res = STRIP_H;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+    static const lv_area_t area = {0, 0, STRIP_W - 1, STRIP_H - 1};
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+    draw_ctx->buf = s_dest;
+    draw_ctx->buf_area = (lv_area_t *)&area;
+    draw_ctx->clip_area = &area;
+    _lv_refr_set_disp_refreshing(disp);
+
+    fill_inputs();
+
+    if (!json) {
+        printf("%d x %d strip, %u iterations\n", STRIP_W, STRIP_H, iterations);
+        printf("%-16s %-4s %9s %9s\n", "case", "swap", "ns/px", "relative");
+    } else {
+        printf("[\n");
+    }
+    /* Relative to the first case blending the same way, img_* to map_mask: what the image format adds */
+    const size_t case_cnt = sizeof(cases) / sizeof(cases[0]);
+    double ns[sizeof(cases) / sizeof(cases[0])];
+    for (size_t i = 0; i < case_cnt; i++) {
+        const blend_case_t *c = &cases[i];
+        ns[i] = bench(draw_ctx, c, &area, iterations);
+        double ref_ns = ns[i];
+        for (size_t j = 0; j < i; j++) {
+            if (!c->swap && cases[j].map == c->map && cases[j].opa == c->opa && cases[j].mask == c->mask) {
+                ref_ns = ns[j];
+                break;
+            }
+        }
+        print_row(c->name, ns[i], ref_ns, json, i + 1 == case_cnt);
+    }
+    if (json) {
+        printf("]\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,295 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Flush planner benchmark.
+ *
+ * Runs the washing screen animations (selection wheel, then the running wash with the
+ * waves and bubbles) with the BSP draw buffers and circular viewport, and counts the
+ * windows, commands and command bytes the GC9A01 driver would send per frame:
+ *   - without merging the invalidated areas and with a full window for every strip
+ *   - with the port's flush planner and the driver's window cache (CASET kept, RAMWR continue)
+ * Every mode starts from the same forked state, so the animations are identical.
+ *
+ * Usage: bench_flush [--seconds S] [--json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "sdkconfig.h"
+#include "lvgl.h"
+#include "lv_example_pub.h"
+#include "lv_img_rle.h"
+#include "lv_img_transform.h"
+#include "asset_pack_host.h"
+#include "esp_lvgl_port_planner.h"
+#include "esp_lvgl_port_viewport.h"
+
+#define DISP_H_RES          (240)
+#define DISP_V_RES          (240)
+#define TICK_PERIOD_MS      (5)
+#define SPI_BYTES_PER_US    (10)    /* 80 MHz */
+#define CMD_COST_US         (2)     /* One polled command transaction */
+#define FRAME_MEMORY_SIZE   (240)
+
+typedef struct {
+    bool plan;
+    bool window_cache;
+} flush_mode_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t merged_areas;
+    uint32_t windows;
+    uint32_t transactions;
+    uint32_t cmd_bytes;
+    uint64_t color_bytes;
+    uint64_t corner_px;
+    uint64_t render_us;
+} flush_stats_t;
+
+static flush_mode_t s_mode;
+static flush_stats_t s_stats;
+static lvgl_port_viewport_t s_viewport;
+static int64_t s_render_start;
+
+/* Same window as panel_gc9a01_draw_bitmap() remembers */
+static struct {
+    int x_start;
+    int x_end;
+    int y_next;
+    int y_end;
+} s_window = {-1, -1, -1, -1};
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Commands of panel_gc9a01_draw_bitmap() */
+static void panel_draw_bitmap(int x_start, int y_start, int x_end, int y_end)
+{
+    int row_end = y_end;
+    const bool cache = s_mode.window_cache;
+
+    if (cache && x_start == s_window.x_start && x_end == s_window.x_end &&
+            y_start == s_window.y_next && y_end <= s_window.y_end) {
+        row_end = s_window.y_end;
+    } else {
+        if (!cache || x_start != s_window.x_start || x_end != s_window.x_end) {
+            s_stats.transactions++;
+            s_stats.cmd_bytes += 1 + 4;
+        }
+        if (cache && row_end < FRAME_MEMORY_SIZE) {
+            row_end = FRAME_MEMORY_SIZE;
+        }
+        s_stats.transactions++;
+        s_stats.cmd_bytes += 1 + 4;
+    }
+    s_stats.windows++;
+    s_stats.transactions++;
+    s_stats.cmd_bytes += 1;
+    s_stats.color_bytes += (x_end - x_start) * (y_end - y_start) * sizeof(lv_color_t);
+
+    s_window.x_start = x_start;
+    s_window.x_end = x_end;
+    s_window.y_next = y_end;
+    s_window.y_end = row_end;
+}
+
+/* Pixels of a window outside of the viewport bands */
+static uint32_t corner_px(const lv_area_t *area)
+{
+    uint32_t px = lv_area_get_size(area);
+    lv_area_t in;
+
+    if (s_viewport.band_cnt == 0) {
+        return 0;
+    }
+    for (int i = 0; i < s_viewport.band_cnt; i++) {
+        if (_lv_area_intersect(&in, area, &s_viewport.bands[i])) {
+            px -= lv_area_get_size(&in);
+        }
+    }
+    return px;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    panel_draw_bitmap(area->x1, area->y1, area->x2 + 1, area->y2 + 1);
+    s_stats.corner_px += corner_px(area);
+    if (lv_disp_flush_is_last(drv)) {
+        s_stats.frames++;
+        s_stats.render_us += now_us() - s_render_start;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void rounder_cb(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    lvgl_port_viewport_round_area(&s_viewport, drv, area);
+}
+
+/* Same as lvgl_port_render_start_callback() */
+static void render_start_cb(lv_disp_drv_t *drv)
+{
+    s_render_start = now_us();
+    if (s_mode.plan) {
+        s_stats.merged_areas += lvgl_port_planner_merge_areas(lv_disp_get_default(), LVGL_PORT_WINDOW_COST,
+                                s_viewport.bands, s_viewport.band_cnt);
+    }
+}
+
+static void run_for(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += TICK_PERIOD_MS) {
+        lv_tick_inc(TICK_PERIOD_MS);
+        lv_timer_handler();
+    }
+}
+
+static void send_to_focused(lv_event_code_t code, uint32_t key)
+{
+    lv_obj_t *obj = lv_group_get_focused(lv_group_get_default());
+    if (obj) {
+        lv_event_send(obj, code, (code == LV_EVENT_KEY) ? &key : NULL);
+    }
+}
+
+/* Selection wheel turned a few times, then the running wash */
+static void scenario_run(uint32_t seconds, flush_stats_t *wheel, flush_stats_t *running)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    for (int i = 0; i < 6; i++) {
+        send_to_focused(LV_EVENT_KEY, (i < 3) ? LV_KEY_RIGHT : LV_KEY_LEFT);
+        run_for(500);
+    }
+    *wheel = s_stats;
+
+    send_to_focused(LV_EVENT_CLICKED, 0);
+    run_for(200);
+    memset(&s_stats, 0, sizeof(s_stats));
+    run_for(seconds * 1000);
+    *running = s_stats;
+}
+
+static void print_row(const char *scene, const flush_mode_t *mode, const flush_stats_t *stats, bool json, bool last)
+{
+    const double frames = stats->frames ? stats->frames : 1;
+    const uint64_t spi_us = stats->transactions * CMD_COST_US + stats->color_bytes / SPI_BYTES_PER_US;
+    if (json) {
+        printf("  {\"scene\": \"%s\", \"plan\": %s, \"window_cache\": %s, \"frames\": %u, \"merged_areas\": %u, "
+               "\"windows\": %u, \"transactions\": %u, \"cmd_bytes\": %u, \"color_bytes\": %llu, \"corner_px\": %llu, \"spi_us\": %llu, "
+               "\"render_us\": %llu}%s\n",
+               scene, mode->plan ? "true" : "false", mode->window_cache ? "true" : "false", stats->frames,
+               stats->merged_areas, stats->windows, stats->transactions, stats->cmd_bytes,
+               (unsigned long long)stats->color_bytes, (unsigned long long)stats->corner_px, (unsigned long long)spi_us,
+               (unsigned long long)stats->render_us, last ? "" : ",");
+    } else {
+        printf("%-8s %-5s %-6s %7u %8.2f %8.2f %8.2f %9.1f %10.0f %9.0f %8.0f %10.0f\n",
+               scene, mode->plan ? "on" : "off", mode->window_cache ? "on" : "off", stats->frames,
+               stats->merged_areas / frames, stats->windows / frames, stats->transactions / frames,
+               stats->cmd_bytes / frames, stats->color_bytes / frames, stats->corner_px / frames, spi_us / frames,
+               stats->render_us / frames);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+    static const flush_mode_t modes[] = {
+        {.plan = false, .window_cache = false},
+        {.plan = false, .window_cache = true},
+        {.plan = true, .window_cache = false},
+        {.plan = true, .window_cache = true},
+    };
+    uint32_t seconds = 4;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--seconds S] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+
+    /* Same draw buffers and viewport as the BSP */
+    const uint32_t buf_size = DISP_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT;
+    lv_color_t *buf1 = malloc(buf_size * sizeof(lv_color_t));
+#if CONFIG_BSP_LCD_DRAW_BUF_DOUBLE
+    lv_color_t *buf2 = malloc(buf_size * sizeof(lv_color_t));
+#else
+    lv_color_t *buf2 = NULL;
+#endif
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, buf_size);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_H_RES;
+    disp_drv.ver_res = DISP_V_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.render_start_cb = render_start_cb;
+    disp_drv.draw_buf = &draw_buf;
+#if CONFIG_BSP_LCD_CIRCULAR_VIEWPORT
+    lvgl_port_viewport_init(&s_viewport, DISP_H_RES, DISP_V_RES, NULL);
+    disp_drv.rounder_cb = rounder_cb;
+#endif
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+    lv_img_transform_init(disp);
+    ui_obj_to_encoder_init();
+    lv_create_home(NULL);
+    lv_func_goto_layer(&washing_Layer);
+    run_for(1000);
+
+    if (!json) {
+        printf("strip=%d lines, %u s running, per frame:\n", CONFIG_BSP_LCD_DRAW_BUF_HEIGHT, seconds);
+        printf("%-8s %-5s %-6s %7s %8s %8s %8s %9s %10s %9s %8s %10s\n", "scene", "plan", "cache", "frames",
+               "merged", "windows", "cmds", "cmd_bytes", "px_bytes", "corner_px", "spi_us", "render_us");
+    } else {
+        printf("[\n");
+    }
+    fflush(stdout);
+    const size_t mode_cnt = sizeof(modes) / sizeof(modes[0]);
+    for (size_t i = 0; i < mode_cnt; i++) {
+        /* Every mode continues from the same state */
+        pid_t pid = fork();
+        if (pid == 0) {
+            flush_stats_t wheel;
+            flush_stats_t running;
+            s_mode = modes[i];
+            scenario_run(seconds, &wheel, &running);
+            print_row("wheel", &modes[i], &wheel, json, false);
+            print_row("running", &modes[i], &running, json, i + 1 == mode_cnt);
+            _exit(0);
+        }
+        waitpid(pid, NULL, 0);
+    }
+    if (json) {
+        printf("]\n");
+    }
+
+    return 0;
+}
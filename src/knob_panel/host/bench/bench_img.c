@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Image storage benchmark.
+ *
+ * For every image of main/ui/imgs, as packed by tools/asset_pack.cmake: the flash it takes,
+ * against the size of the uncompressed RGB565A8 (or RGB565) pixels, and the time to draw
+ * the whole image with lv_draw_img(). Images compressed to RLE are also drawn from an
+ * uncompressed copy, the difference is what decoding the rows adds to a frame showing
+ * the image. The image cache (lv_img_lru) is disabled, it would only time the first draw.
+ *
+ * Usage: bench_img [--iterations N] [--json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+#include "asset_pack_host.h"
+
+#define DISP_W              (240)
+#define DISP_H              (240)
+#define DISP_PX             (DISP_W * DISP_H)
+/* The sprite atlases are larger than the screen */
+#define MAX_IMG_W           (512)
+#define MAX_IMG_PX          (2 * DISP_PX)
+
+#define IMG(name)           #name
+
+/* The images in the tree, the placeholders of the full-screen backgrounds are left out */
+static const char *const s_cases[] = {
+    IMG(icon_light), IMG(icon_light_ns), IMG(icon_washing), IMG(icon_washing_ns),
+    IMG(icon_thermostat), IMG(icon_thermostat_ns), IMG(espressif_logo),
+    IMG(light_close_pwm), IMG(light_close_status), IMG(light_brightness),
+    IMG(light_warm_25), IMG(light_warm_50), IMG(light_warm_75), IMG(light_warm_100),
+    IMG(light_cool_25), IMG(light_cool_50), IMG(light_cool_75), IMG(light_cool_100),
+    IMG(light_pwm_00), IMG(light_pwm_25), IMG(light_pwm_50), IMG(light_pwm_75), IMG(light_pwm_100),
+    IMG(img_washing_bg), IMG(img_washing_wave), IMG(img_washing_wave1), IMG(img_washing_wave2),
+    IMG(img_washing_bubble1), IMG(img_washing_bubble2),
+    IMG(img_washing_stand), IMG(img_washing_shirt), IMG(img_washing_underwear),
+    IMG(wash_underwear1), IMG(wash_underwear2), IMG(wash_shirt),
+    IMG(wash_basic), IMG(wash_blouse), IMG(wash_briefs),
+    IMG(AC_temper), IMG(AC_unit),
+    IMG(standby_atlas),
+    IMG(language_bg), IMG(language_bg_dither), IMG(language_select), IMG(language_unselect),
+};
+
+static lv_color_t s_dest[DISP_PX];
+static uint8_t s_plain_map[MAX_IMG_PX * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t s_line[MAX_IMG_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_disp_flush_ready(drv);
+}
+
+/* Uncompressed copy of an RLE image, in the format img_rgb565a8.py would have left it */
+static void decode_plain(const lv_img_dsc_t *img, lv_img_dsc_t *plain)
+{
+    lv_img_decoder_dsc_t dsc;
+    lv_img_decoder_open(&dsc, img, lv_color_black(), 0);
+    const bool alpha = dsc.header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    const uint32_t px = img->header.w * img->header.h;
+    for (lv_coord_t y = 0; y < img->header.h; y++) {
+        lv_img_decoder_read_line(&dsc, 0, y, img->header.w, s_line);
+        for (lv_coord_t x = 0; x < img->header.w; x++) {
+            const uint32_t i = y * img->header.w + x;
+            if (alpha) {
+                memcpy(&s_plain_map[i * sizeof(lv_color_t)], &s_line[x * LV_IMG_PX_SIZE_ALPHA_BYTE], sizeof(lv_color_t));
+                s_plain_map[px * sizeof(lv_color_t) + i] = s_line[x * LV_IMG_PX_SIZE_ALPHA_BYTE + 2];
+            } else {
+                memcpy(&s_plain_map[i * sizeof(lv_color_t)], &s_line[x * sizeof(lv_color_t)], sizeof(lv_color_t));
+            }
+        }
+    }
+    lv_img_decoder_close(&dsc);
+
+    *plain = *img;
+    plain->header.cf = alpha ? LV_IMG_CF_RGB565A8 : LV_IMG_CF_TRUE_COLOR;
+    plain->data_size = px * (alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+    plain->data = s_plain_map;
+}
+
+/* Microseconds of the fastest full draw of the image, the host is rarely quiet */
+static double bench(lv_draw_ctx_t *draw_ctx, const lv_img_dsc_t *img, uint32_t iterations)
+{
+    const lv_area_t area = {0, 0, img->header.w - 1, img->header.h - 1};
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+
+    int64_t best = INT64_MAX;
+    for (uint32_t i = 0; i < iterations; i++) {
+        memset(s_dest, 0, sizeof(s_dest));
+        const int64_t start = now_ns();
+        lv_draw_img(draw_ctx, &img_dsc, &area, img);
+        const int64_t ns = now_ns() - start;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    return best / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = 200;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--iterations N] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+    lv_img_lru_set_budget(0);
+
+    /* The draw context of a display renders into the whole screen */
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, s_dest, NULL, DISP_PX);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+    static const lv_area_t screen = {0, 0, DISP_W - 1, DISP_H - 1};
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+    draw_ctx->buf = s_dest;
+    draw_ctx->buf_area = (lv_area_t *)&screen;
+    draw_ctx->clip_area = &screen;
+    _lv_refr_set_disp_refreshing(disp);
+
+    if (json) {
+        printf("[\n");
+    } else {
+        printf("%u iterations\n", iterations);
+        printf("%-22s %-4s %9s %9s %6s %9s %9s %9s %7s\n",
+               "image", "fmt", "raw_B", "flash_B", "saved", "plain_us", "rle_us", "decode_us", "ns/px");
+    }
+
+    const size_t case_cnt = sizeof(s_cases) / sizeof(s_cases[0]);
+    uint32_t total_raw = 0;
+    uint32_t total_flash = 0;
+    for (size_t i = 0; i < case_cnt; i++) {
+        const char *name = s_cases[i];
+        const lv_img_dsc_t *img = lv_asset_img(name);
+        if (img == NULL) {
+            return 1;
+        }
+        const uint32_t px = img->header.w * img->header.h;
+        if ((img->header.w > MAX_IMG_W) || (px > MAX_IMG_PX)) {
+            fprintf(stderr, "%s: %u x %u is too large\n", name, img->header.w, img->header.h);
+            return 1;
+        }
+        const bool rle = img->header.cf == LV_IMG_CF_USER_ENCODED_0;
+
+        lv_img_dsc_t plain = *img;
+        if (rle) {
+            decode_plain(img, &plain);
+        }
+        const uint32_t raw = plain.data_size;
+        const uint32_t flash = img->data_size;
+        const double plain_us = bench(draw_ctx, &plain, iterations);
+        const double rle_us = rle ? bench(draw_ctx, img, iterations) : plain_us;
+        const double decode_us = rle_us - plain_us;
+        total_raw += raw;
+        total_flash += flash;
+
+        if (json) {
+            printf("  {\"image\": \"%s\", \"rle\": %d, \"raw_bytes\": %u, \"flash_bytes\": %u, "
+                   "\"plain_us\": %.1f, \"rle_us\": %.1f, \"decode_us\": %.1f, \"decode_ns_per_px\": %.2f},\n",
+                   name, rle, raw, flash, plain_us, rle_us, decode_us, decode_us * 1000 / px);
+        } else {
+            printf("%-22s %-4s %9u %9u %5.0f%% %9.1f %9.1f %9.1f %7.2f\n", name, rle ? "rle" : "-",
+                   raw, flash, 100.0 * (raw - flash) / raw, plain_us, rle_us, decode_us, decode_us * 1000 / px);
+        }
+    }
+
+    if (json) {
+        printf("  {\"image\": \"total\", \"raw_bytes\": %u, \"flash_bytes\": %u}\n]\n", total_raw, total_flash);
+    } else {
+        printf("%-22s %-4s %9u %9u %5.0f%%\n", "total", "", total_raw, total_flash,
+               100.0 * (total_raw - total_flash) / total_raw);
+    }
+
+    return 0;
+}
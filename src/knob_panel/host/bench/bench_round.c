@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Round viewport benchmark.
+ *
+ * Runs the application screens with the firmware LVGL configuration and draw buffer size,
+ * once with the whole square refreshed and once with the invalidated areas split along
+ * the circular viewport of the GC9A01. Reports pixels flushed and render time per frame,
+ * for a full screen redraw and for the screen running on its own (animations, timers).
+ * `spi_us` is the bus time the flushes would take on the board.
+ *
+ * Usage: bench_round [--frames N] [--seconds S] [--json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+#include "lvgl.h"
+#include "lv_example_pub.h"
+#include "lv_img_rle.h"
+#include "lv_img_transform.h"
+#include "asset_pack_host.h"
+#include "esp_lvgl_port_viewport.h"
+
+#define DISP_H_RES          (240)
+#define DISP_V_RES          (240)
+#define TICK_PERIOD_MS      (5)
+#define SPI_BYTES_PER_US    (10)    /* 80 MHz */
+#define PANEL_CMD_COST_US   (6)     /* CASET + RASET + RAMWR polled before every strip */
+
+typedef struct {
+    uint32_t frames;
+    uint32_t flushes;
+    uint64_t flushed_px;
+    uint64_t render_us;
+} round_stats_t;
+
+static round_stats_t s_stats;
+static lvgl_port_viewport_t s_viewport;
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    s_stats.flushes++;
+    s_stats.flushed_px += lv_area_get_size(area);
+    if (lv_disp_flush_is_last(drv)) {
+        s_stats.frames++;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void rounder_cb(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    lvgl_port_viewport_round_area(&s_viewport, drv, area);
+}
+
+typedef struct {
+    const char *name;
+    lv_layer_t *layer;
+} bench_screen_t;
+
+typedef struct {
+    round_stats_t full;
+    round_stats_t idle;
+} bench_result_t;
+
+static void bench_run(lv_disp_t *disp, lv_layer_t *layer, bool viewport, uint32_t frames, uint32_t seconds,
+                      bench_result_t *res)
+{
+    disp->driver->rounder_cb = viewport ? rounder_cb : NULL;
+
+    /* Fresh screen, settled before measuring */
+    lv_func_goto_layer(layer);
+    lv_refr_now(disp);
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    for (uint32_t i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        const int64_t start = now_us();
+        lv_refr_now(disp);
+        s_stats.render_us += now_us() - start;
+    }
+    res->full = s_stats;
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    for (uint32_t ms = 0; ms < seconds * 1000; ms += TICK_PERIOD_MS) {
+        lv_tick_inc(TICK_PERIOD_MS);
+        const int64_t start = now_us();
+        lv_timer_handler();
+        s_stats.render_us += now_us() - start;
+    }
+    res->idle = s_stats;
+}
+
+static void print_row(const char *screen, bool viewport, const char *kind, const round_stats_t *stats, bool json, bool last)
+{
+    const uint32_t frames = stats->frames ? stats->frames : 1;
+    const uint64_t spi_us = stats->flushes * PANEL_CMD_COST_US + stats->flushed_px * sizeof(lv_color_t) / SPI_BYTES_PER_US;
+    if (json) {
+        printf("  {\"screen\": \"%s\", \"viewport\": %s, \"kind\": \"%s\", \"frames\": %u, \"flushes\": %u, "
+               "\"flushed_px\": %llu, \"render_us\": %llu, \"spi_us\": %llu}%s\n",
+               screen, viewport ? "true" : "false", kind, stats->frames, stats->flushes,
+               (unsigned long long)stats->flushed_px, (unsigned long long)stats->render_us,
+               (unsigned long long)spi_us, last ? "" : ",");
+    } else {
+        printf("%-20s %-8s %-5s %7u %9.1f %12llu %11llu %9llu\n",
+               screen, viewport ? "round" : "square", kind, stats->frames, (double)stats->flushes / frames,
+               (unsigned long long)stats->flushed_px / frames, (unsigned long long)stats->render_us / frames,
+               (unsigned long long)spi_us / frames);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const bench_screen_t screens[] = {
+        {"menu", &menu_layer},
+        {"washing", &washing_Layer},
+        {"clock", &clock_screen_layer},
+    };
+    uint32_t frames = 30;
+    uint32_t seconds = 5;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            seconds = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [--seconds S] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+
+    /* Same draw buffers as the BSP */
+    const uint32_t buf_size = DISP_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT;
+    lv_color_t *buf1 = malloc(buf_size * sizeof(lv_color_t));
+#if CONFIG_BSP_LCD_DRAW_BUF_DOUBLE
+    lv_color_t *buf2 = malloc(buf_size * sizeof(lv_color_t));
+#else
+    lv_color_t *buf2 = NULL;
+#endif
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, buf_size);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_H_RES;
+    disp_drv.ver_res = DISP_V_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+    /* Default span: the disc inscribed into the panel, same as esp_lcd_gc9a01_get_visible_span() */
+    lvgl_port_viewport_init(&s_viewport, DISP_H_RES, DISP_V_RES, NULL);
+
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+    lv_img_transform_init(disp);
+    ui_obj_to_encoder_init();
+    lv_create_home(NULL);
+
+    if (!json) {
+        printf("strip=%d lines, bands=%d, band pixels=%u of %u\n", CONFIG_BSP_LCD_DRAW_BUF_HEIGHT,
+               s_viewport.band_cnt, lvgl_port_viewport_get_size(&s_viewport), DISP_H_RES * DISP_V_RES);
+        printf("%-20s %-8s %-5s %7s %9s %12s %11s %9s\n",
+               "screen", "viewport", "kind", "frames", "flushes", "px/frame", "render_us", "spi_us");
+    } else {
+        printf("[\n");
+    }
+    const size_t screen_cnt = sizeof(screens) / sizeof(screens[0]);
+    for (size_t i = 0; i < screen_cnt * 2; i++) {
+        const bench_screen_t *screen = &screens[i / 2];
+        const bool viewport = i % 2;
+        bench_result_t res;
+        bench_run(disp, screen->layer, viewport, frames, seconds, &res);
+        print_row(screen->name, viewport, "full", &res.full, json, false);
+        print_row(screen->name, viewport, "idle", &res.idle, json, i + 1 == screen_cnt * 2);
+    }
+    if (json) {
+        printf("]\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,481 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Per-screen render benchmark.
+ *
+ * Runs on the headless port backend with the BSP configuration (draw buffers, circular
+ * viewport, flush planner). Enters every screen of the application with lv_func_goto_layer(),
+ * lets it settle and replays the same knob script on each. Reports per frame the render time,
+ * the invalidated pixels and the flushed bytes, and the LVGL heap high-water of the screen.
+ * Then leaves the screen alone and reports how often the LVGL task of the port wakes up and
+ * which share of the time it keeps the LVGL tick running (the idle governor stops it).
+ *
+ * The image cache (lv_img_lru) hits, misses, evictions and bytes are also reported, and the
+ * latency of the knob script from the detent to the end of the flush of the frame answering it
+ * (lvgl_port_get_latency_stats()): inputs traced, 90th percentile and maximum.
+ *
+ * Everything but the render time is deterministic. With --repeat the suite runs N times
+ * and the fastest render times are kept. bench/baseline/bench_screens.json holds the
+ * committed numbers, bench/compare_baseline.py reports the differences.
+ *
+ * With --transitions it measures the screen changes instead: menu to every app and back,
+ * the first time (cold, the layer is built) and then on average (warm, retained layers are
+ * only shown again): time of the lv_func_goto_layer() call and render time of the first frame,
+ * then the frames of the transition animation (lv_layer_transition.h) and their mean render
+ * time, and the time to capture the old screen. --cut leaves the transitions uninitialised:
+ * every screen change is a hard cut, as before them.
+ *
+ * With --click it measures the click on an app of the menu: the knob turns to the app, rests
+ * (the menu prefetches it) and is pressed. Reports the time spent from the release of the
+ * button to the end of the flush of the first frame, with the prefetched layer and with it
+ * deleted before the click, which builds the layer in lv_func_goto_layer() as without prefetch.
+ *
+ * Usage: bench_screens [--repeat N] [--json] [--transitions] [--cut] [--click]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+#include "bsp/esp-bsp.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_host.h"
+#include "lv_example_pub.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+#include "lv_layer_transition.h"
+#include "asset_pack_host.h"
+
+#define SETTLE_MS           (1500)
+#define TICK_PERIOD_MS      (5)
+#define TRANSITION_ROUNDS   (8)
+#define CLICK_ROUNDS        (8)
+#define KNOB_REST_MS        (300)
+#define PRESS_MS            (100)
+#define IDLE_MS             (3000)
+
+typedef struct {
+    const char *name;
+    lv_layer_t *layer;
+} bench_screen_t;
+
+/* Knob script replayed on every screen: steps (0 to wait only) and the time to run after them */
+typedef struct {
+    int32_t steps;
+    uint32_t run_ms;
+} knob_step_t;
+
+static const knob_step_t s_knob_script[] = {
+    {0, 500},
+    {1, 300},
+    {1, 300},
+    {1, 600},
+    {-1, 300},
+    {-1, 300},
+    {-1, 600},
+    {3, 800},
+    {-3, 800},
+    {0, 1000},
+};
+
+typedef struct {
+    uint32_t frames;
+    uint64_t render_us;
+    uint64_t render_max_us;
+    uint64_t inv_px;
+    uint64_t flushed_bytes;
+    uint32_t heap_peak;
+    uint32_t idle_wakeups;
+    uint32_t idle_awake_pct;
+    lv_img_lru_stats_t img_cache;
+    uint32_t latency_inputs;
+    uint32_t latency_p90_us;
+    uint32_t latency_max_us;
+} screen_stats_t;
+
+static screen_stats_t s_stats;
+static lv_disp_t *s_disp;
+static uint64_t s_frame_start_us;
+
+static void monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    lvgl_port_flush_stats_t flush;
+    lvgl_port_get_flush_stats(s_disp, &flush);
+
+    const uint64_t frame_us = flush.render_us - s_frame_start_us;
+    s_frame_start_us = flush.render_us;
+    s_stats.inv_px += px;
+    if (frame_us > s_stats.render_max_us) {
+        s_stats.render_max_us = frame_us;
+    }
+}
+
+static void heap_sample(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    const uint32_t used = mon.total_size - mon.free_size;
+    if (used > s_stats.heap_peak) {
+        s_stats.heap_peak = used;
+    }
+}
+
+static void run_sampled(uint32_t ms)
+{
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += TICK_PERIOD_MS) {
+        lvgl_port_host_run(TICK_PERIOD_MS);
+        heap_sample();
+    }
+}
+
+static void goto_layer(lv_layer_t *layer)
+{
+    /* Like the tasks of the application, wake up the idle LVGL task after the change */
+    bsp_display_lock(0);
+    lv_func_goto_layer(layer);
+    bsp_display_unlock();
+    bsp_display_wake();
+}
+
+static void release_retained(void)
+{
+    bsp_display_lock(0);
+    lv_func_release_retained_layers();
+    bsp_display_unlock();
+    bsp_display_wake();
+}
+
+static void bench_run(const bench_screen_t *screen, lv_indev_t *knob, screen_stats_t *res)
+{
+    goto_layer(screen->layer);
+    lvgl_port_host_run(SETTLE_MS);
+
+    memset(&s_stats, 0, sizeof(s_stats));
+    lvgl_port_reset_flush_stats(s_disp);
+    s_frame_start_us = 0;
+    lv_img_lru_reset_stats();
+    lvgl_port_reset_latency_stats();
+    heap_sample();
+
+    for (size_t i = 0; i < sizeof(s_knob_script) / sizeof(s_knob_script[0]); i++) {
+        lvgl_port_host_knob_rotate(knob, s_knob_script[i].steps);
+        run_sampled(s_knob_script[i].run_ms);
+    }
+
+    lvgl_port_flush_stats_t flush;
+    lvgl_port_get_flush_stats(s_disp, &flush);
+    s_stats.frames = flush.frames;
+    s_stats.render_us = flush.render_us;
+    s_stats.flushed_bytes = flush.flushed_bytes;
+    lv_img_lru_get_stats(&s_stats.img_cache);
+
+    lvgl_port_latency_stats_t latency;
+    lvgl_port_get_latency_stats(&latency);
+    s_stats.latency_inputs = latency.stages[LVGL_PORT_LATENCY_TOTAL].count;
+    s_stats.latency_p90_us = lvgl_port_latency_percentile(&latency.stages[LVGL_PORT_LATENCY_TOTAL], 90);
+    s_stats.latency_max_us = latency.stages[LVGL_PORT_LATENCY_TOTAL].max_us;
+
+    /* Long enough for one full window of the wakeup counter without input. The window starts with
+     * a wakeup of the LVGL task, as after a change of the UI, the counter closes its window on it */
+    lvgl_port_idle_stats_t idle;
+    bsp_display_wake();
+    lvgl_port_reset_idle_stats();
+    lvgl_port_host_run(IDLE_MS);
+    s_stats.idle_wakeups = lvgl_port_get_wakeups_per_sec();
+    lvgl_port_get_idle_stats(&idle);
+    s_stats.idle_awake_pct = (uint32_t)(idle.active_us * 100 / (idle.active_us + idle.idle_us));
+    *res = s_stats;
+}
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*
+ * One screen change: time of the lv_func_goto_layer() call, render time and pixels of the first frame,
+ * frames and render time of the whole transition animation, capture of the old screen
+ */
+typedef struct {
+    uint64_t goto_us;
+    uint64_t frame_us;
+    uint64_t inv_px;
+    uint64_t anim_frames;
+    uint64_t anim_us;
+    uint64_t capture_us;
+} transition_t;
+
+static void transition_run(lv_layer_t *layer, transition_t *res)
+{
+    lvgl_port_flush_stats_t flush;
+
+    lv_layer_transition_stats_t stats;
+
+    lvgl_port_reset_flush_stats(s_disp);
+    lv_layer_transition_reset_stats();
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_frame_start_us = 0;
+
+    const uint64_t start = now_us();
+    goto_layer(layer);
+    res->goto_us = now_us() - start;
+
+    do {
+        lvgl_port_host_run(TICK_PERIOD_MS);
+        lvgl_port_get_flush_stats(s_disp, &flush);
+    } while (flush.frames == 0);
+    res->frame_us = flush.render_us;
+    res->inv_px = s_stats.inv_px;
+
+    while (lv_layer_transition_is_active()) {
+        lvgl_port_host_run(TICK_PERIOD_MS);
+    }
+    lvgl_port_get_flush_stats(s_disp, &flush);
+    lv_layer_transition_get_stats(&stats);
+    res->anim_frames = stats.started ? flush.frames : 0;
+    res->anim_us = stats.started ? flush.render_us : 0;
+    res->capture_us = stats.started ? stats.capture_us : 0;
+
+    lvgl_port_host_run(SETTLE_MS);
+}
+
+static void print_transition(const char *from, const char *to, const transition_t *cold, const transition_t *warm)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%s->%s", from, to);
+    printf("%-20s %10llu %10llu %10llu %10llu %10llu %10llu %10llu %10llu\n", name, (unsigned long long)cold->goto_us,
+           (unsigned long long)warm->goto_us / (TRANSITION_ROUNDS - 1), (unsigned long long)cold->frame_us,
+           (unsigned long long)warm->frame_us / (TRANSITION_ROUNDS - 1), (unsigned long long)warm->inv_px / (TRANSITION_ROUNDS - 1),
+           (unsigned long long)warm->anim_frames / (TRANSITION_ROUNDS - 1),
+           (unsigned long long)(warm->anim_frames ? warm->anim_us / warm->anim_frames : 0),
+           (unsigned long long)warm->capture_us / (TRANSITION_ROUNDS - 1));
+}
+
+static void bench_transitions(const bench_screen_t *screens, size_t screen_cnt)
+{
+    printf("%-20s %10s %10s %10s %10s %10s %10s %10s %10s\n", "transition", "cold_goto", "warm_goto", "cold_frame",
+           "warm_frame", "warm_px", "anim_frm", "anim_us", "capture_us");
+    for (size_t i = 0; i < screen_cnt; i++) {
+        if (screens[i].layer == &menu_layer) {
+            continue;
+        }
+        transition_t cold[2], warm[2] = {0};
+        goto_layer(&menu_layer);
+        release_retained();
+        lvgl_port_host_run(SETTLE_MS);
+        for (uint32_t round = 0; round < TRANSITION_ROUNDS; round++) {
+            transition_t res[2];
+            transition_run(screens[i].layer, &res[0]);
+            if (round == 0) {
+                /* The menu is retained now, drop it to build it on the way back too */
+                release_retained();
+            }
+            transition_run(&menu_layer, &res[1]);
+            for (int dir = 0; dir < 2; dir++) {
+                if (round == 0) {
+                    cold[dir] = res[dir];
+                } else {
+                    warm[dir].goto_us += res[dir].goto_us;
+                    warm[dir].frame_us += res[dir].frame_us;
+                    warm[dir].inv_px += res[dir].inv_px;
+                    warm[dir].anim_frames += res[dir].anim_frames;
+                    warm[dir].anim_us += res[dir].anim_us;
+                    warm[dir].capture_us += res[dir].capture_us;
+                }
+            }
+        }
+        print_transition("menu", screens[i].name, &cold[0], &warm[0]);
+        print_transition(screens[i].name, "menu", &cold[1], &warm[1]);
+    }
+}
+
+/* Apps of the menu in its order, ui_menu_new.c */
+static lv_layer_t *const s_menu_apps[] = {&washing_Layer, &thermostat_Layer, &light_2color_Layer};
+#define MENU_APP_CNT        (sizeof(s_menu_apps) / sizeof(s_menu_apps[0]))
+static uint32_t s_menu_index;
+
+/* Turn the menu by one app and rest, a step to the right focuses the previous app */
+static void menu_turn(lv_indev_t *knob, int32_t step)
+{
+    lvgl_port_host_knob_rotate(knob, step);
+    lvgl_port_host_run(KNOB_REST_MS);
+    s_menu_index = (s_menu_index + MENU_APP_CNT - step) % MENU_APP_CNT;
+}
+
+/* Click on the app of the menu, time from the release of the button to the end of the first flush */
+static uint64_t click_run(lv_indev_t *knob, uint32_t index, bool prefetch)
+{
+    lvgl_port_flush_stats_t flush;
+
+    goto_layer(&menu_layer);
+    release_retained();
+    lvgl_port_host_run(SETTLE_MS);
+    while (s_menu_index != index) {
+        menu_turn(knob, -1);
+    }
+    /* Away and back: the menu prefetches the app the knob comes to */
+    menu_turn(knob, 1);
+    menu_turn(knob, -1);
+    lvgl_port_host_run(SETTLE_MS);
+    if (!prefetch) {
+        release_retained();
+    }
+
+    lvgl_port_host_button_set(knob, true);
+    lvgl_port_host_run(PRESS_MS);
+    lvgl_port_reset_flush_stats(s_disp);
+
+    const uint64_t start = now_us();
+    lvgl_port_host_button_set(knob, false);
+    do {
+        lvgl_port_host_run(TICK_PERIOD_MS);
+        lvgl_port_get_flush_stats(s_disp, &flush);
+    } while (flush.frames == 0);
+    const uint64_t click_us = now_us() - start;
+
+    lvgl_port_host_run(SETTLE_MS);
+    return click_us;
+}
+
+static void bench_click(lv_indev_t *knob)
+{
+    printf("%-12s %12s %12s\n", "click", "build_us", "prefetch_us");
+    for (uint32_t i = 0; i < MENU_APP_CNT; i++) {
+        uint64_t build_us = 0, prefetch_us = 0;
+        for (uint32_t round = 0; round < CLICK_ROUNDS; round++) {
+            build_us += click_run(knob, i, false);
+            prefetch_us += click_run(knob, i, true);
+        }
+        printf("%-12s %12llu %12llu\n", s_menu_apps[i]->lv_obj_name, (unsigned long long)build_us / CLICK_ROUNDS,
+               (unsigned long long)prefetch_us / CLICK_ROUNDS);
+    }
+}
+
+static void print_row(const char *screen, const screen_stats_t *stats, bool json, bool last)
+{
+    const uint32_t frames = stats->frames ? stats->frames : 1;
+    if (json) {
+        printf("  {\"screen\": \"%s\", \"frames\": %u, \"render_us_per_frame\": %llu, \"render_max_us\": %llu, "
+               "\"inv_px_per_frame\": %llu, \"flush_bytes_per_frame\": %llu, \"heap_peak\": %u, "
+               "\"idle_wakeups_per_sec\": %u, \"idle_awake_pct\": %u, \"img_cache_hits\": %u, "
+               "\"img_cache_misses\": %u, \"img_cache_evictions\": %u, \"img_cache_peak_bytes\": %u, "
+               "\"latency_inputs\": %u, \"latency_p90_us\": %u, \"latency_max_us\": %u}%s\n",
+               screen, stats->frames, (unsigned long long)stats->render_us / frames,
+               (unsigned long long)stats->render_max_us, (unsigned long long)stats->inv_px / frames,
+               (unsigned long long)stats->flushed_bytes / frames, stats->heap_peak, stats->idle_wakeups,
+               stats->idle_awake_pct, stats->img_cache.hits, stats->img_cache.misses,
+               stats->img_cache.evictions, stats->img_cache.peak_bytes, stats->latency_inputs,
+               stats->latency_p90_us, stats->latency_max_us, last ? "" : ",");
+    } else {
+        printf("%-12s %7u %10llu %10llu %10llu %12llu %10u %8u %8u %8u %8u %8u %9u %8u %8u %8u\n",
+               screen, stats->frames, (unsigned long long)stats->render_us / frames,
+               (unsigned long long)stats->render_max_us, (unsigned long long)stats->inv_px / frames,
+               (unsigned long long)stats->flushed_bytes / frames, stats->heap_peak, stats->idle_wakeups, stats->idle_awake_pct,
+               stats->img_cache.hits, stats->img_cache.misses, stats->img_cache.evictions, stats->img_cache.peak_bytes,
+               stats->latency_inputs, stats->latency_p90_us, stats->latency_max_us);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const bench_screen_t screens[] = {
+        {"menu", &menu_layer},
+        {"washing", &washing_Layer},
+        {"light", &light_2color_Layer},
+        {"thermostat", &thermostat_Layer},
+        {"clock", &clock_screen_layer},
+        {"boot", &boot_Layer},
+        {"language", &language_Layer},
+    };
+    uint32_t repeat = 1;
+    bool json = false;
+    bool transitions = false;
+    bool cut = false;
+    bool click = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else if (!strcmp(argv[i], "--transitions")) {
+            transitions = true;
+        } else if (!strcmp(argv[i], "--cut")) {
+            cut = true;
+        } else if (!strcmp(argv[i], "--click")) {
+            click = true;
+        } else {
+            fprintf(stderr, "usage: %s [--repeat N] [--json] [--transitions] [--cut] [--click]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    s_disp = bsp_display_start();
+    if (s_disp == NULL) {
+        return 1;
+    }
+    s_disp->driver->monitor_cb = monitor_cb;
+    lv_indev_t *knob = bsp_display_get_input_dev();
+
+    /* Same start as app_main(), without the timeout to the clock screen */
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+    lv_img_transform_init(s_disp);
+    if (!cut) {
+        lv_layer_transition_init(s_disp);
+    }
+    ui_obj_to_encoder_init();
+    lv_create_home(&menu_layer);
+    lvgl_port_host_run(SETTLE_MS);
+
+    const size_t screen_cnt = sizeof(screens) / sizeof(screens[0]);
+    if (transitions) {
+        bench_transitions(screens, screen_cnt);
+        return 0;
+    }
+    if (click) {
+        bench_click(knob);
+        return 0;
+    }
+
+    if (!json) {
+        printf("%-12s %7s %10s %10s %10s %12s %10s %8s %8s %8s %8s %8s %9s %8s %8s %8s\n",
+               "screen", "frames", "render_us", "max_us", "inv_px", "flush_bytes", "heap_peak", "idle_wk", "awake_%",
+               "img_hit", "img_miss", "img_evct", "img_bytes", "lat_in", "lat_p90", "lat_max");
+    } else {
+        printf("[\n");
+    }
+    screen_stats_t res[sizeof(screens) / sizeof(screens[0])];
+    for (uint32_t run = 0; run < LV_MAX(repeat, 1); run++) {
+        for (size_t i = 0; i < screen_cnt; i++) {
+            screen_stats_t stats;
+            bench_run(&screens[i], knob, &stats);
+            if (run == 0) {
+                res[i] = stats;
+            } else {
+                res[i].render_us = LV_MIN(res[i].render_us, stats.render_us);
+                res[i].render_max_us = LV_MIN(res[i].render_max_us, stats.render_max_us);
+            }
+        }
+    }
+    for (size_t i = 0; i < screen_cnt; i++) {
+        print_row(screens[i].name, &res[i], json, i + 1 == screen_cnt);
+    }
+    if (json) {
+        printf("]\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,369 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Strip height benchmark.
+ *
+ * Renders a full-screen scene with the firmware LVGL configuration into draw buffers of
+ * different strip heights, once single buffered and once in ping-pong. The panel is simulated
+ * by a thread which holds the bus for the time the SPI transfer takes on the board,
+ * so render/flush overlap and fps can be compared without the hardware.
+ *
+ * Usage: bench_strip [--frames N] [--spi-mhz F] [--cpu-scale S] [--json]
+ *   --cpu-scale  stretch measured render time by S, to approximate the slower target CPU
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include "lvgl.h"
+
+#define DISP_H_RES          (240)
+#define DISP_V_RES          (240)
+#define PANEL_CMD_COST_US   (6)     /* CASET + RASET + RAMWR polled before every strip */
+
+typedef struct {
+    uint32_t frames;
+    uint32_t flushes;
+    uint64_t flushed_bytes;
+    uint64_t render_us;
+    uint64_t transfer_us;
+    uint64_t wait_us;
+    uint64_t overlap_us;
+} flush_stats_t;
+
+typedef struct {
+    lv_disp_drv_t *drv;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t pending_bytes;       /* Bytes of the transfer being sent, 0 when the bus is idle */
+    bool quit;
+    double bytes_per_us;
+    double cpu_scale;
+    void (*draw_wait_for_finish)(lv_draw_ctx_t *draw_ctx);
+
+    /* Same accounting as lvgl_port_flush_callback() */
+    int64_t segment_start;
+    int64_t wait_pending;
+    int64_t emulated_mark;
+    int64_t transfer_start;
+    int64_t transfer_time;
+    bool transfer_pending;
+    flush_stats_t stats;
+} sim_panel_t;
+
+static sim_panel_t s_panel;
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleep_until_us(int64_t deadline)
+{
+    struct timespec ts = {
+        .tv_sec = deadline / 1000000,
+        .tv_nsec = (deadline % 1000000) * 1000,
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    }
+}
+
+static void spin_until_us(int64_t deadline)
+{
+    while (now_us() < deadline) {
+    }
+}
+
+static void *panel_dma_task(void *arg)
+{
+    sim_panel_t *panel = (sim_panel_t *)arg;
+
+    pthread_mutex_lock(&panel->lock);
+    while (!panel->quit) {
+        if (panel->pending_bytes == 0) {
+            pthread_cond_wait(&panel->cond, &panel->lock);
+            continue;
+        }
+        const int64_t start = panel->transfer_start;
+        const int64_t duration = PANEL_CMD_COST_US + (int64_t)(panel->pending_bytes / panel->bytes_per_us);
+        pthread_mutex_unlock(&panel->lock);
+        sleep_until_us(start + duration);
+        pthread_mutex_lock(&panel->lock);
+
+        /* on_color_trans_done */
+        panel->transfer_time = now_us() - start;
+        panel->pending_bytes = 0;
+        lv_disp_flush_ready(panel->drv);
+        pthread_cond_broadcast(&panel->cond);
+    }
+    pthread_mutex_unlock(&panel->lock);
+
+    return NULL;
+}
+
+static void panel_wait_idle(sim_panel_t *panel)
+{
+    pthread_mutex_lock(&panel->lock);
+    while (panel->pending_bytes) {
+        pthread_cond_wait(&panel->cond, &panel->lock);
+    }
+    pthread_mutex_unlock(&panel->lock);
+}
+
+static void stats_commit(sim_panel_t *panel)
+{
+    if (panel->transfer_pending) {
+        panel->stats.transfer_us += panel->transfer_time;
+        panel->transfer_pending = false;
+    }
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    sim_panel_t *panel = (sim_panel_t *)drv->user_data;
+
+    const int64_t now = now_us();
+    const int64_t render_time = now - panel->segment_start - panel->wait_pending;
+    if (panel->transfer_pending) {
+        const int64_t transfer_end = panel->transfer_start + panel->transfer_time;
+        const int64_t overlap = transfer_end - panel->segment_start - panel->wait_pending;
+        if (overlap > 0) {
+            panel->stats.overlap_us += LV_MIN(overlap, render_time);
+        }
+    }
+    stats_commit(panel);
+    panel->stats.render_us += render_time;
+    panel->stats.flushes++;
+    panel->stats.flushed_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+    if (lv_disp_flush_is_last(drv)) {
+        panel->stats.frames++;
+    }
+
+    pthread_mutex_lock(&panel->lock);
+    panel->transfer_start = now;
+    panel->transfer_pending = true;
+    panel->pending_bytes = lv_area_get_size(area) * sizeof(lv_color_t);
+    pthread_cond_broadcast(&panel->cond);
+    pthread_mutex_unlock(&panel->lock);
+
+    panel->segment_start = now_us();
+    panel->wait_pending = 0;
+    panel->emulated_mark = panel->segment_start;
+}
+
+static void wait_cb(lv_disp_drv_t *drv)
+{
+    sim_panel_t *panel = (sim_panel_t *)drv->user_data;
+    const int64_t start = now_us();
+
+    panel_wait_idle(panel);
+
+    const int64_t waited = now_us() - start;
+    panel->wait_pending += waited;
+    panel->stats.wait_us += waited;
+    panel->emulated_mark += waited;
+}
+
+static void render_start_cb(lv_disp_drv_t *drv)
+{
+    sim_panel_t *panel = (sim_panel_t *)drv->user_data;
+
+    panel->segment_start = now_us();
+    panel->wait_pending = 0;
+    panel->emulated_mark = panel->segment_start;
+}
+
+/* Called by LVGL when a strip is rendered, before it waits for a free buffer: stretch the render time here */
+static void draw_wait_for_finish(lv_draw_ctx_t *draw_ctx)
+{
+    sim_panel_t *panel = &s_panel;
+
+    if (panel->draw_wait_for_finish) {
+        panel->draw_wait_for_finish(draw_ctx);
+    }
+    if (panel->cpu_scale > 1.0) {
+        const int64_t now = now_us();
+        const int64_t rendered = now - panel->emulated_mark;
+        spin_until_us(now + (int64_t)(rendered * (panel->cpu_scale - 1.0)));
+        panel->emulated_mark = now_us();
+    }
+}
+
+/* Full-screen content similar to the app screens: gradient background, arc, large text */
+static lv_obj_t *s_arc;
+static lv_obj_t *s_label;
+
+static void scene_create(void)
+{
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x0F1B3D), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x6B2FA0), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    s_arc = lv_arc_create(scr);
+    lv_obj_set_size(s_arc, 220, 220);
+    lv_arc_set_range(s_arc, 0, 100);
+    lv_obj_set_style_arc_width(s_arc, 14, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(s_arc, 14, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(s_arc, lv_color_hex(0xFFA500), LV_PART_INDICATOR);
+    lv_obj_center(s_arc);
+
+    s_label = lv_label_create(scr);
+    lv_obj_set_style_text_font(s_label, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_color(s_label, lv_color_white(), 0);
+    lv_obj_center(s_label);
+
+    lv_obj_t *caption = lv_label_create(scr);
+    lv_obj_set_style_text_font(caption, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_color(caption, lv_color_hex(0xC0C0C0), 0);
+    lv_label_set_text(caption, "Brightness");
+    lv_obj_align(caption, LV_ALIGN_CENTER, 0, 50);
+}
+
+static void scene_step(uint32_t frame)
+{
+    lv_arc_set_value(s_arc, frame % 101);
+    lv_label_set_text_fmt(s_label, "%d%%", (int)(frame % 101));
+    lv_obj_invalidate(lv_scr_act());
+}
+
+typedef struct {
+    uint32_t lines;
+    bool ping_pong;
+    double fps;
+    flush_stats_t stats;
+} bench_result_t;
+
+static void bench_run(lv_disp_t *disp, lv_color_t *buf1, lv_color_t *buf2, uint32_t lines, bool ping_pong,
+                      uint32_t frames, bench_result_t *res)
+{
+    lv_disp_draw_buf_t *draw_buf = disp->driver->draw_buf;
+
+    panel_wait_idle(&s_panel);
+    lv_disp_draw_buf_init(draw_buf, buf1, ping_pong ? buf2 : NULL, lines * DISP_H_RES);
+
+    /* Warm up caches and fonts */
+    scene_step(0);
+    lv_refr_now(disp);
+    panel_wait_idle(&s_panel);
+    memset(&s_panel.stats, 0, sizeof(s_panel.stats));
+    s_panel.transfer_pending = false;
+
+    const int64_t start = now_us();
+    for (uint32_t i = 1; i <= frames; i++) {
+        scene_step(i);
+        lv_refr_now(disp);
+    }
+    panel_wait_idle(&s_panel);
+    const int64_t elapsed = now_us() - start;
+    stats_commit(&s_panel);
+
+    res->lines = lines;
+    res->ping_pong = ping_pong;
+    res->fps = frames * 1000000.0 / elapsed;
+    res->stats = s_panel.stats;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t strip_lines[] = {240, 120, 80, 48, 40, 24, 16, 10};
+    uint32_t frames = 60;
+    double spi_mhz = 80.0;
+    double cpu_scale = 1.0;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--spi-mhz") && i + 1 < argc) {
+            spi_mhz = strtod(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--cpu-scale") && i + 1 < argc) {
+            cpu_scale = strtod(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [--spi-mhz F] [--cpu-scale S] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+
+    lv_color_t *buf1 = malloc(DISP_H_RES * DISP_V_RES * sizeof(lv_color_t));
+    lv_color_t *buf2 = malloc(DISP_H_RES * DISP_V_RES * sizeof(lv_color_t));
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, DISP_H_RES * DISP_V_RES);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_H_RES;
+    disp_drv.ver_res = DISP_V_RES;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.wait_cb = wait_cb;
+    disp_drv.render_start_cb = render_start_cb;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.user_data = &s_panel;
+
+    s_panel.drv = &disp_drv;
+    s_panel.bytes_per_us = spi_mhz / 8.0;
+    s_panel.cpu_scale = cpu_scale;
+    pthread_mutex_init(&s_panel.lock, NULL);
+    pthread_cond_init(&s_panel.cond, NULL);
+    pthread_create(&s_panel.thread, NULL, panel_dma_task, &s_panel);
+
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+    s_panel.draw_wait_for_finish = disp->driver->draw_ctx->wait_for_finish;
+    disp->driver->draw_ctx->wait_for_finish = draw_wait_for_finish;
+    scene_create();
+
+    if (!json) {
+        printf("frames=%u spi=%.0fMHz cpu-scale=%.1f\n", frames, spi_mhz, cpu_scale);
+        printf("%6s %-9s %8s %10s %10s %10s %10s %8s\n",
+               "lines", "mode", "fps", "render_us", "xfer_us", "wait_us", "overlap_us", "hidden");
+    } else {
+        printf("[\n");
+    }
+    const size_t runs = sizeof(strip_lines) / sizeof(strip_lines[0]);
+    for (size_t i = 0; i < runs * 2; i++) {
+        bench_result_t res;
+        bench_run(disp, buf1, buf2, strip_lines[i / 2], i % 2, frames, &res);
+        const double hidden = res.stats.render_us ? 100.0 * res.stats.overlap_us / res.stats.render_us : 0.0;
+        if (json) {
+            printf("  {\"lines\": %u, \"mode\": \"%s\", \"fps\": %.2f, \"frames\": %u, \"flushes\": %u, "
+                   "\"flushed_bytes\": %llu, \"render_us\": %llu, \"transfer_us\": %llu, \"wait_us\": %llu, "
+                   "\"overlap_us\": %llu}%s\n",
+                   res.lines, res.ping_pong ? "ping-pong" : "single", res.fps, res.stats.frames, res.stats.flushes,
+                   (unsigned long long)res.stats.flushed_bytes, (unsigned long long)res.stats.render_us,
+                   (unsigned long long)res.stats.transfer_us, (unsigned long long)res.stats.wait_us,
+                   (unsigned long long)res.stats.overlap_us, (i + 1 < runs * 2) ? "," : "");
+        } else {
+            printf("%6u %-9s %8.1f %10llu %10llu %10llu %10llu %7.1f%%\n",
+                   res.lines, res.ping_pong ? "ping-pong" : "single", res.fps,
+                   (unsigned long long)res.stats.render_us / frames, (unsigned long long)res.stats.transfer_us / frames,
+                   (unsigned long long)res.stats.wait_us / frames, (unsigned long long)res.stats.overlap_us / frames,
+                   hidden);
+        }
+    }
+    if (json) {
+        printf("]\n");
+    }
+
+    pthread_mutex_lock(&s_panel.lock);
+    s_panel.quit = true;
+    pthread_cond_broadcast(&s_panel.cond);
+    pthread_mutex_unlock(&s_panel.lock);
+    pthread_join(s_panel.thread, NULL);
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Transformed image cache benchmark.
+ *
+ * Replays the zoom and rotation animations of the washing screen on their images of the
+ * asset pack, rendered in strips of the BSP draw buffer height like the firmware. Every
+ * animation runs three times: with the cache disabled (LVGL transforms every strip), then
+ * with an empty cache (cold, the first period of the animation) and again (warm, the steps
+ * are cached if they fit in the budget). Reports the render time per frame, the hits and
+ * misses per frame and the bytes the cache holds.
+ *
+ * Usage: bench_transform [--repeat N] [--zoom-step N] [--angle-step N] [--budget BYTES] [--json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+#include "asset_pack_host.h"
+
+#define DISP_W              (240)
+#define DISP_H              (240)
+#define STRIP_H             (CONFIG_BSP_LCD_DRAW_BUF_HEIGHT)
+#define FRAME_MS            (30)
+
+/* An animation of ui_washing.c: values from..to and back over period_ms, ease in and out */
+typedef struct {
+    const char *name;
+    const char *img;
+    bool rotate;                /* Animates the angle, the zoom otherwise */
+    int32_t from;
+    int32_t to;
+    uint32_t period_ms;
+    lv_point_t pivot;           /* -1: centre of the image */
+    lv_coord_t x;               /* Top left corner of the image on the screen */
+    lv_coord_t y;
+} anim_case_t;
+
+static const anim_case_t s_cases[] = {
+    /* Selection wheel: 256 * (100 - |y|) / 70 while an item moves 40 px to the centre */
+    {"wheel_zoom",  "img_washing_shirt",    false, 219, 365, 700,  {-1, -1}, 88, 40},
+    /* Waves of the running cycle: fixed zoom, only their position moves */
+    {"wave_zoom",   "img_washing_wave1",    false, 379, 379, 3600, {-1, -1}, 50, 190},
+    {"shirt_rot",   "wash_shirt",           true,  -450, 450, 3600, {29, 38}, 91, 91},
+    {"underwear_rot", "wash_underwear1",    true,  -150, 150, 2600, {-1, -1}, 100, 100},
+};
+
+typedef struct {
+    double us_per_frame;
+    double hits_per_frame;
+    double misses_per_frame;
+    uint32_t peak_bytes;
+} run_result_t;
+
+static lv_color_t s_strip[DISP_W * STRIP_H];
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_disp_flush_ready(drv);
+}
+
+static int32_t anim_value(const anim_case_t *c, uint32_t t_ms)
+{
+    const uint32_t half = c->period_ms / 2;
+    uint32_t t = t_ms % c->period_ms;
+    if (t > half) {
+        t = c->period_ms - t;
+    }
+    lv_anim_t a;
+    lv_anim_init(&a);
+    a.start_value = c->from;
+    a.end_value = c->to;
+    a.time = half;
+    a.act_time = t;
+    return lv_anim_path_ease_in_out(&a);
+}
+
+/* One period of the animation, the time of the fastest of `repeat` runs */
+static void run(lv_disp_t *disp, const anim_case_t *c, uint32_t repeat, bool flush_cache, run_result_t *res)
+{
+    const lv_img_dsc_t *img = lv_asset_img(c->img);
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+    const uint32_t frames = c->period_ms / FRAME_MS;
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.antialias = true;
+    dsc.pivot.x = c->pivot.x < 0 ? img->header.w / 2 : c->pivot.x;
+    dsc.pivot.y = c->pivot.y < 0 ? img->header.h / 2 : c->pivot.y;
+    const lv_area_t coords = {c->x, c->y, c->x + img->header.w - 1, c->y + img->header.h - 1};
+
+    int64_t best = INT64_MAX;
+    lv_img_transform_stats_t stats = {0};
+    for (uint32_t r = 0; r < repeat; r++) {
+        if (flush_cache) {
+            lv_img_transform_invalidate(NULL);
+        }
+        lv_img_transform_reset_stats();
+        int64_t total = 0;
+        for (uint32_t f = 0; f < frames; f++) {
+            const int32_t v = anim_value(c, f * FRAME_MS);
+            if (c->rotate) {
+                dsc.angle = (v + 3600) % 3600;
+            } else {
+                dsc.zoom = v;
+            }
+            /* A new frame for the cache, which keeps the images of the frame being rendered */
+            disp->refr_timer->last_run = f * 2;
+
+            const int64_t start = now_ns();
+            for (lv_coord_t y = 0; y < DISP_H; y += STRIP_H) {
+                const lv_area_t strip = {0, y, DISP_W - 1, y + STRIP_H - 1};
+                draw_ctx->buf = s_strip;
+                draw_ctx->buf_area = (lv_area_t *)&strip;
+                draw_ctx->clip_area = &strip;
+                lv_draw_img(draw_ctx, &dsc, &coords, img);
+            }
+            total += now_ns() - start;
+        }
+        if (total < best) {
+            best = total;
+            lv_img_transform_get_stats(&stats);
+        }
+    }
+
+    res->us_per_frame = best / 1000.0 / frames;
+    res->hits_per_frame = (double)stats.hits / frames;
+    res->misses_per_frame = (double)stats.misses / frames;
+    res->peak_bytes = stats.peak_bytes;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t repeat = 5;
+    uint32_t zoom_step = LV_IMG_TRANSFORM_ZOOM_STEP;
+    uint32_t angle_step = LV_IMG_TRANSFORM_ANGLE_STEP;
+    uint32_t budget = LV_IMG_TRANSFORM_BUDGET;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--zoom-step") && i + 1 < argc) {
+            zoom_step = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--angle-step") && i + 1 < argc) {
+            angle_step = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--budget") && i + 1 < argc) {
+            budget = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--json")) {
+            json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--repeat N] [--zoom-step N] [--angle-step N] [--budget BYTES] [--json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    lv_init();
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, s_strip, NULL, DISP_W * STRIP_H);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+    lv_img_transform_init(disp);
+    lv_img_transform_set_steps(zoom_step, angle_step);
+    _lv_refr_set_disp_refreshing(disp);
+
+    if (json) {
+        printf("[\n");
+    } else {
+        printf("zoom step %u, angle step %u, budget %u B, %u ms frames\n", zoom_step, angle_step, budget, FRAME_MS);
+        printf("%-14s %7s %9s %9s %9s %9s %9s %9s\n",
+               "animation", "frames", "lvgl_us", "cold_us", "warm_us", "warm_hit", "warm_miss", "bytes");
+    }
+
+    const size_t case_cnt = sizeof(s_cases) / sizeof(s_cases[0]);
+    for (size_t i = 0; i < case_cnt; i++) {
+        const anim_case_t *c = &s_cases[i];
+        if (NULL == lv_asset_img(c->img)) {
+            return 1;
+        }
+        run_result_t lvgl, cold, warm;
+        lv_img_transform_set_budget(0);
+        run(disp, c, repeat, true, &lvgl);
+        lv_img_transform_set_budget(budget);
+        run(disp, c, repeat, true, &cold);
+        run(disp, c, 1, false, &warm);
+        run(disp, c, repeat, false, &warm);
+
+        const uint32_t frames = c->period_ms / FRAME_MS;
+        if (json) {
+            printf("  {\"animation\": \"%s\", \"frames\": %u, \"lvgl_us\": %.1f, \"cold_us\": %.1f, \"warm_us\": %.1f, "
+                   "\"warm_hits_per_frame\": %.2f, \"warm_misses_per_frame\": %.2f, \"peak_bytes\": %u}%s\n",
+                   c->name, frames, lvgl.us_per_frame, cold.us_per_frame, warm.us_per_frame,
+                   warm.hits_per_frame, warm.misses_per_frame, warm.peak_bytes, i + 1 < case_cnt ? "," : "");
+        } else {
+            printf("%-14s %7u %9.1f %9.1f %9.1f %9.2f %9.2f %9u\n", c->name, frames, lvgl.us_per_frame,
+                   cold.us_per_frame, warm.us_per_frame, warm.hits_per_frame, warm.misses_per_frame, warm.peak_bytes);
+        }
+        lv_img_transform_invalidate(NULL);
+    }
+
+    if (json) {
+        printf("]\n");
+    }
+    return 0;
+}
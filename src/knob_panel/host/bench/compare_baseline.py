@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Compare the JSON output of bench_screens with the committed baseline.
+#
+# Frames, invalidated pixels, flushed bytes, heap high-water, idle wakeups and the share
+# of the idle time with the LVGL tick running are deterministic, any increase is a regression. Render times depend on the host, they only count as a
+# regression beyond --time-tolerance (relative, 0.5 = 50 % slower). The knob latencies run on the
+# simulated clock of the host backend, they are deterministic too.
+#
+# Usage: compare_baseline.py <baseline.json> <current.json> [--time-tolerance T]
+
+import argparse
+import json
+import sys
+
+EXACT = ('frames', 'inv_px_per_frame', 'flush_bytes_per_frame', 'heap_peak', 'idle_wakeups_per_sec',
+         'idle_awake_pct', 'latency_p90_us', 'latency_max_us')
+TIMED = ('render_us_per_frame', 'render_max_us')
+
+
+def load(path):
+    with open(path) as f:
+        return {row['screen']: row for row in json.load(f)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare bench_screens results with a baseline')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--time-tolerance', type=float, default=0.5)
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for screen, base in baseline.items():
+        cur = current.get(screen)
+        if cur is None:
+            print('{:<12} missing'.format(screen))
+            regressions += 1
+            continue
+        for key in EXACT + TIMED:
+            old, new = base[key], cur[key]
+            if old == new:
+                continue
+            limit = old * (1 + args.time_tolerance) if key in TIMED else old
+            worse = new > limit
+            regressions += worse
+            change = '{:+.1f} %'.format(100.0 * (new - old) / old) if old else 'new'
+            print('{:<12} {:<22} {:>10} -> {:<10} {:>9}{}'.format(screen, key, old, new, change,
+                                                                    '  REGRESSION' if worse else ''))
+
+    for screen in current.keys() - baseline.keys():
+        print('{:<12} not in the baseline'.format(screen))
+
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,820 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Headless Linux backend of esp_lvgl_port, see esp_lvgl_port_host.h.
+ *
+ * Display and input registration follow esp_lvgl_port.c: same draw buffers, circular viewport
+ * and flush planner. Flushes are copied into the framebuffer and finished at once, the
+ * panel IO takes no time (`transfer_us`, `wait_us` and `overlap_us` stay 0).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_host.h"
+#include "esp_lvgl_port_planner.h"
+#include "esp_lvgl_port_viewport.h"
+#include "esp_lvgl_port_encoder.h"
+#include "esp_lvgl_port_latency.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct lvgl_port_ctx_s {
+    bool        initialized;
+    bool        running;            /* Cleared by lvgl_port_stop() */
+    uint32_t    timer_period_ms;
+    uint32_t    task_max_sleep_ms;
+    uint32_t    idle_threshold_ms;
+    uint32_t    time_ms;            /* Simulated time since lvgl_port_init() */
+    uint32_t    next_wakeup_ms;     /* Time the LVGL task of the port would wake up */
+    uint32_t    lock_depth;
+    struct {
+        uint32_t window_start;      /* Start of the current one second window */
+        uint32_t count;             /* Wakeups in the current window */
+        uint32_t per_sec;           /* Wakeups in the last complete window */
+    } wakeups;
+    struct {
+        bool     active;            /* The LVGL task would sleep with the tick stopped */
+        bool     forever;           /* No LVGL timer is due, only input ends the idle period */
+        uint32_t start_ms;
+        uint32_t stats_start_ms;
+        lvgl_port_idle_stats_t stats;
+    } idle;
+    lvgl_port_latency_t latency;    /* Trace of the encoder input, on the simulated clock */
+} lvgl_port_ctx_t;
+
+typedef struct {
+    lv_disp_drv_t             disp_drv;     /* LVGL display driver */
+    lv_disp_t                 *disp;        /* LVGL display of the driver */
+    uint32_t                  buffer_size;  /* Allocated size of each draw buffer in pixels */
+    lv_color_t                *framebuffer; /* Content of the panel */
+    lvgl_port_viewport_t      viewport;     /* Visible part of a round panel */
+    int64_t                   segment_start;
+    lvgl_port_flush_stats_t   stats;
+} lvgl_port_display_ctx_t;
+
+typedef struct {
+    lv_indev_drv_t  indev_drv;      /* LVGL input device driver */
+    lvgl_port_encoder_input_t input; /* Knob and button events not read by LVGL yet */
+    int32_t         detents;        /* Detents of the turn still to come */
+    uint32_t        detent_ms;      /* Time between them */
+    uint32_t        next_detent_ms; /* Time of the next one */
+} lvgl_port_encoder_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static lvgl_port_ctx_t lvgl_port_ctx;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static int64_t lvgl_port_get_time_us(void);
+static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv);
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area);
+static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_encoder_read_timer_callback(lv_timer_t *timer);
+static void lvgl_port_encoder_turn(void);
+static void lvgl_port_count_wakeup(void);
+static bool lvgl_port_idle_enter(uint32_t *sleep_ms);
+static void lvgl_port_idle_exit(bool deadline);
+static esp_err_t lvgl_port_write_ppm(FILE *f, const lv_color_t *fb, uint32_t w, uint32_t h);
+static esp_err_t lvgl_port_write_png(FILE *f, const lv_color_t *fb, uint32_t w, uint32_t h);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+
+    /* LVGL init */
+    lv_init();
+    lvgl_port_ctx.timer_period_ms = cfg->timer_period_ms > 0 ? cfg->timer_period_ms : 5;
+    lvgl_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms > 0 ? cfg->task_max_sleep_ms : 500;
+    lvgl_port_ctx.idle_threshold_ms = cfg->idle_threshold_ms > 0 ? cfg->idle_threshold_ms : 0;
+    lvgl_port_latency_init(&lvgl_port_ctx.latency);
+    lvgl_port_ctx.running = true;
+    lvgl_port_ctx.initialized = true;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_resume(void)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.initialized, ESP_ERR_INVALID_STATE, TAG, "lvgl_port_init must be called first");
+    lv_timer_enable(true);
+    lvgl_port_ctx.running = true;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_stop(void)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.initialized, ESP_ERR_INVALID_STATE, TAG, "lvgl_port_init must be called first");
+    lv_timer_enable(false);
+    lvgl_port_ctx.running = false;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_deinit(void)
+{
+    lvgl_port_ctx.initialized = false;
+    lvgl_port_ctx.running = false;
+    return ESP_OK;
+}
+
+lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
+{
+    esp_err_t ret = ESP_OK;
+    lv_disp_t *disp = NULL;
+    lv_color_t *buf1 = NULL;
+    lv_color_t *buf2 = NULL;
+    lv_disp_draw_buf_t *disp_buf = NULL;
+    assert(disp_cfg != NULL);
+    assert(disp_cfg->buffer_size > 0);
+    assert(disp_cfg->hres > 0);
+    assert(disp_cfg->vres > 0);
+
+    /* Panel IO and panel handles are not used, the host panel is the framebuffer */
+    lvgl_port_display_ctx_t *disp_ctx = calloc(1, sizeof(lvgl_port_display_ctx_t));
+    ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
+    ESP_GOTO_ON_FALSE(!disp_cfg->monochrome, ESP_ERR_NOT_SUPPORTED, err, TAG, "Monochrome displays are not supported on the host!");
+    disp_ctx->buffer_size = disp_cfg->buffer_size;
+    disp_ctx->framebuffer = calloc(disp_cfg->hres * disp_cfg->vres, sizeof(lv_color_t));
+    ESP_GOTO_ON_FALSE(disp_ctx->framebuffer, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for framebuffer allocation!");
+
+    buf1 = malloc(disp_cfg->buffer_size * sizeof(lv_color_t));
+    ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
+    if (disp_cfg->double_buffer) {
+        buf2 = malloc(disp_cfg->buffer_size * sizeof(lv_color_t));
+        ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
+    }
+    disp_buf = malloc(sizeof(lv_disp_draw_buf_t));
+    ESP_GOTO_ON_FALSE(disp_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL display buffer allocation!");
+    lv_disp_draw_buf_init(disp_buf, buf1, buf2, disp_cfg->buffer_size);
+
+    lv_disp_drv_init(&disp_ctx->disp_drv);
+    disp_ctx->disp_drv.hor_res = disp_cfg->hres;
+    disp_ctx->disp_drv.ver_res = disp_cfg->vres;
+    disp_ctx->disp_drv.flush_cb = lvgl_port_flush_callback;
+    disp_ctx->disp_drv.render_start_cb = lvgl_port_render_start_callback;
+    disp_ctx->disp_drv.draw_buf = disp_buf;
+    disp_ctx->disp_drv.user_data = disp_ctx;
+
+    /* Round panel, split invalidated areas to skip the invisible corners */
+    if (disp_cfg->flags.circular_viewport) {
+        ESP_GOTO_ON_ERROR(lvgl_port_viewport_init(&disp_ctx->viewport, disp_cfg->hres, disp_cfg->vres, disp_cfg->visible_span_cb),
+                          err, TAG, "Circular viewport init failed!");
+        disp_ctx->disp_drv.rounder_cb = lvgl_port_rounder_callback;
+    }
+
+    disp = lv_disp_drv_register(&disp_ctx->disp_drv);
+    disp_ctx->disp = disp;
+
+err:
+    if (ret != ESP_OK) {
+        free(buf1);
+        free(buf2);
+        free(disp_buf);
+        if (disp_ctx) {
+            free(disp_ctx->framebuffer);
+            free(disp_ctx);
+        }
+    }
+
+    return disp;
+}
+
+esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
+{
+    assert(disp);
+    lv_disp_drv_t *disp_drv = disp->driver;
+    assert(disp_drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+
+    lv_disp_remove(disp);
+
+    free(disp_drv->draw_buf->buf1);
+    free(disp_drv->draw_buf->buf2);
+    free(disp_drv->draw_buf);
+    free(disp_ctx->framebuffer);
+    free(disp_ctx);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_set_strip_height(lv_disp_t *disp, uint32_t lines)
+{
+    assert(disp);
+    lv_disp_drv_t *disp_drv = disp->driver;
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
+
+    const uint32_t size = lines * lv_disp_get_hor_res(disp);
+    ESP_RETURN_ON_FALSE(lines > 0 && size <= disp_ctx->buffer_size, ESP_ERR_INVALID_ARG, TAG, "Strip of %d lines does not fit into the draw buffer!", (int)lines);
+    disp_drv->draw_buf->size = size;
+
+    return ESP_OK;
+}
+
+uint32_t lvgl_port_get_strip_height(lv_disp_t *disp)
+{
+    assert(disp);
+    return disp->driver->draw_buf->size / lv_disp_get_hor_res(disp);
+}
+
+esp_err_t lvgl_port_get_flush_stats(lv_disp_t *disp, lvgl_port_flush_stats_t *stats)
+{
+    assert(disp);
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+
+    *stats = disp_ctx->stats;
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_flush_stats(lv_disp_t *disp)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+
+    memset(&disp_ctx->stats, 0, sizeof(disp_ctx->stats));
+}
+
+lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
+{
+    assert(encoder_cfg != NULL);
+    assert(encoder_cfg->disp != NULL);
+
+    /* Knob and button configurations are not used, the input comes from lvgl_port_host_knob_rotate/button_set */
+    lvgl_port_encoder_ctx_t *encoder_ctx = calloc(1, sizeof(lvgl_port_encoder_ctx_t));
+    if (encoder_ctx == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for encoder context allocation!");
+        return NULL;
+    }
+
+    lv_indev_drv_init(&encoder_ctx->indev_drv);
+    encoder_ctx->indev_drv.type = LV_INDEV_TYPE_ENCODER;
+    encoder_ctx->indev_drv.disp = encoder_cfg->disp;
+    encoder_ctx->indev_drv.read_cb = lvgl_port_encoder_read;
+    encoder_ctx->indev_drv.user_data = encoder_ctx;
+    lvgl_port_encoder_input_init(&encoder_ctx->input, &encoder_cfg->accel);
+    lv_indev_t *indev = lv_indev_drv_register(&encoder_ctx->indev_drv);
+    if (indev == NULL) {
+        free(encoder_ctx);
+    } else {
+        indev->driver->read_timer->timer_cb = lvgl_port_encoder_read_timer_callback;
+    }
+
+    return indev;
+}
+
+esp_err_t lvgl_port_remove_encoder(lv_indev_t *encoder)
+{
+    assert(encoder);
+    lvgl_port_encoder_ctx_t *encoder_ctx = (lvgl_port_encoder_ctx_t *)encoder->driver->user_data;
+
+    lv_indev_delete(encoder);
+    free(encoder_ctx);
+
+    return ESP_OK;
+}
+
+lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *buttons_cfg)
+{
+    ESP_LOGE(TAG, "Navigation buttons are not supported on the host!");
+    return NULL;
+}
+
+esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+bool lvgl_port_lock(uint32_t timeout_ms)
+{
+    assert(lvgl_port_ctx.initialized && "lvgl_port_init must be called first");
+
+    /* One thread, the lock only has to be balanced */
+    lvgl_port_ctx.lock_depth++;
+    return true;
+}
+
+void lvgl_port_unlock(void)
+{
+    assert(lvgl_port_ctx.initialized && "lvgl_port_init must be called first");
+    if (lvgl_port_ctx.lock_depth > 0) {
+        lvgl_port_ctx.lock_depth--;
+    }
+}
+
+void lvgl_port_wake(void)
+{
+    lvgl_port_idle_exit(false);
+}
+
+void lvgl_port_flush_ready(lv_disp_t *disp)
+{
+    assert(disp);
+    lv_disp_flush_ready(disp->driver);
+}
+
+esp_err_t lvgl_port_host_run(uint32_t ms)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.initialized, ESP_ERR_INVALID_STATE, TAG, "lvgl_port_init must be called first");
+
+    for (uint32_t elapsed = 0; elapsed < ms; elapsed += lvgl_port_ctx.timer_period_ms) {
+        const uint32_t period = LV_MIN(lvgl_port_ctx.timer_period_ms, ms - elapsed);
+        lv_tick_inc(period);
+        lvgl_port_ctx.time_ms += period;
+        lvgl_port_encoder_turn();
+        if (lvgl_port_ctx.idle.active) {
+            if (lvgl_port_ctx.idle.forever || ((int32_t)(lvgl_port_ctx.time_ms - lvgl_port_ctx.next_wakeup_ms) < 0)) {
+                continue;
+            }
+            lvgl_port_idle_exit(true);
+        }
+        if (lvgl_port_ctx.running && ((int32_t)(lvgl_port_ctx.time_ms - lvgl_port_ctx.next_wakeup_ms) >= 0)) {
+            /* Same sleep as the LVGL task of the port */
+            uint32_t task_delay_ms = lv_timer_handler();
+            if (!lvgl_port_idle_enter(&task_delay_ms)) {
+                if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms)) {
+                    task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+                } else if (task_delay_ms < 1) {
+                    task_delay_ms = 1;
+                }
+            }
+            lvgl_port_ctx.next_wakeup_ms = lvgl_port_ctx.time_ms + task_delay_ms;
+            lvgl_port_count_wakeup();
+        }
+    }
+
+    return ESP_OK;
+}
+
+uint32_t lvgl_port_get_wakeups_per_sec(void)
+{
+    const uint32_t window = lvgl_port_ctx.time_ms - lvgl_port_ctx.wakeups.window_start;
+
+    /* Without wakeups the window is not closed, it is long enough on its own */
+    if (window >= 2 * 1000) {
+        return lvgl_port_ctx.wakeups.count * 1000 / window;
+    }
+    return lvgl_port_ctx.wakeups.per_sec;
+}
+
+esp_err_t lvgl_port_get_idle_stats(lvgl_port_idle_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lvgl_port_lock(0);
+    *stats = lvgl_port_ctx.idle.stats;
+    /* Like on the board, the current idle period counts with its time so far */
+    if (lvgl_port_ctx.idle.active) {
+        stats->idle_us += (uint64_t)(lvgl_port_ctx.time_ms - lvgl_port_ctx.idle.start_ms) * 1000;
+    }
+    stats->active_us = (uint64_t)(lvgl_port_ctx.time_ms - lvgl_port_ctx.idle.stats_start_ms) * 1000 - stats->idle_us;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_idle_stats(void)
+{
+    lvgl_port_lock(0);
+    memset(&lvgl_port_ctx.idle.stats, 0, sizeof(lvgl_port_ctx.idle.stats));
+    lvgl_port_ctx.idle.stats_start_ms = lvgl_port_ctx.time_ms;
+    /* The current idle period counts from here on */
+    if (lvgl_port_ctx.idle.active) {
+        lvgl_port_ctx.idle.start_ms = lvgl_port_ctx.time_ms;
+    }
+    lvgl_port_unlock();
+}
+
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    /* Without the lock of the board: it would end the idle period the trace measures */
+    *stats = lvgl_port_ctx.latency.stats;
+
+    return ESP_OK;
+}
+
+void lvgl_port_reset_latency_stats(void)
+{
+    memset(&lvgl_port_ctx.latency.stats, 0, sizeof(lvgl_port_ctx.latency.stats));
+}
+
+uint32_t lvgl_port_host_get_time_ms(void)
+{
+    return lvgl_port_ctx.time_ms;
+}
+
+const lv_color_t *lvgl_port_host_get_framebuffer(lv_disp_t *disp)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    return disp_ctx->framebuffer;
+}
+
+esp_err_t lvgl_port_host_save_frame(lv_disp_t *disp, const char *path)
+{
+    assert(disp);
+    assert(path);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp->driver->user_data;
+    const uint32_t w = disp->driver->hor_res;
+    const uint32_t h = disp->driver->ver_res;
+
+    FILE *f = fopen(path, "wb");
+    ESP_RETURN_ON_FALSE(f, ESP_FAIL, TAG, "Cannot open %s!", path);
+
+    const size_t len = strlen(path);
+    esp_err_t ret;
+    if (len > 4 && !strcmp(path + len - 4, ".png")) {
+        ret = lvgl_port_write_png(f, disp_ctx->framebuffer, w, h);
+    } else {
+        ret = lvgl_port_write_ppm(f, disp_ctx->framebuffer, w, h);
+    }
+    if (fclose(f) != 0) {
+        ret = ESP_FAIL;
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "Writing %s failed!", path);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_host_knob_rotate(lv_indev_t *encoder, int32_t steps)
+{
+    return lvgl_port_host_knob_spin(encoder, steps, LVGL_PORT_HOST_KNOB_DETENT_MS);
+}
+
+esp_err_t lvgl_port_host_knob_spin(lv_indev_t *encoder, int32_t steps, uint32_t detent_ms)
+{
+    ESP_RETURN_ON_FALSE(encoder && encoder->driver->read_cb == lvgl_port_encoder_read, ESP_ERR_INVALID_ARG, TAG, "Not an encoder of the port!");
+    lvgl_port_encoder_ctx_t *encoder_ctx = (lvgl_port_encoder_ctx_t *)encoder->driver->user_data;
+
+    encoder_ctx->detents = steps;
+    encoder_ctx->detent_ms = detent_ms;
+    encoder_ctx->next_detent_ms = lvgl_port_ctx.time_ms;
+    lvgl_port_encoder_turn();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_host_button_set(lv_indev_t *encoder, bool pressed)
+{
+    ESP_RETURN_ON_FALSE(encoder && encoder->driver->read_cb == lvgl_port_encoder_read, ESP_ERR_INVALID_ARG, TAG, "Not an encoder of the port!");
+    lvgl_port_encoder_ctx_t *encoder_ctx = (lvgl_port_encoder_ctx_t *)encoder->driver->user_data;
+
+    lvgl_port_encoder_input_push(&encoder_ctx->input, pressed ? LVGL_PORT_ENCODER_PRESS : LVGL_PORT_ENCODER_RELEASE, 0, lvgl_port_ctx.time_ms * 1000);
+    lvgl_port_idle_exit(false);
+
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static int64_t lvgl_port_get_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    const int64_t now = lvgl_port_get_time_us();
+    disp_ctx->stats.render_us += now - disp_ctx->segment_start;
+    disp_ctx->stats.flushes++;
+    disp_ctx->stats.flushed_bytes += lv_area_get_size(area) * sizeof(lv_color_t);
+    if (lv_disp_flush_is_last(drv)) {
+        disp_ctx->stats.frames++;
+    }
+    /* The copy is the transfer, it ends at once */
+    lvgl_port_latency_flush(&lvgl_port_ctx.latency, lvgl_port_ctx.time_ms * 1000, lv_disp_flush_is_last(drv));
+    lvgl_port_latency_done(&lvgl_port_ctx.latency, lvgl_port_ctx.time_ms * 1000);
+
+    /* Same window as the panel, row by row */
+    const lv_coord_t w = lv_area_get_width(area);
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&disp_ctx->framebuffer[y * drv->hor_res + area->x1], color_map, w * sizeof(lv_color_t));
+        color_map += w;
+    }
+
+    lv_disp_flush_ready(drv);
+    disp_ctx->segment_start = lvgl_port_get_time_us();
+}
+
+static void lvgl_port_render_start_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+
+    /* Plan the flushed windows, LVGL renders the areas left unjoined */
+    disp_ctx->stats.merged_areas += lvgl_port_planner_merge_areas(disp_ctx->disp, LVGL_PORT_WINDOW_COST,
+                                    disp_ctx->viewport.bands, disp_ctx->viewport.band_cnt);
+
+    disp_ctx->segment_start = lvgl_port_get_time_us();
+    lvgl_port_latency_render(&lvgl_port_ctx.latency, lvgl_port_ctx.time_ms * 1000);
+}
+
+static void lvgl_port_rounder_callback(lv_disp_drv_t *drv, lv_area_t *area)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    lvgl_port_viewport_round_area(&disp_ctx->viewport, drv, area);
+}
+
+static void lvgl_port_encoder_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data)
+{
+    lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev_drv->user_data;
+    assert(ctx);
+
+    /* The events since the last read, in order: LVGL sends one key per step */
+    uint32_t event_us;
+    if (lvgl_port_encoder_input_read(&ctx->input, data, &event_us)) {
+        lvgl_port_latency_input(&lvgl_port_ctx.latency, event_us, lvgl_port_ctx.time_ms * 1000);
+    }
+}
+
+static void lvgl_port_encoder_read_timer_callback(lv_timer_t *timer)
+{
+    lv_indev_read_timer_cb(timer);
+    lvgl_port_latency_handled(&lvgl_port_ctx.latency, lvgl_port_ctx.time_ms * 1000);
+}
+
+/* Detents which have come by now, like the knob callbacks they wake up the idle LVGL task */
+static void lvgl_port_encoder_turn(void)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (indev->driver->read_cb != lvgl_port_encoder_read) {
+            continue;
+        }
+        lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev->driver->user_data;
+        bool detent = false;
+        while (ctx->detents && ((int32_t)(lvgl_port_ctx.time_ms - ctx->next_detent_ms) >= 0)) {
+            const int dir = (ctx->detents > 0) ? 1 : -1;
+            lvgl_port_encoder_input_push(&ctx->input, LVGL_PORT_ENCODER_ROTATE, dir, ctx->next_detent_ms * 1000);
+            ctx->detents -= dir;
+            ctx->next_detent_ms += ctx->detent_ms;
+            detent = true;
+        }
+        if (detent) {
+            lvgl_port_idle_exit(false);
+        }
+    }
+}
+
+/* Same governor as the LVGL task of the port, on the simulated clock */
+static uint32_t lvgl_port_timer_next_ms(void)
+{
+    uint32_t next = LV_NO_TIMER_READY;
+
+    for (lv_timer_t *timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) {
+        if (!timer->paused) {
+            const uint32_t elapsed = lv_tick_elaps(timer->last_run);
+            next = LV_MIN(next, timer->period > elapsed ? timer->period - elapsed : 0);
+        }
+    }
+
+    return next;
+}
+
+static void lvgl_port_idle_pause_input(bool pause)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (indev->driver->read_cb != lvgl_port_encoder_read) {
+            continue;
+        }
+        if (pause) {
+            lv_timer_pause(indev->driver->read_timer);
+        } else {
+            lv_timer_resume(indev->driver->read_timer);
+            lv_timer_ready(indev->driver->read_timer);
+        }
+    }
+}
+
+static bool lvgl_port_idle_input_pending(void)
+{
+    for (lv_indev_t *indev = lv_indev_get_next(NULL); indev; indev = lv_indev_get_next(indev)) {
+        if (indev->driver->read_cb != lvgl_port_encoder_read) {
+            return true;
+        }
+        const lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)indev->driver->user_data;
+        if (lvgl_port_encoder_input_pending(&ctx->input)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool lvgl_port_idle_enter(uint32_t *sleep_ms)
+{
+    if ((lvgl_port_ctx.idle_threshold_ms == 0) || lvgl_port_idle_input_pending()) {
+        return false;
+    }
+
+    lvgl_port_idle_pause_input(true);
+    const uint32_t next = lvgl_port_timer_next_ms();
+    if (next < lvgl_port_ctx.idle_threshold_ms) {
+        lvgl_port_idle_pause_input(false);
+        return false;
+    }
+
+    lvgl_port_ctx.idle.active = true;
+    lvgl_port_ctx.idle.forever = (next == LV_NO_TIMER_READY);
+    lvgl_port_ctx.idle.start_ms = lvgl_port_ctx.time_ms;
+    lvgl_port_ctx.idle.stats.entries++;
+    *sleep_ms = lvgl_port_ctx.idle.forever ? 0 : next;
+
+    return true;
+}
+
+static void lvgl_port_idle_exit(bool deadline)
+{
+    if (!lvgl_port_ctx.idle.active) {
+        return;
+    }
+
+    const uint32_t idle_ms = lvgl_port_ctx.time_ms - lvgl_port_ctx.idle.start_ms;
+    lvgl_port_idle_pause_input(false);
+    lvgl_port_ctx.idle.active = false;
+    /* The task runs lv_timer_handler() at the next tick */
+    lvgl_port_ctx.next_wakeup_ms = lvgl_port_ctx.time_ms;
+
+    lvgl_port_ctx.idle.stats.idle_us += (uint64_t)idle_ms * 1000;
+    lvgl_port_ctx.idle.stats.longest_ms = LV_MAX(lvgl_port_ctx.idle.stats.longest_ms, idle_ms);
+    if (deadline) {
+        lvgl_port_ctx.idle.stats.deadline_wakeups++;
+    } else {
+        lvgl_port_ctx.idle.stats.event_wakeups++;
+    }
+}
+
+static void lvgl_port_count_wakeup(void)
+{
+    const uint32_t now = lvgl_port_ctx.time_ms;
+
+    lvgl_port_ctx.wakeups.count++;
+    if (now - lvgl_port_ctx.wakeups.window_start >= 1000) {
+        lvgl_port_ctx.wakeups.per_sec = lvgl_port_ctx.wakeups.count * 1000 / (now - lvgl_port_ctx.wakeups.window_start);
+        lvgl_port_ctx.wakeups.count = 0;
+        lvgl_port_ctx.wakeups.window_start = now;
+    }
+}
+
+static void lvgl_port_to_rgb888(const lv_color_t *px, uint32_t cnt, uint8_t *rgb)
+{
+    for (uint32_t i = 0; i < cnt; i++) {
+        const uint32_t c = lv_color_to32(px[i]);
+        rgb[i * 3 + 0] = (c >> 16) & 0xFF;
+        rgb[i * 3 + 1] = (c >> 8) & 0xFF;
+        rgb[i * 3 + 2] = c & 0xFF;
+    }
+}
+
+static esp_err_t lvgl_port_write_ppm(FILE *f, const lv_color_t *fb, uint32_t w, uint32_t h)
+{
+    uint8_t *row = malloc(w * 3);
+    ESP_RETURN_ON_FALSE(row, ESP_ERR_NO_MEM, TAG, "Not enough memory for row allocation!");
+
+    esp_err_t ret = fprintf(f, "P6\n%u %u\n255\n", w, h) > 0 ? ESP_OK : ESP_FAIL;
+    for (uint32_t y = 0; y < h && ret == ESP_OK; y++) {
+        lvgl_port_to_rgb888(&fb[y * w], w, row);
+        if (fwrite(row, 3, w, f) != w) {
+            ret = ESP_FAIL;
+        }
+    }
+    free(row);
+
+    return ret;
+}
+
+/* PNG without a compression library: zlib stream of stored deflate blocks */
+static uint32_t lvgl_port_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void lvgl_port_put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static esp_err_t lvgl_port_write_png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t head[8];
+    uint8_t tail[4];
+    lvgl_port_put_be32(head, len);
+    memcpy(&head[4], type, 4);
+    lvgl_port_put_be32(tail, lvgl_port_crc32(lvgl_port_crc32(0, &head[4], 4), data, len));
+
+    if (fwrite(head, 1, sizeof(head), f) != sizeof(head) || (len && fwrite(data, 1, len, f) != len) ||
+            fwrite(tail, 1, sizeof(tail), f) != sizeof(tail)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t lvgl_port_write_png(FILE *f, const lv_color_t *fb, uint32_t w, uint32_t h)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const uint32_t stride = 1 + w * 3;  /* Filter type 0 before every row */
+    const uint32_t raw_len = stride * h;
+    const uint32_t block_max = 0xFFFF;
+    const uint32_t block_cnt = (raw_len + block_max - 1) / block_max;
+    const uint32_t zlib_len = 2 + block_cnt * 5 + raw_len + 4;
+    esp_err_t ret = ESP_OK;
+
+    uint8_t *raw = malloc(raw_len);
+    uint8_t *zlib = malloc(zlib_len);
+    ESP_GOTO_ON_FALSE(raw && zlib, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for PNG allocation!");
+
+    for (uint32_t y = 0; y < h; y++) {
+        raw[y * stride] = 0;
+        lvgl_port_to_rgb888(&fb[y * w], w, &raw[y * stride + 1]);
+    }
+
+    uint8_t *p = zlib;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    uint32_t adler_a = 1;
+    uint32_t adler_b = 0;
+    for (uint32_t pos = 0; pos < raw_len; pos += block_max) {
+        const uint32_t len = LV_MIN(block_max, raw_len - pos);
+        *p++ = (pos + len == raw_len);  /* BFINAL, BTYPE 00 */
+        *p++ = len & 0xFF;
+        *p++ = len >> 8;
+        *p++ = ~len & 0xFF;
+        *p++ = (~len >> 8) & 0xFF;
+        memcpy(p, &raw[pos], len);
+        p += len;
+        for (uint32_t i = pos; i < pos + len; i++) {
+            adler_a = (adler_a + raw[i]) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+    }
+    lvgl_port_put_be32(p, (adler_b << 16) | adler_a);
+
+    uint8_t ihdr[13];
+    lvgl_port_put_be32(&ihdr[0], w);
+    lvgl_port_put_be32(&ihdr[4], h);
+    ihdr[8] = 8;    /* Bit depth */
+    ihdr[9] = 2;    /* RGB */
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+
+    ESP_GOTO_ON_FALSE(fwrite(signature, 1, sizeof(signature), f) == sizeof(signature), ESP_FAIL, err, TAG, "write failed");
+    ESP_GOTO_ON_ERROR(lvgl_port_write_png_chunk(f, "IHDR", ihdr, sizeof(ihdr)), err, TAG, "write failed");
+    ESP_GOTO_ON_ERROR(lvgl_port_write_png_chunk(f, "IDAT", zlib, zlib_len), err, TAG, "write failed");
+    ESP_GOTO_ON_ERROR(lvgl_port_write_png_chunk(f, "IEND", NULL, 0), err, TAG, "write failed");
+
+err:
+    free(raw);
+    free(zlib);
+    return ret;
+}
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Headless Linux backend of esp_lvgl_port
+ *
+ * Implements esp_lvgl_port.h on the host. The display is a RGB565 framebuffer in memory,
+ * the encoder is driven by the caller instead of iot_knob/iot_button. There is no LVGL task,
+ * LVGL runs in the calling thread on a simulated clock (lvgl_port_host_run()), so runs are
+ * repeatable under perf and valgrind.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_lvgl_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run LVGL for a duration of simulated time
+ *
+ * Ticks LVGL by `timer_period_ms` of lvgl_port_init(). lv_timer_handler() is called when the LVGL
+ * task of the port would wake up: after the delay returned by the previous call, limited to
+ * `task_max_sleep_ms` like on the board, and rounded up to the next tick.
+ *
+ * @param ms Simulated time
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if lvgl_port_init() was not called
+ */
+esp_err_t lvgl_port_host_run(uint32_t ms);
+
+/**
+ * @brief Get the simulated time since lvgl_port_init()
+ *
+ * @return Time in ms
+ */
+uint32_t lvgl_port_host_get_time_ms(void);
+
+/**
+ * @brief Get the framebuffer of a display, what the panel would show
+ *
+ * @param disp LVGL display handle (returned from lvgl_port_add_disp)
+ * @return hres * vres pixels, row by row, in the colour format of LVGL
+ */
+const lv_color_t *lvgl_port_host_get_framebuffer(lv_disp_t *disp);
+
+/**
+ * @brief Save the framebuffer of a display to an image file
+ *
+ * @param disp LVGL display handle (returned from lvgl_port_add_disp)
+ * @param path PNG if the path ends with ".png", binary PPM otherwise
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_FAIL                  if the file could not be written
+ */
+esp_err_t lvgl_port_host_save_frame(lv_disp_t *disp, const char *path);
+
+/* Time between the detents of lvgl_port_host_knob_rotate(), a slow turn by hand */
+#define LVGL_PORT_HOST_KNOB_DETENT_MS   (100)
+
+/**
+ * @brief Turn the knob of an encoder at a slow pace
+ *
+ * Same as lvgl_port_host_knob_spin() with detents LVGL_PORT_HOST_KNOB_DETENT_MS apart.
+ *
+ * @param encoder Encoder handle (returned from lvgl_port_add_encoder)
+ * @param steps   Detents to the right if positive, to the left if negative
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if encoder is not an encoder of the port
+ */
+esp_err_t lvgl_port_host_knob_rotate(lv_indev_t *encoder, int32_t steps);
+
+/**
+ * @brief Turn the knob of an encoder, one detent every `detent_ms` of simulated time
+ *
+ * The first detent comes at once, the next ones while lvgl_port_host_run() runs. They go through
+ * the acceleration of the encoder (`accel` of lvgl_port_encoder_cfg_t) like the knob callbacks of
+ * the board, LVGL reads the steps added since its last read. A new turn replaces the detents of
+ * the previous one which did not come yet.
+ *
+ * @param encoder   Encoder handle (returned from lvgl_port_add_encoder)
+ * @param steps     Detents to the right if positive, to the left if negative
+ * @param detent_ms Time between two detents, 0 for all of them at once
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if encoder is not an encoder of the port
+ */
+esp_err_t lvgl_port_host_knob_spin(lv_indev_t *encoder, int32_t steps, uint32_t detent_ms);
+
+/**
+ * @brief Press or release the button of an encoder
+ *
+ * The change is queued with the detents, at the simulated time, like the button callbacks of the
+ * board: a press and release without lvgl_port_host_run() in between still make a click.
+ *
+ * @param encoder Encoder handle (returned from lvgl_port_add_encoder)
+ * @param pressed New state of the button
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if encoder is not an encoder of the port
+ */
+esp_err_t lvgl_port_host_button_set(lv_indev_t *encoder, bool pressed);
+
+#ifdef __cplusplus
+}
+#endif
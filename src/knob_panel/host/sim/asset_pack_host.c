@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "lv_asset_pack.h"
+#include "asset_pack_host.h"
+
+static const char *TAG = "ASSET_PACK";
+
+esp_err_t asset_pack_host_mount(const char *path)
+{
+    if (path == NULL) {
+        path = ASSET_PACK_PATH;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    ESP_RETURN_ON_FALSE(fd >= 0, ESP_ERR_NOT_FOUND, TAG, "cannot open %s", path);
+    struct stat st;
+    void *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    ESP_RETURN_ON_FALSE(base != MAP_FAILED, ESP_ERR_NOT_FOUND, TAG, "cannot map %s", path);
+
+    return lv_asset_pack_load(base, st.st_size);
+}
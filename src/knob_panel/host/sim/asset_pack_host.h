@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Asset pack of the host build
+ *
+ * Maps the pack built by the host CMake project (`assets.bin` in the build directory)
+ * from a file, where the firmware maps the assets partition.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Map an asset pack file and load it with lv_asset_pack_load()
+ *
+ * The file stays mapped until the process exits.
+ *
+ * @param path Pack to map, NULL for the one of the host build
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_NOT_FOUND     if the file cannot be opened or mapped
+ *      - the errors of lv_asset_pack_load()
+ */
+esp_err_t asset_pack_host_mount(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
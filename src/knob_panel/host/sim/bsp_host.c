@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Display part of the ESP32-C3-LCDkit BSP on the headless port backend.
+ * Same configuration as esp32_c3_lcdkit.c: draw buffers, circular viewport and knob encoder.
+ */
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "bsp/esp-bsp.h"
+#include "esp_lvgl_port.h"
+
+static const char *TAG = "ESP32-C3-LCDKit";
+
+static lv_indev_t *disp_indev = NULL;
+
+static const button_config_t bsp_encoder_btn_config = {
+    .type = BUTTON_TYPE_GPIO,
+};
+
+static const knob_config_t bsp_encoder_a_b_config = {
+    .default_direction = 0,
+};
+
+lv_disp_t *bsp_display_start(void)
+{
+    lvgl_port_cfg_t lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    lvgl_port_cfg.idle_threshold_ms = CONFIG_BSP_DISPLAY_IDLE_THRESHOLD_MS;
+    if (lvgl_port_init(&lvgl_port_cfg) != ESP_OK) {
+        ESP_LOGE(TAG, "LVGL port init failed");
+        return NULL;
+    }
+
+    const lvgl_port_display_cfg_t disp_cfg = {
+        .buffer_size = BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT,
+#if CONFIG_BSP_LCD_DRAW_BUF_DOUBLE
+        .double_buffer = true,
+#endif
+        .hres = BSP_LCD_H_RES,
+        .vres = BSP_LCD_V_RES,
+        .monochrome = false,
+        .flags = {
+#if CONFIG_BSP_LCD_CIRCULAR_VIEWPORT
+            .circular_viewport = true,
+#endif
+        }
+    };
+    lv_disp_t *disp = lvgl_port_add_disp(&disp_cfg);
+    if (disp == NULL) {
+        return NULL;
+    }
+
+    const lvgl_port_encoder_cfg_t encoder = {
+        .disp = disp,
+        .encoder_a_b = &bsp_encoder_a_b_config,
+        .encoder_enter = &bsp_encoder_btn_config,
+        .accel = {
+            .slow_ms = CONFIG_BSP_KNOB_ACCEL_SLOW_MS,
+            .fast_ms = CONFIG_BSP_KNOB_ACCEL_FAST_MS,
+            .max_gain = CONFIG_BSP_KNOB_ACCEL_MAX_GAIN,
+        },
+    };
+    disp_indev = lvgl_port_add_encoder(&encoder);
+    if (disp_indev == NULL) {
+        return NULL;
+    }
+
+    return disp;
+}
+
+lv_indev_t *bsp_display_get_input_dev(void)
+{
+    return disp_indev;
+}
+
+bool bsp_display_lock(uint32_t timeout_ms)
+{
+    return lvgl_port_lock(timeout_ms);
+}
+
+void bsp_display_unlock(void)
+{
+    lvgl_port_unlock();
+}
+
+void bsp_display_wake(void)
+{
+    lvgl_port_wake();
+}
+
+esp_err_t bsp_display_backlight_on(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_backlight_off(void)
+{
+    return ESP_OK;
+}
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Knob panel simulator.
+ *
+ * Starts the application UI like app_main() on the headless port backend and plays a script
+ * of knob turns and button presses on a simulated clock. Frames are saved as PNG or PPM.
+ *
+ * Script, one command per line, `#` starts a comment:
+ *   wait <ms>          run LVGL for <ms> of simulated time
+ *   right <n> [<ms>]   turn the knob <n> detents to the right, <ms> apart (100 by default)
+ *   left <n> [<ms>]    turn the knob <n> detents to the left, <ms> apart
+ *   press / release    press or release the knob button
+ *   click              press, wait 100 ms, release, wait 100 ms
+ *   dump <file>        save the display, PNG if <file> ends with .png, PPM otherwise
+ *   stats              print the flush statistics since the previous `stats`
+ *
+ * The images are mapped from the asset pack of the host build, or from --assets.
+ *
+ * Usage: knob_panel_sim [--script FILE|-] [--out DIR] [--assets FILE]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "bsp/esp-bsp.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_host.h"
+#include "lv_example_pub.h"
+#include "lv_img_rle.h"
+#include "lv_img_transform.h"
+#include "lv_layer_transition.h"
+#include "asset_pack_host.h"
+
+#define CLICK_HOLD_MS       (100)
+
+/* Without a script: the boot animation until the home screen */
+static const char *s_default_script =
+    "wait 3000\n"
+    "dump frame.png\n"
+    "stats\n";
+
+static void print_stats(lv_disp_t *disp)
+{
+    lvgl_port_flush_stats_t stats;
+    lvgl_port_get_flush_stats(disp, &stats);
+    const uint32_t frames = stats.frames ? stats.frames : 1;
+    printf("%6u ms: %u frames, %.1f flushes/frame, %llu bytes/frame, %llu us render/frame, %u merged\n",
+           lvgl_port_host_get_time_ms(), stats.frames, (double)stats.flushes / frames,
+           (unsigned long long)stats.flushed_bytes / frames, (unsigned long long)stats.render_us / frames,
+           stats.merged_areas);
+    lvgl_port_reset_flush_stats(disp);
+}
+
+static esp_err_t run_command(lv_disp_t *disp, lv_indev_t *knob, const char *out_dir, const char *cmd, const char *arg, const char *arg2)
+{
+    const uint32_t detent_ms = arg2 ? strtoul(arg2, NULL, 0) : LVGL_PORT_HOST_KNOB_DETENT_MS;
+
+    if (!strcmp(cmd, "wait") && arg) {
+        return lvgl_port_host_run(strtoul(arg, NULL, 0));
+    } else if (!strcmp(cmd, "right") && arg) {
+        return lvgl_port_host_knob_spin(knob, strtol(arg, NULL, 0), detent_ms);
+    } else if (!strcmp(cmd, "left") && arg) {
+        return lvgl_port_host_knob_spin(knob, -strtol(arg, NULL, 0), detent_ms);
+    } else if (!strcmp(cmd, "press")) {
+        return lvgl_port_host_button_set(knob, true);
+    } else if (!strcmp(cmd, "release")) {
+        return lvgl_port_host_button_set(knob, false);
+    } else if (!strcmp(cmd, "click")) {
+        lvgl_port_host_button_set(knob, true);
+        lvgl_port_host_run(CLICK_HOLD_MS);
+        lvgl_port_host_button_set(knob, false);
+        return lvgl_port_host_run(CLICK_HOLD_MS);
+    } else if (!strcmp(cmd, "dump") && arg) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", out_dir, arg);
+        return lvgl_port_host_save_frame(disp, path);
+    } else if (!strcmp(cmd, "stats")) {
+        print_stats(disp);
+        return ESP_OK;
+    }
+    return ESP_ERR_INVALID_ARG;
+}
+
+static int run_script(lv_disp_t *disp, lv_indev_t *knob, const char *out_dir, FILE *script, const char *name)
+{
+    char line[256];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), script)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        const char *cmd = strtok(line, " \t\r\n");
+        if (cmd == NULL) {
+            continue;
+        }
+        const char *arg = strtok(NULL, " \t\r\n");
+        const char *arg2 = arg ? strtok(NULL, " \t\r\n") : NULL;
+        if (run_command(disp, knob, out_dir, cmd, arg, arg2) != ESP_OK) {
+            fprintf(stderr, "%s:%d: %s failed\n", name, line_no, cmd);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *script_path = NULL;
+    const char *out_dir = ".";
+    const char *assets = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--script") && i + 1 < argc) {
+            script_path = argv[++i];
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (!strcmp(argv[i], "--assets") && i + 1 < argc) {
+            assets = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--script FILE|-] [--out DIR] [--assets FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    /* Same start as app_main() */
+    lv_disp_t *disp = bsp_display_start();
+    if (disp == NULL) {
+        return 1;
+    }
+    if (asset_pack_host_mount(assets) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+    lv_img_transform_init(disp);
+    lv_layer_transition_init(disp);
+    ui_obj_to_encoder_init();
+    lv_create_home(&boot_Layer);
+    lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
+    bsp_display_unlock();
+    bsp_display_wake();
+    bsp_display_backlight_on();
+
+    FILE *script;
+    const char *name = script_path ? script_path : "default script";
+    if (script_path == NULL) {
+        script = fmemopen((void *)s_default_script, strlen(s_default_script), "r");
+    } else if (!strcmp(script_path, "-")) {
+        script = stdin;
+    } else {
+        script = fopen(script_path, "r");
+    }
+    if (script == NULL) {
+        fprintf(stderr, "cannot open %s\n", name);
+        return 1;
+    }
+
+    const int ret = run_script(disp, bsp_display_get_input_dev(), out_dir, script, name);
+    if (script != stdin) {
+        fclose(script);
+    }
+
+    return ret;
+}
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/* Host stand-in for the ESP32-C3-LCDkit BSP, only what the screens and the simulator use */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BSP_LCD_H_RES              (240)
+#define BSP_LCD_V_RES              (240)
+
+esp_err_t bsp_led_rgb_set(uint8_t r, uint8_t g, uint8_t b);
+
+/* Display and knob on the headless port backend, see sim/bsp_host.c */
+lv_disp_t *bsp_display_start(void);
+lv_indev_t *bsp_display_get_input_dev(void);
+bool bsp_display_lock(uint32_t timeout_ms);
+void bsp_display_unlock(void);
+void bsp_display_wake(void);
+esp_err_t bsp_display_backlight_on(void);
+esp_err_t bsp_display_backlight_off(void);
+
+#ifdef __cplusplus
+}
+#endif
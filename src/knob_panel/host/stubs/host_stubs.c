@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Host implementations of the ESP-IDF, FreeRTOS and application functions used by the screens.
+ * Tasks are never started and queues/semaphores never block, the host runs LVGL in one thread.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "bsp/esp-bsp.h"
+#include "app_audio.h"
+#include "settings.h"
+#include "ir_nec_test.h"
+
+struct host_queue {
+    uint8_t *items;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+static esp_log_level_t s_log_level = ESP_LOG_WARN;
+static sys_param_t s_sys_param = {
+    .magic = 0,
+    .need_hint = false,
+    .language = LANGUAGE_EN,
+};
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    default:
+        return "ESP_FAIL";
+    }
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    s_log_level = level;
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    static const char letters[] = "-EWIDV";
+    if (level > s_log_level) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c (%s) ", letters[level], tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+void esp_restart(void)
+{
+    fprintf(stderr, "esp_restart() called\n");
+    exit(1);
+}
+
+/* The host heap is not the limit, the UI buffers are bounded by their own budgets */
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return SIZE_MAX / 2;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return SIZE_MAX / 2;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/*******************************************************************************
+* FreeRTOS
+*******************************************************************************/
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char *name, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *handle)
+{
+    (void)task;
+    (void)stack;
+    (void)arg;
+    (void)prio;
+    ESP_LOGD("host", "task %s is not started on the host", name);
+    if (handle) {
+        *handle = NULL;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct host_queue *queue = calloc(1, sizeof(struct host_queue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->items = calloc(length, item_size ? item_size : 1);
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    if (queue) {
+        free(queue->items);
+        free(queue);
+    }
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    (void)ticks;
+    if (queue->count == queue->length) {
+        return errQUEUE_FULL;
+    }
+    if (queue->item_size) {
+        const UBaseType_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->items + tail * queue->item_size, item, queue->item_size);
+    }
+    queue->count++;
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    (void)ticks;
+    if (queue->count == 0) {
+        return pdFALSE;
+    }
+    if (queue->item_size) {
+        memcpy(item, queue->items + queue->head * queue->item_size, queue->item_size);
+    }
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdPASS;
+}
+
+/*******************************************************************************
+* Board and application
+*******************************************************************************/
+
+esp_err_t bsp_led_rgb_set(uint8_t r, uint8_t g, uint8_t b)
+{
+    (void)r;
+    (void)g;
+    (void)b;
+    return ESP_OK;
+}
+
+esp_err_t audio_force_quite(bool ret)
+{
+    (void)ret;
+    return ESP_OK;
+}
+
+esp_err_t audio_handle_info(PDM_SOUND_TYPE voice)
+{
+    (void)voice;
+    return ESP_OK;
+}
+
+esp_err_t audio_play_start()
+{
+    return ESP_OK;
+}
+
+esp_err_t settings_read_parameter_from_nvs(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t settings_write_parameter_to_nvs(void)
+{
+    return ESP_OK;
+}
+
+sys_param_t *settings_get_parameter(void)
+{
+    return &s_sys_param;
+}
+
+esp_err_t nec_test_start()
+{
+    return ESP_OK;
+}
+
+bool nec_test_result()
+{
+    return true;
+}
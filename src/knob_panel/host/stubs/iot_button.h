@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/* Host stand-in for the button component, the host input is scripted (esp_lvgl_port_host.h) */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *button_handle_t;
+
+typedef enum {
+    BUTTON_TYPE_GPIO,
+    BUTTON_TYPE_ADC,
+    BUTTON_TYPE_MATRIX,
+    BUTTON_TYPE_CUSTOM,
+} button_type_t;
+
+typedef struct {
+    int32_t gpio_num;
+    uint8_t active_level;
+} button_gpio_config_t;
+
+typedef struct {
+    button_type_t type;
+    uint16_t long_press_time;
+    uint16_t short_press_time;
+    button_gpio_config_t gpio_button_config;
+} button_config_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/* Host stand-in for the knob component, the host input is scripted (esp_lvgl_port_host.h) */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *knob_handle_t;
+
+typedef enum {
+    KNOB_LEFT = 0,
+    KNOB_RIGHT,
+    KNOB_H_LIM,
+    KNOB_L_LIM,
+    KNOB_ZERO,
+    KNOB_EVENT_MAX,
+    KNOB_NONE,
+} knob_event_t;
+
+typedef struct {
+    uint8_t default_direction;
+    uint8_t gpio_encoder_a;
+    uint8_t gpio_encoder_b;
+} knob_config_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Asset pack test.
+ *
+ * Draws every image of the reference pack (RGB565A8 as img_rgb565a8.py leaves it, one
+ * copy of the data per image) and the same image of the pack of the build (RLE with
+ * shared rows, images with the same data sharing it), over an opaque background, and
+ * fails if a single pixel differs.
+ *
+ * Usage: test_asset_pack
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_rle.h"
+#include "asset_pack_host.h"
+
+#define DISP_W              (240)
+#define DISP_H              (240)
+#define DISP_PX             (DISP_W * DISP_H)
+#define MAX_IMAGES          (128)
+
+typedef struct {
+    const char *name;
+    uint16_t w;
+    uint16_t h;
+    uint32_t hash;
+} render_t;
+
+static lv_color_t s_dest[DISP_PX];
+static render_t s_plain[MAX_IMAGES];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lv_disp_flush_ready(drv);
+}
+
+/* FNV-1a of the screen after drawing the image at the top left corner */
+static uint32_t render(lv_draw_ctx_t *draw_ctx, const lv_img_dsc_t *img)
+{
+    const lv_area_t area = {0, 0, img->header.w - 1, img->header.h - 1};
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    /* Only used by the A8 masks */
+    img_dsc.recolor = lv_color_make(0xFF, 0xD1, 0x71);
+    img_dsc.recolor_opa = LV_OPA_COVER;
+
+    for (uint32_t i = 0; i < DISP_PX; i++) {
+        s_dest[i] = lv_color_make(0x20, 0x40, 0x60);
+    }
+    lv_draw_img(draw_ctx, &img_dsc, &area, img);
+
+    uint32_t hash = 0x811c9dc5;
+    const uint8_t *px = (const uint8_t *)s_dest;
+    for (size_t i = 0; i < sizeof(s_dest); i++) {
+        hash = (hash ^ px[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+int main(void)
+{
+    lv_init();
+    lv_img_rle_init();
+
+    /* The draw context of a display renders into the whole screen */
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, s_dest, NULL, DISP_PX);
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = DISP_W;
+    disp_drv.ver_res = DISP_H;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+    static const lv_area_t screen = {0, 0, DISP_W - 1, DISP_H - 1};
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+    draw_ctx->buf = s_dest;
+    draw_ctx->buf_area = (lv_area_t *)&screen;
+    draw_ctx->clip_area = &screen;
+    _lv_refr_set_disp_refreshing(disp);
+
+    /* The mappings stay, the names of the reference pack remain valid */
+    if (asset_pack_host_mount(ASSET_PACK_PLAIN_PATH) != ESP_OK) {
+        return 1;
+    }
+    size_t count = 0;
+    for (const char *name; (name = lv_asset_name(count)) != NULL; count++) {
+        if (count == MAX_IMAGES) {
+            printf("FAIL more than %d images\n", MAX_IMAGES);
+            return 1;
+        }
+        const lv_img_dsc_t *img = lv_asset_img(name);
+        s_plain[count] = (render_t) {
+            name, img->header.w, img->header.h, render(draw_ctx, img)
+        };
+    }
+
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    int failures = 0;
+    size_t shared = 0;
+    for (size_t i = 0; i < count; i++) {
+        const render_t *plain = &s_plain[i];
+        const lv_img_dsc_t *img = lv_asset_img(plain->name);
+        if (img == NULL || img->header.w != plain->w || img->header.h != plain->h) {
+            printf("FAIL %s: missing or not %u x %u\n", plain->name, plain->w, plain->h);
+            failures++;
+            continue;
+        }
+        if (render(draw_ctx, img) != plain->hash) {
+            printf("FAIL %s: rendered differently\n", plain->name);
+            failures++;
+        }
+        for (size_t j = 0; j < i; j++) {
+            const lv_img_dsc_t *other = lv_asset_img(s_plain[j].name);
+            if (other && other->data == img->data) {
+                shared++;
+                break;
+            }
+        }
+    }
+    if (lv_asset_name(count) != NULL) {
+        printf("FAIL the pack has more images than the reference\n");
+        failures++;
+    }
+
+    printf("%zu images, %zu sharing the data of another, %d failures\n", count, shared, failures);
+    return failures ? 1 : 0;
+}
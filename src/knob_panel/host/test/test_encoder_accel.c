@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Encoder acceleration test.
+ *
+ * Feeds spins of the knob to the steps of the encoder of esp_lvgl_port
+ * (components/espressif__esp_lvgl_port/esp_lvgl_port_encoder.c) with the acceleration of
+ * the BSP, and reads the steps every 30 ms like LVGL. The spins stand for recorded ones: the
+ * detent times of a slow turn, of a flick which speeds up and slows down, and of a turn back.
+ *
+ * A slow turn moves by one step per detent and every detent by one step at least. A flick moves
+ * by three steps per detent or more, the 12 steps of the thermostat range (19 to 30 degrees) take
+ * a flick of 8 detents. The steps read add up to the steps of the detents.
+ *
+ * Usage: test_encoder_accel
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "esp_lvgl_port_encoder.h"
+#include "test_util.h"
+
+#define READ_PERIOD_US      (CONFIG_LV_INDEV_DEF_READ_PERIOD * 1000)
+
+static const lvgl_port_encoder_accel_cfg_t s_accel = {
+    .slow_ms = CONFIG_BSP_KNOB_ACCEL_SLOW_MS,
+    .fast_ms = CONFIG_BSP_KNOB_ACCEL_FAST_MS,
+    .max_gain = CONFIG_BSP_KNOB_ACCEL_MAX_GAIN,
+};
+
+/* Milliseconds between the detents of a spin, negative for a detent to the left */
+static const int s_slow[] = { 250, 180, 200, 150, 220, 170, 160, 300, 200, 190 };
+static const int s_flick[] = {
+    40, 22, 14, 9, 7, 5, 4, 4, 3, 3, 3, 4, 4, 5, 6, 8, 11, 16, 25, 40,
+};
+static const int s_short[] = { 200, 30, 20, 15, 15, 15, 20, 30 };
+static const int s_back[] = { 30, 20, 12, 8, 6, -300, -90, -80, -70 };
+
+/**
+ * @brief Play a spin, reading the steps every READ_PERIOD_US
+ *
+ * @return Steps read, `reads` is set to the number of reads which got steps and `min_gain` to
+ *         the lowest gain of a detent
+ */
+static int32_t spin_run(lvgl_port_encoder_accel_t *acc, const int *detents, int cnt, uint32_t *time_us, int *reads, uint16_t *min_gain)
+{
+    int32_t total = 0;
+    uint32_t next_read = *time_us + READ_PERIOD_US;
+
+    *reads = 0;
+    *min_gain = UINT16_MAX;
+    for (int i = 0; i < cnt; i++) {
+        const uint32_t at = *time_us + abs(detents[i]) * 1000;
+        for (; (int32_t)(next_read - at) <= 0; next_read += READ_PERIOD_US) {
+            const int32_t steps = lvgl_port_encoder_accel_take(acc);
+            *reads += (steps != 0);
+            total += steps;
+        }
+        *time_us = at;
+        const int32_t before = acc->steps;
+        lvgl_port_encoder_accel_detent(acc, detents[i] > 0 ? 1 : -1, at);
+        CHECK(abs(acc->steps - before) >= 1);
+        *min_gain = acc->gain < *min_gain ? acc->gain : *min_gain;
+    }
+    const int32_t steps = lvgl_port_encoder_accel_take(acc);
+    *reads += (steps != 0);
+    total += steps;
+    *time_us += 1000 * 1000;
+    return total;
+}
+
+static void test_spins(void)
+{
+    lvgl_port_encoder_accel_t acc;
+    uint32_t time_us = 12345;
+    int reads;
+    uint16_t min_gain;
+
+    lvgl_port_encoder_accel_init(&acc, &s_accel);
+
+    /* One step per detent, one read per detent */
+    int32_t steps = spin_run(&acc, s_slow, sizeof(s_slow) / sizeof(s_slow[0]), &time_us, &reads, &min_gain);
+    printf("slow   %3d detents: %4d steps in %2d reads\n", (int)(sizeof(s_slow) / sizeof(s_slow[0])), (int)steps, reads);
+    CHECK(steps == sizeof(s_slow) / sizeof(s_slow[0]));
+    CHECK(reads == sizeof(s_slow) / sizeof(s_slow[0]));
+
+    /* Three steps per detent or more, in a few reads */
+    steps = spin_run(&acc, s_flick, sizeof(s_flick) / sizeof(s_flick[0]), &time_us, &reads, &min_gain);
+    printf("flick  %3d detents: %4d steps in %2d reads\n", (int)(sizeof(s_flick) / sizeof(s_flick[0])), (int)steps, reads);
+    CHECK(steps >= 3 * (int32_t)(sizeof(s_flick) / sizeof(s_flick[0])));
+    CHECK(steps <= (int32_t)(sizeof(s_flick) / sizeof(s_flick[0])) * s_accel.max_gain);
+    CHECK(reads <= 8);
+    CHECK(min_gain == LVGL_PORT_ENCODER_GAIN_ONE);
+
+    /* The whole thermostat range in a short flick */
+    steps = spin_run(&acc, s_short, sizeof(s_short) / sizeof(s_short[0]), &time_us, &reads, &min_gain);
+    printf("short  %3d detents: %4d steps in %2d reads\n", (int)(sizeof(s_short) / sizeof(s_short[0])), (int)steps, reads);
+    CHECK(steps >= 12);
+
+    /* Back the other way: the new turn starts at one step, nothing carried over */
+    steps = spin_run(&acc, s_back, sizeof(s_back) / sizeof(s_back[0]), &time_us, &reads, &min_gain);
+    printf("back   %3d detents: %4d steps in %2d reads\n", (int)(sizeof(s_back) / sizeof(s_back[0])), (int)steps, reads);
+    CHECK(acc.dir == -1 && acc.frac == 0);
+    CHECK(acc.gain == LVGL_PORT_ENCODER_GAIN_ONE);
+    CHECK(steps >= 5 - 4 && steps <= 5 * s_accel.max_gain - 4);
+}
+
+/* The steps follow the speed: more per detent the faster, never less than one */
+static void test_curve(void)
+{
+    lvgl_port_encoder_accel_t acc;
+    int32_t last = 0;
+
+    for (int ms = s_accel.slow_ms + 20; ms >= 1; ms -= 1) {
+        lvgl_port_encoder_accel_init(&acc, &s_accel);
+        uint32_t t = 0;
+        for (int i = 0; i < 64; i++) {
+            lvgl_port_encoder_accel_detent(&acc, 1, t);
+            t += ms * 1000;
+        }
+        const int32_t steps = lvgl_port_encoder_accel_take(&acc);
+        CHECK(steps >= last);
+        if (ms >= s_accel.slow_ms) {
+            CHECK(steps == 64);
+        }
+        if (ms <= s_accel.fast_ms) {
+            CHECK(steps >= 60 * s_accel.max_gain);
+        }
+        last = steps;
+    }
+
+    /* Without acceleration */
+    lvgl_port_encoder_accel_init(&acc, NULL);
+    for (int i = 0; i < 50; i++) {
+        lvgl_port_encoder_accel_detent(&acc, i < 30 ? 1 : -1, i * 1000);
+    }
+    CHECK(lvgl_port_encoder_accel_take(&acc) == 10);
+    CHECK(lvgl_port_encoder_accel_take(&acc) == 0);
+}
+
+int main(void)
+{
+    test_spins();
+    test_curve();
+
+    return test_result();
+}
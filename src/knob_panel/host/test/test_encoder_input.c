@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Encoder input event test.
+ *
+ * Feeds knob and button events to the input of the encoder of esp_lvgl_port
+ * (components/espressif__esp_lvgl_port/esp_lvgl_port_encoder.c) and reads them like LVGL
+ * does, again at once as long as `continue_reading` is set. The detents are read as steps
+ * without acceleration.
+ *
+ * A press and release between two reads must make a press and a release, the detents before and
+ * after a button change must come on their side of it, the detents of a ring overflowing must
+ * all come, and a thread pushing events while another reads them must not lose any.
+ *
+ * Usage: test_encoder_input
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "esp_lvgl_port_encoder.h"
+#include "test_util.h"
+
+#define READS_MAX           (16)
+#define THREAD_TURNS        (2000)
+
+typedef struct {
+    int32_t enc_diff;
+    bool pressed;
+} read_t;
+
+static lvgl_port_encoder_input_t s_in;
+
+/**
+ * @brief One read timer of LVGL: reads until `continue_reading` is not set
+ *
+ * @return Number of reads, filled in `reads`
+ */
+static int indev_read(read_t *reads, int max)
+{
+    lv_indev_data_t data;
+    int cnt = 0;
+
+    do {
+        memset(&data, 0, sizeof(data));
+        lvgl_port_encoder_input_read(&s_in, &data, NULL);
+        if (cnt < max) {
+            reads[cnt].enc_diff = data.enc_diff;
+            reads[cnt].pressed = (LV_INDEV_STATE_PRESSED == data.state);
+        }
+        cnt++;
+    } while (data.continue_reading);
+
+    return cnt;
+}
+
+/* A click between two reads of LVGL */
+static void test_click(void)
+{
+    read_t reads[READS_MAX];
+
+    lvgl_port_encoder_input_init(&s_in, NULL);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, 1000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_RELEASE, 0, 2000);
+    CHECK(lvgl_port_encoder_input_pending(&s_in));
+
+    const int cnt = indev_read(reads, READS_MAX);
+    CHECK(cnt == 2);
+    CHECK(reads[0].pressed && !reads[1].pressed);
+    CHECK(reads[0].enc_diff == 0 && reads[1].enc_diff == 0);
+    CHECK(!lvgl_port_encoder_input_pending(&s_in));
+
+    /* Held: pending until released */
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, 3000);
+    CHECK(indev_read(reads, READS_MAX) == 1 && reads[0].pressed);
+    CHECK(lvgl_port_encoder_input_pending(&s_in));
+    CHECK(indev_read(reads, READS_MAX) == 1 && reads[0].pressed);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_RELEASE, 0, 4000);
+    CHECK(indev_read(reads, READS_MAX) == 1 && !reads[0].pressed);
+    CHECK(!lvgl_port_encoder_input_pending(&s_in));
+}
+
+/* Detents on their side of the button changes */
+static void test_order(void)
+{
+    read_t reads[READS_MAX];
+    uint32_t t = 0;
+
+    lvgl_port_encoder_input_init(&s_in, NULL);
+    for (int i = 0; i < 3; i++) {
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, t += 5000);
+    }
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, t += 5000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, -1, t += 5000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, -1, t += 5000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_RELEASE, 0, t += 5000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, t += 5000);
+
+    const int cnt = indev_read(reads, READS_MAX);
+    CHECK(cnt == 5);
+    CHECK(reads[0].enc_diff == 3 && !reads[0].pressed);
+    CHECK(reads[1].enc_diff == 0 && reads[1].pressed);
+    CHECK(reads[2].enc_diff == -2 && reads[2].pressed);
+    CHECK(reads[3].enc_diff == 0 && !reads[3].pressed);
+    CHECK(reads[4].enc_diff == 1 && !reads[4].pressed);
+    CHECK(!lvgl_port_encoder_input_pending(&s_in));
+
+    /* The time of the oldest event of a read, for the latency trace */
+    lv_indev_data_t data = { 0 };
+    uint32_t event_us = 0;
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, 7000);
+    lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, 8000);
+    CHECK(lvgl_port_encoder_input_read(&s_in, &data, &event_us) == 2);
+    CHECK(event_us == 7000 && data.enc_diff == 2);
+    CHECK(lvgl_port_encoder_input_read(&s_in, &data, &event_us) == 0);
+}
+
+/* More detents than the ring holds: the rest waits in the carry, a click still gets in */
+static void test_overflow(void)
+{
+    read_t reads[READS_MAX];
+    const int detents = 3 * LVGL_PORT_ENCODER_RING_SIZE;
+
+    lvgl_port_encoder_input_init(&s_in, NULL);
+    for (int i = 0; i < detents; i++) {
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, i * 1000);
+    }
+    CHECK(atomic_load(&s_in.carry) == detents - (LVGL_PORT_ENCODER_RING_SIZE - LVGL_PORT_ENCODER_BTN_RESERVE));
+    CHECK(lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, detents * 1000));
+    CHECK(lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_RELEASE, 0, detents * 1000 + 1000));
+    CHECK(s_in.dropped == 0);
+
+    const int cnt = indev_read(reads, READS_MAX);
+    CHECK(cnt == 3);
+    CHECK(reads[0].enc_diff == detents && !reads[0].pressed);
+    CHECK(reads[1].pressed && !reads[2].pressed);
+
+    /* Nothing is read, the knob stops with detents in the carry */
+    for (int i = 0; i < detents; i++) {
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, -1, i * 1000);
+    }
+    CHECK(lvgl_port_encoder_input_pending(&s_in));
+    CHECK(indev_read(reads, READS_MAX) == 1 && reads[0].enc_diff == -detents);
+    CHECK(!lvgl_port_encoder_input_pending(&s_in));
+
+    /* Button events past the reserve are dropped and counted */
+    for (int i = 0; i < LVGL_PORT_ENCODER_RING_SIZE - LVGL_PORT_ENCODER_BTN_RESERVE; i++) {
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, 1, i * 1000);
+    }
+    for (int i = 0; i < LVGL_PORT_ENCODER_BTN_RESERVE; i++) {
+        CHECK(lvgl_port_encoder_input_push(&s_in, (i & 1) ? LVGL_PORT_ENCODER_RELEASE : LVGL_PORT_ENCODER_PRESS, 0, 0));
+    }
+    CHECK(!lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, 0));
+    CHECK(s_in.dropped == 1);
+}
+
+/* The knob callbacks in one thread, LVGL in another */
+static atomic_bool s_done;
+static int64_t s_net;
+
+static void *producer_task(void *arg)
+{
+    uint32_t seed = 0x9e3779b9;
+    uint32_t t = 0;
+
+    for (int turn = 0; turn < THREAD_TURNS; turn++) {
+        seed = seed * 1664525 + 1013904223;
+        const int detents = 1 + (seed >> 24) % 100;
+        const int dir = (seed & 0x100) ? -1 : 1;
+        for (int i = 0; i < detents; i++) {
+            lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_ROTATE, dir, t += 1000);
+        }
+        s_net += dir * detents;
+        /* A hand does not click that fast: the button events find room */
+        while (atomic_load(&s_in.head) - atomic_load(&s_in.tail) > LVGL_PORT_ENCODER_RING_SIZE / 2) {
+            sched_yield();
+        }
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_PRESS, 0, t += 1000);
+        lvgl_port_encoder_input_push(&s_in, LVGL_PORT_ENCODER_RELEASE, 0, t += 1000);
+    }
+    atomic_store(&s_done, true);
+    return NULL;
+}
+
+static void test_threads(void)
+{
+    pthread_t producer;
+    lv_indev_data_t data;
+    int64_t diff = 0;
+    int presses = 0;
+    bool pressed = false;
+
+    lvgl_port_encoder_input_init(&s_in, NULL);
+    atomic_init(&s_done, false);
+    CHECK(0 == pthread_create(&producer, NULL, producer_task, NULL));
+    for (bool done = false; !done;) {
+        done = atomic_load(&s_done);
+        do {
+            memset(&data, 0, sizeof(data));
+            lvgl_port_encoder_input_read(&s_in, &data, NULL);
+            diff += data.enc_diff;
+            presses += (LV_INDEV_STATE_PRESSED == data.state) && !pressed;
+            pressed = (LV_INDEV_STATE_PRESSED == data.state);
+        } while (data.continue_reading);
+        done = done && !lvgl_port_encoder_input_pending(&s_in);
+    }
+    pthread_join(producer, NULL);
+
+    printf("threads: %d turns, %lld detents, %d presses, %d dropped\n",
+           THREAD_TURNS, (long long)diff, presses, (int)s_in.dropped);
+    CHECK(diff == s_net);
+    CHECK(presses == THREAD_TURNS);
+    CHECK(s_in.dropped == 0);
+    CHECK(!pressed);
+}
+
+int main(void)
+{
+    test_click();
+    test_order();
+    test_overflow();
+    test_threads();
+
+    return test_result();
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Image cache test.
+ *
+ * Checks the bookkeeping of lv_img_lru on stand-in sources: the least recently used image
+ * goes first, pinned ones and the ones of the frame being rendered stay, the images of a
+ * layer go when it is left, and the RLE decoder hands LVGL the cached pixels.
+ *
+ * Usage: test_img_lru
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+#include "asset_pack_host.h"
+#include "test_util.h"
+
+static void test_lru_order(void)
+{
+    static const uint8_t src[3];
+    lv_img_lru_set_budget(300);
+
+    CHECK(lv_img_lru_add(&src[0], 100) != NULL);
+    CHECK(lv_img_lru_add(&src[1], 100) != NULL);
+    CHECK(lv_img_lru_add(&src[0], 100) == NULL);
+    CHECK(lv_img_lru_add(&src[2], 301) == NULL);
+
+    /* src[0] used last, src[1] is freed for the new image */
+    CHECK(lv_img_lru_get(&src[0]) != NULL);
+    CHECK(lv_img_lru_add(&src[2], 150) != NULL);
+    CHECK(lv_img_lru_get(&src[1]) == NULL);
+    CHECK(lv_img_lru_get(&src[0]) != NULL);
+
+    lv_img_lru_stats_t stats;
+    lv_img_lru_get_stats(&stats);
+    CHECK(stats.entries == 2 && stats.bytes == 250 && stats.evictions == 1);
+
+    lv_img_lru_invalidate_src(NULL);
+    lv_img_lru_get_stats(&stats);
+    CHECK(stats.entries == 0 && stats.bytes == 0);
+}
+
+static void test_owner(void)
+{
+    static const uint8_t src[2];
+    static const uint8_t layer[2];
+    lv_img_lru_set_budget(LV_IMG_LRU_BUDGET);
+
+    lv_img_lru_set_owner(&layer[0]);
+    CHECK(lv_img_lru_add(&src[0], 100) != NULL);
+    lv_img_lru_set_owner(&layer[1]);
+    CHECK(lv_img_lru_add(&src[1], 100) != NULL);
+
+    lv_img_lru_evict_owner(&layer[0]);
+    CHECK(lv_img_lru_get(&src[0]) == NULL);
+    CHECK(lv_img_lru_get(&src[1]) != NULL);
+
+    lv_img_lru_set_owner(NULL);
+    lv_img_lru_invalidate_src(NULL);
+}
+
+/* The images drawn by the frame being rendered are not freed for the next one */
+static void test_frame(lv_disp_t *disp)
+{
+    static const uint8_t src[3];
+    lv_img_lru_set_budget(250);
+
+    _lv_refr_set_disp_refreshing(disp);
+    disp->refr_timer->last_run = 100;
+    CHECK(lv_img_lru_add(&src[0], 100) != NULL);
+    CHECK(lv_img_lru_add(&src[1], 100) != NULL);
+    CHECK(lv_img_lru_add(&src[2], 100) == NULL);
+
+    /* Next frame: src[0] is drawn again, src[1] is the one to go */
+    disp->refr_timer->last_run = 200;
+    CHECK(lv_img_lru_get(&src[0]) != NULL);
+    CHECK(lv_img_lru_add(&src[2], 100) != NULL);
+    CHECK(lv_img_lru_get(&src[1]) == NULL);
+    _lv_refr_set_disp_refreshing(NULL);
+
+    lv_img_lru_invalidate_src(NULL);
+}
+
+static void test_decoder(void)
+{
+    lv_img_lru_set_budget(LV_IMG_LRU_BUDGET);
+    const lv_img_dsc_t *img = lv_asset_img("img_washing_bubble1");
+    const lv_img_dsc_t *other = lv_asset_img("img_washing_bubble2");
+    CHECK(img && img->header.cf == LV_IMG_CF_USER_ENCODED_0);
+    CHECK(other && other->header.cf == LV_IMG_CF_USER_ENCODED_0);
+    if (!img || !other) {
+        return;
+    }
+
+    lv_img_decoder_dsc_t dsc;
+    CHECK(lv_img_decoder_open(&dsc, img, lv_color_black(), 0) == LV_RES_OK);
+    CHECK(dsc.img_data != NULL && dsc.img_data == lv_img_lru_get(img));
+    CHECK(dsc.header.cf == LV_IMG_CF_RGB565A8);
+    lv_img_decoder_close(&dsc);
+
+    /* Only the pinned image stays when the budget shrinks */
+    CHECK(lv_img_lru_pin(other));
+    lv_img_lru_set_budget(0);
+    CHECK(lv_img_lru_get(img) == NULL);
+    CHECK(lv_img_lru_get(other) != NULL);
+
+    /* Not cached, drawn row by row */
+    CHECK(lv_img_decoder_open(&dsc, img, lv_color_black(), 0) == LV_RES_OK);
+    CHECK(dsc.img_data == NULL && dsc.header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_img_decoder_close(&dsc);
+
+    lv_img_lru_invalidate_src(NULL);
+    lv_img_lru_stats_t stats;
+    lv_img_lru_get_stats(&stats);
+    CHECK(stats.entries == 0 && stats.pinned == 0 && stats.bytes == 0);
+}
+
+int main(void)
+{
+    lv_init();
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    lv_img_rle_init();
+
+    lv_disp_t *disp = test_disp_create();
+
+    test_lru_order();
+    test_owner();
+    test_frame(disp);
+    test_decoder();
+
+    return test_result();
+}
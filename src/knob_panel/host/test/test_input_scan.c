@@ -0,0 +1,393 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Input scan tick test.
+ *
+ * Runs the tick shared by the knob and the button
+ * (components/input_scan/input_scan_sched.c) on a simulated clock, with a one
+ * shot timer armed again by every tick like input_scan.c, over a session of the knob panel:
+ * slow and fast turns, clicks, a long press turned while held and a double click, with rests in
+ * between. The scan functions stand for the ones of the drivers: the button debounces its pin
+ * and is busy until released, and arms its level interrupt when the tick stops; the knob calls
+ * back the detents its interrupt queued and keeps the tick while they come faster than it.
+ *
+ * The same session runs on a model of the drivers before the shared tick: a one shot timer of
+ * the knob started by its interrupt for every detent, and a periodic timer of the button started
+ * by its interrupt and stopped once it is at rest. Every timer callback is a wakeup of the
+ * esp_timer task, both counts are printed. The session runs with the power save of the button,
+ * as on the board, and without it, the button scanned all the time.
+ *
+ * Every detent and press must be called back, a detent at most one tick after it came, the
+ * tick must stop in the rests with power save and take fewer wakeups than the two timers.
+ *
+ * Usage: test_input_scan
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "input_scan_sched.h"
+#include "test_util.h"
+
+#define STEP_US             (100)           /* Resolution of the clock, delay of a timer started at 0 */
+#define SESSION_US          (14 * 1000 * 1000)
+#define DETENTS_MAX         (256)
+#define DEBOUNCE_TICKS      CONFIG_BUTTON_DEBOUNCE_TICKS
+
+/* Session: detent times, and the times the button is pressed and released */
+static uint32_t s_detents[DETENTS_MAX];
+static int s_detent_cnt;
+static const uint32_t s_presses[][2] = {
+    { 3000000, 3120000 },                   /* Click */
+    { 6000000, 7500000 },                   /* Long press, turned while held */
+    { 9000000, 9080000 }, { 9180000, 9260000 }, /* Double click */
+};
+#define PRESS_CNT           (sizeof(s_presses) / sizeof(s_presses[0]))
+
+/* Milliseconds between the detents of a flick */
+static const int s_flick[] = { 40, 22, 14, 9, 7, 5, 4, 4, 3, 3, 3, 4, 4, 5, 6, 8, 11, 16, 25, 40 };
+
+static void turn_add(uint32_t start_us, int cnt, uint32_t gap_us)
+{
+    for (int i = 0; i < cnt; i++) {
+        s_detents[s_detent_cnt++] = start_us + i * gap_us;
+    }
+}
+
+static void session_build(void)
+{
+    s_detent_cnt = 0;
+    turn_add(500000, 12, 150000);           /* Slow turn through the menu */
+    uint32_t t = 4000000;
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 0; i < sizeof(s_flick) / sizeof(s_flick[0]); i++) {
+            t += s_flick[i] * 1000;
+            s_detents[s_detent_cnt++] = t;
+        }
+    }
+    turn_add(6400000, 10, 60000);           /* Turned while the button is held */
+    turn_add(10000000, 30, 12000);          /* Medium turn */
+}
+
+static bool pressed_at(uint32_t now)
+{
+    for (size_t i = 0; i < PRESS_CNT; i++) {
+        if (now >= s_presses[i][0] && now < s_presses[i][1]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Button: debounced level, busy until released and at rest, like button_handler() */
+typedef struct {
+    uint32_t now;
+    uint8_t debounce_cnt;
+    bool level;
+    bool last_level;
+    bool armed;                             /* Level interrupt for the press */
+    int presses;
+} btn_t;
+
+static bool btn_scan(btn_t *btn)
+{
+    const bool read = pressed_at(btn->now);
+    if (read != btn->level) {
+        if (++btn->debounce_cnt >= DEBOUNCE_TICKS) {
+            btn->level = read;
+            btn->debounce_cnt = 0;
+            btn->presses += read;
+        }
+    } else {
+        btn->debounce_cnt = 0;
+    }
+    /* Released: BUTTON_PRESS_UP and BUTTON_PRESS_END, then BUTTON_NONE_PRESS on the next tick */
+    const bool busy = btn->level || btn->debounce_cnt || btn->last_level;
+    btn->last_level = btn->level;
+    return busy;
+}
+
+/* Knob: the detents queued by the interrupt */
+typedef struct {
+    uint32_t now;
+    int queued;
+    int called_back;
+    uint32_t last_us;                       /* Time of the last detent called back */
+    uint32_t max_delay_us;
+} knob_t;
+
+static bool knob_take(knob_t *knob)
+{
+    bool fast = false;
+    for (; knob->called_back < knob->queued; knob->called_back++) {
+        const uint32_t at = s_detents[knob->called_back];
+        fast = (at - knob->last_us < INPUT_SCAN_PERIOD_US);
+        knob->last_us = at;
+        if (knob->now - at > knob->max_delay_us) {
+            knob->max_delay_us = knob->now - at;
+        }
+    }
+    return fast;
+}
+
+/* Shared tick */
+static input_scan_sched_t s_sched;
+static btn_t s_btn;
+static knob_t s_knob;
+static int64_t s_timer_at = -1;
+static uint32_t s_now;
+
+static bool scan_btn(void *arg)
+{
+    return btn_scan((btn_t *)arg);
+}
+
+static bool sleep_btn(void *arg)
+{
+    ((btn_t *)arg)->armed = true;
+    return false;
+}
+
+static bool scan_knob(void *arg)
+{
+    return knob_take((knob_t *)arg);
+}
+
+static bool sleep_knob(void *arg)
+{
+    const knob_t *knob = (const knob_t *)arg;
+    return knob->called_back < knob->queued;
+}
+
+static void wake(void)
+{
+    if (input_scan_sched_wake(&s_sched)) {
+        s_timer_at = (int64_t)s_now + STEP_US;
+    }
+}
+
+/**
+ * @brief Run the session on the shared tick
+ *
+ * @param power_save Button registered with its sleep function, else scanned all the time
+ * @param quiet_from Start of the rest which ends the session
+ * @return Ticks after `quiet_from`
+ */
+static uint32_t session_run_shared(bool power_save, uint32_t quiet_from)
+{
+    uint32_t quiet_ticks = 0;
+    int detent = 0;
+
+    input_scan_sched_init(&s_sched);
+    memset(&s_btn, 0, sizeof(s_btn));
+    memset(&s_knob, 0, sizeof(s_knob));
+    s_timer_at = -1;
+    s_now = 0;
+    CHECK(input_scan_sched_add(&s_sched, scan_btn, power_save ? sleep_btn : NULL, &s_btn));
+    CHECK(input_scan_sched_add(&s_sched, scan_knob, sleep_knob, &s_knob));
+    wake();
+
+    for (s_now = 0; s_now < SESSION_US; s_now += STEP_US) {
+        /* Interrupts */
+        for (; detent < s_detent_cnt && s_detents[detent] <= s_now; detent++) {
+            s_knob.queued++;
+            wake();
+        }
+        if (s_btn.armed && pressed_at(s_now)) {
+            s_btn.armed = false;
+            wake();
+        }
+        /* Timer */
+        if (s_timer_at >= 0 && s_timer_at <= s_now) {
+            s_btn.now = s_now;
+            s_knob.now = s_now;
+            quiet_ticks += (s_now >= quiet_from);
+            s_timer_at = input_scan_sched_tick(&s_sched) ? (int64_t)s_now + INPUT_SCAN_PERIOD_US : -1;
+        }
+    }
+    return quiet_ticks;
+}
+
+/* The drivers before: a one shot timer for the knob, a periodic one for the button */
+static uint32_t session_run_two_timers(bool power_save, uint32_t *knob_wakeups, uint32_t *btn_wakeups, int *presses)
+{
+    btn_t btn = { .armed = power_save };
+    knob_t knob = { 0 };
+    int64_t knob_at = -1;
+    int64_t btn_at = power_save ? -1 : INPUT_SCAN_PERIOD_US;
+    int detent = 0;
+
+    *knob_wakeups = 0;
+    *btn_wakeups = 0;
+    for (uint32_t now = 0; now < SESSION_US; now += STEP_US) {
+        for (; detent < s_detent_cnt && s_detents[detent] <= now; detent++) {
+            knob.queued++;
+            if (knob_at < 0) {
+                knob_at = now + STEP_US;
+            }
+        }
+        if (btn.armed && pressed_at(now)) {
+            btn.armed = false;
+            btn_at = now + INPUT_SCAN_PERIOD_US;
+        }
+        if (knob_at >= 0 && knob_at <= now) {
+            knob.now = now;
+            knob_take(&knob);
+            (*knob_wakeups)++;
+            knob_at = -1;
+        }
+        if (btn_at >= 0 && btn_at <= now) {
+            btn.now = now;
+            (*btn_wakeups)++;
+            if (btn_scan(&btn) || !power_save) {
+                btn_at += INPUT_SCAN_PERIOD_US;
+            } else {
+                btn.armed = true;
+                btn_at = -1;
+            }
+        }
+    }
+    CHECK(knob.called_back == s_detent_cnt);
+    *presses = btn.presses;
+    return *knob_wakeups + *btn_wakeups;
+}
+
+static void test_session(bool power_save)
+{
+    uint32_t knob_wakeups, btn_wakeups;
+    int presses;
+
+    session_build();
+    const uint32_t quiet_ticks = session_run_shared(power_save, 11000000);
+    const input_scan_stats_t *stats = &s_sched.stats;
+    const uint32_t before = session_run_two_timers(power_save, &knob_wakeups, &btn_wakeups, &presses);
+
+    printf("session, button power save %s: %d detents, %d presses, %.1f s\n", power_save ? "on" : "off",
+           s_detent_cnt, (int)PRESS_CNT, SESSION_US / 1e6);
+    printf("  two timers:  %5u wakeups (%u knob, %u button)\n", before, knob_wakeups, btn_wakeups);
+    printf("  shared tick: %5u wakeups (%u starts), %.1f %% fewer, detents called back %u us late at most\n",
+           stats->ticks, stats->wakeups, 100.0 * (before - stats->ticks) / before, s_knob.max_delay_us);
+
+    CHECK(s_knob.called_back == s_detent_cnt);
+    CHECK(s_knob.max_delay_us <= INPUT_SCAN_PERIOD_US + STEP_US);
+    CHECK(s_btn.presses == (int)PRESS_CNT);
+    CHECK(presses == (int)PRESS_CNT);
+    CHECK(stats->ticks < before);
+    if (!power_save) {
+        /* The knob never starts the tick of the button */
+        CHECK(stats->wakeups == 1);
+        return;
+    }
+
+    /* At rest together: the tick stopped, the button waits for its interrupt */
+    CHECK(quiet_ticks == 0);
+    CHECK(!atomic_load(&s_sched.running));
+    CHECK(s_timer_at < 0 && s_btn.armed);
+}
+
+/* Registering, removing and pausing keep the order of the inputs */
+static int s_order[INPUT_SCAN_SLOTS];
+static int s_order_cnt;
+
+static bool scan_record(void *arg)
+{
+    s_order[s_order_cnt++] = (int)(intptr_t)arg;
+    return false;
+}
+
+static bool sleep_none(void *arg)
+{
+    (void)arg;
+    return false;
+}
+
+static void test_slots(void)
+{
+    input_scan_sched_t sched;
+
+    input_scan_sched_init(&sched);
+    for (int i = 0; i < INPUT_SCAN_SLOTS; i++) {
+        CHECK(input_scan_sched_add(&sched, scan_record, sleep_none, (void *)(intptr_t)(i + 1)));
+    }
+    CHECK(!input_scan_sched_add(&sched, scan_record, sleep_none, (void *)(intptr_t)100));
+    CHECK(input_scan_sched_remove(&sched, (void *)(intptr_t)3));
+    CHECK(!input_scan_sched_remove(&sched, (void *)(intptr_t)3));
+    CHECK(input_scan_sched_add(&sched, scan_record, sleep_none, (void *)(intptr_t)9));
+
+    s_order_cnt = 0;
+    CHECK(input_scan_sched_wake(&sched));
+    CHECK(!input_scan_sched_wake(&sched));
+    CHECK(!input_scan_sched_tick(&sched));
+    CHECK(!atomic_load(&sched.running));
+    const int expect[] = { 1, 2, 4, 5, 6, 7, 8, 9 };
+    CHECK(s_order_cnt == INPUT_SCAN_SLOTS && !memcmp(s_order, expect, sizeof(expect)));
+
+    /* Paused: not scanned */
+    input_scan_sched_pause(&sched, scan_record, true);
+    s_order_cnt = 0;
+    CHECK(!input_scan_sched_tick(&sched));
+    CHECK(s_order_cnt == 0);
+
+    /* An input without sleep function keeps the tick */
+    input_scan_sched_init(&sched);
+    CHECK(input_scan_sched_add(&sched, scan_record, NULL, (void *)(intptr_t)1));
+    CHECK(input_scan_sched_tick(&sched));
+    CHECK(sched.stats.ticks == 1 && sched.stats.wakeups == 0);
+}
+
+/* An input busy while the tick stops, after its scan: one more tick, unless an interrupt started it */
+static int s_pending;
+static input_scan_sched_t s_race;
+
+static bool scan_idle(void *arg)
+{
+    (void)arg;
+    return false;
+}
+
+static bool sleep_pending(void *arg)
+{
+    (void)arg;
+    if (s_pending == 2) {
+        /* The interrupt of the input comes in the middle and starts the timer itself */
+        CHECK(input_scan_sched_wake(&s_race));
+    }
+    return s_pending != 0;
+}
+
+static void test_race(void)
+{
+    input_scan_sched_init(&s_race);
+    CHECK(input_scan_sched_add(&s_race, scan_idle, sleep_pending, NULL));
+
+    s_pending = 0;
+    CHECK(input_scan_sched_wake(&s_race));
+    CHECK(!input_scan_sched_tick(&s_race));
+    CHECK(!atomic_load(&s_race.running));
+
+    s_pending = 1;
+    CHECK(input_scan_sched_wake(&s_race));
+    CHECK(input_scan_sched_tick(&s_race));
+    CHECK(atomic_load(&s_race.running));
+
+    s_pending = 2;
+    CHECK(!input_scan_sched_tick(&s_race));
+    CHECK(atomic_load(&s_race.running));
+    CHECK(s_race.stats.wakeups == 3);
+}
+
+int main(void)
+{
+    test_session(true);
+    test_session(false);
+    test_slots();
+    test_race();
+
+    return test_result();
+}
@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Knob quadrature decoder test.
+ *
+ * Turns a simulated knob and feeds the decoder of the knob component
+ * (components/espressif__knob/knob_quadrature.c) the way the GPIO interrupt does: the
+ * interrupt of a pin fires when it leaves the level read last, the handler reads both pins
+ * after an interrupt latency and is not entered again before it returns. The edges are made
+ * from a seeded generator, with contact bounce after most edges and latencies up to more than
+ * the time between two edges, at speeds up to 4000 detents per second. A task takes the
+ * detents out of the ring every few milliseconds.
+ *
+ * There are no recordings of the knob of the board: the generator stands for them. A handler
+ * which sees both pins changed takes the way of the last detent, a turn starting in the other
+ * way while the handler is that late cannot be decoded, so the turns start slowly. Nothing is
+ * lost as long as the latency and the bounce together stay under the time of two edges.
+ *
+ * After every turn the count must be the position of the knob and every detent must have been
+ * queued: no count lost, none dropped.
+ *
+ * Usage: test_knob_quadrature
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "knob_quadrature.h"
+#include "test_util.h"
+
+#define TRACE_MAX_US        (2 * 1000 * 1000)
+#define PAUSE_US            (3000)          /* Knob left alone between two turns */
+#define POP_PERIOD_US       (5000)          /* The esp_timer task reading the ring */
+#define RAMP_US             (1000)          /* Time between the first edges of a turn */
+
+static uint32_t s_rand = 0x2545f491;
+
+/* Bit 1: A, bit 0: B, for every microsecond of the trace */
+static uint8_t s_levels[TRACE_MAX_US];
+static uint8_t s_flips[TRACE_MAX_US];
+
+/* Gray code of the quarter steps when A leads, the same as the table of the decoder */
+static const uint8_t s_gray[4] = { 0x0, 0x2, 0x3, 0x1 };
+
+typedef struct {
+    int detents;                            /*!< Signed, A leads when positive */
+    uint32_t edge_us;                       /*!< Time between two edges */
+} turn_t;
+
+typedef struct {
+    uint32_t latency_max_us;                /*!< Interrupt latency, 1 us up to it */
+    uint32_t bounce_us;                     /*!< Bounce window after an edge, 0 for none */
+    uint32_t high_limit;
+    int low_limit;
+} trace_cfg_t;
+
+static uint32_t rand_next(void)
+{
+    s_rand ^= s_rand << 13;
+    s_rand ^= s_rand >> 17;
+    s_rand ^= s_rand << 5;
+    return s_rand;
+}
+
+static uint32_t rand_range(uint32_t lo, uint32_t hi)
+{
+    return lo + rand_next() % (hi - lo + 1);
+}
+
+/* Edge of a pin at `t`, then the contact bouncing back and forth a few times */
+static void trace_edge(uint32_t t, uint8_t pin_mask, uint32_t bounce_us)
+{
+    s_flips[t] ^= pin_mask;
+    if (bounce_us && (rand_next() % 4)) {
+        const int pairs = rand_range(1, 3);
+        for (int i = 0; i < pairs; i++) {
+            s_flips[t + rand_range(1, bounce_us)] ^= pin_mask;
+            s_flips[t + rand_range(1, bounce_us)] ^= pin_mask;
+        }
+    }
+}
+
+/**
+ * @brief Build the levels of the pins for the turns, one after the other
+ *
+ * @return Length of the trace in microseconds, the position of the knob after every turn in `positions`
+ */
+static uint32_t trace_build(const turn_t *turns, int turn_cnt, const trace_cfg_t *cfg, int *positions, uint32_t *ends)
+{
+    uint32_t t = PAUSE_US;
+    int quarter = 0;
+
+    memset(s_flips, 0, sizeof(s_flips));
+    for (int i = 0; i < turn_cnt; i++) {
+        const int dir = turns[i].detents > 0 ? 1 : -1;
+        for (int n = 0; n < abs(turns[i].detents) * 2; n++) {
+            const uint8_t from = s_gray[quarter & 3];
+            quarter += dir;
+            trace_edge(t, from ^ s_gray[quarter & 3], cfg->bounce_us);
+            /* A hand starts slowly: the way of the first edges is the way of the turn */
+            t += n < 2 ? RAMP_US : turns[i].edge_us;
+        }
+        t += PAUSE_US;
+        positions[i] = quarter / 2;
+        ends[i] = t;
+    }
+
+    uint8_t level = s_gray[0];
+    for (uint32_t us = 0; us < t; us++) {
+        level ^= s_flips[us];
+        s_levels[us] = level;
+    }
+    return t;
+}
+
+/**
+ * @brief Run the interrupt and the task reading the ring over the trace
+ *
+ * @return Detents read from the ring, the count is checked against `positions` at the end of every turn
+ */
+static int trace_run(knob_quad_t *quad, uint32_t len, const trace_cfg_t *cfg, const int *positions, const uint32_t *ends, int turn_cnt)
+{
+    uint8_t last = s_levels[0];
+    int64_t isr_at = -1;
+    uint32_t last_time = 0;
+    int popped = 0;
+    int turn = 0;
+    knob_quad_step_t step;
+
+    knob_quad_init(quad, last >> 1, last & 1, false, cfg->high_limit, cfg->low_limit);
+    for (uint32_t us = 0; us < len; us++) {
+        /* Level interrupt: pending as long as a pin differs from what the handler read */
+        if (isr_at < 0 && s_levels[us] != last) {
+            isr_at = us + rand_range(1, cfg->latency_max_us);
+        }
+        if (isr_at == (int64_t)us) {
+            last = s_levels[us];
+            knob_quad_edge(quad, last >> 1, last & 1, us, NULL);
+            isr_at = -1;
+        }
+        if (0 == us % POP_PERIOD_US || us == len - 1) {
+            while (knob_quad_pop(quad, &step)) {
+                CHECK(step.time_us >= last_time);
+                last_time = step.time_us;
+                popped += step.dir;
+            }
+        }
+        if (turn < turn_cnt && us == ends[turn] - 1) {
+            if (quad->count != positions[turn]) {
+                printf("turn %d: count %d, position %d\n", turn, quad->count, positions[turn]);
+            }
+            CHECK(quad->count == positions[turn]);
+            turn++;
+        }
+    }
+    CHECK(turn == turn_cnt);
+    return popped;
+}
+
+static void test_turns(const char *name, const turn_t *turns, int turn_cnt, const trace_cfg_t *cfg)
+{
+    static knob_quad_t quad;
+    int positions[16];
+    uint32_t ends[16];
+
+    const uint32_t len = trace_build(turns, turn_cnt, cfg, positions, ends);
+    const int popped = trace_run(&quad, len, cfg, positions, ends, turn_cnt);
+    printf("%-10s %7u us, %5d detents, %4u edges skipped, %u dropped\n",
+           name, len, positions[turn_cnt - 1], quad.skipped, quad.dropped);
+    CHECK(quad.dropped == 0);
+    CHECK(popped == positions[turn_cnt - 1]);
+}
+
+/* Clean edges, the handler always in time */
+static void test_clean(void)
+{
+    const turn_t turns[] = {
+        { 20, 5000 }, { -20, 5000 }, { 1, 2000 }, { -1, 2000 }, { 300, 500 }, { -7, 1000 },
+    };
+    const trace_cfg_t cfg = { .latency_max_us = 20, .high_limit = 100000, .low_limit = -100000 };
+    test_turns("clean", turns, sizeof(turns) / sizeof(turns[0]), &cfg);
+}
+
+/* Fast turns with bounce, the handler sometimes seeing both pins changed */
+static void test_fast(void)
+{
+    const turn_t turns[] = {
+        { 400, 250 }, { -400, 250 }, { 1000, 150 }, { 3, 125 }, { -600, 125 }, { 800, 125 },
+        { -1200, 160 }, { 2, 2000 },
+    };
+    const trace_cfg_t cfg = { .latency_max_us = 180, .bounce_us = 30, .high_limit = 100000, .low_limit = -100000 };
+    test_turns("fast", turns, sizeof(turns) / sizeof(turns[0]), &cfg);
+}
+
+/* The count goes back to 0 at the limits, the steps say which one */
+static void test_limits(void)
+{
+    static knob_quad_t quad;
+    knob_quad_step_t step;
+    int high = 0, low = 0, zero = 0;
+
+    knob_quad_init(&quad, 0, 0, false, 5, -3);
+    for (int q = 1; q <= 14; q++) {
+        const uint8_t s = s_gray[q & 3];
+        knob_quad_edge(&quad, s >> 1, s & 1, q, NULL);
+    }
+    CHECK(quad.count == 2);
+    for (int q = 13; q >= 0; q--) {
+        const uint8_t s = s_gray[q & 3];
+        knob_quad_edge(&quad, s >> 1, s & 1, 100 + q, NULL);
+    }
+    while (knob_quad_pop(&quad, &step)) {
+        high += KNOB_QUAD_HIGH == step.limit;
+        low += KNOB_QUAD_LOW == step.limit;
+        zero += KNOB_QUAD_ZERO == step.limit;
+    }
+    /* Up 7: 5 -> 0, then 2. down 7: 2 -> 0, -3 -> 0, then -2 */
+    CHECK(high == 1 && low == 1 && zero == 1);
+    CHECK(quad.count == -2);
+
+    /* Reversed knob */
+    knob_quad_init(&quad, 0, 0, true, 100, -100);
+    for (int q = 1; q <= 8; q++) {
+        const uint8_t s = s_gray[q & 3];
+        knob_quad_edge(&quad, s >> 1, s & 1, q, NULL);
+    }
+    CHECK(quad.count == -4);
+}
+
+int main(void)
+{
+    test_clean();
+    test_fast();
+    test_limits();
+
+    return test_result();
+}
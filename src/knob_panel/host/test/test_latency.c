@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Input latency trace test.
+ *
+ * Walks inputs through the latency trace of esp_lvgl_port
+ * (components/espressif__esp_lvgl_port/esp_lvgl_port_latency.c) the way the port calls
+ * it: the read callback of LVGL, the end of the read timer, the start of rendering for every
+ * strip, the flush of every strip and the end of the transfer of the last one.
+ *
+ * An input must get the times of its stages, inputs read while the last strip of a frame is sent
+ * are answered by the next frame, an input no frame answers within a second is counted as
+ * unanswered, inputs past the samples in flight are counted as dropped, and the percentiles are
+ * the upper bounds of their buckets.
+ *
+ * Usage: test_latency
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "esp_lvgl_port_latency.h"
+#include "test_util.h"
+
+static lvgl_port_latency_t s_lat;
+
+/* A frame of `strips` strips, rendered from `start_us`, each strip taking `strip_us` */
+static uint32_t frame_run(uint32_t start_us, int strips, uint32_t strip_us)
+{
+    uint32_t t = start_us;
+    for (int i = 0; i < strips; i++) {
+        lvgl_port_latency_render(&s_lat, t);
+        t += strip_us;
+        lvgl_port_latency_flush(&s_lat, t, i == strips - 1);
+    }
+    return t;
+}
+
+/* The times of every stage of one input */
+static void test_stages(void)
+{
+    const lvgl_port_latency_stats_t *st = &s_lat.stats;
+
+    lvgl_port_latency_init(&s_lat);
+    lvgl_port_latency_input(&s_lat, 1000, 5000);
+    lvgl_port_latency_handled(&s_lat, 5100);
+    CHECK(!lvgl_port_latency_flushed(&s_lat));
+    const uint32_t end = frame_run(8000, 3, 1000);
+    CHECK(lvgl_port_latency_flushed(&s_lat));
+    lvgl_port_latency_done(&s_lat, end + 4000);
+    CHECK(!lvgl_port_latency_flushed(&s_lat));
+
+    CHECK(st->stages[LVGL_PORT_LATENCY_READ].max_us == 4000);
+    CHECK(st->stages[LVGL_PORT_LATENCY_HANDLE].max_us == 100);
+    CHECK(st->stages[LVGL_PORT_LATENCY_WAIT].max_us == 2900);
+    CHECK(st->stages[LVGL_PORT_LATENCY_RENDER].max_us == 1000);
+    CHECK(st->stages[LVGL_PORT_LATENCY_FLUSH].max_us == 2000 + 4000);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].max_us == end + 4000 - 1000);
+    for (int stage = 0; stage < LVGL_PORT_LATENCY_STAGES; stage++) {
+        CHECK(st->stages[stage].count == 1);
+    }
+
+    /* The stages add up to the total */
+    uint64_t sum = 0;
+    for (int stage = 0; stage < LVGL_PORT_LATENCY_TOTAL; stage++) {
+        sum += st->stages[stage].sum_us;
+    }
+    CHECK(sum == st->stages[LVGL_PORT_LATENCY_TOTAL].sum_us);
+}
+
+/* An input read while the last strip of a frame is sent waits for the next frame */
+static void test_next_frame(void)
+{
+    const lvgl_port_latency_stats_t *st = &s_lat.stats;
+
+    lvgl_port_latency_init(&s_lat);
+    lvgl_port_latency_input(&s_lat, 0, 1000);
+    lvgl_port_latency_handled(&s_lat, 1000);
+    uint32_t end = frame_run(2000, 2, 1000);
+
+    /* Read before the transfer of the last strip ended */
+    lvgl_port_latency_input(&s_lat, 3500, 4500);
+    lvgl_port_latency_handled(&s_lat, 4500);
+    lvgl_port_latency_done(&s_lat, end + 2000);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].count == 1);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].max_us == end + 2000);
+    CHECK(!lvgl_port_latency_flushed(&s_lat));
+
+    /* Counted by the next frame */
+    end = frame_run(10000, 2, 500);
+    lvgl_port_latency_done(&s_lat, end);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].count == 2);
+    CHECK(st->stages[LVGL_PORT_LATENCY_WAIT].max_us == 10000 - 4500);
+    CHECK(st->unanswered == 0 && st->dropped == 0);
+}
+
+/* Inputs changing nothing on the screen, and more inputs than samples */
+static void test_unanswered(void)
+{
+    const lvgl_port_latency_stats_t *st = &s_lat.stats;
+
+    lvgl_port_latency_init(&s_lat);
+    lvgl_port_latency_input(&s_lat, 0, 1000);
+    lvgl_port_latency_handled(&s_lat, 1000);
+    lvgl_port_latency_input(&s_lat, 500000, 500000);
+    lvgl_port_latency_handled(&s_lat, 500000);
+    CHECK(st->unanswered == 0);
+
+    /* A frame a second after the first input answers only the second one */
+    const uint32_t end = frame_run(1001000, 1, 1000);
+    lvgl_port_latency_done(&s_lat, end);
+    CHECK(st->unanswered == 1);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].count == 1);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].max_us == end - 500000);
+
+    /* Reads without a handled read timer in between, past the samples in flight */
+    for (int i = 0; i < LVGL_PORT_LATENCY_SAMPLES + 2; i++) {
+        lvgl_port_latency_input(&s_lat, 2000000 + i, 2000000 + i);
+    }
+    CHECK(st->dropped == 2);
+    lvgl_port_latency_handled(&s_lat, 2000100);
+    lvgl_port_latency_done(&s_lat, 2000200);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].count == 1);
+    lvgl_port_latency_done(&s_lat, frame_run(2001000, 1, 1000) + 3000);
+    CHECK(st->stages[LVGL_PORT_LATENCY_TOTAL].count == 1 + LVGL_PORT_LATENCY_SAMPLES);
+}
+
+/* The percentiles are the upper bounds of their buckets, never above the maximum */
+static void test_percentile(void)
+{
+    lvgl_port_latency_hist_t hist;
+
+    memset(&hist, 0, sizeof(hist));
+    CHECK(lvgl_port_latency_percentile(&hist, 50) == 0);
+
+    lvgl_port_latency_init(&s_lat);
+    for (int i = 0; i < 100; i++) {
+        /* 90 inputs of 1.5 ms and 10 of 20 ms */
+        const uint32_t total_us = i < 90 ? 1500 : 20000;
+        lvgl_port_latency_input(&s_lat, i * 100000, i * 100000);
+        lvgl_port_latency_handled(&s_lat, i * 100000);
+        frame_run(i * 100000, 1, 0);
+        lvgl_port_latency_done(&s_lat, i * 100000 + total_us);
+    }
+    const lvgl_port_latency_hist_t *total = &s_lat.stats.stages[LVGL_PORT_LATENCY_TOTAL];
+    CHECK(total->count == 100);
+    CHECK(total->sum_us == 90 * 1500 + 10 * 20000);
+    CHECK(lvgl_port_latency_percentile(total, 50) == 2048);
+    CHECK(lvgl_port_latency_percentile(total, 90) == 2048);
+    CHECK(lvgl_port_latency_percentile(total, 91) == 20000);
+    CHECK(lvgl_port_latency_percentile(total, 99) == 20000);
+    CHECK(lvgl_port_latency_percentile(total, 100) == 20000);
+
+    /* Past the last bucket */
+    memset(&hist, 0, sizeof(hist));
+    hist.count = 1;
+    hist.max_us = 30 * 1000 * 1000;
+    hist.buckets[LVGL_PORT_LATENCY_BUCKETS - 1] = 1;
+    CHECK(lvgl_port_latency_percentile(&hist, 50) == hist.max_us);
+
+    lvgl_port_print_latency_stats(&s_lat.stats);
+}
+
+int main(void)
+{
+    test_stages();
+    test_next_frame();
+    test_unanswered();
+    test_percentile();
+
+    return test_result();
+}
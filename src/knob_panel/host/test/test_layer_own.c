@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Layer timer and animation registry test.
+ *
+ * Switches between stand-in layers with lv_func_goto_layer() and checks that only what the
+ * layer left owns goes: its timers and animations, including an animation of a variable which
+ * is not an object, while a timer and an animation of nobody keep running. A retained layer
+ * pauses its timers and animations and continues them where they were when it comes back.
+ * An animation past LV_LAYER_OWN_ANIM_MAX or of a paused layer is not started, and the timer
+ * of a show layer goes with it.
+ *
+ * Usage: test_layer_own
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "lv_schedule_basic.h"
+#include "test_util.h"
+
+static uint32_t s_timer_runs;
+static uint32_t s_foreign_runs;
+static uint32_t s_anim_deleted;
+static int32_t s_anim_value;
+static int32_t s_foreign_value;
+
+static void run(uint32_t ms)
+{
+    for (uint32_t t = 0; t < ms; t += 10) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+}
+
+static void owned_timer_cb(lv_timer_t *timer)
+{
+    s_timer_runs++;
+}
+
+static void foreign_timer_cb(lv_timer_t *timer)
+{
+    s_foreign_runs++;
+}
+
+static void anim_cb(void *var, int32_t v)
+{
+    *(int32_t *)var = v;
+}
+
+static void anim_deleted_cb(lv_anim_t *a)
+{
+    s_anim_deleted++;
+}
+
+static void anim_start(lv_layer_t *layer, int32_t *var, uint32_t time)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, anim_cb);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_path_cb(&a, lv_anim_path_linear);
+    lv_anim_set_deleted_cb(&a, anim_deleted_cb);
+    if (layer) {
+        CHECK(lv_func_layer_anim_start(layer, &a) != NULL);
+    } else {
+        lv_anim_start(&a);
+    }
+}
+
+static bool layer_enter_cb(void *layer)
+{
+    lv_layer_t *create_layer = layer;
+    if (NULL == create_layer->lv_obj_layer) {
+        create_layer->lv_obj_layer = lv_obj_create(lv_scr_act());
+        /* Owns a timer and an animation of a variable which is not an object */
+        CHECK(lv_func_layer_timer_create(create_layer, owned_timer_cb, 100, NULL) != NULL);
+        anim_start(create_layer, &s_anim_value, 1000);
+    }
+    return true;
+}
+
+static bool layer_exit_cb(void *layer)
+{
+    return true;
+}
+
+static lv_layer_t s_layer_a = {
+    .lv_obj_name = "layer_a",
+    .enter_cb = layer_enter_cb,
+    .exit_cb = layer_exit_cb,
+};
+
+static lv_layer_t s_layer_b = {
+    .lv_obj_name = "layer_b",
+    .enter_cb = layer_enter_cb,
+    .exit_cb = layer_exit_cb,
+    .retain = { .enable = true },
+};
+
+static lv_layer_t s_layer_empty = {
+    .lv_obj_name = "layer_empty",
+    .enter_cb = layer_exit_cb,
+    .exit_cb = layer_exit_cb,
+};
+
+static void test_delete(void)
+{
+    lv_timer_t *foreign = lv_timer_create(foreign_timer_cb, 100, NULL);
+    anim_start(NULL, &s_foreign_value, 2000);
+
+    lv_func_goto_layer(&s_layer_a);
+    CHECK(s_layer_a.own.timer_cnt == 1 && s_layer_a.own.anim_cnt == 1);
+    run(500);
+    CHECK(s_timer_runs >= 4);
+    CHECK(s_anim_value > 0 && s_anim_value < 1000);
+
+    /* Leaving the layer deletes what it owns, only that */
+    s_anim_deleted = 0;
+    lv_func_goto_layer(&s_layer_empty);
+    CHECK(NULL == s_layer_a.lv_obj_layer);
+    CHECK(s_layer_a.own.timer_cnt == 0 && s_layer_a.own.anim_cnt == 0);
+    CHECK(s_anim_deleted == 1);
+
+    const int32_t value = s_anim_value;
+    const uint32_t timer_runs = s_timer_runs;
+    const uint32_t foreign_runs = s_foreign_runs;
+    const int32_t foreign_value = s_foreign_value;
+    run(500);
+    CHECK(s_anim_value == value && s_timer_runs == timer_runs);
+    CHECK(s_foreign_runs > foreign_runs && s_foreign_value > foreign_value);
+
+    lv_timer_del(foreign);
+    lv_anim_del(&s_foreign_value, anim_cb);
+}
+
+/* Past LV_LAYER_OWN_ANIM_MAX, or on a paused layer, an animation is not started at all */
+static void test_refuse(void)
+{
+    static int32_t values[LV_LAYER_OWN_ANIM_MAX];
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, anim_cb);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+
+    const uint16_t running = lv_anim_count_running();
+    lv_func_goto_layer(&s_layer_a);
+    for (int i = 1; i < LV_LAYER_OWN_ANIM_MAX; i++) {
+        lv_anim_set_var(&a, &values[i]);
+        CHECK(lv_func_layer_anim_start(&s_layer_a, &a) != NULL);
+    }
+    lv_anim_set_var(&a, &values[0]);
+    CHECK(lv_func_layer_anim_start(&s_layer_a, &a) == NULL);
+    CHECK(lv_anim_get(&values[0], anim_cb) == NULL);
+    CHECK(s_layer_a.own.anim_cnt == LV_LAYER_OWN_ANIM_MAX);
+
+    lv_func_goto_layer(&s_layer_empty);
+    CHECK(lv_anim_count_running() == running);
+
+    lv_func_goto_layer(&s_layer_b);
+    lv_func_goto_layer(&s_layer_empty);
+    CHECK(s_layer_b.own.paused);
+    CHECK(lv_func_layer_anim_start(&s_layer_b, &a) == NULL);
+    CHECK(lv_anim_count_running() == running);
+    lv_func_release_retained_layers();
+}
+
+/* The timer of a show layer is owned by it and goes with it */
+static uint32_t s_show_runs;
+
+static void show_timer_cb(lv_timer_t *timer)
+{
+    s_show_runs++;
+}
+
+static bool show_enter_cb(void *layer)
+{
+    lv_layer_t *show_layer = layer;
+    show_layer->lv_obj_layer = lv_obj_create(show_layer->lv_obj_parent);
+    return true;
+}
+
+static lv_layer_t s_show = {
+    .lv_obj_name = "show",
+    .enter_cb = show_enter_cb,
+    .exit_cb = layer_exit_cb,
+    .timer_cb = show_timer_cb,
+};
+
+static lv_layer_t s_layer_show = {
+    .lv_obj_name = "layer_show",
+    .enter_cb = layer_enter_cb,
+    .exit_cb = layer_exit_cb,
+    .lv_show_layer = &s_show,
+};
+
+static void test_show_layer(void)
+{
+    lv_func_goto_layer(&s_layer_show);
+    CHECK(s_show.timer_handle && s_show.own.timer_cnt == 1 && s_show.own.timers[0] == s_show.timer_handle);
+    run(100);
+    CHECK(s_show_runs > 0);
+
+    lv_func_goto_layer(&s_layer_empty);
+    CHECK(NULL == s_show.timer_handle && s_show.own.timer_cnt == 0);
+    const uint32_t show_runs = s_show_runs;
+    run(100);
+    CHECK(s_show_runs == show_runs);
+}
+
+static void test_pause(void)
+{
+    s_anim_value = 0;
+    lv_func_goto_layer(&s_layer_b);
+    run(300);
+    CHECK(s_anim_value > 0 && s_anim_value < 1000);
+
+    /* Retained: paused as a group, nothing deleted */
+    s_anim_deleted = 0;
+    lv_func_goto_layer(&s_layer_empty);
+    CHECK(s_layer_b.own.paused && s_layer_b.own.anim_cnt == 1 && s_layer_b.own.timer_cnt == 1);
+    CHECK(s_anim_deleted == 0);
+
+    const int32_t value = s_anim_value;
+    const uint32_t timer_runs = s_timer_runs;
+    run(500);
+    CHECK(s_anim_value == value && s_timer_runs == timer_runs);
+
+    /* Back where it was, then it ends and leaves the registry */
+    lv_func_goto_layer(&s_layer_b);
+    CHECK(!s_layer_b.own.paused && s_layer_b.own.anim_cnt == 1);
+    run(20);
+    CHECK(s_anim_value >= value && s_anim_value < value + 100);
+    CHECK(s_timer_runs > timer_runs);
+    run(1000);
+    CHECK(s_anim_value == 1000 && s_anim_deleted == 1);
+    CHECK(s_layer_b.own.anim_cnt == 0);
+
+    /* An owned timer deleted early, an owned animation deleted by LVGL */
+    CHECK(s_layer_b.own.timer_cnt == 1);
+    lv_func_layer_timer_del(&s_layer_b, s_layer_b.own.timers[0]);
+    CHECK(s_layer_b.own.timer_cnt == 0);
+    anim_start(&s_layer_b, &s_anim_value, 1000);
+    CHECK(s_layer_b.own.anim_cnt == 1);
+    lv_anim_del(&s_anim_value, anim_cb);
+    CHECK(s_layer_b.own.anim_cnt == 0 && s_anim_deleted == 2);
+
+    lv_func_goto_layer(&s_layer_empty);
+    lv_func_release_retained_layers();
+    CHECK(NULL == s_layer_b.lv_obj_layer && !s_layer_b.own.paused);
+}
+
+int main(void)
+{
+    lv_init();
+
+    test_disp_create();
+
+    test_delete();
+    test_pause();
+    test_refuse();
+    test_show_layer();
+
+    return test_result();
+}
@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Light beam mask test.
+ *
+ * The cool beams of the light screen are LV_IMG_CF_ALPHA_8BIT masks from the asset pack,
+ * filled with the tint of ui_light_2color.c. Each one is drawn by LVGL like the light layer
+ * does and compared with the colour image it replaced (test/data, the former
+ * light_cool_25..100), both over black. A pixel may differ by 24 of 255 in a channel, three
+ * steps of the red and blue of RGB565, and the pixels drawn by either image by one step (8)
+ * on average. They differ by 21 at most and by 4.9 to 6.6 on average.
+ * The warm beams are not masks: their colour art has a gradient a mask loses, up to 70 of
+ * 255 off.
+ *
+ * Usage: test_light_mask
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "asset_pack_host.h"
+#include "test_util.h"
+
+#define TINT                lv_color_make(0xF0, 0xED, 0xFF)     /* light_image.tint */
+#define MAX_DIFF            (24)
+#define MAX_MEAN_DIFF       (8.0)
+
+LV_IMG_DECLARE(light_cool_25);
+LV_IMG_DECLARE(light_cool_50);
+LV_IMG_DECLARE(light_cool_75);
+LV_IMG_DECLARE(light_cool_100);
+
+typedef struct {
+    const char *mask;
+    const lv_img_dsc_t *art;
+} light_case_t;
+
+static const light_case_t s_cases[] = {
+    {"light_cool_25", &light_cool_25},
+    {"light_cool_50", &light_cool_50},
+    {"light_cool_75", &light_cool_75},
+    {"light_cool_100", &light_cool_100},
+};
+
+#define MAX_W               (160)
+#define MAX_H               (240)
+
+static lv_color_t s_want[MAX_W * MAX_H];
+static lv_color_t s_got[MAX_W * MAX_H];
+
+/* The image drawn by LVGL over black, like the light layer draws it */
+static void draw(lv_color_t *buf, const lv_img_dsc_t *src, lv_opa_t recolor_opa)
+{
+    lv_obj_t *canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, buf, src->header.w, src->header.h, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_COVER);
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.recolor = TINT;
+    dsc.recolor_opa = recolor_opa;
+    lv_canvas_draw_img(canvas, 0, 0, src, &dsc);
+    lv_obj_del(canvas);
+}
+
+static void test_mask(const light_case_t *c)
+{
+    const lv_img_dsc_t *mask = lv_asset_img(c->mask);
+    CHECK(mask != NULL && mask->header.cf == LV_IMG_CF_ALPHA_8BIT);
+    if (!mask) {
+        return;
+    }
+    CHECK(mask->header.w == c->art->header.w && mask->header.h == c->art->header.h);
+
+    if (mask->header.w > MAX_W || mask->header.h > MAX_H) {
+        CHECK(false);
+        return;
+    }
+    draw(s_want, c->art, LV_OPA_TRANSP);
+    draw(s_got, mask, LV_OPA_COVER);
+
+    uint32_t px = 0;
+    uint32_t sum = 0;
+    int max = 0;
+    for (uint32_t i = 0; i < (uint32_t)mask->header.w * mask->header.h; i++) {
+        const lv_color32_t a = {.full = lv_color_to32(s_want[i])};
+        const lv_color32_t b = {.full = lv_color_to32(s_got[i])};
+        if (a.full == b.full && a.full == lv_color_to32(lv_color_black())) {
+            continue;
+        }
+        const int diff = LV_MAX3(abs(a.ch.red - b.ch.red), abs(a.ch.green - b.ch.green),
+                                 abs(a.ch.blue - b.ch.blue));
+        max = LV_MAX(max, diff);
+        sum += diff;
+        px++;
+    }
+    const double mean = px ? (double)sum / px : 0.0;
+    printf("%-16s %6u px  max %2d  mean %.2f\n", c->mask, (unsigned)px, max, mean);
+    CHECK(px > 0);
+    CHECK(max <= MAX_DIFF);
+    CHECK(mean <= MAX_MEAN_DIFF);
+}
+
+int main(void)
+{
+    lv_init();
+    if (asset_pack_host_mount(NULL) != ESP_OK) {
+        return 1;
+    }
+    test_disp_create();
+
+    for (size_t i = 0; i < sizeof(s_cases) / sizeof(s_cases[0]); i++) {
+        test_mask(&s_cases[i]);
+    }
+    return test_result();
+}
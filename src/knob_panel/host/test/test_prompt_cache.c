@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Voice prompt cache test.
+ *
+ * Builds the prompt cache (main/prompt_pcm.c) from the MP3 prompts of spiffs/ the way
+ * app_audio.c does in the prompts partition, and checks that it fits the partition of
+ * partitions.csv, that every prompt decodes to its samples starting with the voice, and that a
+ * tone comes through the low-pass filter, the resampling and the ADPCM clean.
+ *
+ * Then measures the time from a request to the first sample for both paths of
+ * audio_handle_info(): before, the file opened, sniffed by is_mp3() (three seeks) and decoded
+ * by libhelix up to its first frame; after, the prompt looked up in the cache and its first
+ * samples decoded. Both run on the host, from the local file system instead of SPIFFS, so the
+ * times only compare the work. The silence each path plays before the voice is printed too.
+ *
+ * Usage: test_prompt_cache
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "mp3dec.h"
+#include "prompt_pcm.h"
+#include "test_util.h"
+
+#define REPEAT              (20)
+#define FIRST_SAMPLES       (256)           /* Written to the codec at once by app_audio.c */
+
+/* The prompts of app_audio.c, ZERO_PERCENT to ONE_HUNDRED_PERCENT */
+static const char *const s_prompts[] = {
+    "Zero.mp3", "TwentyFive.mp3", "Fifty.mp3", "SeventyFive.mp3", "OneHundred.mp3",
+};
+#define PROMPT_CNT          (sizeof(s_prompts) / sizeof(s_prompts[0]))
+
+static uint8_t *s_cache;
+static size_t s_cache_size;
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int cmp_i64(const void *a, const void *b)
+{
+    const int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Size of the prompts partition */
+static size_t partition_size(void)
+{
+    FILE *fp = fopen(PARTITIONS_CSV, "r");
+    char line[160];
+    size_t size = 0;
+
+    while (fp && fgets(line, sizeof(line), fp)) {
+        /* Name, type, subtype, offset, size: the offset is often left empty */
+        char *field[5] = { line };
+        int n = 1;
+        for (char *c = line; *c && n < 5; c++) {
+            if (',' == *c) {
+                *c = '\0';
+                field[n++] = c + 1;
+            }
+        }
+        if ('#' != line[0] && 5 == n && !strcmp(line, "prompts")) {
+            char *end;
+            size = strtoul(field[4], &end, 0);
+            size *= ('K' == *end) ? 1024 : (('M' == *end) ? 1024 * 1024 : 1);
+        }
+    }
+    if (fp) {
+        fclose(fp);
+    }
+    return size;
+}
+
+/* Write function of the cache in memory, as app_audio.c writes the partition */
+typedef struct {
+    uint32_t offset;
+} sink_t;
+
+static bool sink_write(void *arg, const uint8_t *data, size_t len)
+{
+    sink_t *sink = (sink_t *)arg;
+    if (len > s_cache_size - sink->offset) {
+        return false;
+    }
+    memcpy(s_cache + sink->offset, data, len);
+    sink->offset += len;
+    return true;
+}
+
+static uint32_t s_voice_ms[PROMPT_CNT];     /* Time of the voice in the MP3 */
+
+static void test_build(void)
+{
+    prompt_pcm_header_t hdr = { 0 };
+    prompt_pcm_enc_t enc;
+    sink_t sink = { .offset = PROMPT_PCM_DATA_OFFSET };
+    size_t mp3_total = 0;
+
+    s_cache_size = partition_size();
+    CHECK(s_cache_size > PROMPT_PCM_DATA_OFFSET);
+    s_cache = malloc(s_cache_size);
+    memset(s_cache, 0xff, s_cache_size);
+
+    printf("%-16s %8s %8s %8s %8s\n", "prompt", "mp3 B", "cache B", "played", "voice at");
+    for (size_t i = 0; i < PROMPT_CNT; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", SPIFFS_DIR, s_prompts[i]);
+        FILE *fp = fopen(path, "rb");
+        CHECK(fp);
+        if (!fp) {
+            continue;
+        }
+        fseek(fp, 0, SEEK_END);
+        const long mp3_size = ftell(fp);
+        rewind(fp);
+
+        prompt_pcm_entry_t *entry = &hdr.entries[hdr.count++];
+        entry->offset = sink.offset;
+        entry->src_size = mp3_size;
+        CHECK(prompt_pcm_enc_mp3(&enc, fp, sink_write, &sink));
+        CHECK(prompt_pcm_enc_finish(&enc, &entry->samples));
+        CHECK(enc.in_rate == 44100);
+        sink.offset = (sink.offset + 3) & ~3U;
+        fclose(fp);
+
+        s_voice_ms[i] = enc.voice_at * 1000ULL / PROMPT_PCM_RATE;
+        mp3_total += mp3_size;
+        printf("%-16s %8ld %8u %5u ms %5u ms\n", s_prompts[i], mp3_size, enc.bytes,
+               entry->samples * 1000 / PROMPT_PCM_RATE, s_voice_ms[i]);
+        CHECK(entry->samples > PROMPT_PCM_RATE / 2 && entry->samples <= enc.samples);
+    }
+    prompt_pcm_header_seal(&hdr);
+    memcpy(s_cache, &hdr, sizeof(hdr));
+    printf("cache: %u of %zu B of the partition for %zu B of MP3\n", sink.offset, s_cache_size, mp3_total);
+
+    CHECK(sizeof(prompt_pcm_header_t) <= PROMPT_PCM_DATA_OFFSET);
+    CHECK(prompt_pcm_header_valid((const prompt_pcm_header_t *)s_cache, s_cache_size));
+    CHECK(!prompt_pcm_header_valid((const prompt_pcm_header_t *)s_cache, sink.offset - 4));
+
+    /* Every prompt plays its samples, the voice within the pre-roll */
+    const prompt_pcm_header_t *cache = (const prompt_pcm_header_t *)s_cache;
+    int16_t pcm[FIRST_SAMPLES];
+    for (int i = 0; i < cache->count; i++) {
+        prompt_pcm_dec_t dec;
+        uint32_t total = 0, voice = UINT32_MAX;
+        size_t n;
+        prompt_pcm_dec_init(&dec, s_cache, &cache->entries[i]);
+        while ((n = prompt_pcm_dec_read(&dec, pcm, FIRST_SAMPLES))) {
+            for (size_t j = 0; j < n && UINT32_MAX == voice; j++) {
+                if (abs(pcm[j]) > PROMPT_PCM_LOUD) {
+                    voice = total + j;
+                }
+            }
+            total += n;
+        }
+        CHECK(total == cache->entries[i].samples);
+        CHECK(voice <= PROMPT_PCM_PREROLL + 8);
+    }
+
+    /* A changed header is not taken */
+    s_cache[offsetof(prompt_pcm_header_t, entries)] ^= 1;
+    CHECK(!prompt_pcm_header_valid((const prompt_pcm_header_t *)s_cache, s_cache_size));
+    s_cache[offsetof(prompt_pcm_header_t, entries)] ^= 1;
+}
+
+/* A 1 kHz tone between two silences, fitted with a sine after the round trip */
+static bool tone_write(void *arg, const uint8_t *data, size_t len)
+{
+    sink_t *sink = (sink_t *)arg;
+    memcpy(s_cache + sink->offset, data, len);
+    sink->offset += len;
+    return true;
+}
+
+static void test_tone(void)
+{
+    const int rate = 44100, amp = 8000;
+    const int before = rate / 5, tone = rate / 2, after = rate * 3 / 10;
+    static int16_t in[2 * 44100];
+    static int16_t out[PROMPT_PCM_RATE];
+    prompt_pcm_enc_t enc;
+    prompt_pcm_entry_t entry = { .offset = 0 };
+    sink_t sink = { 0 };
+
+    memset(in, 0, sizeof(in));
+    for (int i = 0; i < tone; i++) {
+        const int16_t s = (int16_t)lround(amp * sin(2 * M_PI * 1000 * i / rate));
+        in[2 * (before + i)] = s;
+        in[2 * (before + i) + 1] = s;
+    }
+    prompt_pcm_enc_init(&enc, rate, tone_write, &sink);
+    CHECK(prompt_pcm_enc_push(&enc, in, before + tone + after, 2));
+    CHECK(prompt_pcm_enc_finish(&enc, &entry.samples));
+
+    /* Leading silence left out, trailing silence not played */
+    const uint32_t expect = (uint32_t)tone * PROMPT_PCM_RATE / rate + PROMPT_PCM_PREROLL + PROMPT_PCM_TAIL;
+    CHECK(abs((int)entry.samples - (int)expect) < PROMPT_PCM_RATE / 100);
+    CHECK(abs((int)enc.voice_at - before * PROMPT_PCM_RATE / rate) < 16);
+
+    prompt_pcm_dec_t dec;
+    prompt_pcm_dec_init(&dec, s_cache, &entry);
+    const size_t n = prompt_pcm_dec_read(&dec, out, PROMPT_PCM_RATE);
+    CHECK(n == entry.samples);
+
+    /* Least squares fit of a sine and a cosine over the middle of the tone */
+    double ss = 0, cc = 0, sc = 0, ys = 0, yc = 0;
+    const int from = PROMPT_PCM_PREROLL + PROMPT_PCM_RATE / 20, to = from + PROMPT_PCM_RATE / 4;
+    for (int i = from; i < to; i++) {
+        const double s = sin(2 * M_PI * 1000 * i / PROMPT_PCM_RATE), c = cos(2 * M_PI * 1000 * i / PROMPT_PCM_RATE);
+        ss += s * s;
+        cc += c * c;
+        sc += s * c;
+        ys += out[i] * s;
+        yc += out[i] * c;
+    }
+    const double det = ss * cc - sc * sc;
+    const double a = (ys * cc - yc * sc) / det, b = (yc * ss - ys * sc) / det;
+    double sig = 0, noise = 0;
+    for (int i = from; i < to; i++) {
+        const double fit = a * sin(2 * M_PI * 1000 * i / PROMPT_PCM_RATE) + b * cos(2 * M_PI * 1000 * i / PROMPT_PCM_RATE);
+        sig += fit * fit;
+        noise += (out[i] - fit) * (out[i] - fit);
+    }
+    const double snr = 10 * log10(sig / noise);
+    const double gain = sqrt(a * a + b * b) / amp;
+    printf("tone: %.1f dB SNR, gain %.3f\n", snr, gain);
+    CHECK(snr > 25);
+    CHECK(fabs(gain - 1) < 0.05);
+}
+
+/* The path of audio_handle_info() before the cache, up to the first frame of samples */
+static int64_t mp3_first_sample_us(const char *name)
+{
+    static uint8_t in[2 * MAINBUF_SIZE];
+    static int16_t pcm[MAX_NCHAN * MAX_NGRAN * MAX_NSAMP];
+    char path[256];
+    uint8_t magic[10];
+
+    const int64_t start = now_us();
+    snprintf(path, sizeof(path), "%s/%s", SPIFFS_DIR, name);
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return -1;
+    }
+    /* is_mp3() of esp-audio-player */
+    fseek(fp, 0, SEEK_SET);
+    fread(magic, 1, 3, fp);
+    fseek(fp, 0, SEEK_SET);
+    fread(magic, 1, sizeof(magic), fp);
+    fseek(fp, 0, SEEK_SET);
+
+    /* decode_mp3() of esp-audio-player, which starts every file with a new decoder state */
+    HMP3Decoder mp3 = MP3InitDecoder();
+    int left = fread(in, 1, sizeof(in), fp);
+    uint8_t *ptr = in;
+    int64_t first = -1;
+    while (left > 0 && first < 0) {
+        const int sync = MP3FindSyncWord(ptr, left);
+        if (sync < 0) {
+            break;
+        }
+        ptr += sync;
+        left -= sync;
+        const int err = MP3Decode(mp3, &ptr, &left, pcm, 0);
+        if (!err) {
+            first = now_us() - start;
+        } else if (ERR_MP3_INDATA_UNDERFLOW == err) {
+            memmove(in, ptr, left);
+            ptr = in;
+            left += fread(in + left, 1, sizeof(in) - left, fp);
+        } else if (ERR_MP3_MAINDATA_UNDERFLOW != err) {
+            ptr++;
+            left--;
+        }
+    }
+    MP3FreeDecoder(mp3);
+    fclose(fp);
+    return first;
+}
+
+/* The path with the cache: the prompt looked up and its first samples decoded */
+static int64_t cache_first_sample_us(int index)
+{
+    static int16_t pcm[FIRST_SAMPLES];
+    prompt_pcm_dec_t dec;
+
+    const int64_t start = now_us();
+    const prompt_pcm_header_t *cache = (const prompt_pcm_header_t *)s_cache;
+    prompt_pcm_dec_init(&dec, s_cache, &cache->entries[index]);
+    const size_t n = prompt_pcm_dec_read(&dec, pcm, FIRST_SAMPLES);
+    const int64_t first = now_us() - start;
+    return n ? first : -1;
+}
+
+static void test_latency(void)
+{
+    int64_t mp3[REPEAT], cache[REPEAT];
+
+    printf("request to first sample (median of %d), then silence before the voice:\n", REPEAT);
+    for (size_t i = 0; i < PROMPT_CNT; i++) {
+        for (int r = 0; r < REPEAT; r++) {
+            mp3[r] = mp3_first_sample_us(s_prompts[i]);
+            cache[r] = cache_first_sample_us(i);
+        }
+        qsort(mp3, REPEAT, sizeof(mp3[0]), cmp_i64);
+        qsort(cache, REPEAT, sizeof(cache[0]), cmp_i64);
+        printf("%-16s mp3 %5lld us + %4u ms, cache %3lld us + %2u ms\n", s_prompts[i],
+               (long long)mp3[REPEAT / 2], s_voice_ms[i], (long long)cache[REPEAT / 2],
+               PROMPT_PCM_PREROLL * 1000 / PROMPT_PCM_RATE);
+        CHECK(mp3[0] > 0 && cache[0] >= 0);
+        CHECK(cache[REPEAT / 2] < mp3[REPEAT / 2]);
+    }
+}
+
+int main(void)
+{
+    test_build();
+    test_latency();
+    test_tone();
+
+    free(s_cache);
+    return test_result();
+}
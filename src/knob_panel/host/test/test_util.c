@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include "test_util.h"
+
+static int s_failures;
+
+void test_check(bool cond, const char *what, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, what);
+        s_failures++;
+    }
+}
+
+int test_result(void)
+{
+    printf("%d failures\n", s_failures);
+    return s_failures ? 1 : 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/*
+ * Helpers shared by the host tests.
+ *
+ * CHECK() prints the failed condition with its line and counts it, test_result() prints the
+ * count and gives the exit status of the test. test_disp_create() (test_disp.c, linked with
+ * LVGL) registers a headless 240x240 display which flushes nothing.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHECK(cond)         test_check(cond, #cond, __LINE__)
+
+struct _lv_disp_t;
+
+/**
+ * @brief Count a failed condition, use CHECK()
+ *
+ * @param cond Condition checked
+ * @param what Condition as written
+ * @param line Line of the check
+ */
+void test_check(bool cond, const char *what, int line);
+
+/**
+ * @brief Print the failures of the test
+ *
+ * @return Exit status of the test: 0 without failures, else 1
+ */
+int test_result(void);
+
+/**
+ * @brief Register a headless display of the size of the panel, after lv_init()
+ *
+ * @return The display
+ */
+struct _lv_disp_t *test_disp_create(void);
+
+#ifdef __cplusplus
+}
+#endif
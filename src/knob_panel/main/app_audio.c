@@ -5,8 +5,14 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "esp_task_wdt.h"
 #include "esp_check.h"
@@ -15,19 +21,55 @@
 #include "esp_timer.h"
 #include "esp_spiffs.h"
 #include "esp_vfs.h"
+#include "esp_partition.h"
 #include "freertos/event_groups.h"
 #include "app_audio.h"
 #include "audio_player.h"
+#include "prompt_pcm.h"
 #include "bsp/esp-bsp.h"
 
 static const char *TAG = "app_audio";
 
+/* Voice prompts, ZERO_PERCENT onwards, played from the prompts partition once decoded there */
+static const char *const prompt_files[] = {
+    "Zero.mp3", "TwentyFive.mp3", "Fifty.mp3", "SeventyFive.mp3", "OneHundred.mp3",
+};
+#define PROMPT_CNT              (sizeof(prompt_files) / sizeof(prompt_files[0]))
+#define PROMPT_CHUNK_SAMPLES    256         /* Decoded and written to the codec at once, 16 ms */
+#define PROMPT_TASK_PRIORITY    5           /* As the audio player, the cache is built below it */
+
+typedef struct {
+    uint32_t rate;
+    uint32_t bits;
+    i2s_slot_mode_t ch;
+} audio_clk_t;
+
+typedef struct {
+    const esp_partition_t *part;
+    uint32_t offset;
+} prompt_sink_t;
+
 //static EventGroupHandle_t event_group;
 static esp_codec_dev_handle_t play_dev_handle;
+static SemaphoreHandle_t codec_lock;        /* The player and the prompts take turns on the codec */
+static audio_clk_t player_clk;              /* Format of the file the player plays */
+static bool player_clk_lost;                /* A prompt changed the format under the player */
+static const void *_Atomic prompt_cache;    /* Mapped prompts partition, NULL while it is not built */
+static QueueHandle_t prompt_queue;          /* Prompt to play, a newer request replaces it */
+static _Atomic int64_t request_us;          /* Time of the request waiting for its first sample */
 
 static esp_err_t bsp_audio_reconfig_clk(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch);
 static esp_err_t bsp_audio_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms);
 
+/* Latency of the request: logged when its first sample goes to the codec */
+static void audio_first_sample(const char *source)
+{
+    const int64_t request = atomic_exchange(&request_us, 0);
+    if (request) {
+        ESP_LOGI(TAG, "first sample %lld us after the request (%s)", esp_timer_get_time() - request, source);
+    }
+}
+
 esp_err_t audio_force_quite(bool ret)
 {
     return audio_player_stop();
@@ -37,19 +79,46 @@ esp_err_t app_audio_write(void *audio_buffer, size_t len, size_t *bytes_written,
 {
     esp_err_t ret = ESP_OK;
 
+    xSemaphoreTake(codec_lock, portMAX_DELAY);
+    if (player_clk_lost) {
+        bsp_audio_reconfig_clk(player_clk.rate, player_clk.bits, player_clk.ch);
+        player_clk_lost = false;
+    }
+    audio_first_sample("mp3");
     if (bsp_audio_write(audio_buffer, len, bytes_written, 1000) != ESP_OK) {
         ESP_LOGE(TAG, "Write Task: i2s write failed");
         ret = ESP_FAIL;
     }
+    xSemaphoreGive(codec_lock);
 
     return ret;
 }
 
+static esp_err_t app_audio_reconfig_clk(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch)
+{
+    xSemaphoreTake(codec_lock, portMAX_DELAY);
+    player_clk = (audio_clk_t) {
+        .rate = rate, .bits = bits_cfg, .ch = ch,
+    };
+    player_clk_lost = false;
+    esp_err_t ret = bsp_audio_reconfig_clk(rate, bits_cfg, ch);
+    xSemaphoreGive(codec_lock);
+    return ret;
+}
+
 esp_err_t audio_handle_info(PDM_SOUND_TYPE voice)
 {
     char filepath[30];
     esp_err_t ret = ESP_OK;
 
+    atomic_store(&request_us, esp_timer_get_time());
+    if (voice >= ZERO_PERCENT && voice <= ONE_HUNDRED_PERCENT && atomic_load(&prompt_cache)) {
+        /* Straight from the cache to the codec, neither SPIFFS nor the MP3 decoder */
+        const uint8_t index = voice - ZERO_PERCENT;
+        xQueueOverwrite(prompt_queue, &index);
+        return ESP_OK;
+    }
+
     switch (voice) {
     case SOUND_TYPE_KNOB:
         sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "knob_1ch.mp3");
@@ -68,19 +137,11 @@ esp_err_t audio_handle_info(PDM_SOUND_TYPE voice)
         sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "factory.mp3");
         break;
     case ZERO_PERCENT:
-        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "Zero.mp3");
-        break;
     case TWENTY_FIVE_PERCENT:
-        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "TwentyFive.mp3");
-        break;
     case FIFTY_PERCENT:
-        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "Fifty.mp3");
-        break;
     case SEVENTY_FIVE_PERCENT:
-        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "SeventyFive.mp3");
-        break;
     case ONE_HUNDRED_PERCENT:
-        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, "OneHundred.mp3");
+        sprintf(filepath, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, prompt_files[voice - ZERO_PERCENT]);
         break;
     }
 
@@ -149,6 +210,143 @@ static esp_err_t bsp_audio_write(void *audio_buffer, size_t len, size_t *bytes_w
     return ret;
 }
 
+static void prompt_play(uint8_t index)
+{
+    static int16_t pcm[PROMPT_CHUNK_SAMPLES];
+    const void *cache = atomic_load(&prompt_cache);
+    const prompt_pcm_header_t *hdr = cache;
+    prompt_pcm_dec_t dec;
+    size_t n;
+
+    /* Cut the player short, as a new file would */
+    if (AUDIO_PLAYER_STATE_PLAYING == audio_player_get_state()) {
+        audio_player_stop();
+        for (int i = 0; i < 10 && AUDIO_PLAYER_STATE_PLAYING == audio_player_get_state(); i++) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+
+    xSemaphoreTake(codec_lock, portMAX_DELAY);
+    bsp_audio_reconfig_clk(PROMPT_PCM_RATE, I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
+    player_clk_lost = true;
+    prompt_pcm_dec_init(&dec, cache, &hdr->entries[index]);
+    while ((n = prompt_pcm_dec_read(&dec, pcm, PROMPT_CHUNK_SAMPLES))) {
+        audio_first_sample("cache");
+        esp_codec_dev_write(play_dev_handle, pcm, n * sizeof(pcm[0]));
+        if (uxQueueMessagesWaiting(prompt_queue)) {
+            break;      /* Replaced by a newer prompt */
+        }
+    }
+    xSemaphoreGive(codec_lock);
+}
+
+static bool prompt_partition_write(void *arg, const uint8_t *data, size_t len)
+{
+    prompt_sink_t *sink = (prompt_sink_t *)arg;
+
+    if (len > sink->part->size - sink->offset || ESP_OK != esp_partition_write(sink->part, sink->offset, data, len)) {
+        return false;
+    }
+    sink->offset += len;
+    return true;
+}
+
+/* The cache was decoded from the prompts now in SPIFFS. st_mtime is only kept with
+ * CONFIG_SPIFFS_USE_MTIME, set in sdkconfig.defaults, the image build stores it then. */
+static bool prompt_cache_current(const esp_partition_t *part, const prompt_pcm_header_t *hdr)
+{
+    char path[48];
+    struct stat st;
+
+    if (!prompt_pcm_header_valid(hdr, part->size) || PROMPT_CNT != hdr->count) {
+        return false;
+    }
+    for (int i = 0; i < PROMPT_CNT; i++) {
+        sprintf(path, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, prompt_files[i]);
+        if (stat(path, &st) || hdr->entries[i].src_size != st.st_size || hdr->entries[i].src_mtime != (uint32_t)st.st_mtime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Decode every prompt into the partition, the header last so that an interrupted build is not taken */
+static esp_err_t prompt_cache_build(const esp_partition_t *part, prompt_pcm_header_t *hdr)
+{
+    esp_err_t ret = ESP_OK;
+    char path[48];
+    struct stat st;
+    prompt_sink_t sink = {
+        .part = part,
+        .offset = PROMPT_PCM_DATA_OFFSET,
+    };
+
+    prompt_pcm_enc_t *enc = malloc(sizeof(prompt_pcm_enc_t));
+    ESP_RETURN_ON_FALSE(enc, ESP_ERR_NO_MEM, TAG, "no memory for the prompt encoder");
+    ESP_GOTO_ON_ERROR(esp_partition_erase_range(part, 0, part->size), err, TAG, "erase the prompts partition");
+
+    memset(hdr, 0, sizeof(prompt_pcm_header_t));
+    for (int i = 0; i < PROMPT_CNT; i++) {
+        sprintf(path, "%s/%s", CONFIG_BSP_SPIFFS_MOUNT_POINT, prompt_files[i]);
+        ESP_GOTO_ON_FALSE(0 == stat(path, &st), ESP_ERR_NOT_FOUND, err, TAG, "no prompt %s", path);
+        FILE *fp = fopen(path, "r");
+        ESP_GOTO_ON_FALSE(fp, ESP_ERR_NOT_FOUND, err, TAG, "Failed open file:%s", path);
+
+        prompt_pcm_entry_t *entry = &hdr->entries[hdr->count++];
+        entry->offset = sink.offset;
+        entry->src_size = st.st_size;
+        entry->src_mtime = st.st_mtime;
+        const bool ok = prompt_pcm_enc_mp3(enc, fp, prompt_partition_write, &sink) &&
+                        prompt_pcm_enc_finish(enc, &entry->samples);
+        fclose(fp);
+        ESP_GOTO_ON_FALSE(ok, ESP_ERR_NO_MEM, err, TAG, "decode %s into the cache", path);
+        sink.offset = (sink.offset + 3) & ~3;
+    }
+    prompt_pcm_header_seal(hdr);
+    ESP_GOTO_ON_ERROR(esp_partition_write(part, 0, hdr, sizeof(prompt_pcm_header_t)), err, TAG, "write the prompt cache header");
+    ESP_LOGI(TAG, "prompt cache: %"PRIu32" of %"PRIu32" bytes", sink.offset, part->size);
+err:
+    free(enc);
+    return ret;
+}
+
+/* Builds the cache if the prompts changed, then plays the prompts from it */
+static void prompt_task(void *arg)
+{
+    prompt_pcm_header_t hdr;
+    const void *base = NULL;
+    esp_partition_mmap_handle_t handle;
+    uint8_t index;
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "prompts");
+    esp_err_t ret = part ? esp_partition_read(part, 0, &hdr, sizeof(hdr)) : ESP_ERR_NOT_FOUND;
+    if (ESP_OK == ret && !prompt_cache_current(part, &hdr)) {
+        const int64_t start = esp_timer_get_time();
+        ret = prompt_cache_build(part, &hdr);
+        if (ESP_OK == ret) {
+            ESP_LOGI(TAG, "prompts decoded in %lld ms", (esp_timer_get_time() - start) / 1000);
+        } else {
+            ESP_LOGE(TAG, "prompt cache build failed (%s)", esp_err_to_name(ret));
+        }
+    }
+    if (ESP_OK == ret) {
+        ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &base, &handle);
+    }
+    if (ESP_OK != ret) {
+        ESP_LOGW(TAG, "no prompt cache (%s), the prompts play from SPIFFS", esp_err_to_name(ret));
+        vTaskDelete(NULL);
+        return;
+    }
+
+    atomic_store(&prompt_cache, base);
+    vTaskPrioritySet(NULL, PROMPT_TASK_PRIORITY);
+    while (true) {
+        if (xQueueReceive(prompt_queue, &index, portMAX_DELAY)) {
+            prompt_play(index);
+        }
+    }
+}
+
 static void bsp_codec_init()
 {
     play_dev_handle = bsp_audio_codec_speaker_init();
@@ -160,14 +358,21 @@ esp_err_t audio_play_start()
     esp_err_t ret = ESP_OK;
 
     bsp_codec_init();
+    codec_lock = xSemaphoreCreateMutex();
+    prompt_queue = xQueueCreate(1, sizeof(uint8_t));
+    ESP_RETURN_ON_FALSE(codec_lock && prompt_queue, ESP_ERR_NO_MEM, TAG, "no memory for the prompts");
 
     audio_player_config_t config = {
         .mute_fn = app_mute_function,
         .write_fn = app_audio_write,
-        .clk_set_fn = bsp_audio_reconfig_clk,
+        .clk_set_fn = app_audio_reconfig_clk,
         .priority = 5
     };
     ESP_ERROR_CHECK(audio_player_new(config));
     audio_player_callback_register(audio_callback,NULL);
+
+    /* Decoding the prompts takes a few seconds after they changed, below the UI */
+    BaseType_t ret_val = xTaskCreate(prompt_task, "Prompt Task", 4 * 1024, NULL, tskIDLE_PRIORITY + 1, NULL);
+    ESP_RETURN_ON_FALSE(pdPASS == ret_val, ESP_ERR_NO_MEM, TAG, "prompt task create failed");
     return ret;
 }
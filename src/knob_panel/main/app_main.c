@@ -7,10 +7,14 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
 #include "esp_heap_caps.h"
+#include "esp_pm.h"
+#include "esp_partition.h"
+#include "esp_check.h"
 #include "nvs_flash.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
@@ -18,6 +22,11 @@
 #include "app_audio.h"
 #include "settings.h"
 #include "lv_example_pub.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+#include "lv_layer_transition.h"
+#include "lv_asset_pack.h"
 #include "bsp/esp-bsp.h"
 
 static const char *TAG = "main";
@@ -153,6 +162,23 @@ static void monitor_task(void *arg)
         printf("Min. Ever Free Size\t%d\t\t%d\n",
                heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL),
                heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM));
+        printf("LVGL Wakeups/s\t\t%"PRIu32"\n", lvgl_port_get_wakeups_per_sec());
+        lvgl_port_idle_stats_t idle;
+        lvgl_port_get_idle_stats(&idle);
+        printf("LVGL Idle\t\t%llu ms idle, %llu ms active, %"PRIu32" periods, longest %"PRIu32" ms\n",
+               idle.idle_us / 1000, idle.active_us / 1000, idle.entries, idle.longest_ms);
+        lvgl_port_reset_idle_stats();
+        lv_img_lru_stats_t img_cache;
+        lv_img_lru_get_stats(&img_cache);
+        printf("Image Cache\t\t%"PRIu32" hits, %"PRIu32" misses, %"PRIu32" evictions, %"PRIu32" B (peak %"PRIu32" B), %u pinned\n",
+               img_cache.hits, img_cache.misses, img_cache.evictions, img_cache.bytes, img_cache.peak_bytes, img_cache.pinned);
+        lv_img_lru_reset_stats();
+        static lvgl_port_latency_stats_t latency;
+        if (lvgl_port_get_latency_stats(&latency) == ESP_OK && latency.stages[LVGL_PORT_LATENCY_TOTAL].count) {
+            printf("Knob Latency\n");
+            lvgl_port_print_latency_stats(&latency);
+            lvgl_port_reset_latency_stats();
+        }
 
         printf("Getting real time stats over %d ticks\n", STATS_TICKS);
         if (print_real_time_stats(STATS_TICKS) == ESP_OK) {
@@ -175,6 +201,45 @@ static void sys_monitor_start(void)
 #endif
 
 
+#if CONFIG_PM_ENABLE
+static void power_save_init(void)
+{
+    /* The LVGL port stops its tick when the UI is idle, the knob and button wake up over GPIO */
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = CONFIG_XTAL_FREQ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = true,
+#endif
+    };
+    ESP_ERROR_CHECK(esp_pm_configure(&pm_config));
+}
+#endif
+
+/* The images are mapped from the assets partition for the lifetime of the application */
+static esp_err_t asset_pack_mount(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "assets");
+    ESP_RETURN_ON_FALSE(part, ESP_ERR_NOT_FOUND, TAG, "no assets partition");
+
+    const void *base = NULL;
+    esp_partition_mmap_handle_t handle;
+    ESP_RETURN_ON_ERROR(esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &base, &handle),
+                        TAG, "map the assets partition");
+    return lv_asset_pack_load(base, part->size);
+}
+
+/* Without its images the UI cannot be built: say how to write them instead of starting it */
+static void asset_pack_missing_screen(void)
+{
+    lv_obj_t *label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 180);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label, "No images in the assets partition.\nidf.py -p PORT assets-flash");
+    lv_obj_center(label);
+}
+
 esp_err_t bsp_board_init(void)
 {
     ESP_ERROR_CHECK(bsp_led_init());
@@ -193,14 +258,33 @@ void app_main(void)
     }
     ESP_ERROR_CHECK(err);
     ESP_ERROR_CHECK(settings_read_parameter_from_nvs());
+    /* Blank or stale after flashing the application alone, keep booting to say so */
+    const esp_err_t assets_err = asset_pack_mount();
+    if (ESP_OK != assets_err) {
+        ESP_LOGE(TAG, "no asset pack (%s), write it with `idf.py -p PORT assets-flash`", esp_err_to_name(assets_err));
+    }
 
-    bsp_display_start();
+#if CONFIG_PM_ENABLE
+    power_save_init();
+#endif
+    lv_disp_t *disp = bsp_display_start();
 
     ESP_LOGI(TAG, "Display LVGL demo");
+    lv_img_rle_init();
+    lv_img_transform_init(disp);
+    lv_layer_transition_init(disp);
     ui_obj_to_encoder_init();
-    lv_create_home(&boot_Layer);
-    lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
+    if (ESP_OK == assets_err) {
+        lv_create_home(&boot_Layer);
+        lv_create_clock(&clock_screen_layer, TIME_ENTER_CLOCK_2MIN);
+    } else {
+        asset_pack_missing_screen();
+    }
     bsp_display_unlock();
+    bsp_display_wake();
+    /* The image caches and the transition snapshot take from what is left here, see lv_sys_heap.h */
+    ESP_LOGI(TAG, "internal heap after the UI: %u bytes free, largest block %u",
+             heap_caps_get_free_size(MALLOC_CAP_INTERNAL), heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
 
     vTaskDelay(pdMS_TO_TICKS(500));
     bsp_display_backlight_on();
@@ -0,0 +1,337 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "mp3dec.h"
+#include "prompt_pcm.h"
+
+#define MP3_IN_SIZE     (2 * MAINBUF_SIZE)
+
+static const int16_t s_adpcm_step[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+static const int8_t s_adpcm_index[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static int16_t clamp16(int32_t v)
+{
+    return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v);
+}
+
+/* Apply a code to the predictor, the encoder does it too to stay in step with the decoder */
+static int16_t adpcm_apply(prompt_pcm_adpcm_t *st, uint8_t code)
+{
+    const int32_t step = s_adpcm_step[st->index];
+    int32_t diff = step >> 3;
+
+    if (code & 4) {
+        diff += step;
+    }
+    if (code & 2) {
+        diff += step >> 1;
+    }
+    if (code & 1) {
+        diff += step >> 2;
+    }
+    st->predictor = clamp16(st->predictor + ((code & 8) ? -diff : diff));
+    const int index = st->index + s_adpcm_index[code];
+    st->index = index < 0 ? 0 : (index > 88 ? 88 : index);
+    return st->predictor;
+}
+
+static uint8_t adpcm_encode(prompt_pcm_adpcm_t *st, int16_t sample)
+{
+    int32_t diff = sample - st->predictor;
+    int32_t step = s_adpcm_step[st->index];
+    uint8_t code = 0;
+
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+    }
+    adpcm_apply(st, code);
+    return code;
+}
+
+static void enc_flush(prompt_pcm_enc_t *enc)
+{
+    if (enc->buf_len && !enc->failed) {
+        enc->failed = !enc->write(enc->arg, enc->buf, enc->buf_len);
+    }
+    enc->bytes += enc->buf_len;
+    enc->buf_len = 0;
+}
+
+/* Two codes a byte, the first one in the low nibble */
+static void enc_code(prompt_pcm_enc_t *enc, int16_t sample)
+{
+    const uint8_t code = adpcm_encode(&enc->adpcm, sample);
+
+    if (enc->samples & 1) {
+        enc->buf[enc->buf_len++] |= code << 4;
+        if (enc->buf_len == sizeof(enc->buf)) {
+            enc_flush(enc);
+        }
+    } else {
+        enc->buf[enc->buf_len] = code;
+    }
+    enc->samples++;
+    if (abs(sample) > PROMPT_PCM_LOUD) {
+        enc->voice_end = enc->samples;
+    }
+}
+
+/* A resampled sample: held back until the voice starts, then encoded */
+static void enc_resampled(prompt_pcm_enc_t *enc, int16_t sample)
+{
+    const uint32_t at = enc->out_count++;
+
+    if (UINT32_MAX == enc->voice_at) {
+        if (abs(sample) <= PROMPT_PCM_LOUD) {
+            enc->preroll[at % PROMPT_PCM_PREROLL] = sample;
+            return;
+        }
+        enc->voice_at = at;
+        for (uint32_t i = at > PROMPT_PCM_PREROLL ? at - PROMPT_PCM_PREROLL : 0; i < at; i++) {
+            enc_code(enc, enc->preroll[i % PROMPT_PCM_PREROLL]);
+        }
+    }
+    enc_code(enc, sample);
+}
+
+/* Low-pass filter the input, then take the samples at PROMPT_PCM_RATE between two inputs */
+static void enc_sample(prompt_pcm_enc_t *enc, int16_t x)
+{
+    enc->hist[enc->hist_pos] = x;
+    enc->hist[enc->hist_pos + PROMPT_PCM_TAPS] = x;
+    enc->hist_pos = (enc->hist_pos + 1) % PROMPT_PCM_TAPS;
+
+    const int16_t *h = &enc->hist[enc->hist_pos];
+    int32_t acc = 0;
+    for (int i = 0; i < PROMPT_PCM_TAPS; i++) {
+        acc += enc->coef[i] * h[i];
+    }
+    const int32_t y = clamp16(acc >> 14);
+
+    /* Output k lies at k * in_rate / PROMPT_PCM_RATE inputs, after input n - 1 and up to input n */
+    const int64_t n = enc->in_count++;
+    while ((int64_t)enc->out_count * enc->in_rate <= n * PROMPT_PCM_RATE) {
+        const int64_t num = (int64_t)enc->out_count * enc->in_rate - (n - 1) * PROMPT_PCM_RATE;
+        enc_resampled(enc, clamp16(enc->last + (int32_t)((y - enc->last) * num / PROMPT_PCM_RATE)));
+    }
+    enc->last = y;
+}
+
+void prompt_pcm_enc_init(prompt_pcm_enc_t *enc, uint32_t in_rate, prompt_pcm_write_t write, void *arg)
+{
+    memset(enc, 0, sizeof(*enc));
+    enc->in_rate = in_rate;
+    enc->voice_at = UINT32_MAX;
+    enc->write = write;
+    enc->arg = arg;
+
+    /* Windowed sinc, cut off below half of the lower of both rates */
+    const uint32_t rate = in_rate < PROMPT_PCM_RATE ? in_rate : PROMPT_PCM_RATE;
+    const double fc = 0.44 * rate / in_rate;
+    const int mid = PROMPT_PCM_TAPS / 2;
+    double h[PROMPT_PCM_TAPS], sum = 0;
+    for (int i = 0; i < PROMPT_PCM_TAPS; i++) {
+        const double t = i - mid;
+        const double sinc = t ? sin(2 * M_PI * fc * t) / (M_PI * t) : 2 * fc;
+        h[i] = sinc * (0.54 - 0.46 * cos(2 * M_PI * i / (PROMPT_PCM_TAPS - 1)));
+        sum += h[i];
+    }
+    int32_t total = 0;
+    for (int i = 0; i < PROMPT_PCM_TAPS; i++) {
+        enc->coef[i] = (int16_t)lround(h[i] / sum * (1 << 14));
+        total += enc->coef[i];
+    }
+    enc->coef[mid] += (1 << 14) - total;   /* Unity gain for a constant input */
+}
+
+bool prompt_pcm_enc_push(prompt_pcm_enc_t *enc, const int16_t *pcm, size_t frames, int channels)
+{
+    for (size_t i = 0; i < frames; i++) {
+        if (2 == channels) {
+            enc_sample(enc, (pcm[2 * i] + pcm[2 * i + 1]) / 2);
+        } else {
+            enc_sample(enc, pcm[i]);
+        }
+    }
+    return !enc->failed;
+}
+
+bool prompt_pcm_enc_finish(prompt_pcm_enc_t *enc, uint32_t *samples)
+{
+    if (enc->samples & 1) {
+        enc->buf_len++;
+    }
+    enc_flush(enc);
+    *samples = enc->voice_end + PROMPT_PCM_TAIL < enc->samples ? enc->voice_end + PROMPT_PCM_TAIL : enc->samples;
+    return !enc->failed;
+}
+
+/* Past an ID3v2 tag, the MP3 frames follow */
+static void mp3_skip_id3(FILE *fp)
+{
+    uint8_t tag[10];
+    long start = 0;
+
+    if (sizeof(tag) == fread(tag, 1, sizeof(tag), fp) && !memcmp(tag, "ID3", 3)) {
+        start = sizeof(tag) + ((tag[6] & 0x7f) << 21 | (tag[7] & 0x7f) << 14 | (tag[8] & 0x7f) << 7 | (tag[9] & 0x7f));
+        if (tag[5] & 0x10) {
+            start += sizeof(tag);   /* Footer */
+        }
+    }
+    fseek(fp, start, SEEK_SET);
+}
+
+bool prompt_pcm_enc_mp3(prompt_pcm_enc_t *enc, FILE *fp, prompt_pcm_write_t write, void *arg)
+{
+    HMP3Decoder mp3 = MP3InitDecoder();
+    uint8_t *in = malloc(MP3_IN_SIZE);
+    int16_t *pcm = malloc(MAX_NCHAN * MAX_NGRAN * MAX_NSAMP * sizeof(int16_t));
+    bool ok = mp3 && in && pcm;
+    bool started = false;
+    bool eof = false;
+    uint8_t *ptr = in;
+    int left = 0;
+
+    mp3_skip_id3(fp);
+    while (ok) {
+        if (left < MAINBUF_SIZE && !eof) {
+            memmove(in, ptr, left);
+            ptr = in;
+            const size_t want = MP3_IN_SIZE - left;
+            const size_t got = fread(in + left, 1, want, fp);
+            eof = (got < want);
+            left += got;
+        }
+        const int sync = MP3FindSyncWord(ptr, left);
+        if (sync < 0) {
+            if (eof) {
+                break;
+            }
+            /* The last byte may start a sync word */
+            ptr += left - 1;
+            left = 1;
+            continue;
+        }
+        ptr += sync;
+        left -= sync;
+
+        const int err = MP3Decode(mp3, &ptr, &left, pcm, 0);
+        if (ERR_MP3_INDATA_UNDERFLOW == err) {
+            if (eof) {
+                break;
+            }
+            continue;
+        } else if (ERR_MP3_MAINDATA_UNDERFLOW == err) {
+            continue;   /* The bit reservoir fills from the next frames */
+        } else if (err) {
+            ptr++;      /* Not a frame, look for the next sync word */
+            left--;
+            continue;
+        }
+
+        MP3FrameInfo info;
+        MP3GetLastFrameInfo(mp3, &info);
+        if (!started) {
+            prompt_pcm_enc_init(enc, info.samprate, write, arg);
+            started = true;
+        }
+        ok = prompt_pcm_enc_push(enc, pcm, info.outputSamps / info.nChans, info.nChans);
+    }
+
+    free(pcm);
+    free(in);
+    if (mp3) {
+        MP3FreeDecoder(mp3);
+    }
+    return ok && started;
+}
+
+static uint32_t crc32(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t crc = UINT32_MAX;
+
+    while (len--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+void prompt_pcm_header_seal(prompt_pcm_header_t *hdr)
+{
+    hdr->magic = PROMPT_PCM_MAGIC;
+    hdr->version = PROMPT_PCM_VERSION;
+    hdr->sample_rate = PROMPT_PCM_RATE;
+    hdr->crc = crc32(hdr, offsetof(prompt_pcm_header_t, crc));
+}
+
+bool prompt_pcm_header_valid(const prompt_pcm_header_t *hdr, size_t size)
+{
+    if (PROMPT_PCM_MAGIC != hdr->magic || PROMPT_PCM_VERSION != hdr->version ||
+            PROMPT_PCM_RATE != hdr->sample_rate || hdr->count > PROMPT_PCM_MAX ||
+            crc32(hdr, offsetof(prompt_pcm_header_t, crc)) != hdr->crc) {
+        return false;
+    }
+    for (int i = 0; i < hdr->count; i++) {
+        const prompt_pcm_entry_t *entry = &hdr->entries[i];
+        if (entry->offset < PROMPT_PCM_DATA_OFFSET || entry->offset > size ||
+                (entry->samples + 1) / 2 > size - entry->offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void prompt_pcm_dec_init(prompt_pcm_dec_t *dec, const void *base, const prompt_pcm_entry_t *entry)
+{
+    memset(dec, 0, sizeof(*dec));
+    dec->codes = (const uint8_t *)base + entry->offset;
+    dec->samples = entry->samples;
+}
+
+size_t prompt_pcm_dec_read(prompt_pcm_dec_t *dec, int16_t *pcm, size_t max)
+{
+    size_t n = dec->samples - dec->pos;
+
+    if (n > max) {
+        n = max;
+    }
+    for (size_t i = 0; i < n; i++, dec->pos++) {
+        const uint8_t code = (dec->codes[dec->pos >> 1] >> ((dec->pos & 1) * 4)) & 0xf;
+        pcm[i] = adpcm_apply(&dec->adpcm, code);
+    }
+    return n;
+}
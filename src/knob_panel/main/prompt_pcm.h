@@ -0,0 +1,191 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Voice prompt cache: the MP3 prompts decoded once into compact PCM
+ *
+ * The prompts are decoded with libhelix, mixed down to mono, resampled to PROMPT_PCM_RATE and
+ * stored as IMA ADPCM, 4 bits a sample, after a header indexing them. The silence before the
+ * voice is left out but for PROMPT_PCM_PREROLL samples, the silence after it is not played.
+ * app_audio.c builds the cache in the prompts partition and plays it from the mapping.
+ * Nothing here touches the hardware, the host tests build the same cache from the same files.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROMPT_PCM_MAGIC        0x504d5250      /* "PRMP" */
+#define PROMPT_PCM_VERSION      1
+#define PROMPT_PCM_RATE         16000           /* Sample rate of the cache, mono 16 bit once decoded */
+#define PROMPT_PCM_MAX          8               /* Prompts in one cache */
+#define PROMPT_PCM_DATA_OFFSET  4096            /* The header has the first flash sector to itself */
+#define PROMPT_PCM_PREROLL      (PROMPT_PCM_RATE / 100)     /* Kept before the voice, 10 ms */
+#define PROMPT_PCM_TAIL         (PROMPT_PCM_RATE / 20)      /* Played after the voice, 50 ms */
+#define PROMPT_PCM_LOUD         256             /* Samples above this level are voice, about -42 dBFS */
+#define PROMPT_PCM_TAPS         31              /* Low-pass filter in front of the resampling */
+
+/**
+ * @brief One prompt of the cache
+ */
+typedef struct {
+    uint32_t offset;        /*!< Of its ADPCM codes, from the start of the cache */
+    uint32_t samples;       /*!< Samples played */
+    uint32_t src_size;      /*!< Size of the MP3 it was decoded from */
+    uint32_t src_mtime;     /*!< Modification time of the MP3, 0 if the file system keeps none */
+} prompt_pcm_entry_t;
+
+/**
+ * @brief Start of the cache, written once all the prompts are
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t sample_rate;
+    prompt_pcm_entry_t entries[PROMPT_PCM_MAX];
+    uint32_t crc;           /*!< CRC-32 of everything above */
+} prompt_pcm_header_t;
+
+/**
+ * @brief Called with the ADPCM codes of the prompt being encoded, in order
+ *
+ * @return false to abort the encoding (no room left, write error)
+ */
+typedef bool (*prompt_pcm_write_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief State of the predictor shared by the encoder and the decoder
+ */
+typedef struct {
+    int16_t predictor;
+    uint8_t index;
+} prompt_pcm_adpcm_t;
+
+/**
+ * @brief Encoder of one prompt
+ */
+typedef struct {
+    uint32_t in_rate;
+    int16_t coef[PROMPT_PCM_TAPS];          /* Low-pass filter, Q14 */
+    int16_t hist[2 * PROMPT_PCM_TAPS];      /* Input history, twice to read it in one run */
+    uint8_t hist_pos;
+    uint32_t in_count;
+    int32_t last;                           /* Filtered input sample before the current one */
+    uint32_t out_count;                     /* Resampled samples, voice or not */
+    int16_t preroll[PROMPT_PCM_PREROLL];    /* Resampled samples before the voice */
+    uint32_t voice_at;                      /* First sample of the voice, UINT32_MAX before it */
+    prompt_pcm_adpcm_t adpcm;
+    uint32_t samples;                       /* Samples encoded */
+    uint32_t voice_end;                     /* Encoded samples up to the last loud one */
+    uint8_t buf[256];
+    size_t buf_len;
+    uint32_t bytes;                         /* Bytes written */
+    prompt_pcm_write_t write;
+    void *arg;
+    bool failed;
+} prompt_pcm_enc_t;
+
+/**
+ * @brief Reader of one prompt
+ */
+typedef struct {
+    const uint8_t *codes;
+    uint32_t pos;
+    uint32_t samples;
+    prompt_pcm_adpcm_t adpcm;
+} prompt_pcm_dec_t;
+
+/**
+ * @brief Start encoding a prompt
+ *
+ * @param enc Encoder
+ * @param in_rate Sample rate of the input
+ * @param write Called with the codes, a few hundred bytes at a time
+ * @param arg Argument of write
+ */
+void prompt_pcm_enc_init(prompt_pcm_enc_t *enc, uint32_t in_rate, prompt_pcm_write_t write, void *arg);
+
+/**
+ * @brief Encode interleaved 16 bit samples, mixed down to mono
+ *
+ * @param enc Encoder
+ * @param pcm Samples
+ * @param frames Samples of every channel
+ * @param channels 1 or 2
+ * @return false if the write function failed
+ */
+bool prompt_pcm_enc_push(prompt_pcm_enc_t *enc, const int16_t *pcm, size_t frames, int channels);
+
+/**
+ * @brief Write what is left of the prompt
+ *
+ * @param enc Encoder
+ * @param[out] samples Samples to play, up to PROMPT_PCM_TAIL after the voice
+ * @return false if the write function failed
+ */
+bool prompt_pcm_enc_finish(prompt_pcm_enc_t *enc, uint32_t *samples);
+
+/**
+ * @brief Decode an MP3 file and encode it
+ *
+ * The encoder is started with the sample rate of the file, prompt_pcm_enc_finish() is left to
+ * the caller.
+ *
+ * @param enc Encoder, started by this function
+ * @param fp MP3 file, an ID3 tag in front is skipped
+ * @param write Called with the codes
+ * @param arg Argument of write
+ * @return false if the file holds no MP3 frame, memory is short or the write function failed
+ */
+bool prompt_pcm_enc_mp3(prompt_pcm_enc_t *enc, FILE *fp, prompt_pcm_write_t write, void *arg);
+
+/**
+ * @brief Seal a header filled with its prompts
+ *
+ * @param hdr Header, `count` and `entries` set
+ */
+void prompt_pcm_header_seal(prompt_pcm_header_t *hdr);
+
+/**
+ * @brief Check a header read from a cache
+ *
+ * @param hdr Header
+ * @param size Size of the cache it heads
+ * @return true if it was sealed by this version and its prompts lie within the cache
+ */
+bool prompt_pcm_header_valid(const prompt_pcm_header_t *hdr, size_t size);
+
+/**
+ * @brief Start reading a prompt
+ *
+ * @param dec Reader
+ * @param base Start of the cache
+ * @param entry Prompt
+ */
+void prompt_pcm_dec_init(prompt_pcm_dec_t *dec, const void *base, const prompt_pcm_entry_t *entry);
+
+/**
+ * @brief Decode the next samples of the prompt
+ *
+ * @param dec Reader
+ * @param pcm Filled with mono 16 bit samples at PROMPT_PCM_RATE
+ * @param max Room in pcm
+ * @return Samples decoded, 0 at the end of the prompt
+ */
+size_t prompt_pcm_dec_read(prompt_pcm_dec_t *dec, int16_t *pcm, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
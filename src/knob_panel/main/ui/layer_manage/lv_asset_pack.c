@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+
+/* Layout of the pack, see tools/asset_pack.py */
+#define ASSET_PACK_MAGIC        "LVAP"
+#define ASSET_PACK_VERSION      1
+#define ASSET_PACK_FLAG_SWAP    0x01
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t count;
+    uint32_t size;
+    uint32_t flags;
+} asset_pack_header_t;
+
+typedef struct {
+    uint32_t hash;              /* FNV-1a of the name, the entries are sorted by it */
+    uint32_t name_offset;
+    uint32_t data_offset;       /* Shared by the images with the same data */
+    uint32_t data_size;
+    uint8_t cf;
+    uint8_t reserved0;
+    uint16_t w;
+    uint16_t h;
+    uint16_t reserved1;
+} asset_pack_entry_t;
+
+static const char *TAG = "ASSET_PACK";
+
+static struct {
+    const uint8_t *base;
+    const asset_pack_entry_t *entries;
+    uint16_t count;
+    lv_img_dsc_t *imgs;         /* One descriptor per entry, the data stays in the pack */
+} s_pack;
+
+static uint32_t asset_hash(const char *name)
+{
+    uint32_t hash = 0x811c9dc5;
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 0x01000193;
+    }
+    return hash;
+}
+
+esp_err_t lv_asset_pack_load(const void *base, size_t size)
+{
+    const asset_pack_header_t *header = base;
+    ESP_RETURN_ON_FALSE(base && size >= sizeof(*header) && !memcmp(header->magic, ASSET_PACK_MAGIC, 4),
+                        ESP_ERR_INVALID_ARG, TAG, "not an asset pack");
+    ESP_RETURN_ON_FALSE(header->version == ASSET_PACK_VERSION, ESP_ERR_INVALID_VERSION, TAG,
+                        "asset pack version %d, expected %d", header->version, ASSET_PACK_VERSION);
+    ESP_RETURN_ON_FALSE(header->size <= size && sizeof(*header) + header->count * sizeof(asset_pack_entry_t) <= header->size,
+                        ESP_ERR_INVALID_SIZE, TAG, "asset pack of %" PRIu32 " bytes in %u bytes", header->size, (unsigned)size);
+    ESP_RETURN_ON_FALSE(LV_COLOR_DEPTH == 16 && !!(header->flags & ASSET_PACK_FLAG_SWAP) == !!LV_COLOR_16_SWAP,
+                        ESP_ERR_INVALID_ARG, TAG, "asset pack built for another colour format");
+
+    const uint8_t *pack = base;
+    const asset_pack_entry_t *entries = (const asset_pack_entry_t *)(header + 1);
+    for (uint16_t i = 0; i < header->count; i++) {
+        const asset_pack_entry_t *entry = &entries[i];
+        ESP_RETURN_ON_FALSE(entry->name_offset < header->size &&
+                            memchr(pack + entry->name_offset, '\0', header->size - entry->name_offset) &&
+                            entry->data_offset <= header->size && entry->data_size <= header->size - entry->data_offset,
+                            ESP_ERR_INVALID_SIZE, TAG, "asset %d out of the pack", i);
+    }
+
+    lv_img_dsc_t *imgs = calloc(header->count, sizeof(lv_img_dsc_t));
+    ESP_RETURN_ON_FALSE(imgs || !header->count, ESP_ERR_NO_MEM, TAG, "no memory for %d image descriptors", header->count);
+    for (uint16_t i = 0; i < header->count; i++) {
+        imgs[i].header.cf = entries[i].cf;
+        imgs[i].header.always_zero = 0;
+        imgs[i].header.reserved = 0;
+        imgs[i].header.w = entries[i].w;
+        imgs[i].header.h = entries[i].h;
+        imgs[i].data_size = entries[i].data_size;
+        imgs[i].data = pack + entries[i].data_offset;
+    }
+
+    /* The decoded copies of the previous pack are keyed by its descriptors */
+    if (s_pack.imgs) {
+        lv_img_lru_invalidate_src(NULL);
+        lv_img_transform_invalidate(NULL);
+    }
+    free(s_pack.imgs);
+    s_pack.base = pack;
+    s_pack.entries = entries;
+    s_pack.count = header->count;
+    s_pack.imgs = imgs;
+    ESP_LOGI(TAG, "%d images, %" PRIu32 " bytes", header->count, header->size);
+    return ESP_OK;
+}
+
+const lv_img_dsc_t *lv_asset_img(const char *name)
+{
+    const uint32_t hash = asset_hash(name);
+
+    /* First entry with the hash, then the ones sharing it */
+    uint32_t lo = 0;
+    uint32_t hi = s_pack.count;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) / 2;
+        if (s_pack.entries[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (; lo < s_pack.count && s_pack.entries[lo].hash == hash; lo++) {
+        if (!strcmp((const char *)s_pack.base + s_pack.entries[lo].name_offset, name)) {
+            return &s_pack.imgs[lo];
+        }
+    }
+
+    ESP_LOGW(TAG, "no image %s in the asset pack", name);
+    return NULL;
+}
+
+const char *lv_asset_name(size_t index)
+{
+    if (index >= s_pack.count) {
+        return NULL;
+    }
+    return (const char *)s_pack.base + s_pack.entries[index].name_offset;
+}
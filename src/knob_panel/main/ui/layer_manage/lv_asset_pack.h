@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_ASSET_PACK_H
+#define LV_ASSET_PACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Image of the asset pack by the name of its lv_img_dsc_t in main/ui/imgs */
+#define LV_ASSET_IMG(name)      lv_asset_img(#name)
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Index the asset pack built by tools/asset_pack.py
+ *
+ * The pack stays where it is, the image descriptors point into it. It must stay mapped
+ * for as long as LVGL may draw from it.
+ *
+ * @param base Start of the mapped pack (esp_partition_mmap() on the board, mmap() on the host)
+ * @param size Size of the mapping
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if it is not an asset pack or one for another LVGL colour format
+ *      - ESP_ERR_INVALID_VERSION if it was built by another version of the packer
+ *      - ESP_ERR_INVALID_SIZE if it does not fit in the mapping
+ *      - ESP_ERR_NO_MEM if the descriptors cannot be allocated
+ */
+esp_err_t lv_asset_pack_load(const void *base, size_t size);
+
+/**
+ * @brief Look an image of the asset pack up
+ *
+ * @param name Name of the lv_img_dsc_t of the image source
+ * @return Descriptor of the image, NULL if the pack holds no such image
+ */
+const lv_img_dsc_t *lv_asset_img(const char *name);
+
+/**
+ * @brief Name of an image of the asset pack, to list them
+ *
+ * @param index Index of the image, in the order of the pack
+ * @return Name of the image, NULL past the last image
+ */
+const char *lv_asset_name(size_t index);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_ASSET_PACK_H*/
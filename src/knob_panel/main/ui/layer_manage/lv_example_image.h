@@ -14,6 +14,8 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "lv_asset_pack.h"
+#include "lv_img_lru.h"
 
 /*********************
  *      DEFINES
@@ -26,70 +28,7 @@ extern "C" {
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
-LV_IMG_DECLARE(icon_light);
-LV_IMG_DECLARE(icon_washing);
-LV_IMG_DECLARE(icon_thermostat);
-LV_IMG_DECLARE(icon_washing_ns);
-LV_IMG_DECLARE(icon_thermostat_ns);
-LV_IMG_DECLARE(icon_light_ns);
-
-LV_IMG_DECLARE(espressif_logo);
-
-LV_IMG_DECLARE(light_close_bg)
-LV_IMG_DECLARE(light_close_pwm)
-LV_IMG_DECLARE(light_close_status)
-LV_IMG_DECLARE(light_cool_100)
-LV_IMG_DECLARE(light_cool_25)
-LV_IMG_DECLARE(light_cool_50)
-LV_IMG_DECLARE(light_cool_75)
-LV_IMG_DECLARE(light_cool_bg)
-LV_IMG_DECLARE(light_warm_100)
-LV_IMG_DECLARE(light_warm_25)
-LV_IMG_DECLARE(light_warm_50)
-LV_IMG_DECLARE(light_warm_75)
-LV_IMG_DECLARE(light_warm_bg)
-
-LV_IMG_DECLARE(light_pwm_00)
-LV_IMG_DECLARE(light_pwm_25)
-LV_IMG_DECLARE(light_pwm_50)
-LV_IMG_DECLARE(light_pwm_75)
-LV_IMG_DECLARE(light_pwm_100)
-
-LV_IMG_DECLARE(img_washing_bg);
-LV_IMG_DECLARE(img_washing_wave1);
-LV_IMG_DECLARE(img_washing_wave2);
-LV_IMG_DECLARE(img_washing_bubble1);
-LV_IMG_DECLARE(img_washing_bubble2);
-LV_IMG_DECLARE(img_washing_stand);
-LV_IMG_DECLARE(img_washing_shirt);
-LV_IMG_DECLARE(img_washing_underwear);
-LV_IMG_DECLARE(wash_underwear1)
-LV_IMG_DECLARE(wash_underwear2)
-LV_IMG_DECLARE(wash_shirt)
-LV_IMG_DECLARE(wash_basic)
-LV_IMG_DECLARE(wash_blouse)
-LV_IMG_DECLARE(wash_briefs)
-
-LV_IMG_DECLARE(AC_BG)
-LV_IMG_DECLARE(AC_temper)
-LV_IMG_DECLARE(AC_unit)
-
-LV_IMG_DECLARE(standby_eye_left)
-LV_IMG_DECLARE(standby_eye_right)
-LV_IMG_DECLARE(standby_eye_1)
-LV_IMG_DECLARE(standby_eye_2)
-LV_IMG_DECLARE(standby_eye_close)
-LV_IMG_DECLARE(standby_face)
-LV_IMG_DECLARE(standby_mouth_2)
-LV_IMG_DECLARE(standby_eye_1_fade)
-LV_IMG_DECLARE(standby_eye_3)
-LV_IMG_DECLARE(standby_eye_open)
-LV_IMG_DECLARE(standby_mouth_1)
-
-LV_IMG_DECLARE(language_bg)
-LV_IMG_DECLARE(language_bg_dither)
-LV_IMG_DECLARE(language_select)
-LV_IMG_DECLARE(language_unselect)
+/* The images are looked up in the asset pack with LV_ASSET_IMG() */
 
 /********************************
  * font
@@ -19,14 +19,18 @@ static const char *TAG = "LVGL_PUB";
 
 static lv_group_t *group;
 
+/*
+ * The encoder group is the default group, except while lv_func_prefetch_layer() builds a
+ * hidden layer: its objects then go to a group of their own.
+ */
 void ui_add_obj_to_encoder_group(lv_obj_t *obj)
 {
-    lv_group_add_obj(group, obj);
+    lv_group_add_obj(lv_group_get_default(), obj);
 }
 
 void ui_remove_all_objs_from_encoder_group(void)
 {
-    lv_group_remove_all_objs(group);
+    lv_group_remove_all_objs(lv_group_get_default());
 }
 
 void ui_obj_to_encoder_init(void)
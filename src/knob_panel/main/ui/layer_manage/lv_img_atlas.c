@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include "lvgl.h"
+#include "lv_asset_pack.h"
+#include "lv_img_atlas.h"
+
+/*
+ * Offset moving a frame of `size` pixels where lv_obj_align() puts its source image of
+ * `src_size` pixels: the alignment places the start, the middle or the end of the object.
+ */
+static lv_coord_t atlas_align_ofs(lv_coord_t ofs, int anchor, lv_coord_t src_pos, lv_coord_t size, lv_coord_t src_size)
+{
+    switch (anchor) {
+    case 1:
+        return ofs + src_pos + size / 2 - src_size / 2;
+    case 2:
+        return ofs + src_pos + size - src_size;
+    default:
+        return ofs + src_pos;
+    }
+}
+
+lv_obj_t *lv_img_atlas_create(lv_obj_t *parent, const lv_img_atlas_t *atlas)
+{
+    lv_obj_t *obj = lv_img_create(parent);
+    lv_img_set_src(obj, lv_asset_img(atlas->name));
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    return obj;
+}
+
+void lv_img_atlas_set_frame(lv_obj_t *obj, const lv_img_atlas_t *atlas, uint16_t frame,
+                            lv_align_t align, lv_coord_t x_ofs, lv_coord_t y_ofs)
+{
+    LV_ASSERT(frame < atlas->frame_cnt);
+    const lv_img_atlas_frame_t *f = &atlas->frames[frame];
+
+    /* Start, middle or end of the parent on each axis */
+    int x_anchor = 0;
+    int y_anchor = 0;
+    switch (align) {
+    case LV_ALIGN_TOP_MID:      x_anchor = 1; break;
+    case LV_ALIGN_TOP_RIGHT:    x_anchor = 2; break;
+    case LV_ALIGN_BOTTOM_LEFT:  y_anchor = 2; break;
+    case LV_ALIGN_BOTTOM_MID:   x_anchor = 1; y_anchor = 2; break;
+    case LV_ALIGN_BOTTOM_RIGHT: x_anchor = 2; y_anchor = 2; break;
+    case LV_ALIGN_LEFT_MID:     y_anchor = 1; break;
+    case LV_ALIGN_RIGHT_MID:    x_anchor = 2; y_anchor = 1; break;
+    case LV_ALIGN_CENTER:       x_anchor = 1; y_anchor = 1; break;
+    default:                    break;
+    }
+    const lv_coord_t x = atlas_align_ofs(x_ofs, x_anchor, f->src_x, f->w, f->src_w);
+    const lv_coord_t y = atlas_align_ofs(y_ofs, y_anchor, f->src_y, f->h, f->src_h);
+
+    /* Every style change invalidates the object, even with the same value */
+    if (!lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) &&
+            (lv_obj_get_style_width(obj, LV_PART_MAIN) == f->w) && (lv_obj_get_style_height(obj, LV_PART_MAIN) == f->h) &&
+            (lv_img_get_offset_x(obj) == -f->x) && (lv_img_get_offset_y(obj) == -f->y) &&
+            (lv_obj_get_style_align(obj, LV_PART_MAIN) == align) &&
+            (lv_obj_get_style_x(obj, LV_PART_MAIN) == x) && (lv_obj_get_style_y(obj, LV_PART_MAIN) == y)) {
+        return;
+    }
+
+    lv_obj_set_size(obj, f->w, f->h);
+    lv_img_set_offset_x(obj, -f->x);
+    lv_img_set_offset_y(obj, -f->y);
+    lv_obj_align(obj, align, x, y);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+}
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_IMG_ATLAS_H
+#define LV_IMG_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include "lvgl.h"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Rectangle of a frame in the atlas, and where it sits in its source image */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    int16_t src_x;              /* Top left corner in the source image, the transparent border is cut off */
+    int16_t src_y;
+    uint16_t src_w;             /* Size of the source image, the frame is aligned as it would be */
+    uint16_t src_h;
+} lv_img_atlas_frame_t;
+
+/* Generated with the frames by tools/img_atlas.py */
+typedef struct {
+    const char *name;           /* Image of the asset pack */
+    const lv_img_atlas_frame_t *frames;
+    uint16_t frame_cnt;
+} lv_img_atlas_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Create an image showing frames of an atlas
+ *
+ * The image is the whole atlas, the size of the object and the offset of the image
+ * (lv_img_set_offset_x/y()) leave only the rectangle of the frame visible. The object
+ * must not be zoomed or rotated.
+ *
+ * @param parent Parent object
+ * @param atlas Atlas
+ * @return The image, hidden until lv_img_atlas_set_frame()
+ */
+lv_obj_t *lv_img_atlas_create(lv_obj_t *parent, const lv_img_atlas_t *atlas);
+
+/**
+ * @brief Show a frame, placed where lv_obj_align() would place its whole source image
+ *
+ * Only the alignments inside the parent are supported. Nothing is invalidated when the
+ * frame and its place do not change.
+ *
+ * @param obj Image of lv_img_atlas_create()
+ * @param atlas Atlas of the image
+ * @param frame Index of the frame
+ * @param align Alignment of the source image
+ * @param x_ofs X offset of the source image
+ * @param y_ofs Y offset of the source image
+ */
+void lv_img_atlas_set_frame(lv_obj_t *obj, const lv_img_atlas_t *atlas, uint16_t frame,
+                            lv_align_t align, lv_coord_t x_ofs, lv_coord_t y_ofs);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_ATLAS_H*/
@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+#include "lv_sys_heap.h"
+
+typedef struct {
+    const void *src;            /* NULL when the slot is free */
+    const void *owner;
+    uint8_t *data;
+    uint32_t size;
+    uint32_t last_use;
+    uint32_t frame;             /* Frame which last drew it, see lru_frame() */
+    bool pinned;
+} lv_img_lru_entry_t;
+
+static struct {
+    lv_img_lru_entry_t entries[LV_IMG_LRU_ENTRY_MAX];
+    uint32_t budget;
+    uint32_t clock;             /* Counts the uses, orders the entries */
+    const void *owner;
+    lv_img_lru_stats_t stats;
+} s_lru = {
+    .budget = LV_IMG_LRU_BUDGET,
+};
+
+static lv_img_lru_entry_t *lru_find(const void *src)
+{
+    for (int i = 0; i < LV_IMG_LRU_ENTRY_MAX; i++) {
+        if (s_lru.entries[i].src == src) {
+            return &s_lru.entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void lru_free(lv_img_lru_entry_t *entry)
+{
+    s_lru.stats.bytes -= entry->size;
+    s_lru.stats.entries--;
+    s_lru.stats.pinned -= entry->pinned;
+    s_lru.stats.evictions++;
+    /* The transformed copies are keyed by the decoded pixels */
+    lv_img_transform_invalidate(entry->data);
+    free(entry->data);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/*
+ * Frame being rendered, 0 outside of a refresh. The refresh timer of the display keeps
+ * the time it started to run while it renders the frame, strip after strip.
+ */
+static uint32_t lru_frame(void)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if ((NULL == disp) || (NULL == disp->refr_timer)) {
+        return 0;
+    }
+    return disp->refr_timer->last_run | 1;
+}
+
+/*
+ * Least recently used entry which is not pinned. The images of the frame being rendered
+ * stay: when they do not all fit, the one left out is drawn row by row instead of all of
+ * them being decoded again on every strip.
+ */
+static lv_img_lru_entry_t *lru_victim(void)
+{
+    const uint32_t frame = lru_frame();
+    lv_img_lru_entry_t *victim = NULL;
+    for (int i = 0; i < LV_IMG_LRU_ENTRY_MAX; i++) {
+        lv_img_lru_entry_t *entry = &s_lru.entries[i];
+        if (entry->src && !entry->pinned && (0 == frame || entry->frame != frame) &&
+                (NULL == victim || entry->last_use < victim->last_use)) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+const uint8_t *lv_img_lru_get(const void *src)
+{
+    lv_img_lru_entry_t *entry = lru_find(src);
+    if (NULL == entry) {
+        s_lru.stats.misses++;
+        return NULL;
+    }
+    s_lru.stats.hits++;
+    entry->last_use = ++s_lru.clock;
+    entry->frame = lru_frame();
+    return entry->data;
+}
+
+uint8_t *lv_img_lru_add(const void *src, uint32_t size)
+{
+    if ((NULL == src) || (size > s_lru.budget) || lru_find(src)) {
+        s_lru.stats.rejects++;
+        return NULL;
+    }
+
+    /* Free the least recently used images until it fits, pinned ones stay */
+    lv_img_lru_entry_t *slot = lru_find(NULL);
+    while ((s_lru.stats.bytes + size > s_lru.budget) || (NULL == slot)) {
+        lv_img_lru_entry_t *victim = lru_victim();
+        if (NULL == victim) {
+            s_lru.stats.rejects++;
+            return NULL;
+        }
+        lru_free(victim);
+        slot = lru_find(NULL);
+    }
+    /* The rest of the firmware shares the internal RAM, the cache gives way to it */
+    while (!lv_sys_heap_can_alloc(size)) {
+        lv_img_lru_entry_t *victim = lru_victim();
+        if (NULL == victim) {
+            s_lru.stats.rejects++;
+            return NULL;
+        }
+        lru_free(victim);
+    }
+
+    uint8_t *data = malloc(size);
+    if (NULL == data) {
+        s_lru.stats.rejects++;
+        return NULL;
+    }
+    slot->src = src;
+    slot->owner = s_lru.owner;
+    slot->data = data;
+    slot->size = size;
+    slot->last_use = ++s_lru.clock;
+    slot->frame = lru_frame();
+    slot->pinned = false;
+
+    s_lru.stats.bytes += size;
+    s_lru.stats.entries++;
+    if (s_lru.stats.bytes > s_lru.stats.peak_bytes) {
+        s_lru.stats.peak_bytes = s_lru.stats.bytes;
+    }
+    return data;
+}
+
+bool lv_img_lru_pin(const void *src)
+{
+    /* The decoder of the image adds it to the cache when it opens it */
+    if (NULL == lru_find(src)) {
+        lv_img_decoder_dsc_t dsc;
+        if (lv_img_decoder_open(&dsc, src, lv_color_black(), 0) != LV_RES_OK) {
+            return false;
+        }
+        lv_img_decoder_close(&dsc);
+    }
+
+    lv_img_lru_entry_t *entry = lru_find(src);
+    if (NULL == entry) {
+        return false;
+    }
+    if (!entry->pinned) {
+        entry->pinned = true;
+        s_lru.stats.pinned++;
+    }
+    return true;
+}
+
+void lv_img_lru_set_owner(const void *owner)
+{
+    s_lru.owner = owner;
+}
+
+void lv_img_lru_evict_owner(const void *owner)
+{
+    for (int i = 0; i < LV_IMG_LRU_ENTRY_MAX; i++) {
+        if (s_lru.entries[i].src && s_lru.entries[i].owner == owner) {
+            lru_free(&s_lru.entries[i]);
+        }
+    }
+}
+
+void lv_img_lru_invalidate_src(const void *src)
+{
+    for (int i = 0; i < LV_IMG_LRU_ENTRY_MAX; i++) {
+        if (s_lru.entries[i].src && (NULL == src || s_lru.entries[i].src == src)) {
+            lru_free(&s_lru.entries[i]);
+        }
+    }
+}
+
+void lv_img_lru_set_budget(uint32_t budget)
+{
+    s_lru.budget = budget;
+    while (s_lru.stats.bytes > budget) {
+        lv_img_lru_entry_t *victim = lru_victim();
+        if (NULL == victim) {
+            break;
+        }
+        lru_free(victim);
+    }
+}
+
+void lv_img_lru_get_stats(lv_img_lru_stats_t *stats)
+{
+    *stats = s_lru.stats;
+}
+
+void lv_img_lru_reset_stats(void)
+{
+    s_lru.stats.hits = 0;
+    s_lru.stats.misses = 0;
+    s_lru.stats.evictions = 0;
+    s_lru.stats.rejects = 0;
+    s_lru.stats.peak_bytes = s_lru.stats.bytes;
+}
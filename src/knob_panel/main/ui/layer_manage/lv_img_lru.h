@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_IMG_LRU_H
+#define LV_IMG_LRU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Bytes of decoded images kept at most, least recently drawn ones are freed above it
+ * or when the system heap runs short (lv_sys_heap_can_alloc()) */
+#ifndef LV_IMG_LRU_BUDGET
+#define LV_IMG_LRU_BUDGET       (64 * 1024)
+#endif
+
+/* Decoded images kept at the same time, whatever their size */
+#define LV_IMG_LRU_ENTRY_MAX    16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hits;              /* Draws served from the cache */
+    uint32_t misses;            /* Draws which decoded the image, or its rows if it was not cached */
+    uint32_t evictions;         /* Images freed for others or when their layer was left */
+    uint32_t rejects;           /* Images larger than what could be freed or the system heap spares */
+    uint32_t bytes;             /* Decoded bytes held now */
+    uint32_t peak_bytes;
+    uint16_t entries;
+    uint16_t pinned;
+} lv_img_lru_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Decoded image cache of the decoders of the application, keyed by the image source
+ *
+ * LVGL's own image cache only counts entries and is disabled (CONFIG_LV_IMG_CACHE_DEF_SIZE 0),
+ * so a decoder runs on every draw. A decoder which can decode an image as a whole asks the
+ * cache first and hands LVGL the cached pixels, drawn like an image in flash.
+ * Entries belong to the layer shown when they were added (lv_img_lru_set_owner()),
+ * lv_func_goto_layer() frees them when it leaves the layer. The images drawn by the frame
+ * being rendered are not freed for another one of the same frame, the image which does not
+ * fit is drawn by its decoder row by row instead.
+ *
+ * The LVGL image cache must stay disabled: it would keep pointers to evicted images.
+ */
+
+/**
+ * @brief Look a decoded image up, counts a hit or a miss
+ *
+ * @param src Image source
+ * @return Decoded pixels, NULL if not cached
+ */
+const uint8_t *lv_img_lru_get(const void *src);
+
+/**
+ * @brief Make room for a decoded image, the caller decodes into the returned buffer
+ *
+ * Least recently used images which are not pinned are freed until it fits in the budget and
+ * the system heap keeps LV_SYS_HEAP_RESERVE free besides.
+ *
+ * @param src Image source
+ * @param size Bytes of the decoded image
+ * @return Buffer of `size` bytes, NULL if it does not fit
+ */
+uint8_t *lv_img_lru_add(const void *src, uint32_t size);
+
+/**
+ * @brief Decode an image now and keep it until its layer is left
+ *
+ * For the images a layer draws on every frame. Only images of a decoder using the cache
+ * can be pinned.
+ *
+ * @param src Image source
+ * @return true if the image is cached and pinned
+ */
+bool lv_img_lru_pin(const void *src);
+
+/**
+ * @brief Set the owner of the images added from now on, the layer being shown
+ *
+ * @param owner Owner, NULL for none
+ */
+void lv_img_lru_set_owner(const void *owner);
+
+/**
+ * @brief Free the images of an owner, pinned or not
+ *
+ * @param owner Owner given to lv_img_lru_set_owner()
+ */
+void lv_img_lru_evict_owner(const void *owner);
+
+/**
+ * @brief Free the decoded copy of an image whose source goes away or changes
+ *
+ * @param src Image source, NULL for all the images
+ */
+void lv_img_lru_invalidate_src(const void *src);
+
+/**
+ * @brief Set the byte budget, frees the images above it which are not pinned
+ *
+ * @param budget Bytes, 0 disables the cache
+ */
+void lv_img_lru_set_budget(uint32_t budget);
+
+/**
+ * @brief Get the statistics since the last reset
+ *
+ * @param stats Filled with the statistics
+ */
+void lv_img_lru_get_stats(lv_img_lru_stats_t *stats);
+
+/**
+ * @brief Reset the counters of the statistics, not what is cached
+ */
+void lv_img_lru_reset_stats(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_LRU_H*/
@@ -0,0 +1,178 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <string.h>
+
+#include "lvgl.h"
+#include "lv_img_rle.h"
+#include "lv_img_lru.h"
+
+/* Layout of the data, see tools/img_rle.py */
+#define RLE_HEADER_SIZE     4
+#define RLE_FLAG_ALPHA      0x01
+#define RLE_RUN             128     /* Control bytes from here repeat one pixel */
+#define RLE_RUN_BIAS        125     /* Repeat count = control - RLE_RUN_BIAS */
+
+static uint32_t rle_offset(const uint8_t *data, uint32_t index)
+{
+    /* The map is a byte array, no alignment to count on */
+    const uint8_t *p = data + RLE_HEADER_SIZE + index * 4;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Pixels [x, x + len) of one row of colours, `stride` bytes apart in buf */
+static void rle_read_colours(const uint8_t *src, lv_coord_t x, lv_coord_t len, uint8_t *buf, uint8_t stride)
+{
+    while (len > 0) {
+        const uint8_t ctrl = *src++;
+        const bool run = ctrl >= RLE_RUN;
+        lv_coord_t cnt = run ? ctrl - RLE_RUN_BIAS : ctrl + 1;
+        const uint8_t *next = src + (run ? sizeof(lv_color_t) : cnt * sizeof(lv_color_t));
+        if (x >= cnt) {
+            x -= cnt;
+            src = next;
+            continue;
+        }
+        if (!run) {
+            src += x * sizeof(lv_color_t);
+        }
+        cnt -= x;
+        x = 0;
+        if (cnt > len) {
+            cnt = len;
+        }
+        len -= cnt;
+        for (; cnt > 0; cnt--) {
+            memcpy(buf, src, sizeof(lv_color_t));
+            buf += stride;
+            src += run ? 0 : sizeof(lv_color_t);
+        }
+        src = next;
+    }
+}
+
+/* Same for a row of alpha */
+static void rle_read_alpha(const uint8_t *src, lv_coord_t x, lv_coord_t len, uint8_t *buf, uint8_t stride)
+{
+    while (len > 0) {
+        const uint8_t ctrl = *src++;
+        const bool run = ctrl >= RLE_RUN;
+        lv_coord_t cnt = run ? ctrl - RLE_RUN_BIAS : ctrl + 1;
+        const uint8_t *next = src + (run ? 1 : cnt);
+        if (x >= cnt) {
+            x -= cnt;
+            src = next;
+            continue;
+        }
+        if (!run) {
+            src += x;
+        }
+        cnt -= x;
+        x = 0;
+        if (cnt > len) {
+            cnt = len;
+        }
+        len -= cnt;
+        for (; cnt > 0; cnt--) {
+            *buf = *src;
+            buf += stride;
+            src += run ? 0 : 1;
+        }
+        src = next;
+    }
+}
+
+static lv_res_t rle_info(lv_img_decoder_t *decoder, const void *src, lv_img_header_t *header)
+{
+    LV_UNUSED(decoder);
+
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) {
+        return LV_RES_INV;
+    }
+    const lv_img_dsc_t *img = src;
+    if (img->header.cf != LV_IMG_CF_USER_ENCODED_0 || img->data_size < RLE_HEADER_SIZE ||
+            img->data[0] != 'R' || img->data[1] != 'L') {
+        return LV_RES_INV;
+    }
+
+    header->always_zero = 0;
+    header->w = img->header.w;
+    header->h = img->header.h;
+    header->cf = (img->data[2] & RLE_FLAG_ALPHA) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    return LV_RES_OK;
+}
+
+/* The whole image as RGB565A8 (all the colours, then all the alpha) or RGB565 */
+static void rle_decode(const lv_img_dsc_t *img, bool alpha, uint8_t *buf)
+{
+    const uint8_t *data = img->data;
+    const lv_coord_t w = img->header.w;
+    const lv_coord_t h = img->header.h;
+
+    for (lv_coord_t y = 0; y < h; y++) {
+        rle_read_colours(data + rle_offset(data, y), 0, w, buf + y * w * sizeof(lv_color_t), sizeof(lv_color_t));
+        if (alpha) {
+            rle_read_alpha(data + rle_offset(data, h + y), 0, w, buf + (w * h) * sizeof(lv_color_t) + y * w, 1);
+        }
+    }
+}
+
+static lv_res_t rle_open(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc)
+{
+    LV_UNUSED(decoder);
+
+    const lv_img_dsc_t *img = dsc->src;
+    const bool alpha = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    dsc->user_data = NULL;
+
+    /* Decoded once into the image cache if it fits, LVGL then draws it like an image in flash */
+    const uint8_t *decoded = lv_img_lru_get(img);
+    if (NULL == decoded) {
+        uint32_t size = img->header.w * img->header.h * (alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+        uint8_t *buf = lv_img_lru_add(img, size);
+        if (buf) {
+            rle_decode(img, alpha, buf);
+        }
+        decoded = buf;
+    }
+    if (decoded) {
+        dsc->img_data = decoded;
+        dsc->header.cf = alpha ? LV_IMG_CF_RGB565A8 : LV_IMG_CF_TRUE_COLOR;
+        return LV_RES_OK;
+    }
+
+    /* Otherwise nothing to allocate, LVGL draws the image with rle_read_line() */
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t rle_read_line(lv_img_decoder_t *decoder, lv_img_decoder_dsc_t *dsc,
+                              lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t *buf)
+{
+    LV_UNUSED(decoder);
+
+    const lv_img_dsc_t *img = dsc->src;
+    const uint8_t *data = img->data;
+    if (dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+        rle_read_colours(data + rle_offset(data, y), x, len, buf, LV_IMG_PX_SIZE_ALPHA_BYTE);
+        rle_read_alpha(data + rle_offset(data, img->header.h + y), x, len,
+                       buf + LV_IMG_PX_SIZE_ALPHA_BYTE - 1, LV_IMG_PX_SIZE_ALPHA_BYTE);
+    } else {
+        rle_read_colours(data + rle_offset(data, y), x, len, buf, sizeof(lv_color_t));
+    }
+    return LV_RES_OK;
+}
+
+void lv_img_rle_init(void)
+{
+#if LV_COLOR_DEPTH == 16
+    lv_img_decoder_t *decoder = lv_img_decoder_create();
+    LV_ASSERT_MALLOC(decoder);
+    lv_img_decoder_set_info_cb(decoder, rle_info);
+    lv_img_decoder_set_open_cb(decoder, rle_open);
+    lv_img_decoder_set_read_line_cb(decoder, rle_read_line);
+#endif
+}
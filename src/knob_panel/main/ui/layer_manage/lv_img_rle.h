@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_IMG_RLE_H
+#define LV_IMG_RLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Register the decoder of the images compressed by tools/img_rle.py
+ *
+ * The images keep LV_IMG_CF_USER_ENCODED_0 in their descriptor. They are decoded whole into
+ * the image cache (lv_img_lru.h) when they fit in its budget, otherwise from flash one row
+ * at a time, only the pixels LVGL asks for. They must not be drawn with zoom or rotation,
+ * LVGL only transforms images it gets as a whole.
+ *
+ * Call once after lv_init(), before the first image is drawn.
+ */
+void lv_img_rle_init(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_RLE_H*/
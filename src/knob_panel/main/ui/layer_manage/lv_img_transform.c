@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lvgl.h"
+#include "lv_img_transform.h"
+#include "lv_sys_heap.h"
+
+/* What the transformed pixels depend on */
+typedef struct {
+    const uint8_t *map;         /* NULL when the slot is free */
+    lv_coord_t src_w;
+    lv_coord_t src_h;
+    lv_img_cf_t cf;
+    uint16_t zoom;
+    int16_t angle;
+    lv_point_t pivot;
+    bool antialias;
+} lv_img_transform_key_t;
+
+typedef struct {
+    lv_img_transform_key_t key;
+    lv_area_t area;             /* Transformed area, relative to the untransformed image */
+    uint8_t *data;              /* RGB565A8 */
+    uint32_t size;
+    uint32_t last_use;
+    uint32_t frame;             /* Frame which last drew it, see transform_frame() */
+} lv_img_transform_entry_t;
+
+static struct {
+    lv_img_transform_entry_t entries[LV_IMG_TRANSFORM_ENTRY_MAX];
+    uint32_t budget;
+    uint16_t zoom_step;
+    uint16_t angle_step;
+    uint32_t clock;             /* Counts the uses, orders the entries */
+    lv_img_transform_stats_t stats;
+    void (*draw_img_decoded)(struct _lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                             const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t color_format);
+} s_transform = {
+    .budget = LV_IMG_TRANSFORM_BUDGET,
+    .zoom_step = LV_IMG_TRANSFORM_ZOOM_STEP,
+    .angle_step = LV_IMG_TRANSFORM_ANGLE_STEP,
+};
+
+static lv_img_transform_entry_t *transform_find(const lv_img_transform_key_t *key)
+{
+    for (int i = 0; i < LV_IMG_TRANSFORM_ENTRY_MAX; i++) {
+        if (!memcmp(&s_transform.entries[i].key, key, sizeof(*key))) {
+            return &s_transform.entries[i];
+        }
+    }
+    return NULL;
+}
+
+static lv_img_transform_entry_t *transform_free_slot(void)
+{
+    for (int i = 0; i < LV_IMG_TRANSFORM_ENTRY_MAX; i++) {
+        if (NULL == s_transform.entries[i].key.map) {
+            return &s_transform.entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void transform_free(lv_img_transform_entry_t *entry)
+{
+    s_transform.stats.bytes -= entry->size;
+    s_transform.stats.entries--;
+    s_transform.stats.evictions++;
+    free(entry->data);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* Frame being rendered, 0 outside of a refresh, as in lv_img_lru.c */
+static uint32_t transform_frame(void)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if ((NULL == disp) || (NULL == disp->refr_timer)) {
+        return 0;
+    }
+    return disp->refr_timer->last_run | 1;
+}
+
+/* Least recently used entry which the frame being rendered has not drawn */
+static lv_img_transform_entry_t *transform_victim(void)
+{
+    const uint32_t frame = transform_frame();
+    lv_img_transform_entry_t *victim = NULL;
+    for (int i = 0; i < LV_IMG_TRANSFORM_ENTRY_MAX; i++) {
+        lv_img_transform_entry_t *entry = &s_transform.entries[i];
+        if (entry->key.map && (0 == frame || entry->frame != frame) &&
+                (NULL == victim || entry->last_use < victim->last_use)) {
+            victim = entry;
+        }
+    }
+    return victim;
+}
+
+static uint32_t transform_round(uint32_t value, uint16_t step)
+{
+    return (value + step / 2) / step * step;
+}
+
+/* Transform the whole image into a new entry, NULL if it does not fit */
+static lv_img_transform_entry_t *transform_add(lv_draw_ctx_t *draw_ctx, const lv_img_transform_key_t *key,
+                                               const lv_draw_img_dsc_t *dsc)
+{
+    lv_area_t area;
+    _lv_img_buf_get_transformed_area(&area, key->src_w, key->src_h, dsc->angle, dsc->zoom, &dsc->pivot);
+    const uint32_t px = lv_area_get_size(&area);
+    const uint32_t size = px * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    if (size > s_transform.budget) {
+        s_transform.stats.rejects++;
+        return NULL;
+    }
+
+    lv_img_transform_entry_t *slot = transform_free_slot();
+    while ((s_transform.stats.bytes + size > s_transform.budget) || (NULL == slot)) {
+        lv_img_transform_entry_t *victim = transform_victim();
+        if (NULL == victim) {
+            s_transform.stats.rejects++;
+            return NULL;
+        }
+        transform_free(victim);
+        slot = transform_free_slot();
+    }
+    /* The rest of the firmware shares the internal RAM, the cache gives way to it */
+    while (!lv_sys_heap_can_alloc(size)) {
+        lv_img_transform_entry_t *victim = transform_victim();
+        if (NULL == victim) {
+            s_transform.stats.rejects++;
+            return NULL;
+        }
+        transform_free(victim);
+    }
+
+    uint8_t *data = malloc(size);
+    if (NULL == data) {
+        s_transform.stats.rejects++;
+        return NULL;
+    }
+    /* Colours then alphas, the layout of LV_IMG_CF_RGB565A8 */
+    lv_draw_transform(draw_ctx, &area, key->map, key->src_w, key->src_h, key->src_w, dsc, key->cf,
+                      (lv_color_t *)data, data + px * sizeof(lv_color_t));
+
+    slot->key = *key;
+    slot->area = area;
+    slot->data = data;
+    slot->size = size;
+
+    s_transform.stats.bytes += size;
+    s_transform.stats.entries++;
+    if (s_transform.stats.bytes > s_transform.stats.peak_bytes) {
+        s_transform.stats.peak_bytes = s_transform.stats.bytes;
+    }
+    return slot;
+}
+
+static void transform_draw_img_decoded(struct _lv_draw_ctx_t *draw_ctx, const lv_draw_img_dsc_t *dsc,
+                                       const lv_area_t *coords, const uint8_t *map_p, lv_img_cf_t color_format)
+{
+    const bool transform = (dsc->angle != 0) || (dsc->zoom != LV_IMG_ZOOM_NONE);
+    const bool supported = (LV_IMG_CF_TRUE_COLOR == color_format) || (LV_IMG_CF_TRUE_COLOR_ALPHA == color_format) ||
+                           (LV_IMG_CF_RGB565A8 == color_format);
+    if (!transform || !supported || (0 == s_transform.budget)) {
+        s_transform.draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+        return;
+    }
+
+    lv_draw_img_dsc_t rounded = *dsc;
+    rounded.zoom = LV_MAX(transform_round(dsc->zoom, s_transform.zoom_step), 1);
+    rounded.angle = transform_round(dsc->angle, s_transform.angle_step) % 3600;
+    if ((0 == rounded.angle) && (LV_IMG_ZOOM_NONE == rounded.zoom)) {
+        s_transform.draw_img_decoded(draw_ctx, &rounded, coords, map_p, color_format);
+        return;
+    }
+
+    lv_img_transform_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.map = map_p;
+    key.src_w = lv_area_get_width(coords);
+    key.src_h = lv_area_get_height(coords);
+    key.cf = color_format;
+    key.zoom = rounded.zoom;
+    key.angle = rounded.angle;
+    key.pivot = dsc->pivot;
+    key.antialias = dsc->antialias;
+
+    lv_img_transform_entry_t *entry = transform_find(&key);
+    if (entry) {
+        s_transform.stats.hits++;
+    } else {
+        s_transform.stats.misses++;
+        entry = transform_add(draw_ctx, &key, &rounded);
+        if (NULL == entry) {
+            s_transform.draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+            return;
+        }
+    }
+    entry->last_use = ++s_transform.clock;
+    entry->frame = transform_frame();
+
+    /* LVGL already clips to the exact transformed area, the rounded one may be a pixel larger */
+    lv_area_t area = entry->area;
+    lv_area_move(&area, coords->x1, coords->y1);
+    rounded.zoom = LV_IMG_ZOOM_NONE;
+    rounded.angle = 0;
+    s_transform.draw_img_decoded(draw_ctx, &rounded, &area, entry->data, LV_IMG_CF_RGB565A8);
+}
+
+void lv_img_transform_init(lv_disp_t *disp)
+{
+#if LV_COLOR_DEPTH == 16
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+    LV_ASSERT(draw_ctx->draw_img_decoded != transform_draw_img_decoded);
+    s_transform.draw_img_decoded = draw_ctx->draw_img_decoded;
+    draw_ctx->draw_img_decoded = transform_draw_img_decoded;
+#endif
+}
+
+void lv_img_transform_invalidate(const uint8_t *map)
+{
+    for (int i = 0; i < LV_IMG_TRANSFORM_ENTRY_MAX; i++) {
+        if (s_transform.entries[i].key.map && (NULL == map || s_transform.entries[i].key.map == map)) {
+            transform_free(&s_transform.entries[i]);
+        }
+    }
+}
+
+void lv_img_transform_set_steps(uint16_t zoom_step, uint16_t angle_step)
+{
+    s_transform.zoom_step = LV_MAX(zoom_step, 1);
+    s_transform.angle_step = LV_MAX(angle_step, 1);
+    lv_img_transform_invalidate(NULL);
+}
+
+void lv_img_transform_set_budget(uint32_t budget)
+{
+    s_transform.budget = budget;
+    while (s_transform.stats.bytes > budget) {
+        lv_img_transform_entry_t *victim = transform_victim();
+        if (NULL == victim) {
+            break;
+        }
+        transform_free(victim);
+    }
+}
+
+void lv_img_transform_get_stats(lv_img_transform_stats_t *stats)
+{
+    *stats = s_transform.stats;
+}
+
+void lv_img_transform_reset_stats(void)
+{
+    s_transform.stats.hits = 0;
+    s_transform.stats.misses = 0;
+    s_transform.stats.evictions = 0;
+    s_transform.stats.rejects = 0;
+    s_transform.stats.peak_bytes = s_transform.stats.bytes;
+}
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_IMG_TRANSFORM_H
+#define LV_IMG_TRANSFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Bytes of transformed images kept at most, least recently drawn ones are freed above it
+ * or when the system heap runs short (lv_sys_heap_can_alloc()) */
+#ifndef LV_IMG_TRANSFORM_BUDGET
+#define LV_IMG_TRANSFORM_BUDGET         (96 * 1024)
+#endif
+
+/* The zoom is rounded to a multiple of it (256 = 1x), 1 to keep it as set */
+#ifndef LV_IMG_TRANSFORM_ZOOM_STEP
+#define LV_IMG_TRANSFORM_ZOOM_STEP      4
+#endif
+
+/* The angle is rounded to a multiple of it (0.1 degree), 1 to keep it as set */
+#ifndef LV_IMG_TRANSFORM_ANGLE_STEP
+#define LV_IMG_TRANSFORM_ANGLE_STEP     10
+#endif
+
+/* Transformed images kept at the same time, whatever their size */
+#define LV_IMG_TRANSFORM_ENTRY_MAX      32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hits;              /* Draws served from the cache */
+    uint32_t misses;            /* Draws which transformed the image */
+    uint32_t evictions;         /* Images freed for others or when their layer was left */
+    uint32_t rejects;           /* Images larger than what could be freed or the system heap spares, transformed by LVGL */
+    uint32_t bytes;             /* Transformed bytes held now */
+    uint32_t peak_bytes;
+    uint16_t entries;
+} lv_img_transform_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Cache of the zoomed and rotated images drawn by a display
+ *
+ * LVGL transforms an image pixel by pixel, with interpolation, for every strip of every
+ * frame which shows it. The cache keeps the whole transformed image, keyed by its pixels,
+ * the zoom and the angle rounded to LV_IMG_TRANSFORM_ZOOM_STEP and LV_IMG_TRANSFORM_ANGLE_STEP,
+ * the pivot and the anti-aliasing, and draws it like an untransformed RGB565A8 image.
+ * An animation going through the same steps again only transforms them once.
+ * The images of the frame being rendered are not freed for another one of the same frame.
+ *
+ * Install it once, after the display is registered: it wraps draw_img_decoded of the draw
+ * context of the display.
+ *
+ * @param disp Display
+ */
+void lv_img_transform_init(lv_disp_t *disp);
+
+/**
+ * @brief Free the transformed copies of decoded pixels which go away or change
+ *
+ * lv_func_goto_layer() frees them all when it leaves a layer.
+ *
+ * @param map Pixels given to draw_img_decoded, NULL for all the images
+ */
+void lv_img_transform_invalidate(const uint8_t *map);
+
+/**
+ * @brief Set the rounding of the zoom and the angle, frees the cached images
+ *
+ * @param zoom_step Zoom step (256 = 1x), 1 for the exact zoom
+ * @param angle_step Angle step (0.1 degree), 1 for the exact angle
+ */
+void lv_img_transform_set_steps(uint16_t zoom_step, uint16_t angle_step);
+
+/**
+ * @brief Set the byte budget, frees the images above it
+ *
+ * @param budget Bytes, 0 disables the cache: LVGL transforms every draw
+ */
+void lv_img_transform_set_budget(uint32_t budget);
+
+/**
+ * @brief Get the statistics since the last reset
+ *
+ * @param stats Filled with the statistics
+ */
+void lv_img_transform_get_stats(lv_img_transform_stats_t *stats);
+
+/**
+ * @brief Reset the counters of the statistics, not what is cached
+ */
+void lv_img_transform_reset_stats(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_TRANSFORM_H*/
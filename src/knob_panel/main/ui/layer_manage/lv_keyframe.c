@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include "lvgl.h"
+#include "lv_keyframe.h"
+
+static void keyframe_apply(lv_keyframe_player_t *player, const lv_keyframe_t *key)
+{
+    if (key->event) {
+        if (player->event_cb) {
+            player->event_cb(player, key->event);
+        }
+        return;
+    }
+
+    lv_obj_t *obj = player->tracks[key->track];
+    if (LV_KEYFRAME_HIDE == key->frame) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_img_atlas_set_frame(obj, player->atlas, key->frame, key->align, key->x, key->y);
+    }
+}
+
+void lv_keyframe_start(lv_keyframe_player_t *player)
+{
+    player->next = 0;
+    player->start = lv_tick_get();
+    lv_keyframe_update(player);
+}
+
+uint32_t lv_keyframe_update(lv_keyframe_player_t *player)
+{
+    const uint32_t elapsed = lv_tick_elaps(player->start);
+
+    while ((player->next < player->key_cnt) && (player->keys[player->next].time <= elapsed)) {
+        keyframe_apply(player, &player->keys[player->next++]);
+    }
+    if (player->next == player->key_cnt) {
+        return LV_KEYFRAME_DONE;
+    }
+    return player->keys[player->next].time - elapsed;
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_KEYFRAME_H
+#define LV_KEYFRAME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include "lvgl.h"
+#include "lv_img_atlas.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Frame of a key hiding its track */
+#define LV_KEYFRAME_HIDE        (-1)
+
+/* Returned by lv_keyframe_update() once the last key is applied */
+#define LV_KEYFRAME_DONE        0
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* One change of a timeline, the keys are sorted by time */
+typedef struct {
+    uint32_t time;              /* ms from the start of the timeline */
+    uint8_t track;              /* Image of lv_keyframe_player_t.tracks */
+    uint8_t event;              /* Not 0: only calls event_cb with it, at that time */
+    int16_t frame;              /* Frame of the atlas, or LV_KEYFRAME_HIDE */
+    lv_align_t align;           /* Alignment and offsets of the source image of the frame */
+    lv_coord_t x;
+    lv_coord_t y;
+} lv_keyframe_t;
+
+typedef struct lv_keyframe_player lv_keyframe_player_t;
+
+typedef void (*lv_keyframe_event_cb_t)(lv_keyframe_player_t *player, uint8_t event);
+
+struct lv_keyframe_player {
+    const lv_img_atlas_t *atlas;
+    lv_obj_t **tracks;          /* Images of lv_img_atlas_create() */
+    const lv_keyframe_t *keys;
+    uint16_t key_cnt;
+    lv_keyframe_event_cb_t event_cb;
+    uint16_t next;              /* First key not applied yet */
+    uint32_t start;             /* lv_tick_get() at the start */
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Start the timeline over, the keys at time 0 are applied right away
+ *
+ * @param player Player, atlas, tracks, keys and event_cb set
+ */
+void lv_keyframe_start(lv_keyframe_player_t *player);
+
+/**
+ * @brief Apply the keys which are due
+ *
+ * Nothing has to run between two keys: call it again after the returned time, from a
+ * timer of that period (lv_func_layer_set_tick() for the timer of a layer).
+ *
+ * @param player Player
+ * @return ms until the next key, LV_KEYFRAME_DONE after the last one
+ */
+uint32_t lv_keyframe_update(lv_keyframe_player_t *player);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_KEYFRAME_H*/
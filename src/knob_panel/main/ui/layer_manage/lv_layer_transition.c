@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "lvgl.h"
+#include "lv_layer_transition.h"
+#include "lv_sys_heap.h"
+
+static const char *TAG = "layer_transition";
+
+static struct {
+    uint8_t *buf;               /* One screen, held from the capture to the end of the transition */
+    uint32_t buf_size;
+    bool captured;              /* buf holds the old layer, the transition did not start yet */
+    lv_img_dsc_t img_dsc;
+    lv_obj_t *img;              /* Snapshot shown by the running transition, NULL when none runs */
+    lv_obj_t *layer_obj;        /* New layer */
+    lv_layer_transition_type_t type;
+    lv_layer_transition_stats_t stats;
+} s_transition;
+
+static uint32_t transition_heap_free_block(void)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_biggest_size;
+#else
+    return UINT32_MAX;
+#endif
+}
+
+/* v goes from 0 (old layer shown) to LV_OPA_COVER (new layer shown) */
+static void transition_anim_cb(void *var, int32_t v)
+{
+    lv_obj_t *img = var;
+    const lv_coord_t w = s_transition.img_dsc.header.w;
+    lv_coord_t x = (lv_coord_t)(w * v / LV_OPA_COVER);
+
+    switch (s_transition.type) {
+    case LV_LAYER_TRANSITION_FADE:
+        lv_obj_set_style_img_opa(img, LV_OPA_COVER - v, 0);
+        break;
+    case LV_LAYER_TRANSITION_SLIDE_LEFT:
+        lv_obj_set_x(img, -x);
+        lv_obj_set_x(s_transition.layer_obj, w - x);
+        break;
+    case LV_LAYER_TRANSITION_SLIDE_RIGHT:
+        lv_obj_set_x(img, x);
+        lv_obj_set_x(s_transition.layer_obj, x - w);
+        break;
+    default:
+        break;
+    }
+}
+
+static void transition_buf_free(void)
+{
+    free(s_transition.buf);
+    s_transition.buf = NULL;
+    s_transition.captured = false;
+}
+
+static void transition_ready_cb(lv_anim_t *a)
+{
+    lv_layer_transition_finish();
+}
+
+void lv_layer_transition_init(lv_disp_t *disp)
+{
+    s_transition.buf_size = lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp) * sizeof(lv_color_t);
+}
+
+bool lv_layer_transition_capture(lv_obj_t *scr)
+{
+    /* A transition still running holds the buffer, it ends before the layer changes again */
+    lv_layer_transition_finish();
+    transition_buf_free();
+
+    /* lv_snapshot draws the whole tree once, with the draw buffers of a frame */
+    if ((0 == s_transition.buf_size) || (transition_heap_free_block() < LV_LAYER_TRANSITION_HEAP_MIN) ||
+            !lv_sys_heap_can_alloc(s_transition.buf_size)) {
+        ESP_LOGW(TAG, "No heap for the snapshot, hard cut");
+        s_transition.stats.cuts++;
+        return false;
+    }
+    s_transition.buf = malloc(s_transition.buf_size);
+    if (NULL == s_transition.buf) {
+        s_transition.stats.cuts++;
+        return false;
+    }
+
+    const int64_t start = esp_timer_get_time();
+    if (LV_RES_OK != lv_snapshot_take_to_buf(scr, LV_IMG_CF_TRUE_COLOR, &s_transition.img_dsc,
+                                             s_transition.buf, s_transition.buf_size)) {
+        transition_buf_free();
+        s_transition.stats.cuts++;
+        return false;
+    }
+    s_transition.stats.capture_us = (uint32_t)(esp_timer_get_time() - start);
+    s_transition.captured = true;
+    return true;
+}
+
+void lv_layer_transition_start(lv_obj_t *layer_obj, const lv_layer_transition_t *transition)
+{
+    if (!s_transition.captured) {
+        return;
+    }
+    s_transition.captured = false;
+    if ((NULL == layer_obj) || (LV_LAYER_TRANSITION_NONE == transition->type)) {
+        transition_buf_free();
+        return;
+    }
+
+    /* Above the screen, so above the new layer whatever it does with its children */
+    lv_obj_t *img = lv_img_create(lv_layer_top());
+    lv_img_set_src(img, &s_transition.img_dsc);
+    s_transition.img = img;
+    s_transition.layer_obj = layer_obj;
+    s_transition.type = transition->type;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, img);
+    lv_anim_set_values(&a, 0, LV_OPA_COVER);
+    lv_anim_set_exec_cb(&a, transition_anim_cb);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_time(&a, transition->time_ms ? transition->time_ms : LV_LAYER_TRANSITION_TIME);
+    lv_anim_set_ready_cb(&a, transition_ready_cb);
+    lv_anim_start(&a);
+    s_transition.stats.started++;
+}
+
+void lv_layer_transition_finish(void)
+{
+    lv_obj_t *img = s_transition.img;
+
+    if (NULL == img) {
+        return;
+    }
+    s_transition.img = NULL;
+    lv_anim_del(img, transition_anim_cb);
+    if (lv_obj_is_valid(s_transition.layer_obj)) {
+        lv_obj_set_x(s_transition.layer_obj, 0);
+    }
+    s_transition.layer_obj = NULL;
+    lv_obj_del(img);
+    transition_buf_free();
+}
+
+bool lv_layer_transition_is_active(void)
+{
+    return NULL != s_transition.img;
+}
+
+void lv_layer_transition_get_stats(lv_layer_transition_stats_t *stats)
+{
+    *stats = s_transition.stats;
+}
+
+void lv_layer_transition_reset_stats(void)
+{
+    memset(&s_transition.stats, 0, sizeof(s_transition.stats));
+}
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_LAYER_TRANSITION_H
+#define LV_LAYER_TRANSITION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Duration of a transition whose layer does not set one */
+#ifndef LV_LAYER_TRANSITION_TIME
+#define LV_LAYER_TRANSITION_TIME        200
+#endif
+
+/* Largest free LVGL heap block needed to capture the old layer, a hard cut below it */
+#ifndef LV_LAYER_TRANSITION_HEAP_MIN
+#define LV_LAYER_TRANSITION_HEAP_MIN    (8 * 1024)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    LV_LAYER_TRANSITION_NONE = 0,       /* Hard cut */
+    LV_LAYER_TRANSITION_FADE,           /* The old layer fades out over the new one */
+    LV_LAYER_TRANSITION_SLIDE_LEFT,     /* The new layer pushes the old one out to the left */
+    LV_LAYER_TRANSITION_SLIDE_RIGHT,    /* The new layer pushes the old one out to the right */
+} lv_layer_transition_type_t;
+
+/* Transition into a layer, `.transition` of lv_layer_t */
+typedef struct {
+    lv_layer_transition_type_t type;
+    uint16_t time_ms;           /* 0 for LV_LAYER_TRANSITION_TIME */
+} lv_layer_transition_t;
+
+typedef struct {
+    uint32_t started;           /* Transitions animated */
+    uint32_t cuts;              /* Transitions asked for but cut: no system heap for the snapshot or LVGL heap */
+    uint32_t capture_us;        /* Time of the last capture of the old layer */
+} lv_layer_transition_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Transitions between layers drawn over a snapshot of the old one
+ *
+ * lv_func_goto_layer() captures the screen once with lv_snapshot before it leaves the old
+ * layer, then animates the snapshot and the new layer: per frame only the new tree renders,
+ * the old one is a plain image. The snapshot buffer, one screen of RGB565 (115 KB on the
+ * 240x240 panel), is allocated by the capture and freed when the transition ends. When the
+ * system heap cannot spare it (lv_sys_heap_can_alloc()), or the LVGL heap is short of
+ * LV_LAYER_TRANSITION_HEAP_MIN for the capture, the layers are switched with a hard cut.
+ *
+ * Call it once after the display is registered, before the first transition.
+ *
+ * @param disp Display
+ */
+void lv_layer_transition_init(lv_disp_t *disp);
+
+/**
+ * @brief Capture the screen into the snapshot buffer, before the old layer goes away
+ *
+ * @param scr Screen showing the old layer
+ * @return true if captured, false for a hard cut
+ */
+bool lv_layer_transition_capture(lv_obj_t *scr);
+
+/**
+ * @brief Animate the captured screen away and the new layer in
+ *
+ * @param layer_obj Object of the new layer, NULL to drop the capture (hard cut)
+ * @param transition Transition into the new layer
+ */
+void lv_layer_transition_start(lv_obj_t *layer_obj, const lv_layer_transition_t *transition);
+
+/**
+ * @brief End a running transition at once: snapshot deleted, new layer in place
+ */
+void lv_layer_transition_finish(void);
+
+/**
+ * @brief Whether a transition is running
+ */
+bool lv_layer_transition_is_active(void);
+
+/**
+ * @brief Get the statistics since the last reset
+ *
+ * @param stats Filled with the statistics
+ */
+void lv_layer_transition_get_stats(lv_layer_transition_stats_t *stats);
+
+/**
+ * @brief Reset the statistics
+ */
+void lv_layer_transition_reset_stats(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_LAYER_TRANSITION_H*/
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
+#include <string.h>
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "lv_schedule_basic.h"
+#include "lv_img_lru.h"
+#include "lv_img_transform.h"
+#include "misc/lv_gc.h"
 
 static const char *TAG = "lvgl_basic";
 
@@ -18,9 +23,20 @@ static const char *TAG = "lvgl_basic";
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_timer_t *timer_system;
 static lv_layer_t *current_layer = NULL;
 
+/* Suspended retained layers, least recently used first, one spare entry until trimmed */
+static lv_layer_t *retained_layers[LV_LAYER_RETAIN_MAX + 1];
+static uint8_t retained_cnt;
+
+/* Layer being built by the prefetch slices, its encoder group members go to prefetch_group */
+static lv_layer_t *prefetch_layer;
+static lv_timer_t *prefetch_timer;
+static lv_group_t *prefetch_group;
+
+/* Layers with running owned animations, linked by own.next */
+static lv_layer_t *anim_owners;
+
 static time_out_count time_enter_clock = {
     .timeOut = 0,
     .time_base = 0,
@@ -53,18 +69,406 @@ bool reload_time_out(time_out_count *tm)
     return true;
 }
 
+static uint32_t lv_func_mem_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static bool lv_func_obj_in_layer(lv_obj_t *layer_obj, void *var)
+{
+    /* Animation variables are not always objects, only follow the ones LVGL knows */
+    if ((NULL == var) || !lv_obj_is_valid(var)) {
+        return false;
+    }
+    for (lv_obj_t *obj = var; obj; obj = lv_obj_get_parent(obj)) {
+        if (obj == layer_obj) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Remember the encoder group members of a new retained layer, the group is emptied
+ * before every lv_func_goto_layer() and the layer has to get them back when resumed.
+ */
+static void lv_func_retain_group(lv_layer_t *layer, lv_group_t *group)
+{
+    lv_obj_t **obj_p;
+
+    layer->retain.group_obj_cnt = 0;
+    if (NULL == group) {
+        return;
+    }
+    _LV_LL_READ(&group->obj_ll, obj_p) {
+        if ((layer->retain.group_obj_cnt < LV_LAYER_RETAIN_GROUP_MAX) && lv_func_obj_in_layer(layer->lv_obj_layer, *obj_p)) {
+            layer->retain.group_objs[layer->retain.group_obj_cnt++] = *obj_p;
+        }
+    }
+}
+
+static void lv_func_own_link(lv_layer_t *layer)
+{
+    for (lv_layer_t *owner = anim_owners; owner; owner = owner->own.next) {
+        if (owner == layer) {
+            return;
+        }
+    }
+    layer->own.next = anim_owners;
+    anim_owners = layer;
+}
+
+static void lv_func_own_unlink(lv_layer_t *layer)
+{
+    for (lv_layer_t **owner = &anim_owners; *owner; owner = &(*owner)->own.next) {
+        if (*owner == layer) {
+            *owner = layer->own.next;
+            break;
+        }
+    }
+    layer->own.next = NULL;
+}
+
+/* deleted_cb of the owned animations: ended, deleted with their object or by lv_anim_del() */
+static void lv_func_own_anim_deleted_cb(lv_anim_t *a)
+{
+    for (lv_layer_t *layer = anim_owners; layer; layer = layer->own.next) {
+        lv_layer_own_t *own = &layer->own;
+        for (uint8_t i = 0; i < own->anim_cnt; i++) {
+            if (own->anims[i] != a) {
+                continue;
+            }
+            lv_anim_deleted_cb_t deleted_cb = own->deleted_cbs[i];
+            own->anim_cnt--;
+            own->anims[i] = own->anims[own->anim_cnt];
+            own->deleted_cbs[i] = own->deleted_cbs[own->anim_cnt];
+            if (0 == own->anim_cnt) {
+                lv_func_own_unlink(layer);
+            }
+            if (deleted_cb) {
+                deleted_cb(a);
+            }
+            return;
+        }
+    }
+}
+
+/* Delete the timers and animations of the layer, it is deleted */
+static void lv_func_layer_del_own(lv_layer_t *layer)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    for (uint8_t i = 0; i < own->timer_cnt; i++) {
+        lv_timer_del(own->timers[i]);
+    }
+    own->timer_cnt = 0;
+
+    if (own->paused) {
+        for (uint8_t i = 0; i < own->anim_cnt; i++) {
+            if (own->deleted_cbs[i]) {
+                own->deleted_cbs[i](&own->paused_anims[i]);
+            }
+        }
+        lv_mem_free(own->paused_anims);
+        own->paused_anims = NULL;
+        own->anim_cnt = 0;
+        own->paused = false;
+    }
+    /* Each lv_anim_del() takes its animation out of the list through the deleted_cb */
+    while (own->anim_cnt) {
+        lv_anim_t *a = own->anims[own->anim_cnt - 1];
+        if (!lv_anim_del(a->var, a->exec_cb)) {
+            own->anim_cnt--;
+        }
+    }
+    lv_func_own_unlink(layer);
+}
+
+static void lv_func_suspend_layer(lv_layer_t *layer)
+{
+    layer->exit_cb(layer);
+    LV_LOG_INFO("[=] Suspend lv_layer :%s", layer->lv_obj_name);
+    lv_obj_add_flag(layer->lv_obj_layer, LV_OBJ_FLAG_HIDDEN);
+    if (layer->timer_handle) {
+        lv_timer_pause(layer->timer_handle);
+    }
+    /* Hidden objects must not keep the encoder focus */
+    for (uint8_t i = 0; i < layer->retain.group_obj_cnt; i++) {
+        lv_group_remove_obj(layer->retain.group_objs[i]);
+    }
+    lv_func_layer_pause(layer);
+
+    layer->retain.suspended = true;
+    retained_layers[retained_cnt++] = layer;
+}
+
+static void lv_func_unlist_retained(lv_layer_t *layer)
+{
+    for (uint8_t i = 0; i < retained_cnt; i++) {
+        if (retained_layers[i] == layer) {
+            retained_cnt--;
+            memmove(&retained_layers[i], &retained_layers[i + 1], (retained_cnt - i) * sizeof(retained_layers[0]));
+            break;
+        }
+    }
+    layer->retain.suspended = false;
+}
+
+/*
+ * Event driven layers: run timer_cb now when notified, every tick_ms when asked for,
+ * otherwise keep the timer paused so that LVGL does not wake up for the layer.
+ */
+static void lv_func_layer_arm_timer(lv_layer_t *layer)
+{
+    lv_timer_t *timer = layer->timer_handle;
+
+    if ((NULL == timer) || !layer->update.event_driven || layer->retain.suspended) {
+        return;
+    }
+    if (layer->update.dirty) {
+        lv_timer_resume(timer);
+        lv_timer_ready(timer);
+    } else if (layer->update.tick_ms) {
+        /* First tick one period from now, not right away after a long pause */
+        if (timer->paused) {
+            lv_timer_reset(timer);
+        }
+        lv_timer_set_period(timer, layer->update.tick_ms);
+        lv_timer_resume(timer);
+    } else {
+        lv_timer_pause(timer);
+    }
+}
+
+static void lv_func_layer_timer_cb(lv_timer_t *timer)
+{
+    lv_layer_t *layer = timer->user_data;
+
+    /* Notifications from timer_cb itself ask for one more run */
+    layer->update.dirty = false;
+    layer->timer_cb(timer);
+
+    /* timer_cb may have left the layer, its timer is deleted or paused then */
+    if (layer->timer_handle == timer) {
+        lv_func_layer_arm_timer(layer);
+    }
+}
+
+static void lv_func_layer_del_timer(lv_layer_t *layer)
+{
+    if (layer->timer_handle) {
+        LV_LOG_INFO("[-] Delete lv_timer :%s,%p", layer->lv_obj_name, layer->timer_handle);
+        lv_timer_del(layer->timer_handle);
+        layer->timer_handle = NULL;
+    }
+    layer->update.dirty = false;
+    layer->update.tick_ms = 0;
+}
+
+static void lv_func_evict_layer(lv_layer_t *layer)
+{
+    LV_LOG_INFO("[-] Evict lv_layer :%s, %u bytes", layer->lv_obj_name, layer->retain.mem_size);
+    lv_func_unlist_retained(layer);
+    lv_obj_del(layer->lv_obj_layer);
+    layer->lv_obj_layer = NULL;
+    lv_func_layer_del_timer(layer);
+    lv_func_layer_del_own(layer);
+    layer->retain.group_obj_cnt = 0;
+}
+
+static void lv_func_resume_layer(lv_layer_t *layer)
+{
+    lv_func_unlist_retained(layer);
+    layer->enter_cb(layer);
+    LV_LOG_INFO("[=] Resume lv_layer :%s", layer->lv_obj_name);
+
+    lv_obj_clear_flag(layer->lv_obj_layer, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_foreground(layer->lv_obj_layer);
+    if (layer->update.event_driven) {
+        layer->update.dirty = true;
+        lv_func_layer_arm_timer(layer);
+    } else if (layer->timer_handle) {
+        lv_timer_resume(layer->timer_handle);
+    }
+
+    lv_func_layer_resume(layer);
+
+    for (uint8_t i = 0; i < layer->retain.group_obj_cnt; i++) {
+        if (lv_obj_is_valid(layer->retain.group_objs[i])) {
+            lv_group_add_obj(lv_group_get_default(), layer->retain.group_objs[i]);
+        }
+    }
+}
+
+/*
+ * Delete the least recently used retained layers until they fit in the budget,
+ * `keep` is the layer about to be resumed.
+ */
+static void lv_func_trim_retained(lv_layer_t *keep)
+{
+    uint32_t retained_size = 0;
+    for (uint8_t i = 0; i < retained_cnt; i++) {
+        retained_size += retained_layers[i]->retain.mem_size;
+    }
+
+    uint8_t i = 0;
+    while (((retained_size > LV_LAYER_RETAIN_BUDGET) || (retained_cnt > LV_LAYER_RETAIN_MAX)) && (i < retained_cnt)) {
+        lv_layer_t *layer = retained_layers[i];
+        if (layer == keep) {
+            i++;
+            continue;
+        }
+        retained_size -= layer->retain.mem_size;
+        lv_func_evict_layer(layer);
+    }
+}
+
+/*
+ * Building a layer and drawing it needs large blocks (shadows, draw layers), the hidden
+ * layers fragment the heap. Delete the least recently used ones but `keep` until a block
+ * of `reserve` bytes is free, returns false if there is still none.
+ */
+static bool lv_func_reserve_heap(lv_layer_t *keep, uint32_t reserve)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    while (mon.free_biggest_size < reserve) {
+        uint8_t i = 0;
+        while ((i < retained_cnt) && (retained_layers[i] == keep)) {
+            i++;
+        }
+        if (i == retained_cnt) {
+            return false;
+        }
+        lv_func_evict_layer(retained_layers[i]);
+        lv_mem_monitor(&mon);
+    }
+#endif
+    return true;
+}
+
+/*
+ * Run build steps of the prefetched layer until it is complete or `budget_us` is spent,
+ * returns true once complete.
+ */
+static bool lv_func_prefetch_steps(lv_layer_t *layer, int64_t budget_us)
+{
+    lv_group_t *group = lv_group_get_default();
+    const uint32_t mem_used = lv_func_mem_used();
+    const int64_t start = esp_timer_get_time();
+    bool done;
+
+    /* Out of sight: nothing is redrawn and the encoder group of the shown layer is left alone */
+    lv_disp_enable_invalidation(NULL, false);
+    lv_group_set_default(prefetch_group);
+    do {
+        done = layer->prefetch.build_cb(layer, layer->prefetch.step++);
+        if (layer->lv_obj_layer) {
+            lv_obj_add_flag(layer->lv_obj_layer, LV_OBJ_FLAG_HIDDEN);
+        }
+    } while (!done && (esp_timer_get_time() - start < budget_us));
+    lv_group_set_default(group);
+    lv_disp_enable_invalidation(NULL, true);
+
+    layer->retain.mem_size += lv_func_mem_used() - mem_used;
+    return done;
+}
+
+/*
+ * Keep the complete prefetched layer like a suspended retained one,
+ * lv_func_goto_layer() resumes it instead of building it.
+ */
+static void lv_func_prefetch_done(lv_layer_t *layer)
+{
+    LV_LOG_INFO("[+] Prefetch lv_layer:%s, %u bytes", layer->lv_obj_name, layer->retain.mem_size);
+    prefetch_layer = NULL;
+    lv_timer_pause(prefetch_timer);
+
+    lv_func_retain_group(layer, prefetch_group);
+    lv_group_remove_all_objs(prefetch_group);
+    lv_func_layer_pause(layer);
+
+    layer->retain.suspended = true;
+    if ((NULL == layer->timer_handle) && layer->timer_cb) {
+        layer->timer_handle = lv_timer_create(lv_func_layer_timer_cb, TIME_ON_TRIGGER, layer);
+        lv_timer_pause(layer->timer_handle);
+    }
+    retained_layers[retained_cnt++] = layer;
+    lv_func_trim_retained(layer);
+}
+
+static void lv_func_prefetch_cancel(void)
+{
+    lv_layer_t *layer = prefetch_layer;
+
+    if (NULL == layer) {
+        return;
+    }
+    prefetch_layer = NULL;
+    lv_timer_pause(prefetch_timer);
+    if (layer->lv_obj_layer) {
+        LV_LOG_INFO("[-] Cancel prefetch lv_layer:%s", layer->lv_obj_name);
+        lv_obj_del(layer->lv_obj_layer);
+        layer->lv_obj_layer = NULL;
+    }
+    lv_func_layer_del_own(layer);
+}
+
+static void lv_func_prefetch_timer_cb(lv_timer_t *timer)
+{
+    lv_layer_t *layer = prefetch_layer;
+    lv_disp_t *disp = lv_disp_get_default();
+    const uint32_t inactive = lv_disp_get_inactive_time(NULL);
+
+    if (inactive < LV_LAYER_PREFETCH_IDLE_MS) {
+        /* Wake up once the input has been idle long enough */
+        lv_timer_set_period(timer, LV_LAYER_PREFETCH_IDLE_MS - inactive);
+        return;
+    }
+    lv_timer_set_period(timer, LV_LAYER_PREFETCH_PERIOD_MS);
+    if (disp && disp->inv_p) {
+        /* A frame is due, build after it */
+        return;
+    }
+
+    /* Room to build like lv_func_goto_layer() does, then to draw the shown layer */
+    if ((0 == layer->prefetch.step) && !lv_func_reserve_heap(NULL, LV_LAYER_RETAIN_RESERVE)) {
+        LV_LOG_WARN("No heap to prefetch %s", layer->lv_obj_name);
+        lv_func_prefetch_cancel();
+        return;
+    }
+    const bool done = lv_func_prefetch_steps(layer, LV_LAYER_PREFETCH_SLICE_MS * 1000);
+    if (!lv_func_reserve_heap(layer, LV_LAYER_PREFETCH_RESERVE)) {
+        LV_LOG_WARN("No heap left by the prefetch of %s", layer->lv_obj_name);
+        lv_func_prefetch_cancel();
+    } else if (done) {
+        lv_func_prefetch_done(layer);
+    }
+}
+
 void lv_func_create_layer(lv_layer_t *create_layer)
 {
     bool result = false;
+    const uint32_t mem_used = lv_func_mem_used();
     result = create_layer->enter_cb(create_layer);
     if (true == result) {
         LV_LOG_INFO("[+] Create lv_layer:%s", create_layer->lv_obj_name);
     }
 
-    if ((true == result) && (NULL == create_layer->timer_handle)) {
-        create_layer->timer_handle = lv_timer_create(create_layer->timer_cb, TIME_ON_TRIGGER, NULL);
+    if ((true == result) && (NULL == create_layer->timer_handle) && create_layer->timer_cb) {
+        create_layer->timer_handle = lv_timer_create(lv_func_layer_timer_cb, TIME_ON_TRIGGER, create_layer);
         //lv_timer_set_repeat_count(create_layer->timer_handle, 10);
         LV_LOG_INFO("[+] Create lv_timer:%s", create_layer->lv_obj_name);
+        create_layer->update.dirty = true;
+        lv_func_layer_arm_timer(create_layer);
+    }
+
+    if ((true == result) && create_layer->retain.enable) {
+        create_layer->retain.mem_size = lv_func_mem_used() - mem_used;
+        lv_func_retain_group(create_layer, lv_group_get_default());
     }
 
     if (create_layer->lv_show_layer) {
@@ -75,7 +479,10 @@ void lv_func_create_layer(lv_layer_t *create_layer)
         }
 
         if ((true == result) && (NULL == create_layer->lv_show_layer->timer_handle)) {
-            create_layer->lv_show_layer->timer_handle = lv_timer_create(create_layer->lv_show_layer->timer_cb, TIME_ON_TRIGGER, NULL);
+            /* Owned by the show layer, deleted with its other timers when it goes */
+            create_layer->lv_show_layer->timer_handle = lv_func_layer_timer_create(create_layer->lv_show_layer,
+                                                                                    create_layer->lv_show_layer->timer_cb,
+                                                                                    TIME_ON_TRIGGER, NULL);
             LV_LOG_INFO("[+] Create show lv_timer:%s", create_layer->lv_show_layer->lv_obj_name);
         }
     }
@@ -86,9 +493,26 @@ void lv_func_goto_layer(lv_layer_t *dst_layer)
     lv_timer_enable(false);
     lv_layer_t *src_layer = current_layer;
 
+    /* A partial prefetch is completed for the new layer, deleted for another one */
+    if (prefetch_layer && (prefetch_layer == dst_layer)) {
+        lv_func_prefetch_steps(dst_layer, INT64_MAX);
+        lv_func_prefetch_done(dst_layer);
+    } else {
+        lv_func_prefetch_cancel();
+    }
+
+    /* The old layer is drawn once into a snapshot, the transition animates it as an image */
+    lv_layer_transition_finish();
+    const bool transition = src_layer && dst_layer && (src_layer != dst_layer) &&
+                            (LV_LAYER_TRANSITION_NONE != dst_layer->transition.type) &&
+                            lv_layer_transition_capture(lv_scr_act());
+
     if (src_layer) {
 
-        if (src_layer->lv_obj_layer) {
+        if (src_layer->lv_obj_layer && src_layer->retain.enable && (NULL == src_layer->lv_show_layer)) {
+            lv_func_suspend_layer(src_layer);
+            lv_func_trim_retained(dst_layer);
+        } else if (src_layer->lv_obj_layer) {
 
             if (src_layer->lv_show_layer) {
                 src_layer->exit_cb(src_layer->lv_show_layer);
@@ -101,9 +525,9 @@ void lv_func_goto_layer(lv_layer_t *dst_layer)
 
                 if (src_layer->lv_show_layer->timer_handle) {
                     LV_LOG_INFO("[-] Delete show lv_timer:%s,%p", src_layer->lv_show_layer->lv_obj_name, src_layer->lv_show_layer->timer_handle);
-                    lv_timer_del(src_layer->lv_show_layer->timer_handle);
                     src_layer->lv_show_layer->timer_handle = NULL;
                 }
+                lv_func_layer_del_own(src_layer->lv_show_layer);
             }
 
             src_layer->exit_cb(src_layer);
@@ -113,40 +537,238 @@ void lv_func_goto_layer(lv_layer_t *dst_layer)
             src_layer->lv_obj_layer = NULL;
         }
 
-        if (src_layer->timer_handle) {
-            LV_LOG_INFO("[-] Delete lv_timer :%s,%p", src_layer->lv_obj_name, src_layer->timer_handle);
-            lv_timer_del(src_layer->timer_handle);
-            src_layer->timer_handle = NULL;
-        }
-
-        lv_timer_t *list;
-        while ((list = lv_timer_get_next(NULL)) != timer_system) {
-            LV_LOG_INFO("lv_time_del, %p,%p", list, timer_system);
-            lv_timer_del(list);
+        /* Only what the layer owns goes, the timers and animations of others keep running */
+        if (!src_layer->retain.suspended) {
+            lv_func_layer_del_timer(src_layer);
+            lv_func_layer_del_own(src_layer);
         }
 
-        lv_anim_del_all();
+        /* The decoded images of the layer go with it, retained or not */
+        lv_img_lru_evict_owner(src_layer);
+        lv_img_transform_invalidate(NULL);
     }
 
     if (dst_layer) {
-        if (NULL == dst_layer->lv_obj_layer) {
+        lv_img_lru_set_owner(dst_layer);
+        if (dst_layer->retain.suspended) {
+            lv_func_resume_layer(dst_layer);
+        } else if (NULL == dst_layer->lv_obj_layer) {
+            lv_func_reserve_heap(NULL, LV_LAYER_RETAIN_RESERVE);
             lv_func_create_layer(dst_layer);
         } else {
             LV_LOG_INFO("%s != NULL", dst_layer->lv_obj_name);
         }
         current_layer = dst_layer;
+        if (transition) {
+            lv_layer_transition_start(dst_layer->lv_obj_layer, &dst_layer->transition);
+        }
     }
 
     lv_timer_enable(true);
 }
 
+/*
+ * Delete every hidden retained layer, for example when the LVGL heap runs low
+ */
+void lv_func_release_retained_layers(void)
+{
+    lv_timer_enable(false);
+    while (retained_cnt) {
+        lv_func_evict_layer(retained_layers[0]);
+    }
+    lv_timer_enable(true);
+}
+
+/*
+ * Build the layer hidden in idle slices, the layer the user most likely goes to next.
+ * Replaces the previous request, a partial build of another layer is deleted. Does nothing
+ * for a layer without build_cb or already built, NULL only cancels.
+ */
+void lv_func_prefetch_layer(lv_layer_t *layer)
+{
+    if (layer == prefetch_layer) {
+        return;
+    }
+    lv_func_prefetch_cancel();
+    if ((NULL == layer) || (NULL == layer->prefetch.build_cb) || layer->lv_obj_layer ||
+            layer->lv_show_layer || (layer == current_layer)) {
+        return;
+    }
+
+    if (NULL == prefetch_group) {
+        prefetch_group = lv_group_create();
+    }
+    if (NULL == prefetch_timer) {
+        prefetch_timer = lv_timer_create(lv_func_prefetch_timer_cb, LV_LAYER_PREFETCH_PERIOD_MS, NULL);
+    }
+    if ((NULL == prefetch_group) || (NULL == prefetch_timer)) {
+        ESP_LOGE(TAG, "No memory for the prefetch");
+        return;
+    }
+    prefetch_layer = layer;
+    layer->prefetch.step = 0;
+    layer->retain.mem_size = 0;
+    lv_timer_set_period(prefetch_timer, LV_LAYER_PREFETCH_PERIOD_MS);
+    lv_timer_reset(prefetch_timer);
+    lv_timer_resume(prefetch_timer);
+}
+
+/*
+ * Mark the layer dirty, its timer_cb runs once at the next LVGL timer run.
+ * Other tasks must hold the LVGL lock.
+ */
+void lv_func_layer_notify(lv_layer_t *layer)
+{
+    layer->update.dirty = true;
+    lv_func_layer_arm_timer(layer);
+}
+
+/*
+ * Run timer_cb of the layer every tick_ms, 0 to stop
+ */
+void lv_func_layer_set_tick(lv_layer_t *layer, uint32_t tick_ms)
+{
+    layer->update.tick_ms = tick_ms;
+    lv_func_layer_arm_timer(layer);
+}
+
+/*
+ * Create a timer owned by the layer: paused with it, deleted with it. It repeats forever,
+ * delete it earlier with lv_func_layer_timer_del().
+ */
+lv_timer_t *lv_func_layer_timer_create(lv_layer_t *layer, lv_timer_cb_t timer_cb, uint32_t period, void *user_data)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    ESP_RETURN_ON_FALSE(own->timer_cnt < LV_LAYER_OWN_TIMER_MAX, NULL, TAG, "%s owns too many timers", layer->lv_obj_name);
+    lv_timer_t *timer = lv_timer_create(timer_cb, period, user_data);
+    ESP_RETURN_ON_FALSE(timer, NULL, TAG, "No memory for a timer of %s", layer->lv_obj_name);
+    if (own->paused) {
+        lv_timer_pause(timer);
+    }
+    own->timers[own->timer_cnt++] = timer;
+    return timer;
+}
+
+void lv_func_layer_timer_del(lv_layer_t *layer, lv_timer_t *timer)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    for (uint8_t i = 0; i < own->timer_cnt; i++) {
+        if (own->timers[i] == timer) {
+            own->timers[i] = own->timers[--own->timer_cnt];
+            lv_timer_del(timer);
+            return;
+        }
+    }
+    ESP_LOGE(TAG, "Timer %p not owned by %s", timer, layer->lv_obj_name);
+}
+
+/*
+ * Start an animation owned by the layer: paused with it, deleted with it. Its deleted_cb is
+ * still called when it is deleted, not when it is paused. A paused layer or one owning
+ * LV_LAYER_OWN_ANIM_MAX animations does not start it: it would outlive the layer.
+ */
+lv_anim_t *lv_func_layer_anim_start(lv_layer_t *layer, const lv_anim_t *a)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    ESP_RETURN_ON_FALSE(!own->paused, NULL, TAG, "%s is paused, animation not started", layer->lv_obj_name);
+    ESP_RETURN_ON_FALSE(own->anim_cnt < LV_LAYER_OWN_ANIM_MAX, NULL, TAG, "%s owns too many animations", layer->lv_obj_name);
+
+    lv_anim_t owned = *a;
+    owned.deleted_cb = lv_func_own_anim_deleted_cb;
+    /* Before lv_anim_start(), which deletes an animation of the same variable and exec_cb */
+    lv_func_own_link(layer);
+    lv_anim_t *node = lv_anim_start(&owned);
+    if (node) {
+        own->deleted_cbs[own->anim_cnt] = a->deleted_cb;
+        own->anims[own->anim_cnt++] = node;
+        /* Again, the deleted animation may have been the last one */
+        lv_func_own_link(layer);
+    } else if (0 == own->anim_cnt) {
+        lv_func_own_unlink(layer);
+    }
+    return node;
+}
+
+/*
+ * Pause the owned timers and animations of the layer as a group, the animations continue
+ * where they were on lv_func_layer_resume(). lv_func_goto_layer() pauses a retained layer it leaves.
+ */
+void lv_func_layer_pause(lv_layer_t *layer)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    if (own->paused) {
+        return;
+    }
+    own->paused = true;
+    for (uint8_t i = 0; i < own->timer_cnt; i++) {
+        lv_timer_pause(own->timers[i]);
+    }
+    if (0 == own->anim_cnt) {
+        return;
+    }
+
+    lv_func_own_unlink(layer);
+    own->paused_anims = lv_mem_alloc(own->anim_cnt * sizeof(lv_anim_t));
+    if (NULL == own->paused_anims) {
+        ESP_LOGE(TAG, "No memory to pause the animations of %s", layer->lv_obj_name);
+    }
+    for (uint8_t i = 0; i < own->anim_cnt; i++) {
+        lv_anim_t *a = own->anims[i];
+        if (own->paused_anims) {
+            lv_memcpy(&own->paused_anims[i], a, sizeof(lv_anim_t));
+            /* Continue from the current time, do not apply the start value again */
+            own->paused_anims[i].early_apply = 0;
+        }
+        /* Paused, not deleted: neither the registry nor the caller hear of it */
+        a->deleted_cb = NULL;
+        lv_anim_del(a->var, a->exec_cb);
+        own->anims[i] = NULL;
+    }
+    if (NULL == own->paused_anims) {
+        own->anim_cnt = 0;
+    }
+}
+
+void lv_func_layer_resume(lv_layer_t *layer)
+{
+    lv_layer_own_t *own = &layer->own;
+
+    if (!own->paused) {
+        return;
+    }
+    own->paused = false;
+    for (uint8_t i = 0; i < own->timer_cnt; i++) {
+        lv_timer_resume(own->timers[i]);
+    }
+
+    const uint8_t anim_cnt = own->anim_cnt;
+    own->anim_cnt = 0;
+    lv_func_own_link(layer);
+    for (uint8_t i = 0; i < anim_cnt; i++) {
+        /* The copies keep lv_func_own_anim_deleted_cb */
+        lv_anim_t *node = lv_anim_start(&own->paused_anims[i]);
+        if (node) {
+            own->deleted_cbs[own->anim_cnt] = own->deleted_cbs[i];
+            own->anims[own->anim_cnt++] = node;
+        }
+    }
+    if (0 == own->anim_cnt) {
+        lv_func_own_unlink(layer);
+    }
+    lv_mem_free(own->paused_anims);
+    own->paused_anims = NULL;
+}
+
 /*
  * once only
  */
 void lv_create_home(lv_layer_t *home_layer)
 {
     ESP_LOGI(TAG, "Enter home page");
-    timer_system = lv_timer_get_next(NULL);
     lv_func_goto_layer(home_layer);
 }
 
@@ -166,7 +788,9 @@ static void time_clock_update_cb(lv_timer_t *timer)
     lv_obj_t *obj = (lv_obj_t *)timer->user_data;
     lv_layer_t *clock_layer = (lv_layer_t *)obj;
 
-    if (is_time_out(&time_enter_clock)) {
+    if (current_layer && current_layer->block_clock) {
+        feed_clock_time();
+    } else if (is_time_out(&time_enter_clock)) {
         lv_func_goto_layer(clock_layer);
         feed_clock_time();
     }
@@ -177,7 +801,6 @@ void lv_create_clock(lv_layer_t *clock_layer, uint32_t tmOut)
     set_time_out(&time_enter_clock, tmOut);
     lv_timer_t *timer_clock = lv_timer_create(time_clock_update_cb, 1 * 1000, clock_layer);
     if ( timer_clock ) {
-        timer_system = timer_clock;
         ESP_LOGI(TAG, "Init clock time ok, %p", timer_clock);
     }
 }
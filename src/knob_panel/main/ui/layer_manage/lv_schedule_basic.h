@@ -15,6 +15,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lvgl.h"
+#include "lv_layer_transition.h"
 
 /*********************
  *      DEFINES
@@ -37,8 +38,122 @@ extern "C" {
 } /*extern "C"*/
 #endif
 
+/* LVGL heap the hidden retained layers may keep, least recently used ones are deleted above it */
+#ifndef LV_LAYER_RETAIN_BUDGET
+#define LV_LAYER_RETAIN_BUDGET      (12 * 1024)
+#endif
+
+/* Largest free LVGL heap block to keep before building a layer, retained layers are deleted to get it */
+#ifndef LV_LAYER_RETAIN_RESERVE
+#define LV_LAYER_RETAIN_RESERVE     (14 * 1024)
+#endif
+
+/* Retained layers kept at the same time, whatever their size */
+#define LV_LAYER_RETAIN_MAX         4
+
+/* Encoder group objects restored when a retained layer comes back */
+#define LV_LAYER_RETAIN_GROUP_MAX   4
+
+/* Largest free LVGL heap block a prefetch leaves for the draw buffers of the shown layer */
+#ifndef LV_LAYER_PREFETCH_RESERVE
+#define LV_LAYER_PREFETCH_RESERVE   (12 * 1024)
+#endif
+
+/* Time a prefetch slice may take, it runs at least one build step */
+#ifndef LV_LAYER_PREFETCH_SLICE_MS
+#define LV_LAYER_PREFETCH_SLICE_MS  8
+#endif
+
+/* Period of the prefetch slices, the frames of the shown layer run in between */
+#ifndef LV_LAYER_PREFETCH_PERIOD_MS
+#define LV_LAYER_PREFETCH_PERIOD_MS 30
+#endif
+
+/* Input inactivity before a prefetch starts, nothing is built while the knob turns */
+#ifndef LV_LAYER_PREFETCH_IDLE_MS
+#define LV_LAYER_PREFETCH_IDLE_MS   200
+#endif
+
+/* Timers a layer owns, see lv_layer_own_t */
+#ifndef LV_LAYER_OWN_TIMER_MAX
+#define LV_LAYER_OWN_TIMER_MAX      4
+#endif
+
+/* Animations a layer owns at the same time, see lv_layer_own_t */
+#ifndef LV_LAYER_OWN_ANIM_MAX
+#define LV_LAYER_OWN_ANIM_MAX       12
+#endif
+
 typedef bool (*lv_layer_enter_cb)(void *layer);
 typedef bool (*lv_layer_exit_cb)(void *layer);
+typedef bool (*lv_layer_build_cb)(void *layer, uint8_t step);
+
+/*
+ * Retained mode of a layer.
+ *
+ * When `enable` is set, leaving the layer hides its objects, pauses its timers and its
+ * animations instead of deleting them. Going back to it shows them again, so the transition
+ * costs one redraw instead of a widget build. exit_cb and enter_cb are still called on every
+ * leave and return, enter_cb finds lv_obj_layer set and only refreshes its state. Only opt in
+ * layers whose exit_cb leaves the objects usable.
+ */
+typedef struct {
+    bool enable;
+    bool suspended;
+    uint32_t mem_size;                                      /* LVGL heap taken by the build of the layer */
+    uint8_t group_obj_cnt;
+    lv_obj_t *group_objs[LV_LAYER_RETAIN_GROUP_MAX];        /* Encoder group members of the layer */
+} lv_layer_retain_t;
+
+/*
+ * Update mode of a layer.
+ *
+ * By default timer_cb polls every 10 ms. With `event_driven` set, the timer of the layer is
+ * paused while nothing changes: timer_cb runs once when the layer is built or resumed, once
+ * after lv_func_layer_notify() however many notifications came before it, and every `tick_ms`
+ * while lv_func_layer_set_tick() asks for it. An idle layer does not wake LVGL up.
+ */
+typedef struct {
+    bool event_driven;
+    bool dirty;                 /* Notified, timer_cb did not run yet */
+    uint32_t tick_ms;           /* Period of timer_cb, 0 when only notifications run it */
+} lv_layer_update_t;
+
+/*
+ * Prefetch of a layer.
+ *
+ * build_cb creates the objects of the layer in steps from 0: the first one sets lv_obj_layer,
+ * the last one returns true. enter_cb builds the layer by running all of them. After
+ * lv_func_prefetch_layer() they run hidden, in slices of LV_LAYER_PREFETCH_SLICE_MS while
+ * another layer is shown and idle, and the layer is then kept like a suspended retained one:
+ * going to it only shows it. The steps must only create LVGL objects, timers and animations
+ * of the layer, a prefetched layer may be deleted without enter_cb or exit_cb being called.
+ */
+typedef struct {
+    lv_layer_build_cb build_cb;
+    uint8_t step;               /* Next step of a partial build */
+} lv_layer_prefetch_t;
+
+/*
+ * Timers and animations owned by a layer.
+ *
+ * lv_func_layer_timer_create() and lv_func_layer_anim_start() register them with the layer.
+ * lv_func_goto_layer() deletes the ones of the layer it leaves, or pauses them when the layer
+ * is retained, without looking at the timers and animations of anything else: the clock
+ * timer, the prefetch or a transition keep running. Animations of the objects of a layer
+ * which are not registered (scrolling, rollers) go with their objects only.
+ * Owned timers repeat forever, delete one with lv_func_layer_timer_del().
+ */
+typedef struct {
+    lv_timer_t *timers[LV_LAYER_OWN_TIMER_MAX];
+    lv_anim_t *anims[LV_LAYER_OWN_ANIM_MAX];                /* Running, in the animation list of LVGL */
+    lv_anim_deleted_cb_t deleted_cbs[LV_LAYER_OWN_ANIM_MAX];/* deleted_cb of the caller of each */
+    lv_anim_t *paused_anims;                                /* Copies of the animations while paused */
+    uint8_t timer_cnt;
+    uint8_t anim_cnt;
+    bool paused;
+    struct lv_layer *next;                                  /* Next layer with running animations */
+} lv_layer_own_t;
 
 typedef struct lv_layer {
     char *lv_obj_name;
@@ -49,6 +164,12 @@ typedef struct lv_layer {
     lv_layer_exit_cb exit_cb;
     lv_timer_cb_t timer_cb;
     lv_timer_t *timer_handle;
+    lv_layer_retain_t retain;
+    lv_layer_update_t update;
+    lv_layer_prefetch_t prefetch;
+    lv_layer_transition_t transition;   /* Animation from the previous layer, see lv_layer_transition.h */
+    lv_layer_own_t own;
+    bool block_clock;           /* Never replaced by the clock screen, instead of feed_clock_time() on every tick */
 } lv_layer_t;
 
 typedef struct {
@@ -72,4 +193,22 @@ extern void lv_create_clock(lv_layer_t *clock_layer, uint32_t tmOut);
 
 extern void lv_func_goto_layer(lv_layer_t *dst_layer);
 
+extern void lv_func_release_retained_layers(void);
+
+extern void lv_func_prefetch_layer(lv_layer_t *layer);
+
+extern void lv_func_layer_notify(lv_layer_t *layer);
+
+extern void lv_func_layer_set_tick(lv_layer_t *layer, uint32_t tick_ms);
+
+extern lv_timer_t *lv_func_layer_timer_create(lv_layer_t *layer, lv_timer_cb_t timer_cb, uint32_t period, void *user_data);
+
+extern void lv_func_layer_timer_del(lv_layer_t *layer, lv_timer_t *timer);
+
+extern lv_anim_t *lv_func_layer_anim_start(lv_layer_t *layer, const lv_anim_t *a);
+
+extern void lv_func_layer_pause(lv_layer_t *layer);
+
+extern void lv_func_layer_resume(lv_layer_t *layer);
+
 #endif /*LV_EXAMPLE_FUNC_H*/
@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include "esp_heap_caps.h"
+
+#include "lv_sys_heap.h"
+
+bool lv_sys_heap_can_alloc(uint32_t size)
+{
+    const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    return (heap_caps_get_largest_free_block(caps) >= size) &&
+           (heap_caps_get_free_size(caps) >= size + LV_SYS_HEAP_RESERVE);
+}
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#ifndef LV_SYS_HEAP_H
+#define LV_SYS_HEAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Internal RAM the UI buffers leave to the drivers and tasks, the ESP32-C3 has no PSRAM */
+#ifndef LV_SYS_HEAP_RESERVE
+#define LV_SYS_HEAP_RESERVE     (32 * 1024)
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Whether a large buffer of the UI may be taken from the system heap
+ *
+ * The image caches and the transition snapshot are sized for the UI alone (LV_IMG_LRU_BUDGET,
+ * LV_IMG_TRANSFORM_BUDGET, one screen), they ask here before every allocation so that
+ * together they never leave the rest of the firmware short of internal RAM.
+ *
+ * @param size Size of the buffer
+ * @return true if a block of that size is free and LV_SYS_HEAP_RESERVE stays free besides
+ */
+bool lv_sys_heap_can_alloc(uint32_t size);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SYS_HEAP_H*/
@@ -45,7 +45,7 @@ static void anim_timer_handle(lv_obj_t *parent)
 
     if (-90 == count) {
         img_logo = lv_img_create(page);
-        lv_img_set_src(img_logo, &espressif_logo);
+        lv_img_set_src(img_logo, LV_ASSET_IMG(espressif_logo));
         lv_obj_center(img_logo);
     }
 
@@ -14,29 +14,79 @@
 #include "lv_example_image.h"
 #include "bsp/esp-bsp.h"
 
-#define MIN_MOUTH_ZOOM      128
-#define MAX_MOUTH_ZOOM      365
+#include "lv_keyframe.h"
+#include "standby_atlas.h"
 
 static bool clock_screen_layer_enter_cb(void *layer);
 static bool clock_screen_layer_exit_cb(void *layer);
 static void clock_screen_layer_timer_cb(lv_timer_t *tmr);
 
+/* Only runs when the next key of the face is due, the clock screen never times out to itself */
 lv_layer_t clock_screen_layer = {
     .lv_obj_name    = "clock_screen_layer",
     .lv_obj_layer   = NULL,
     .enter_cb       = clock_screen_layer_enter_cb,
     .exit_cb        = clock_screen_layer_exit_cb,
     .timer_cb       = clock_screen_layer_timer_cb,
+    .update         = {.event_driven = true},
+    .transition     = {.type = LV_LAYER_TRANSITION_FADE},
+    .block_clock    = true,
 };
 
-static uint16_t flash_sub_step = 0;
-static uint8_t flash_main_step = 0;
+/* Images of the face, frames of standby_atlas */
+enum {
+    TRACK_EYE_BG,
+    TRACK_EYE_FADE,
+    TRACK_EYE,
+    TRACK_EYE_LEFT,
+    TRACK_EYE_RIGHT,
+    TRACK_MOUTH,
+    TRACK_CNT,
+};
 
-static lv_obj_t *page;
-static lv_obj_t *img_face, *img_eye_bg, *img_eye, * img_mouth, *img_eye_fade;
-static lv_obj_t *img_eye_left, * img_eye_right;
+enum {
+    EVENT_PUPILS_START = 1,
+    EVENT_PUPILS_STOP,
+    EVENT_MOUTH_START,
+};
+
+#define KEY(ms, track, frame, align, x, y)  {ms, track, 0, frame, align, x, y}
+#define HIDE(ms, track)                     {ms, track, 0, LV_KEYFRAME_HIDE, LV_ALIGN_DEFAULT, 0, 0}
+#define EVENT(ms, event)                    {ms, 0, event, 0, LV_ALIGN_DEFAULT, 0, 0}
+
+/*
+ * Eyes open and looking around, a blink of the fade, eyes wide open, then asleep with the
+ * mouth breathing until the screen is left.
+ */
+static const lv_keyframe_t s_face_keys[] = {
+    KEY(0,      TRACK_EYE_BG,       STANDBY_EYE_CLOSE,      LV_ALIGN_CENTER,    0, 0),
+    KEY(0,      TRACK_EYE_FADE,     STANDBY_EYE_FADE,       LV_ALIGN_CENTER,    0, 40),
+    KEY(0,      TRACK_EYE_LEFT,     STANDBY_EYE_LEFT,       LV_ALIGN_TOP_LEFT,  70, 105),
+    KEY(0,      TRACK_EYE_RIGHT,    STANDBY_EYE_RIGHT,      LV_ALIGN_TOP_RIGHT, 163, 105),
+    KEY(0,      TRACK_MOUTH,        STANDBY_MOUTH_NATIVE,   LV_ALIGN_TOP_MID,   0, 163),
+
+    KEY(60,     TRACK_EYE_BG,       STANDBY_EYE_OPEN,       LV_ALIGN_CENTER,    0, 0),
+    KEY(60,     TRACK_EYE_LEFT,     STANDBY_EYE_LEFT,       LV_ALIGN_TOP_LEFT,  75, 100),
+    KEY(60,     TRACK_EYE_RIGHT,    STANDBY_EYE_RIGHT,      LV_ALIGN_TOP_LEFT,  115, 100),
+    EVENT(60,   EVENT_PUPILS_START),
+    HIDE(120,   TRACK_EYE_FADE),
+    KEY(3000,   TRACK_EYE_FADE,     STANDBY_EYE_FADE,       LV_ALIGN_CENTER,    0, 40),
+
+    HIDE(4920,  TRACK_EYE_FADE),
+    HIDE(4920,  TRACK_EYE_LEFT),
+    HIDE(4920,  TRACK_EYE_RIGHT),
+    EVENT(4920, EVENT_PUPILS_STOP),
+    KEY(4920,   TRACK_EYE,          STANDBY_EYE_2,          LV_ALIGN_CENTER,    0, 0),
+
+    KEY(7440,   TRACK_EYE_BG,       STANDBY_EYE_CLOSE,      LV_ALIGN_CENTER,    0, 0),
+    KEY(7440,   TRACK_EYE,          STANDBY_EYE_3,          LV_ALIGN_CENTER,    0, 5),
+    EVENT(7440, EVENT_MOUTH_START),
+};
 
-static time_out_count time_50ms;
+static lv_obj_t *page;
+static lv_obj_t *img_face;
+static lv_obj_t *tracks[TRACK_CNT];
+static lv_keyframe_player_t face_player;
 
 static void wakeup_event_cb(lv_event_t *e)
 {
@@ -52,14 +102,63 @@ static void wakeup_event_cb(lv_event_t *e)
     }
 }
 
+/* Zoom of the former lv_img_set_zoom() animation, shown as the closest pre-scaled frame */
 static void set_mouth_zoom(void *img, int32_t v)
 {
-    if (2 == flash_main_step) {
-        lv_img_set_zoom(img, v);
-        if (MIN_MOUTH_ZOOM == v) {
-            // audio_continue_next();
+    uint16_t closest = 0;
+    for (uint16_t i = 1; i < STANDBY_MOUTH_CNT; i++) {
+        if (LV_ABS(standby_mouth_zoom[i] - v) < LV_ABS(standby_mouth_zoom[closest] - v)) {
+            closest = i;
         }
     }
+    lv_img_atlas_set_frame(img, &standby_atlas, STANDBY_MOUTH_0 + closest, LV_ALIGN_TOP_MID, 0, 163);
+}
+
+static void set_anim_eye_x(void *obj, int32_t v)
+{
+    lv_obj_set_x(obj, v);
+}
+
+static void anim_eye_start(lv_obj_t *obj, int32_t dx)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+    lv_anim_set_time(&a, 2000);
+    lv_anim_set_playback_time(&a, 1000);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_values(&a, lv_obj_get_x_aligned(obj), lv_obj_get_x_aligned(obj) + dx);
+    lv_anim_set_exec_cb(&a, set_anim_eye_x);
+    lv_func_layer_anim_start(&clock_screen_layer, &a);
+}
+
+static void face_event_cb(lv_keyframe_player_t *player, uint8_t event)
+{
+    switch (event) {
+    case EVENT_PUPILS_START:
+        anim_eye_start(tracks[TRACK_EYE_LEFT], -50);
+        anim_eye_start(tracks[TRACK_EYE_RIGHT], 50);
+        break;
+    case EVENT_PUPILS_STOP:
+        lv_anim_del(tracks[TRACK_EYE_LEFT], set_anim_eye_x);
+        lv_anim_del(tracks[TRACK_EYE_RIGHT], set_anim_eye_x);
+        break;
+    case EVENT_MOUTH_START: {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, tracks[TRACK_MOUTH]);
+        lv_anim_set_time(&a, 2000);
+        lv_anim_set_exec_cb(&a, set_mouth_zoom);
+        lv_anim_set_values(&a, standby_mouth_zoom[0], standby_mouth_zoom[STANDBY_MOUTH_CNT - 1]);
+        lv_anim_set_playback_time(&a, 2500);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_func_layer_anim_start(&clock_screen_layer, &a);
+        break;
+    }
+    default:
+        break;
+    }
 }
 
 void ui_flash_face_init(lv_obj_t *parent)
@@ -72,43 +171,21 @@ void ui_flash_face_init(lv_obj_t *parent)
     lv_obj_center(page);
 
     img_face = lv_img_create(page);
-    lv_img_set_src(img_face, &standby_face);
+    lv_img_set_src(img_face, LV_ASSET_IMG(standby_face));
     lv_obj_align(img_face, LV_ALIGN_CENTER, 0, 0);
 
-    img_eye_bg = lv_img_create(page);
-    lv_img_set_src(img_eye_bg, &standby_eye_close);
-    lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-
-    img_eye_fade = lv_img_create(page);
-    lv_img_set_src(img_eye_fade, &standby_eye_1_fade);
-    lv_obj_align(img_eye_fade, LV_ALIGN_CENTER, 0, 40);
-
-    img_eye = lv_img_create(page);
-    lv_img_set_src(img_eye, &standby_eye_3);
-    lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_add_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
-
-    img_eye_left = lv_img_create(page);
-    lv_img_set_src(img_eye_left, &standby_eye_left);
-    lv_obj_align(img_eye_left, LV_ALIGN_TOP_LEFT, 70, 105);
-
-    img_eye_right = lv_img_create(page);
-    lv_img_set_src(img_eye_right, &standby_eye_right);
-    lv_obj_align(img_eye_right, LV_ALIGN_TOP_RIGHT, 163, 105);
-
-    img_mouth = lv_img_create(page);
-    lv_img_set_src(img_mouth, &standby_mouth_2);
-    lv_obj_align(img_mouth, LV_ALIGN_TOP_MID, 0, 163);
-
-    lv_anim_t a;
-    lv_anim_init(&a);
-    lv_anim_set_var(&a, img_mouth);
-    lv_anim_set_time(&a, 2000);
-    lv_anim_set_exec_cb(&a, set_mouth_zoom);
-    lv_anim_set_values(&a, MIN_MOUTH_ZOOM, MAX_MOUTH_ZOOM);
-    lv_anim_set_playback_time(&a, 2500);
-    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&a);
+    /* In drawing order, the keys at time 0 show them */
+    for (int i = 0; i < TRACK_CNT; i++) {
+        tracks[i] = lv_img_atlas_create(page, &standby_atlas);
+    }
+    face_player = (lv_keyframe_player_t) {
+        .atlas = &standby_atlas,
+        .tracks = tracks,
+        .keys = s_face_keys,
+        .key_cnt = sizeof(s_face_keys) / sizeof(s_face_keys[0]),
+        .event_cb = face_event_cb,
+    };
+    lv_keyframe_start(&face_player);
 
     lv_obj_add_event_cb(page, wakeup_event_cb, LV_EVENT_FOCUSED, NULL);
     lv_obj_add_event_cb(page, wakeup_event_cb, LV_EVENT_KEY, NULL);
@@ -131,10 +208,6 @@ static bool clock_screen_layer_enter_cb(void *layer)
         lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
 
         ui_flash_face_init(create_layer->lv_obj_layer);
-        set_time_out(&time_50ms, 50);
-
-        flash_sub_step = 0;
-        flash_main_step = 0;
     }
     audio_force_quite(false);
 
@@ -148,94 +221,7 @@ static bool clock_screen_layer_exit_cb(void *layer)
     return true;
 }
 
-static void set_anim_left_eye(void *obj, int32_t v)
-{
-    if (0 == flash_main_step) {
-        lv_obj_set_x(img_eye_left, v);
-    }
-}
-
-static void set_anim_right_eye(void *obj, int32_t v)
-{
-    if (0 == flash_main_step) {
-        lv_obj_set_x(img_eye_right, v);
-    }
-}
-
 static void clock_screen_layer_timer_cb(lv_timer_t *tmr)
 {
-    static lv_anim_t anim_eye;
-    feed_clock_time();
-    if (is_time_out(&time_50ms)) {
-
-        switch (flash_main_step) {
-        case 0:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_open);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-
-                lv_obj_align(img_eye_left, LV_ALIGN_TOP_LEFT, 75, 100);
-                lv_obj_align(img_eye_right, LV_ALIGN_TOP_LEFT, 115, 100);
-
-                lv_obj_clear_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
-
-                lv_anim_init(&anim_eye);
-                lv_anim_set_var(&anim_eye, img_eye_left);
-                lv_anim_set_delay(&anim_eye, 0);
-                lv_anim_set_path_cb(&anim_eye, lv_anim_path_ease_in_out);
-                lv_anim_set_time(&anim_eye, 2000);
-                lv_anim_set_playback_time(&anim_eye, 1000);
-                lv_anim_set_repeat_count(&anim_eye, LV_ANIM_REPEAT_INFINITE);
-
-                lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_left) + 0, lv_obj_get_x_aligned(img_eye_left) - 50);
-                lv_anim_set_exec_cb(&anim_eye, set_anim_left_eye);
-                lv_anim_start(&anim_eye);
-
-                lv_anim_set_values(&anim_eye, lv_obj_get_x_aligned(img_eye_right) + 0, lv_obj_get_x_aligned(img_eye_right) + 50);
-                lv_anim_set_exec_cb(&anim_eye, set_anim_right_eye);
-                lv_anim_start(&anim_eye);
-                flash_sub_step += 1;
-            } else {
-                if (flash_sub_step++ < 80) { //0-400
-                    if ((flash_sub_step / 50) % 2) {
-                        lv_obj_clear_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                    } else {
-                        lv_obj_add_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                    }
-                } else {
-                    flash_sub_step = 0;
-                    flash_main_step += 1;
-                }
-            }
-            break;
-        case 1:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_open);
-                lv_img_set_src(img_eye, &standby_eye_2);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-                lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0);
-
-                lv_obj_add_flag(img_eye_fade, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye_left, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_add_flag(img_eye_right, LV_OBJ_FLAG_HIDDEN);
-                lv_obj_clear_flag(img_eye, LV_OBJ_FLAG_HIDDEN);
-            }
-            if (flash_sub_step++ > 40) { //0-4000
-                flash_sub_step = 0;
-                flash_main_step += 1;
-                // audio_handle_info(SOUND_TYPE_SNORE);
-            }
-            break;
-        case 2:
-            if (0 == flash_sub_step) {
-                lv_img_set_src(img_eye_bg, &standby_eye_close);
-                lv_img_set_src(img_eye, &standby_eye_3);
-                lv_obj_align(img_eye_bg, LV_ALIGN_CENTER, 0, 0);
-                lv_obj_align(img_eye, LV_ALIGN_CENTER, 0, 0 + 5);
-            }
-            break;
-        }
-    }
+    lv_func_layer_set_tick(&clock_screen_layer, lv_keyframe_update(&face_player));
 }
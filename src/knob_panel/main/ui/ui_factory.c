@@ -167,7 +167,7 @@ void lv_create_rst_select(lv_obj_t *parent)
     if ((NULL == imgbtn_TEST_OK) && (NULL == imgbtn_TEST_FAILED)) {
         imgbtn_TEST_OK = lv_img_create(page);
         lv_obj_align(imgbtn_TEST_OK, LV_ALIGN_CENTER, -40, 50);
-        lv_img_set_src(imgbtn_TEST_OK, &language_select);
+        lv_img_set_src(imgbtn_TEST_OK, LV_ASSET_IMG(language_select));
 
         label_EN = lv_label_create(imgbtn_TEST_OK);
         lv_obj_set_style_text_font(label_EN, &font_SourceHanSansCN_20, 0);
@@ -177,7 +177,7 @@ void lv_create_rst_select(lv_obj_t *parent)
 
         imgbtn_TEST_FAILED = lv_img_create(page);
         lv_obj_align(imgbtn_TEST_FAILED, LV_ALIGN_CENTER, 40, 50);
-        lv_img_set_src(imgbtn_TEST_FAILED, &language_unselect);
+        lv_img_set_src(imgbtn_TEST_FAILED, LV_ASSET_IMG(language_unselect));
 
         label_CN = lv_label_create(imgbtn_TEST_FAILED);
         lv_obj_set_style_text_font(label_CN, &font_SourceHanSansCN_20, 0);
@@ -190,19 +190,19 @@ void lv_create_rst_select(lv_obj_t *parent)
     }
 
     if (lv_obj_has_state(imgbtn_TEST_OK, LV_STATE_CHECKED) == false) {
-        lv_img_set_src(imgbtn_TEST_OK, &language_select);
+        lv_img_set_src(imgbtn_TEST_OK, LV_ASSET_IMG(language_select));
         lv_obj_add_state(imgbtn_TEST_OK, LV_STATE_CHECKED);
         lv_obj_set_style_text_opa(label_EN, LV_OPA_COVER, 0);
 
-        lv_img_set_src(imgbtn_TEST_FAILED, &language_unselect);
+        lv_img_set_src(imgbtn_TEST_FAILED, LV_ASSET_IMG(language_unselect));
         lv_obj_clear_state(imgbtn_TEST_FAILED, LV_STATE_CHECKED);
         lv_obj_set_style_text_opa(label_CN, LV_OPA_40, 0);
     } else {
-        lv_img_set_src(imgbtn_TEST_FAILED, &language_select);
+        lv_img_set_src(imgbtn_TEST_FAILED, LV_ASSET_IMG(language_select));
         lv_obj_add_state(imgbtn_TEST_FAILED, LV_STATE_CHECKED);
         lv_obj_set_style_text_opa(label_CN, LV_OPA_COVER, 0);
 
-        lv_img_set_src(imgbtn_TEST_OK, &language_unselect);
+        lv_img_set_src(imgbtn_TEST_OK, LV_ASSET_IMG(language_unselect));
         lv_obj_clear_state(imgbtn_TEST_OK, LV_STATE_CHECKED);
         lv_obj_set_style_text_opa(label_EN, LV_OPA_40, 0);
     }
@@ -20,7 +20,6 @@ static time_out_count time_500ms;
 
 static bool language_Layer_enter_cb(void *layer);
 static bool language_Layer_exit_cb(void *layer);
-static void language_Layer_timer_cb(lv_timer_t *tmr);
 
 lv_layer_t language_Layer = {
     .lv_obj_name    = "language_Layer",
@@ -29,7 +28,9 @@ lv_layer_t language_Layer = {
     .lv_show_layer  = NULL,
     .enter_cb       = language_Layer_enter_cb,
     .exit_cb        = language_Layer_exit_cb,
-    .timer_cb       = language_Layer_timer_cb,
+    .timer_cb       = NULL,
+    .update         = { .event_driven = true },
+    .block_clock    = true,
 };
 
 static void language_event_cb(lv_event_t *e)
@@ -43,20 +44,20 @@ static void language_event_cb(lv_event_t *e)
 
         if (is_time_out(&time_500ms)) {
             if (lv_obj_has_state(imgbtn_lang_EN, LV_STATE_CHECKED) == false) {
-                lv_img_set_src(imgbtn_lang_EN, &language_select);
+                lv_img_set_src(imgbtn_lang_EN, LV_ASSET_IMG(language_select));
                 lv_obj_add_state(imgbtn_lang_EN, LV_STATE_CHECKED);
                 lv_obj_set_style_text_opa(label_EN, LV_OPA_COVER, 0);
 
-                lv_img_set_src(imgbtn_lang_CN, &language_unselect);
+                lv_img_set_src(imgbtn_lang_CN, LV_ASSET_IMG(language_unselect));
                 lv_obj_clear_state(imgbtn_lang_CN, LV_STATE_CHECKED);
                 lv_obj_set_style_text_opa(label_CN, LV_OPA_40, 0);
                 param->language = LANGUAGE_EN;
             } else {
-                lv_img_set_src(imgbtn_lang_CN, &language_select);
+                lv_img_set_src(imgbtn_lang_CN, LV_ASSET_IMG(language_select));
                 lv_obj_add_state(imgbtn_lang_CN, LV_STATE_CHECKED);
                 lv_obj_set_style_text_opa(label_CN, LV_OPA_COVER, 0);
 
-                lv_img_set_src(imgbtn_lang_EN, &language_unselect);
+                lv_img_set_src(imgbtn_lang_EN, LV_ASSET_IMG(language_unselect));
                 lv_obj_clear_state(imgbtn_lang_EN, LV_STATE_CHECKED);
                 lv_obj_set_style_text_opa(label_EN, LV_OPA_40, 0);
                 param->language = LANGUAGE_CN;
@@ -81,7 +82,7 @@ void ui_language_init(lv_obj_t *parent)
     lv_obj_center(page);
 
     lv_obj_t *img_language_bg = lv_img_create(page);
-    lv_img_set_src(img_language_bg, &language_bg_dither);
+    lv_img_set_src(img_language_bg, LV_ASSET_IMG(language_bg_dither));
     lv_obj_align(img_language_bg, LV_ALIGN_CENTER, 0, 0);
 
     lv_obj_t *labelinfo_top = lv_label_create(page);
@@ -96,7 +97,7 @@ void ui_language_init(lv_obj_t *parent)
 
     imgbtn_lang_EN = lv_img_create(page);
     lv_obj_align(imgbtn_lang_EN, LV_ALIGN_CENTER, -40, 50);
-    lv_img_set_src(imgbtn_lang_EN, &language_select);
+    lv_img_set_src(imgbtn_lang_EN, LV_ASSET_IMG(language_select));
     lv_obj_add_state(imgbtn_lang_EN, LV_STATE_CHECKED);
 
     label_EN = lv_label_create(imgbtn_lang_EN);
@@ -107,7 +108,7 @@ void ui_language_init(lv_obj_t *parent)
 
     imgbtn_lang_CN = lv_img_create(page);
     lv_obj_align(imgbtn_lang_CN, LV_ALIGN_CENTER, 40, 50);
-    lv_img_set_src(imgbtn_lang_CN, &language_unselect);
+    lv_img_set_src(imgbtn_lang_CN, LV_ASSET_IMG(language_unselect));
     lv_obj_clear_state(imgbtn_lang_CN, LV_STATE_CHECKED);
 
     label_CN = lv_label_create(imgbtn_lang_CN);
@@ -151,8 +152,3 @@ static bool language_Layer_exit_cb(void *layer)
     LV_LOG_USER("");
     return true;
 }
-
-static void language_Layer_timer_cb(lv_timer_t *tmr)
-{
-    feed_clock_time();
-}
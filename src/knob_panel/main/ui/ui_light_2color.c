@@ -47,28 +47,36 @@ typedef struct
 
 typedef struct
 {
-    const lv_img_dsc_t *img_bg[2];
-
-    const lv_img_dsc_t *img_pwm_25[2];
-    const lv_img_dsc_t *img_pwm_50[2];
-    const lv_img_dsc_t *img_pwm_75[2];
-    const lv_img_dsc_t *img_pwm_100[2];
+    const char *img_bg[2];
+
+    const char *img_pwm_25[2];
+    const char *img_pwm_50[2];
+    const char *img_pwm_75[2];
+    const char *img_pwm_100[2];
+    lv_opa_t tint_opa[2];       /* img_recolor_opa, the masks are drawn in the recolor */
+    lv_color_t tint;            /* img_recolor of the cool masks */
 } ui_light_img_t;
 
 static lv_obj_t *page;
-static time_out_count time_20ms, time_500ms;
+static time_out_count time_20ms;
 
 static lv_obj_t *img_light_bg, *label_pwm_set;
 static lv_obj_t *img_light_pwm_25, *img_light_pwm_50, *img_light_pwm_75, *img_light_pwm_100, *img_light_pwm_0;
 
 static light_set_attribute_t light_set_conf, light_xor;
+static lv_style_t style_light_tint;
 
+/* The cool beams are LV_IMG_CF_ALPHA_8BIT masks filled with the tint at draw time
+ * (tools/img_a8_mask.py, checked against the former colour art by test_light_mask).
+ * The warm ones keep their colour art, a mask loses their gradient. */
 static const ui_light_img_t light_image = {
-    {&light_warm_bg, &light_cool_bg},
-    {&light_warm_25, &light_cool_25},
-    {&light_warm_50, &light_cool_50},
-    {&light_warm_75, &light_cool_75},
-    {&light_warm_100, &light_cool_100},
+    {"light_warm_bg", "light_cool_bg"},
+    {"light_warm_25", "light_cool_25"},
+    {"light_warm_50", "light_cool_50"},
+    {"light_warm_75", "light_cool_75"},
+    {"light_warm_100", "light_cool_100"},
+    {LV_OPA_TRANSP, LV_OPA_COVER},
+    LV_COLOR_MAKE(0xF0, 0xED, 0xFF),
 };
 
 lv_layer_t light_2color_Layer = {
@@ -79,6 +87,9 @@ lv_layer_t light_2color_Layer = {
     .enter_cb = light_2color_layer_enter_cb,
     .exit_cb = light_2color_layer_exit_cb,
     .timer_cb = light_2color_layer_timer_cb,
+    .update = { .event_driven = true },
+    .transition = { .type = LV_LAYER_TRANSITION_SLIDE_LEFT },
+    .block_clock = true,
 };
 
 static void light_2color_event_cb(lv_event_t *e)
@@ -96,21 +107,18 @@ static void light_2color_event_cb(lv_event_t *e)
     {
         uint32_t key = lv_event_get_key(e);
 
-        if (is_time_out(&time_500ms))
+        if (LV_KEY_RIGHT == key)
         {
-            if (LV_KEY_RIGHT == key)
+            if (light_set_conf.light_pwm < 100)
             {
-                if (light_set_conf.light_pwm < 100)
-                {
-                    light_set_conf.light_pwm += 25;
-                }
+                light_set_conf.light_pwm += 25;
             }
-            else if (LV_KEY_LEFT == key)
+        }
+        else if (LV_KEY_LEFT == key)
+        {
+            if (light_set_conf.light_pwm > 0)
             {
-                if (light_set_conf.light_pwm > 0)
-                {
-                    light_set_conf.light_pwm -= 25;
-                }
+                light_set_conf.light_pwm -= 25;
             }
         }
     }
@@ -179,11 +187,24 @@ static void play_audio_task(void *param)
                 vTaskDelay(pdMS_TO_TICKS(2000));
                 xSemaphoreGive(playback_semaphore);
                 xSemaphoreGive(light_update_semaphore);
+
+                // The layer timer only runs when notified, let it show the new setting
+                bsp_display_lock(0);
+                lv_func_layer_notify(&light_2color_Layer);
+                bsp_display_unlock();
+                bsp_display_wake();
             }
         }
     }
 }
 
+/* LVGL fills the A8 masks with the recolor of their style, shared by the four beams */
+static void light_set_tint(lv_opa_t opa)
+{
+    lv_style_set_img_recolor_opa(&style_light_tint, opa);
+    lv_obj_report_style_change(&style_light_tint);
+}
+
 void ui_light_2color_init(lv_obj_t *parent)
 {
     // Init all the semaphores and queue
@@ -229,7 +250,7 @@ void ui_light_2color_init(lv_obj_t *parent)
     lv_obj_center(page);
 
     img_light_bg = lv_img_create(page);
-    lv_img_set_src(img_light_bg, &light_warm_bg);
+    lv_img_set_src(img_light_bg, LV_ASSET_IMG(light_warm_bg));
     lv_obj_align(img_light_bg, LV_ALIGN_CENTER, 0, 0);
 
     label_pwm_set = lv_label_create(page);
@@ -245,25 +266,39 @@ void ui_light_2color_init(lv_obj_t *parent)
     lv_obj_align(label_pwm_set, LV_ALIGN_CENTER, 0, 65);
 
     img_light_pwm_0 = lv_img_create(page);
-    lv_img_set_src(img_light_pwm_0, &light_close_status);
+    lv_img_set_src(img_light_pwm_0, LV_ASSET_IMG(light_close_status));
     lv_obj_add_flag(img_light_pwm_0, LV_OBJ_FLAG_HIDDEN);
     lv_obj_align(img_light_pwm_0, LV_ALIGN_TOP_MID, 0, 0);
 
+    /* The style outlives the layer, init it only once */
+    static bool style_inited = false;
+    if (false == style_inited)
+    {
+        style_inited = true;
+        lv_style_init(&style_light_tint);
+        lv_style_set_img_recolor(&style_light_tint, light_image.tint);
+    }
+    lv_style_set_img_recolor_opa(&style_light_tint, light_image.tint_opa[light_set_conf.light_cck]);
+
     img_light_pwm_25 = lv_img_create(page);
-    lv_img_set_src(img_light_pwm_25, &light_warm_25);
+    lv_img_set_src(img_light_pwm_25, LV_ASSET_IMG(light_warm_25));
+    lv_obj_add_style(img_light_pwm_25, &style_light_tint, 0);
     lv_obj_align(img_light_pwm_25, LV_ALIGN_TOP_MID, 0, 0);
 
     img_light_pwm_50 = lv_img_create(page);
-    lv_img_set_src(img_light_pwm_50, &light_warm_50);
+    lv_img_set_src(img_light_pwm_50, LV_ASSET_IMG(light_warm_50));
+    lv_obj_add_style(img_light_pwm_50, &style_light_tint, 0);
     lv_obj_align(img_light_pwm_50, LV_ALIGN_TOP_MID, 0, 0);
 
     img_light_pwm_75 = lv_img_create(page);
-    lv_img_set_src(img_light_pwm_75, &light_warm_75);
+    lv_img_set_src(img_light_pwm_75, LV_ASSET_IMG(light_warm_75));
+    lv_obj_add_style(img_light_pwm_75, &style_light_tint, 0);
     lv_obj_add_flag(img_light_pwm_75, LV_OBJ_FLAG_HIDDEN);
     lv_obj_align(img_light_pwm_75, LV_ALIGN_TOP_MID, 0, 0);
 
     img_light_pwm_100 = lv_img_create(page);
-    lv_img_set_src(img_light_pwm_100, &light_warm_100);
+    lv_img_set_src(img_light_pwm_100, LV_ASSET_IMG(light_warm_100));
+    lv_obj_add_style(img_light_pwm_100, &style_light_tint, 0);
     lv_obj_add_flag(img_light_pwm_100, LV_OBJ_FLAG_HIDDEN);
     lv_obj_align(img_light_pwm_100, LV_ALIGN_TOP_MID, 0, 0);
 
@@ -291,7 +326,6 @@ static bool light_2color_layer_enter_cb(void *layer)
 
         ui_light_2color_init(create_layer->lv_obj_layer);
         set_time_out(&time_20ms, 20);
-        set_time_out(&time_500ms, 200);
     }
 
     return ret;
@@ -313,7 +347,6 @@ static void light_2color_layer_timer_cb(lv_timer_t *tmr)
 {
     uint32_t RGB_color = 0xFF;
 
-    feed_clock_time();
     // Attempt to take the semaphore without blocking
     if (xSemaphoreTake(light_update_semaphore, 0) == pdFALSE)
     {
@@ -351,28 +384,29 @@ static void light_2color_layer_timer_cb(lv_timer_t *tmr)
         }
 
         uint8_t cck_set = (uint8_t)light_xor.light_cck;
+        light_set_tint(light_image.tint_opa[cck_set]);
 
         switch (light_xor.light_pwm)
         {
         case 100:
             lv_obj_clear_flag(img_light_pwm_100, LV_OBJ_FLAG_HIDDEN);
-            lv_img_set_src(img_light_pwm_100, light_image.img_pwm_100[cck_set]);
-            lv_img_set_src(img_light_bg, light_image.img_bg[cck_set]);
+            lv_img_set_src(img_light_pwm_100, lv_asset_img(light_image.img_pwm_100[cck_set]));
+            lv_img_set_src(img_light_bg, lv_asset_img(light_image.img_bg[cck_set]));
             break;
         case 75:
             lv_obj_clear_flag(img_light_pwm_75, LV_OBJ_FLAG_HIDDEN);
-            lv_img_set_src(img_light_pwm_75, light_image.img_pwm_75[cck_set]);
-            lv_img_set_src(img_light_bg, light_image.img_bg[cck_set]);
+            lv_img_set_src(img_light_pwm_75, lv_asset_img(light_image.img_pwm_75[cck_set]));
+            lv_img_set_src(img_light_bg, lv_asset_img(light_image.img_bg[cck_set]));
             break;
         case 50:
             lv_obj_clear_flag(img_light_pwm_50, LV_OBJ_FLAG_HIDDEN);
-            lv_img_set_src(img_light_pwm_50, light_image.img_pwm_50[cck_set]);
-            lv_img_set_src(img_light_bg, light_image.img_bg[cck_set]);
+            lv_img_set_src(img_light_pwm_50, lv_asset_img(light_image.img_pwm_50[cck_set]));
+            lv_img_set_src(img_light_bg, lv_asset_img(light_image.img_bg[cck_set]));
             break;
         case 25:
             lv_obj_clear_flag(img_light_pwm_25, LV_OBJ_FLAG_HIDDEN);
-            lv_img_set_src(img_light_pwm_25, light_image.img_pwm_25[cck_set]);
-            lv_img_set_src(img_light_bg, light_image.img_bg[cck_set]);
+            lv_img_set_src(img_light_pwm_25, lv_asset_img(light_image.img_pwm_25[cck_set]));
+            lv_img_set_src(img_light_bg, lv_asset_img(light_image.img_bg[cck_set]));
             break;
         default:
             break;
@@ -31,20 +31,23 @@ lv_layer_t menu_layer = {
     .enter_cb       = main_layer_enter_cb,
     .exit_cb        = main_layer_exit_cb,
     .timer_cb       = main_layer_timer_cb,
+    .retain         = { .enable = true },
+    .update         = { .event_driven = true },
+    .transition     = { .type = LV_LAYER_TRANSITION_SLIDE_RIGHT },
 };
 typedef struct {
     const char *name_CN;
     const char *name_EN;
-    const lv_img_dsc_t *icon;
-    const lv_img_dsc_t *icon_ns;
+    const char *icon;           /* Names in the asset pack */
+    const char *icon_ns;
     lv_color_t theme_color;
     void *layer;
 } ui_menu_app_t;
 
 static ui_menu_app_t menu[] = {
-    {"洗衣模式",    "Washing",     &icon_washing,      &icon_washing_ns,       LV_COLOR_MAKE(36, 163, 235), &washing_Layer},
-    {"恒温器",      "Thermostat",  &icon_thermostat,   &icon_thermostat_ns,    LV_COLOR_MAKE(249, 139, 122), &thermostat_Layer},
-    {"照明模式",    "Light",       &icon_light,        &icon_light_ns,         LV_COLOR_MAKE(255, 229, 147), &light_2color_Layer},
+    {"洗衣模式",    "Washing",     "icon_washing",     "icon_washing_ns",      LV_COLOR_MAKE(36, 163, 235), &washing_Layer},
+    {"恒温器",      "Thermostat",  "icon_thermostat",  "icon_thermostat_ns",   LV_COLOR_MAKE(249, 139, 122), &thermostat_Layer},
+    {"照明模式",    "Light",       "icon_light",       "icon_light_ns",        LV_COLOR_MAKE(255, 229, 147), &light_2color_Layer},
 };
 
 #define APP_NUM 3//(sizeof(menu) / sizeof(ui_menu_app_t))
@@ -57,7 +60,7 @@ static lv_obj_t *tips_btn, *tips_label;
 static uint8_t tips_delay;
 static uint8_t factory_Enter;
 
-static time_out_count time_100ms, time_500ms;
+#define TIPS_TICK_PERIOD 500
 
 static uint32_t ui_get_num_offset(uint32_t num, int32_t max, int32_t offset)
 {
@@ -86,6 +89,7 @@ void set_tips_info()
 {
     tips_delay = 4;
     lv_obj_clear_flag(tips_btn, LV_OBJ_FLAG_HIDDEN);
+    lv_func_layer_set_tick(&menu_layer, TIPS_TICK_PERIOD);
 }
 
 static void arc_path_by_theta(int16_t theta, int16_t *x, int16_t *y)
@@ -116,43 +120,43 @@ static void menu_event_cb(lv_event_t *e)
         lv_group_set_editing(lv_group_get_default(), true);
     } else if (LV_EVENT_KEY == code) {
         uint32_t key = lv_event_get_key(e);
-        if (is_time_out(&time_100ms)) {
-            int8_t last_index = app_index;
-            if (LV_KEY_RIGHT == key) {
-                app_index = get_app_index(-1);
-            } else if (LV_KEY_LEFT == key) {
-                app_index = get_app_index(1);
-            }
-            if ((factory_Enter < 6) && (app_index == 2)) {
-                factory_Enter = 7;
-                ESP_LOGI(TAG, "Invalid Enter factory");
-            }
+        int8_t last_index = app_index;
+        if (LV_KEY_RIGHT == key) {
+            app_index = get_app_index(-1);
+        } else if (LV_KEY_LEFT == key) {
+            app_index = get_app_index(1);
+        }
+        if ((factory_Enter < 6) && (app_index == 2)) {
+            factory_Enter = 7;
+            ESP_LOGI(TAG, "Invalid Enter factory");
+        }
 
-            if ((factory_Enter < 6) && (++factory_Enter == 6) && (app_index == 0)) {
-                ESP_LOGI(TAG, "Enter factory");
-                lv_indev_wait_release(lv_indev_get_next(NULL));
-                ui_remove_all_objs_from_encoder_group();
-                lv_func_goto_layer(&factory_Layer);
-                return;
-            }
+        if ((factory_Enter < 6) && (++factory_Enter == 6) && (app_index == 0)) {
+            ESP_LOGI(TAG, "Enter factory");
+            lv_indev_wait_release(lv_indev_get_next(NULL));
+            ui_remove_all_objs_from_encoder_group();
+            lv_func_goto_layer(&factory_Layer);
+            return;
+        }
 
-            // audio_handle_info(SOUND_TYPE_KNOB);
+        // audio_handle_info(SOUND_TYPE_KNOB);
 
-            for (int i = 0; i < APP_NUM; i++) {
-                obj_set_to_hightlight(icons[i], i == app_index);
-            }
-            lv_obj_swap(icons[last_index], icons[get_app_index(0)]);
-            lv_img_set_src(icons[last_index], menu[last_index].icon_ns);
-            lv_img_set_src(icons[get_app_index(0)], menu[get_app_index(0)].icon);
-            lv_obj_set_style_border_color(page, menu[get_app_index(0)].theme_color, 0);
-
-            sys_param_t *param = settings_get_parameter();
-            if (LANGUAGE_CN == param->language) {
-                lv_label_set_text(label_name, menu[get_app_index(0)].name_CN);
-            } else {
-                lv_label_set_text(label_name, menu[get_app_index(0)].name_EN);
-            }
+        for (int i = 0; i < APP_NUM; i++) {
+            obj_set_to_hightlight(icons[i], i == app_index);
         }
+        lv_obj_swap(icons[last_index], icons[get_app_index(0)]);
+        lv_img_set_src(icons[last_index], lv_asset_img(menu[last_index].icon_ns));
+        lv_img_set_src(icons[get_app_index(0)], lv_asset_img(menu[get_app_index(0)].icon));
+        lv_obj_set_style_border_color(page, menu[get_app_index(0)].theme_color, 0);
+
+        sys_param_t *param = settings_get_parameter();
+        if (LANGUAGE_CN == param->language) {
+            lv_label_set_text(label_name, menu[get_app_index(0)].name_CN);
+        } else {
+            lv_label_set_text(label_name, menu[get_app_index(0)].name_EN);
+        }
+        /* Build the focused app once the knob rests, the click then only shows it */
+        lv_func_prefetch_layer(menu[get_app_index(0)].layer);
         feed_clock_time();
 
     } else if (LV_EVENT_CLICKED == code) {
@@ -194,9 +198,9 @@ void ui_menu_init(lv_obj_t *parent)
         arc_path_by_theta(180 + i * 120, &x, &y);
         icons[i] = lv_img_create(page);
         if (i == app_index) {
-            lv_img_set_src(icons[i], menu[i].icon);
+            lv_img_set_src(icons[i], lv_asset_img(menu[i].icon));
         } else {
-            lv_img_set_src(icons[i], menu[i].icon_ns);
+            lv_img_set_src(icons[i], lv_asset_img(menu[i].icon_ns));
         }
         lv_obj_align(icons[i], LV_ALIGN_CENTER, x, y);
         lv_obj_set_style_border_color(icons[i], menu[i].theme_color, 0);
@@ -267,9 +271,8 @@ static bool main_layer_enter_cb(void *layer)
 
         ui_menu_init(create_layer->lv_obj_layer);
     }
-    set_time_out(&time_100ms, 200);
-    set_time_out(&time_500ms, 500);
     feed_clock_time();
+    lv_func_prefetch_layer(menu[get_app_index(0)].layer);
 
     return ret;
 }
@@ -283,13 +286,12 @@ static bool main_layer_exit_cb(void *layer)
 
 static void main_layer_timer_cb(lv_timer_t *tmr)
 {
-    if (is_time_out(&time_500ms)) {
-        if (tips_delay) {
-            tips_delay--;
-            if (0 == tips_delay) {
-                lv_obj_add_flag(tips_btn, LV_OBJ_FLAG_HIDDEN);
-                esp_restart();
-            }
+    /* Runs every TIPS_TICK_PERIOD while the factory reset tips are shown */
+    if (tips_delay) {
+        tips_delay--;
+        if (0 == tips_delay) {
+            lv_obj_add_flag(tips_btn, LV_OBJ_FLAG_HIDDEN);
+            esp_restart();
         }
     }
 
@@ -14,11 +14,11 @@
 static lv_obj_t *temp_arc;
 static lv_obj_t *page;
 static lv_obj_t *temp_wheel;
-static time_out_count time_500ms;
+static lv_obj_t *img_thermostat_temp;
 
 static bool thermostat_layer_enter_cb(void *layer);
 static bool thermostat_layer_exit_cb(void *layer);
-static void thermostat_layer_timer_cb(lv_timer_t *tmr);
+static bool thermostat_layer_build_cb(void *layer, uint8_t step);
 
 lv_layer_t thermostat_Layer = {
     .lv_obj_name    = "thermostat_Layer",
@@ -27,7 +27,12 @@ lv_layer_t thermostat_Layer = {
     .lv_show_layer  = NULL,
     .enter_cb       = thermostat_layer_enter_cb,
     .exit_cb        = thermostat_layer_exit_cb,
-    .timer_cb       = thermostat_layer_timer_cb,
+    .timer_cb       = NULL,
+    .retain         = { .enable = true },
+    .update         = { .event_driven = true },
+    .prefetch       = { .build_cb = thermostat_layer_build_cb },
+    .transition     = { .type = LV_LAYER_TRANSITION_SLIDE_LEFT },
+    .block_clock    = true,
 };
 
 static void thermostat_event_cb(lv_event_t *e)
@@ -40,21 +45,19 @@ static void thermostat_event_cb(lv_event_t *e)
         lv_group_set_editing(lv_group_get_default(), true);
     } else if (LV_EVENT_KEY == code) {
 
-        if (is_time_out(&time_500ms)) {
-            uint32_t key = lv_event_get_key(e);
-            current = lv_arc_get_value(temp_arc);
-            if (LV_KEY_RIGHT == key) {
-                if (current < lv_arc_get_max_value(temp_arc)) {
-                    current++;
-                }
-            } else {
-                if (current > lv_arc_get_min_value(temp_arc)) {
-                    current--;
-                }
+        uint32_t key = lv_event_get_key(e);
+        current = lv_arc_get_value(temp_arc);
+        if (LV_KEY_RIGHT == key) {
+            if (current < lv_arc_get_max_value(temp_arc)) {
+                current++;
+            }
+        } else {
+            if (current > lv_arc_get_min_value(temp_arc)) {
+                current--;
             }
-            lv_arc_set_value(temp_arc, current);
-            lv_roller_set_selected(temp_wheel, (current - 19), LV_ANIM_ON);
         }
+        lv_arc_set_value(temp_arc, current);
+        lv_roller_set_selected(temp_wheel, (current - 19), LV_ANIM_ON);
 
     } else if (LV_EVENT_LONG_PRESSED == code) {
         lv_indev_wait_release(lv_indev_get_next(NULL));
@@ -121,17 +124,23 @@ static void mask_event_cb(lv_event_t *e)
 void lv_create_obj_roller(lv_obj_t *parent)
 {
     static lv_style_t style;
-    lv_style_init(&style);
-    lv_style_set_bg_color(&style, lv_color_black());
-    lv_style_set_bg_opa(&style, LV_OPA_0);
-    lv_style_set_text_color(&style, lv_color_white());
-    lv_style_set_border_width(&style, 0);
-    lv_style_set_pad_all(&style, 0);
-    lv_obj_add_style(lv_scr_act(), &style, 0);
+    static bool style_inited = false;
+
+    /* The screen outlives the layer, init the style and add it only once */
+    if (false == style_inited) {
+        style_inited = true;
+        lv_style_init(&style);
+        lv_style_set_bg_color(&style, lv_color_black());
+        lv_style_set_bg_opa(&style, LV_OPA_0);
+        lv_style_set_text_color(&style, lv_color_white());
+        lv_style_set_border_width(&style, 0);
+        lv_style_set_pad_all(&style, 0);
+        lv_obj_add_style(lv_scr_act(), &style, 0);
+    }
 
     temp_wheel = lv_roller_create(parent);
     lv_obj_add_style(temp_wheel, &style, 0);
-    printf("line_space:%d\r\n", lv_obj_get_style_text_line_space(temp_wheel, LV_PART_MAIN));
+    LV_LOG_USER("line_space:%d", lv_obj_get_style_text_line_space(temp_wheel, LV_PART_MAIN));
     lv_obj_set_style_text_line_space(temp_wheel, 40, LV_PART_MAIN);
     //lv_obj_set_style_border_width(temp_wheel, 10, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(temp_wheel, LV_OPA_TRANSP, LV_PART_SELECTED);
@@ -159,7 +168,7 @@ void lv_create_obj_roller(lv_obj_t *parent)
     lv_obj_add_event_cb(temp_wheel, mask_event_cb, LV_EVENT_ALL, NULL);
 }
 
-void ui_thermostat_init(lv_obj_t *parent)
+static void ui_thermostat_create_page(lv_obj_t *parent)
 {
     page = lv_obj_create(parent);
     lv_obj_set_size(page, LV_HOR_RES, LV_VER_RES);
@@ -170,11 +179,11 @@ void ui_thermostat_init(lv_obj_t *parent)
     lv_obj_center(page);
 
     lv_obj_t *img_thermostat_bg = lv_img_create(page);
-    lv_img_set_src(img_thermostat_bg, &AC_BG);
+    lv_img_set_src(img_thermostat_bg, LV_ASSET_IMG(AC_BG));
     lv_obj_align(img_thermostat_bg, LV_ALIGN_CENTER, 0, 0);
 
-    lv_obj_t *img_thermostat_temp = lv_img_create(page);
-    lv_img_set_src(img_thermostat_temp, &AC_temper);
+    img_thermostat_temp = lv_img_create(page);
+    lv_img_set_src(img_thermostat_temp, LV_ASSET_IMG(AC_temper));
     lv_obj_align(img_thermostat_temp, LV_ALIGN_CENTER, 0, 20);
 
     temp_arc = lv_arc_create(page);
@@ -207,9 +216,12 @@ void ui_thermostat_init(lv_obj_t *parent)
     lv_obj_align(temp_arc, LV_ALIGN_TOP_MID, 0, 15);
 
     lv_obj_t *img_temp_unit = lv_img_create(page);
-    lv_img_set_src(img_temp_unit, &AC_unit);
+    lv_img_set_src(img_temp_unit, LV_ASSET_IMG(AC_unit));
     lv_obj_align(img_temp_unit, LV_ALIGN_CENTER, 50, -10);
+}
 
+static void ui_thermostat_start(lv_obj_t *parent)
+{
     lv_create_obj_roller(parent);
     lv_roller_set_selected(temp_wheel, (22 - 19), LV_ANIM_ON);
 
@@ -221,7 +233,7 @@ void ui_thermostat_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&a1, lv_anim_path_overshoot);
     //lv_anim_set_time(&a1, 400);
     lv_anim_set_time(&a1, 400 * 3);
-    lv_anim_start(&a1);
+    lv_func_layer_anim_start(&thermostat_Layer, &a1);
 
     lv_anim_t a2;
     lv_anim_init(&a2);
@@ -231,7 +243,7 @@ void ui_thermostat_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&a2, lv_anim_path_overshoot);
     //lv_anim_set_time(&a2, 400);
     lv_anim_set_time(&a1, 400 * 3);
-    lv_anim_start(&a2);
+    lv_func_layer_anim_start(&thermostat_Layer, &a2);
 
     ui_remove_all_objs_from_encoder_group();//roll will add event default.
     lv_obj_add_event_cb(page, thermostat_event_cb, LV_EVENT_FOCUSED, NULL);
@@ -240,6 +252,22 @@ void ui_thermostat_init(lv_obj_t *parent)
     ui_add_obj_to_encoder_group(page);
 }
 
+/* The build in steps, lv_func_prefetch_layer() runs them in idle slices */
+static bool thermostat_layer_build_cb(void *layer, uint8_t step)
+{
+    lv_layer_t *create_layer = layer;
+
+    if (0 == step) {
+        create_layer->lv_obj_layer = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(create_layer->lv_obj_layer);
+        lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
+        ui_thermostat_create_page(create_layer->lv_obj_layer);
+        return false;
+    }
+    ui_thermostat_start(create_layer->lv_obj_layer);
+    return true;
+}
+
 static bool thermostat_layer_enter_cb(void *layer)
 {
     bool ret = false;
@@ -248,12 +276,8 @@ static bool thermostat_layer_enter_cb(void *layer)
     lv_layer_t *create_layer = layer;
     if (NULL == create_layer->lv_obj_layer) {
         ret = true;
-        create_layer->lv_obj_layer = lv_obj_create(lv_scr_act());
-        lv_obj_remove_style_all(create_layer->lv_obj_layer);
-        lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
-
-        ui_thermostat_init(create_layer->lv_obj_layer);
-        set_time_out(&time_500ms, 100);
+        for (uint8_t step = 0; !thermostat_layer_build_cb(layer, step); step++) {
+        }
     }
     return ret;
 }
@@ -263,8 +287,3 @@ static bool thermostat_layer_exit_cb(void *layer)
     LV_LOG_USER("");
     return true;
 }
-
-static void thermostat_layer_timer_cb(lv_timer_t *tmr)
-{
-    feed_clock_time();
-}
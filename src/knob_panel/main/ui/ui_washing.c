@@ -18,6 +18,7 @@
 static bool washing_layer_enter_cb(void *layer);
 static bool washing_layer_exit_cb(void *layer);
 static void washing_layer_timer_cb(lv_timer_t *tmr);
+static bool washing_layer_build_cb(void *layer, uint8_t step);
 
 lv_layer_t washing_Layer = {
     .lv_obj_name    = "washing_Layer",
@@ -27,12 +28,18 @@ lv_layer_t washing_Layer = {
     .enter_cb       = washing_layer_enter_cb,
     .exit_cb        = washing_layer_exit_cb,
     .timer_cb       = washing_layer_timer_cb,
+    .retain         = { .enable = true },
+    .update         = { .event_driven = true },
+    .prefetch       = { .build_cb = washing_layer_build_cb },
+    .transition     = { .type = LV_LAYER_TRANSITION_SLIDE_LEFT },
+    .block_clock    = true,
 };
 
 #define FUNC_NUM 3
+#define WASH_COUNTDOWN_PERIOD 500
 typedef struct {
-    const lv_img_dsc_t *wash_funcs_CN;
-    const lv_img_dsc_t *wash_funcs_EN;
+    const char *wash_funcs_CN;  /* Names in the asset pack */
+    const char *wash_funcs_EN;
     uint8_t wash_time;
 } wash_cycle_t;
 
@@ -45,9 +52,9 @@ typedef enum {
 } WASH_MODE_T;
 
 static const wash_cycle_t wash_cycle[FUNC_NUM] = {
-    {&img_washing_stand, &wash_basic, 58},
-    {&img_washing_shirt, &wash_blouse, 68},
-    {&img_washing_underwear, &wash_briefs, 28},
+    {"img_washing_stand", "wash_basic", 58},
+    {"img_washing_shirt", "wash_blouse", 68},
+    {"img_washing_underwear", "wash_briefs", 28},
 };
 
 static lv_coord_t cycle_init_y_axis[FUNC_NUM];
@@ -60,6 +67,7 @@ static lv_obj_t *img_funcs[FUNC_NUM];
 static lv_obj_t *page_background, *page_standby, *page_run;
 static lv_obj_t *img_bg_wash;
 static lv_obj_t *img_wave1, *img_wave2;
+static lv_obj_t *img_bub1, *img_bub2;
 static lv_obj_t *img_run_wave1, *img_run_wave2;
 static lv_coord_t img_wave1_x, img_wave2_x, img_run_wave1_x, img_run_wave2_x;
 static lv_obj_t *img_anmi_shirt, *img_anmi_underwear1, *img_anmi_underwear2;
@@ -68,7 +76,12 @@ static lv_obj_t *label_leftTimeH, *label_leftTimeL, *label_leftTime_unit;
 static WASH_MODE_T wash_mode, wash_mode_xor;
 static uint8_t item_central;
 static uint32_t wash_time_left, wash_demo_left;
-static time_out_count time_1000ms;
+
+static void wash_mode_set(WASH_MODE_T mode)
+{
+    wash_mode = mode;
+    lv_func_layer_notify(&washing_Layer);
+}
 
 static uint32_t get_cycle_position(uint32_t num, int32_t max, int32_t offset)
 {
@@ -220,7 +233,7 @@ static void washing_event_cb(lv_event_t *e)
             lv_anim_set_ready_cb(&a1, func_anim_ready_cb);
             lv_anim_set_user_data(&a1, (void *)changed);
             lv_anim_set_time(&a1, 350);
-            lv_anim_start(&a1);
+            lv_func_layer_anim_start(&washing_Layer, &a1);
         }
 
     } else if (LV_EVENT_LONG_PRESSED == code) {
@@ -230,18 +243,18 @@ static void washing_event_cb(lv_event_t *e)
             ui_remove_all_objs_from_encoder_group();
             lv_func_goto_layer(&menu_layer);
         } else if ((WASH_MODE_RUN == wash_mode) || (WASH_MODE_PAUSE == wash_mode)) {
-            wash_mode = WASH_MODE_EOC;
+            wash_mode_set(WASH_MODE_EOC);
         } else if (WASH_MODE_EOC == wash_mode) {
-            wash_mode = WASH_MODE_STANDBY;
+            wash_mode_set(WASH_MODE_STANDBY);
         }
     } else if (LV_EVENT_CLICKED == code) {
         if(false == forbidden_sec_trigger) {
             if (WASH_MODE_STANDBY == wash_mode) {
-                wash_mode = WASH_MODE_RUN;
+                wash_mode_set(WASH_MODE_RUN);
             } else if (WASH_MODE_RUN == wash_mode) {
-                wash_mode = WASH_MODE_PAUSE;
+                wash_mode_set(WASH_MODE_PAUSE);
             } else if (WASH_MODE_PAUSE == wash_mode) {
-                wash_mode = WASH_MODE_RUN;
+                wash_mode_set(WASH_MODE_RUN);
             }
         } else {
             forbidden_sec_trigger = false;
@@ -311,10 +324,8 @@ static void mask_event_cb(lv_event_t *e)
     }
 }
 
-void ui_washing_init(lv_obj_t *parent)
+static void ui_washing_create_pages(lv_obj_t *parent)
 {
-    sys_param_t *param = settings_get_parameter();
-
     page_background = lv_obj_create(parent);
     lv_obj_set_size(page_background, LV_HOR_RES, LV_VER_RES);
 
@@ -336,10 +347,12 @@ void ui_washing_init(lv_obj_t *parent)
     // lv_obj_set_size(page_run, LV_HOR_RES -10, LV_VER_RES -10);
     lv_obj_set_size(page_run, LV_HOR_RES, LV_VER_RES);
     lv_obj_align(page_run, LV_ALIGN_CENTER, 0, 0);
+}
+
+static void ui_washing_create_run_page(void)
+{
+    sys_param_t *param = settings_get_parameter();
 
-    /*
-     * create run page
-     */
     label_leftTimeH = lv_label_create(page_run);
     lv_obj_set_style_text_font(label_leftTimeH, &HelveticaNeue_Regular_48, 0);
     lv_label_set_text(label_leftTimeH, "12");
@@ -367,11 +380,11 @@ void ui_washing_init(lv_obj_t *parent)
     lv_obj_align(label_info, LV_ALIGN_CENTER, 0, 40);
 
     img_run_wave1 = lv_img_create(page_run);
-    lv_img_set_src(img_run_wave1, &img_washing_wave1);
+    lv_img_set_src(img_run_wave1, LV_ASSET_IMG(img_washing_wave1));
     lv_obj_align(img_run_wave1, LV_ALIGN_BOTTOM_MID, -15, 10);
     lv_img_set_zoom(img_run_wave1, 256 * (240 - 0) / 162);
     img_run_wave2 = lv_img_create(page_run);
-    lv_img_set_src(img_run_wave2, &img_washing_wave2);
+    lv_img_set_src(img_run_wave2, LV_ASSET_IMG(img_washing_wave2));
     lv_obj_align(img_run_wave2, LV_ALIGN_BOTTOM_MID, 20, 10);
     lv_img_set_zoom(img_run_wave2, 256 * (240 - 0) / 162);
     // lv_obj_add_event_cb(img_run_wave1, mask_event_cb, LV_EVENT_ALL, NULL);
@@ -387,41 +400,43 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&anmi_run_wave, lv_anim_path_ease_in_out);
     lv_anim_set_time(&anmi_run_wave, lv_rand(3200, 4000));
     lv_anim_set_repeat_count(&anmi_run_wave, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&anmi_run_wave);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_run_wave);
 
     lv_obj_add_flag(page_run, LV_OBJ_FLAG_HIDDEN);
+}
+
+static void ui_washing_create_standby_page(void)
+{
+    sys_param_t *param = settings_get_parameter();
 
-    /*
-     * create standby page
-     */
     img_bg_wash = lv_img_create(page_standby);
-    lv_img_set_src(img_bg_wash, &img_washing_bg);
+    lv_img_set_src(img_bg_wash, LV_ASSET_IMG(img_washing_bg));
     lv_obj_align(img_bg_wash, LV_ALIGN_LEFT_MID, 7, 0);
 
     img_wave1 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_wave1, &img_washing_wave1);
+    lv_img_set_src(img_wave1, LV_ASSET_IMG(img_washing_wave1));
     lv_obj_align(img_wave1, LV_ALIGN_BOTTOM_MID, -15, 10);
     img_wave2 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_wave2, &img_washing_wave2);
+    lv_img_set_src(img_wave2, LV_ASSET_IMG(img_washing_wave2));
     lv_obj_align(img_wave2, LV_ALIGN_BOTTOM_MID, 20, 10);
     lv_obj_add_event_cb(img_wave1, mask_event_cb, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(img_wave2, mask_event_cb, LV_EVENT_ALL, NULL);
 
-    lv_obj_t *img_bub1 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_bub1, &img_washing_bubble1);
+    img_bub1 = lv_img_create(img_bg_wash);
+    lv_img_set_src(img_bub1, LV_ASSET_IMG(img_washing_bubble1));
     lv_obj_center(img_bub1);
-    lv_obj_t *img_bub2 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_bub2, &img_washing_bubble2);
+    img_bub2 = lv_img_create(img_bg_wash);
+    lv_img_set_src(img_bub2, LV_ASSET_IMG(img_washing_bubble2));
     lv_obj_center(img_bub2);
 
     img_anmi_shirt = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_anmi_shirt, &wash_shirt);
+    lv_img_set_src(img_anmi_shirt, LV_ASSET_IMG(wash_shirt));
     lv_obj_align(img_anmi_shirt, LV_ALIGN_TOP_MID, 0, 20);
     img_anmi_underwear1 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_anmi_underwear1, &wash_underwear1);
+    lv_img_set_src(img_anmi_underwear1, LV_ASSET_IMG(wash_underwear1));
     lv_obj_align(img_anmi_underwear1, LV_ALIGN_TOP_MID, 0, 15);
     img_anmi_underwear2 = lv_img_create(img_bg_wash);
-    lv_img_set_src(img_anmi_underwear2, &wash_underwear2);
+    lv_img_set_src(img_anmi_underwear2, LV_ASSET_IMG(wash_underwear2));
     lv_obj_align(img_anmi_underwear2, LV_ALIGN_TOP_MID, 0, 15 + 28 + 8);
 
     label_wash_time = lv_label_create(page_standby);
@@ -437,15 +452,18 @@ void ui_washing_init(lv_obj_t *parent)
         //arc_path_by_theta(i * 45, &x, &y);
         img_funcs[i] = lv_img_create(page_standby);
         if (LANGUAGE_CN == param->language) {
-            lv_img_set_src(img_funcs[i], wash_cycle[i].wash_funcs_CN);
+            lv_img_set_src(img_funcs[i], lv_asset_img(wash_cycle[i].wash_funcs_CN));
         } else {
-            lv_img_set_src(img_funcs[i], wash_cycle[i].wash_funcs_EN);
+            lv_img_set_src(img_funcs[i], lv_asset_img(wash_cycle[i].wash_funcs_EN));
         }
         x = 40;
         y = (i - 1) * 40;
         lv_obj_align(img_funcs[i], LV_ALIGN_CENTER, x, y);
     }
+}
 
+static void ui_washing_start_standby(void)
+{
     lv_anim_t anmi_bub1;
     lv_anim_init(&anmi_bub1);
     lv_anim_set_var(&anmi_bub1, img_bub1);
@@ -455,7 +473,7 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&anmi_bub1, lv_anim_path_ease_in_out);
     lv_anim_set_time(&anmi_bub1, lv_rand(1800, 2300));
     lv_anim_set_repeat_count(&anmi_bub1, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&anmi_bub1);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_bub1);
 
     lv_anim_t anmi_bub2;
     lv_anim_init(&anmi_bub2);
@@ -466,7 +484,7 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&anmi_bub2, lv_anim_path_ease_in_out);
     lv_anim_set_time(&anmi_bub2, lv_rand(2000, 2800));
     lv_anim_set_repeat_count(&anmi_bub2, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&anmi_bub2);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_bub2);
 
     img_wave1_x = lv_obj_get_x_aligned(img_wave1);
     img_wave2_x = lv_obj_get_x_aligned(img_wave2);
@@ -479,7 +497,7 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_path_cb(&anmi_wave, lv_anim_path_ease_in_out);
     lv_anim_set_time(&anmi_wave, lv_rand(3200, 4000));
     lv_anim_set_repeat_count(&anmi_wave, LV_ANIM_REPEAT_INFINITE);
-    lv_anim_start(&anmi_wave);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_wave);
 
     lv_anim_t anmi_shirt;
     lv_anim_init(&anmi_shirt);
@@ -491,7 +509,7 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_time(&anmi_shirt, lv_rand(3200, 4000));
     lv_anim_set_repeat_count(&anmi_shirt, LV_ANIM_REPEAT_INFINITE);
     lv_anim_set_playback_time(&anmi_shirt, lv_rand(3200, 4000));
-    lv_anim_start(&anmi_shirt);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_shirt);
 
     lv_anim_t anmi_underwear;
     lv_anim_init(&anmi_underwear);
@@ -503,7 +521,7 @@ void ui_washing_init(lv_obj_t *parent)
     lv_anim_set_time(&anmi_underwear, lv_rand(2200, 3000));
     lv_anim_set_repeat_count(&anmi_underwear, LV_ANIM_REPEAT_INFINITE);
     lv_anim_set_playback_time(&anmi_underwear, lv_rand(2200, 3000));
-    lv_anim_start(&anmi_underwear);
+    lv_func_layer_anim_start(&washing_Layer, &anmi_underwear);
 
     lv_obj_add_event_cb(page_background, washing_event_cb, LV_EVENT_FOCUSED, NULL);
     lv_obj_add_event_cb(page_background, washing_event_cb, LV_EVENT_LONG_PRESSED, NULL);
@@ -517,6 +535,30 @@ void ui_washing_init(lv_obj_t *parent)
     menu_position_reset();
 }
 
+/* The build in steps of a few ms each, lv_func_prefetch_layer() runs them in idle slices */
+static bool washing_layer_build_cb(void *layer, uint8_t step)
+{
+    lv_layer_t *create_layer = layer;
+
+    switch (step) {
+    case 0:
+        create_layer->lv_obj_layer = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(create_layer->lv_obj_layer);
+        lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
+        ui_washing_create_pages(create_layer->lv_obj_layer);
+        return false;
+    case 1:
+        ui_washing_create_run_page();
+        return false;
+    case 2:
+        ui_washing_create_standby_page();
+        return false;
+    default:
+        ui_washing_start_standby();
+        return true;
+    }
+}
+
 static bool washing_layer_enter_cb(void *layer)
 {
     bool ret = false;
@@ -525,14 +567,15 @@ static bool washing_layer_enter_cb(void *layer)
     lv_layer_t *create_layer = layer;
     if (NULL == create_layer->lv_obj_layer) {
         ret = true;
-        create_layer->lv_obj_layer = lv_obj_create(lv_scr_act());
-        lv_obj_remove_style_all(create_layer->lv_obj_layer);
-        lv_obj_set_size(create_layer->lv_obj_layer, LV_HOR_RES, LV_VER_RES);
-
-        ui_washing_init(create_layer->lv_obj_layer);
-        set_time_out(&time_1000ms, 500);
+        for (uint8_t step = 0; !washing_layer_build_cb(layer, step); step++) {
+        }
     }
 
+    /* Drawn on every frame of the standby animation, freed again when the layer is left */
+    lv_img_lru_pin(LV_ASSET_IMG(img_washing_bg));
+    lv_img_lru_pin(LV_ASSET_IMG(img_washing_bubble1));
+    lv_img_lru_pin(LV_ASSET_IMG(img_washing_bubble2));
+
     return ret;
 }
 
@@ -544,7 +587,6 @@ static bool washing_layer_exit_cb(void *layer)
 
 static void washing_layer_timer_cb(lv_timer_t *tmr)
 {
-    feed_clock_time();
     sys_param_t *param = settings_get_parameter();
 
     if (wash_mode_xor ^ wash_mode) {
@@ -580,9 +622,11 @@ static void washing_layer_timer_cb(lv_timer_t *tmr)
             break;
         }
         wash_mode_xor = wash_mode;
+        /* Only a running program needs a tick, for the countdown */
+        lv_func_layer_set_tick(&washing_Layer, (WASH_MODE_RUN == wash_mode) ? WASH_COUNTDOWN_PERIOD : 0);
     }
 
-    if (is_time_out(&time_1000ms) && (WASH_MODE_RUN == wash_mode)) {
+    if (WASH_MODE_RUN == wash_mode) {
         if (wash_demo_left) {
             if (wash_time_left % 2) {
                 lv_obj_add_flag(label_leftTime_unit, LV_OBJ_FLAG_HIDDEN);
@@ -594,7 +638,7 @@ static void washing_layer_timer_cb(lv_timer_t *tmr)
             wash_time_left--;
             wash_demo_left--;
         } else {
-            wash_mode = WASH_MODE_EOC;
+            wash_mode_set(WASH_MODE_EOC);
         }
     }
 }
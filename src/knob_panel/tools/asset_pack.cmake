@@ -0,0 +1,29 @@
+# Build step packing the converted images into the binary of the asset partition,
+# see asset_pack.py. The application maps it at runtime instead of linking the images.
+set(ASSET_PACK_SCRIPTS ${CMAKE_CURRENT_LIST_DIR}/asset_pack.py ${CMAKE_CURRENT_LIST_DIR}/img_rle.py)
+
+# asset_pack_build(<target> <python> <output> SWAP <0|1> IMAGES <image.c>...
+#                  [MAX_SIZE <bytes>] [NO_DEDUP] [PLACEHOLDERS <name=WxH>...])
+#
+# Adds the target <target> building <output> from the image sources, with the byte
+# order of LV_COLOR_16_SWAP. MAX_SIZE fails the build when the pack does not fit.
+# Images with the same data share it unless NO_DEDUP is given.
+function(asset_pack_build target python output)
+    cmake_parse_arguments(arg "NO_DEDUP" "SWAP;MAX_SIZE" "IMAGES;PLACEHOLDERS" ${ARGN})
+    list(GET ASSET_PACK_SCRIPTS 0 script)
+    set(args --swap ${arg_SWAP})
+    if(arg_MAX_SIZE)
+        list(APPEND args --max-size ${arg_MAX_SIZE})
+    endif()
+    if(arg_NO_DEDUP)
+        list(APPEND args --no-dedup)
+    endif()
+    foreach(placeholder ${arg_PLACEHOLDERS})
+        list(APPEND args --placeholder ${placeholder})
+    endforeach()
+    add_custom_command(OUTPUT ${output}
+                       COMMAND ${python} ${script} ${output} ${args} ${arg_IMAGES}
+                       DEPENDS ${arg_IMAGES} ${ASSET_PACK_SCRIPTS}
+                       VERBATIM)
+    add_custom_target(${target} ALL DEPENDS ${output})
+endfunction()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Pack the 16-bit colour depth images of the LVGL image sources (as written by
+# img_rgb565a8.py and img_rle.py) and the LV_IMG_CF_ALPHA_8BIT masks (img_a8_mask.py)
+# into one binary, mapped at runtime by
+# main/ui/layer_manage/lv_asset_pack.c. All values are little-endian:
+#
+#   header   'LVAP', uint16_t version, uint16_t count, uint32_t size, uint32_t flags
+#            (bit 0: LV_COLOR_16_SWAP)
+#   entries  count entries sorted by hash, 24 bytes each:
+#            uint32_t hash (FNV-1a of the name), uint32_t name offset,
+#            uint32_t data offset, uint32_t data size,
+#            uint8_t cf, uint8_t 0, uint16_t w, uint16_t h, uint16_t 0
+#   names    NUL-terminated
+#   data     4-byte aligned, as the image descriptor points to it
+#
+# The name of an image is the name of its lv_img_dsc_t. --placeholder adds an opaque
+# black LV_IMG_CF_TRUE_COLOR image, for the artwork which is not part of the tree.
+#
+# The data is content-addressed: images with the same bytes point to one copy, and the
+# bytes saved are reported, with the RLE rows shared inside images by img_rle.py.
+# --no-dedup writes every image on its own.
+#
+# Usage: asset_pack.py <output.bin> --swap 0|1 [--max-size N] [--no-dedup]
+#                      [--placeholder NAME=WxH]... <image.c>...
+
+import argparse
+import hashlib
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from img_rle import BLOCK_16, HEX, SIZE  # noqa: E402
+
+MAGIC = b'LVAP'
+VERSION = 1
+FLAG_SWAP = 0x01
+HEADER = struct.Struct('<4sHHII')
+ENTRY = struct.Struct('<IIIIBxHHxx')
+ALIGN = 4
+
+# lv_img_cf_t of LVGL 8 (src/draw/lv_img_buf.h)
+CF_VALUES = {
+    'LV_IMG_CF_TRUE_COLOR': 4,
+    'LV_IMG_CF_TRUE_COLOR_ALPHA': 5,
+    'LV_IMG_CF_ALPHA_8BIT': 14,
+    'LV_IMG_CF_RGB565A8': 20,
+    'LV_IMG_CF_USER_ENCODED_0': 30,
+}
+CF_ANY = re.compile(r'^\s*\.header\.cf = (LV_IMG_CF_\w+),\s*$')
+NAME = re.compile(r'\blv_img_dsc_t (\w+) = \{')
+MAP_DATA = re.compile(r'\buint8_t \w+\[\] = \{(.*?)\};', re.S)
+
+
+def fnv1a(name):
+    h = 0x811c9dc5
+    for b in name.encode():
+        h = ((h ^ b) * 0x01000193) & 0xffffffff
+    return h
+
+
+def image_cf(lines):
+    """Format under '#if LV_COLOR_DEPTH == 16', or of the whole image"""
+    cf = None
+    in_16 = False
+    for line in lines:
+        if line.startswith('#if LV_COLOR_DEPTH == 16\n'):
+            in_16 = True
+        elif line.startswith('#'):
+            in_16 = False
+        m = CF_ANY.match(line)
+        if m and (in_16 or cf is None):
+            cf = m.group(1)
+    return cf
+
+
+def read_image(path, swap):
+    with open(path) as f:
+        lines = f.readlines()
+    text = ''.join(lines)
+    name = NAME.search(text).group(1)
+    sizes = dict(SIZE.findall(text))
+    cf = image_cf(lines)
+    if cf not in CF_VALUES:
+        raise ValueError('{}: format {} is not supported'.format(path, cf))
+    if cf == 'LV_IMG_CF_ALPHA_8BIT':
+        # The same for every colour depth
+        return name, CF_VALUES[cf], int(sizes['w']), int(sizes['h']), \
+            bytes(int(x, 16) for x in HEX.findall(MAP_DATA.search(text).group(1)))
+
+    block = None
+    for i, line in enumerate(lines):
+        if block is not None and line.startswith('#endif'):
+            return name, CF_VALUES[cf], int(sizes['w']), int(sizes['h']), \
+                bytes(int(x, 16) for x in HEX.findall(''.join(lines[block + 1:i])))
+        if BLOCK_16.match(line) and ('!=' in line) == bool(swap):
+            block = i
+    raise ValueError('{}: no 16-bit colour block'.format(path))
+
+
+def placeholder(spec):
+    name, size = spec.split('=')
+    w, h = (int(v) for v in size.split('x'))
+    return name, CF_VALUES['LV_IMG_CF_TRUE_COLOR'], w, h, bytes(w * h * 2)
+
+
+def shared_rle_rows(cf, data):
+    """Bytes of the rows an RLE image points to more than once"""
+    if cf != CF_VALUES['LV_IMG_CF_USER_ENCODED_0'] or data[:2] != b'RL':
+        return 0
+    rows = (struct.unpack_from('<I', data, 4)[0] - 4) // 4
+    offsets = struct.unpack_from('<{}I'.format(rows), data, 4)
+    ends = sorted(set(offsets)) + [len(data)]
+    size = {start: end - start for start, end in zip(ends, ends[1:])}
+    return sum(size[o] for o in offsets) - sum(size.values())
+
+
+def pack(images, swap, dedup=True):
+    images = sorted(images, key=lambda img: fnv1a(img[0]))
+    names = [img[0] for img in images]
+    if len(set(names)) != len(names):
+        raise ValueError('duplicate image names')
+
+    names_offset = HEADER.size + ENTRY.size * len(images)
+    name_blob = bytearray()
+    name_offsets = []
+    for name in names:
+        name_offsets.append(names_offset + len(name_blob))
+        name_blob += name.encode() + b'\0'
+
+    data_blob = bytearray()
+    data_start = names_offset + len(name_blob)
+    data_start += -data_start % ALIGN
+    entries = bytearray()
+    blobs = {}
+    duplicates = 0
+    saved = 0
+    for (name, cf, w, h, data), name_offset in zip(images, name_offsets):
+        digest = hashlib.sha256(data).digest()
+        if dedup and digest in blobs:
+            duplicates += 1
+            saved += len(data)
+        else:
+            data_blob += bytes(-len(data_blob) % ALIGN)
+            blobs[digest] = data_start + len(data_blob)
+            data_blob += data
+        entries += ENTRY.pack(fnv1a(name), name_offset, blobs[digest], len(data), cf, w, h)
+
+    size = data_start + len(data_blob)
+    out = bytearray(HEADER.pack(MAGIC, VERSION, len(images), size, FLAG_SWAP if swap else 0))
+    out += entries + name_blob
+    out += bytes(data_start - len(out))
+    out += data_blob
+    return out, duplicates, saved
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack LVGL images into an asset partition image')
+    parser.add_argument('output')
+    parser.add_argument('images', nargs='*')
+    parser.add_argument('--swap', type=int, choices=(0, 1), required=True, help='LV_COLOR_16_SWAP')
+    parser.add_argument('--max-size', type=lambda v: int(v, 0), help='size of the partition')
+    parser.add_argument('--no-dedup', action='store_true', help='one copy of the data per image')
+    parser.add_argument('--placeholder', action='append', default=[], metavar='NAME=WxH')
+    args = parser.parse_intermixed_args()
+
+    try:
+        images = [read_image(path, args.swap) for path in args.images]
+        images += [placeholder(spec) for spec in args.placeholder]
+        out, duplicates, saved = pack(images, args.swap, not args.no_dedup)
+    except (KeyError, ValueError, AttributeError, struct.error) as e:
+        sys.exit('asset_pack: {}'.format(e))
+    rows = sum(shared_rle_rows(cf, data) for _, cf, _, _, data in images)
+    print('asset_pack: {} images in {} bytes, {} duplicate images ({} bytes) and {} bytes of shared RLE rows saved'
+          .format(len(images), len(out), duplicates, saved, rows))
+    if args.max_size is not None and len(out) > args.max_size:
+        sys.exit('asset_pack: {} bytes do not fit in the {} bytes of the partition'.format(len(out), args.max_size))
+    with open(args.output, 'wb') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Reduce a LV_IMG_CF_TRUE_COLOR_ALPHA image of the LVGL image converter, drawn in one
+# colour, to a LV_IMG_CF_ALPHA_8BIT mask. The mask is the brightness of the image over
+# black (the largest channel times the alpha), LVGL fills it with the img_recolor of
+# the style. The colour to recolor it with to look like the input is printed.
+#
+# The output is a source in the format of the LVGL image converter, with one row of
+# the image per line.
+#
+# Usage: img_a8_mask.py <input.c> <output.c> <name>
+
+import re
+import sys
+
+BLOCK_32 = re.compile(r'^#if LV_COLOR_DEPTH == 32\s*$')
+HEX = re.compile(r'0x([0-9a-fA-F]{2})')
+SIZE = re.compile(r'\.header\.([wh]) = (\d+),')
+
+TEMPLATE = '''\
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+#ifndef LV_ATTRIBUTE_IMG_{upper}
+#define LV_ATTRIBUTE_IMG_{upper}
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_{upper} uint8_t {name}_map[] = {{
+  /*Pixel format: Alpha 8 bit*/
+{rows}}};
+
+const lv_img_dsc_t {name} = {{
+  .header.cf = LV_IMG_CF_ALPHA_8BIT,
+  .header.always_zero = 0,
+  .header.reserved = 0,
+  .header.w = {w},
+  .header.h = {h},
+  .data_size = {size},
+  .data = {name}_map,
+}};
+'''
+
+
+def read_argb8888(lines):
+    """Pixels of the 32-bit block as (r, g, b, a)"""
+    for i, line in enumerate(lines):
+        if BLOCK_32.match(line):
+            end = next(j for j in range(i, len(lines)) if lines[j].startswith('#endif'))
+            data = [int(x, 16) for x in HEX.findall(''.join(lines[i + 1:end]))]
+            return [(data[j + 2], data[j + 1], data[j], data[j + 3]) for j in range(0, len(data), 4)]
+    raise ValueError('no 32-bit colour block')
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit('usage: img_a8_mask.py <input.c> <output.c> <name>')
+    src, dst, name = sys.argv[1:]
+
+    with open(src) as f:
+        lines = f.readlines()
+    try:
+        sizes = dict(SIZE.findall(''.join(lines)))
+        w, h = int(sizes['w']), int(sizes['h'])
+        pixels = read_argb8888(lines)
+    except (KeyError, ValueError, StopIteration) as e:
+        sys.exit('{}: {}'.format(src, e or 'unterminated #if'))
+    if len(pixels) != w * h:
+        sys.exit('{}: {} pixels for {} x {}'.format(src, len(pixels), w, h))
+
+    mask = [(max(r, g, b) * a + 127) // 255 for r, g, b, a in pixels]
+
+    # Least-squares colour of the mask against the image over black
+    norm = sum(m * m for m in mask) or 1
+    tint = [min(255, round(sum(p[c] * p[3] / 255 * m for p, m in zip(pixels, mask)) / norm * 255)) for c in range(3)]
+    print('{}: recolor 0x{:02X}{:02X}{:02X}'.format(name, *tint))
+
+    rows = ''.join('  ' + ''.join('0x{:02x}, '.format(v) for v in mask[y * w:(y + 1) * w]) + '\n' for y in range(h))
+    with open(dst, 'w') as f:
+        f.write(TEMPLATE.format(name=name, upper=name.upper(), rows=rows, w=w, h=h, size=w * h))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,28 @@
+# Build step packing the frames of an animation into one image and a header of frame
+# rectangles, see img_atlas.py. The image goes through img_rle_convert() like the others.
+set(IMG_ATLAS_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/img_atlas.py)
+
+# img_atlas_build(<target> <python> <spec> <name>)
+#
+# Adds the target <target> writing <name>.c and the header <name>.h into the img_atlas
+# directory of the current binary directory, from the frames listed in <spec>. Sets
+# <target>_IMAGE to the image source and <target>_INCLUDE_DIR to the directory of the header.
+function(img_atlas_build target python spec name)
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/img_atlas)
+    file(STRINGS ${spec} lines REGEX "^(frame|zoom) ")
+    get_filename_component(spec_dir ${spec} DIRECTORY)
+    set(sources)
+    foreach(line ${lines})
+        string(REGEX REPLACE "^[a-z]+ +[^ ]+ +([^ ]+).*" "\\1" source "${line}")
+        list(APPEND sources ${spec_dir}/${source})
+    endforeach()
+    add_custom_command(OUTPUT ${out_dir}/${name}.c ${out_dir}/${name}.h
+                       COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
+                       COMMAND ${python} ${IMG_ATLAS_SCRIPT} ${spec} ${out_dir}/${name}.c ${out_dir}/${name}.h
+                       DEPENDS ${spec} ${sources} ${IMG_ATLAS_SCRIPT}
+                       VERBATIM)
+    add_custom_target(${target} DEPENDS ${out_dir}/${name}.c ${out_dir}/${name}.h)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${spec})
+    set(${target}_IMAGE ${out_dir}/${name}.c PARENT_SCOPE)
+    set(${target}_INCLUDE_DIR ${out_dir} PARENT_SCOPE)
+endfunction()
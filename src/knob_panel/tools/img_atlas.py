@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Pack the LV_IMG_CF_TRUE_COLOR_ALPHA frames of an animation, sources of the LVGL image
+# converter, into one image (the atlas) and a header with the rectangle of every frame,
+# drawn by main/ui/layer_manage/lv_img_atlas.c. The spec lists the frames, paths are
+# relative to it:
+#
+#   atlas <name>                                 name of the image and of the header
+#   frame <name> <source.c>                      the image as it is
+#   zoom <name> <source.c> <min> <max> <count>   the image scaled by <count> zoom levels
+#                                                from <min> to <max> (256 = 1x, as
+#                                                lv_img_set_zoom()), the closest to 256
+#                                                is replaced by 256
+#
+# The transparent border of every frame is cut off, the header keeps where the frame
+# sits in the source image so that it is placed as the whole image would be. Zoomed
+# frames are scaled around the centre (the default pivot of lv_img) with bilinear
+# filtering, in the source image they may extend beyond its borders.
+#
+# The atlas is a source in the format of the image converter (16-bit blocks in both
+# byte orders and the 32-bit block), converted and packed like the images of main/ui/imgs.
+#
+# Usage: img_atlas.py <spec.txt> <output.c> <output.h>
+
+import os
+import re
+import sys
+
+BLOCK_16 = re.compile(r'^#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0\s*$')
+BLOCK_16_SWAP = re.compile(r'^#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP != 0\s*$')
+BLOCK_32 = re.compile(r'^#if LV_COLOR_DEPTH == 32\s*$')
+HEX = re.compile(r'0x([0-9a-fA-F]{2})')
+SIZE = re.compile(r'\.header\.([wh]) = (\d+),')
+BYTES_PER_LINE = 32
+MAX_WIDTH = 512
+
+TEMPLATE_C = '''\
+/* Generated by tools/img_atlas.py from {spec}, do not edit */
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+
+#ifndef LV_ATTRIBUTE_MEM_ALIGN
+#define LV_ATTRIBUTE_MEM_ALIGN
+#endif
+
+#ifndef LV_ATTRIBUTE_IMG_{upper}
+#define LV_ATTRIBUTE_IMG_{upper}
+#endif
+
+const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST LV_ATTRIBUTE_IMG_{upper} uint8_t {name}_map[] = {{
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+  /*Pixel format: Alpha 8 bit, Red: 5 bit, Green: 6 bit, Blue: 5 bit*/
+{block_16}#endif
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP != 0
+  /*Pixel format: Alpha 8 bit, Red: 5 bit, Green: 6 bit, Blue: 5 bit  BUT the 2  color bytes are swapped*/
+{block_16_swap}#endif
+#if LV_COLOR_DEPTH == 32
+  /*Pixel format: Fix 0xFF: 8 bit, Red: 8 bit, Green: 8 bit, Blue: 8 bit*/
+{block_32}#endif
+}};
+
+const lv_img_dsc_t {name} = {{
+  .header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA,
+  .header.always_zero = 0,
+  .header.reserved = 0,
+  .header.w = {w},
+  .header.h = {h},
+  .data_size = {px} * LV_IMG_PX_SIZE_ALPHA_BYTE,
+  .data = {name}_map,
+}};
+'''
+
+TEMPLATE_H = '''\
+/* Generated by tools/img_atlas.py from {spec}, do not edit */
+#pragma once
+
+#include "lv_img_atlas.h"
+
+enum {{
+{enum}    {upper}_FRAME_CNT,
+}};
+{zooms}
+static const lv_img_atlas_frame_t {name}_frames[{upper}_FRAME_CNT] = {{
+{frames}}};
+
+static const lv_img_atlas_t {name} = {{
+    .name = "{name}",
+    .frames = {name}_frames,
+    .frame_cnt = {upper}_FRAME_CNT,
+}};
+'''
+
+
+class Frame:
+    """Pixels of a frame as (b16, b16_swap, argb) tuples, b16 are 3 bytes like the blocks"""
+
+    def __init__(self, name, w, h, pixels, x=0, y=0, src_w=None, src_h=None):
+        self.name = name
+        self.w, self.h = w, h
+        self.pixels = pixels
+        self.x, self.y = x, y                   # Top left corner in the source image
+        self.src_w = src_w if src_w is not None else w
+        self.src_h = src_h if src_h is not None else h
+        self.ax = self.ay = 0                   # Top left corner in the atlas
+
+    def trim(self):
+        rows = [y for y in range(self.h) if any(self.pixels[y * self.w + x][2][3] for x in range(self.w))]
+        cols = [x for x in range(self.w) if any(self.pixels[y * self.w + x][2][3] for y in range(self.h))]
+        if not rows:
+            rows, cols = [0], [0]
+        x0, x1, y0, y1 = cols[0], cols[-1] + 1, rows[0], rows[-1] + 1
+        self.pixels = [self.pixels[y * self.w + x] for y in range(y0, y1) for x in range(x0, x1)]
+        self.x += x0
+        self.y += y0
+        self.w, self.h = x1 - x0, y1 - y0
+
+
+def read_block(lines, pattern, size):
+    for i, line in enumerate(lines):
+        if pattern.match(line):
+            end = next(j for j in range(i, len(lines)) if lines[j].startswith('#endif'))
+            data = bytes(int(x, 16) for x in HEX.findall(''.join(lines[i + 1:end])))
+            return [data[j:j + size] for j in range(0, len(data), size)]
+    raise ValueError('no block {}'.format(pattern.pattern))
+
+
+def read_image(path):
+    with open(path) as f:
+        lines = f.readlines()
+    sizes = dict(SIZE.findall(''.join(lines)))
+    w, h = int(sizes['w']), int(sizes['h'])
+    b16 = read_block(lines, BLOCK_16, 3)
+    b16_swap = read_block(lines, BLOCK_16_SWAP, 3)
+    # B, G, R, A in the source, kept as (r, g, b, a)
+    argb = [(p[2], p[1], p[0], p[3]) for p in read_block(lines, BLOCK_32, 4)]
+    if not (len(b16) == len(b16_swap) == len(argb) == w * h):
+        raise ValueError('{}: the blocks are not {} x {} pixels'.format(path, w, h))
+    return w, h, list(zip(b16, b16_swap, argb))
+
+
+def rgb565(r, g, b, a):
+    c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+    return bytes((c & 0xFF, c >> 8, a)), bytes((c >> 8, c & 0xFF, a))
+
+
+def zoomed(name, w, h, pixels, zoom):
+    """The image scaled by zoom / 256 around its centre, in a canvas large enough for it"""
+    if zoom == 256:
+        return Frame(name, w, h, pixels)
+
+    scale = zoom / 256
+    px, py = w / 2, h / 2
+    x0 = int((0 - px) * scale + px) - 1
+    x1 = int((w - px) * scale + px) + 2
+    y0 = int((0 - py) * scale + py) - 1
+    y1 = int((h - py) * scale + py) + 2
+
+    def premultiplied(x, y):
+        if 0 <= x < w and 0 <= y < h:
+            r, g, b, a = pixels[y * w + x][2]
+            return r * a, g * a, b * a, a
+        return 0, 0, 0, 0
+
+    out = []
+    for y in range(y0, y1):
+        for x in range(x0, x1):
+            # Centre of the output pixel in the source
+            sx = (x + 0.5 - px) / scale + px - 0.5
+            sy = (y + 0.5 - py) / scale + py - 0.5
+            ix, iy = int(sx // 1), int(sy // 1)
+            fx, fy = sx - ix, sy - iy
+            acc = [0.0] * 4
+            for dx, dy, wgt in ((0, 0, (1 - fx) * (1 - fy)), (1, 0, fx * (1 - fy)),
+                                (0, 1, (1 - fx) * fy), (1, 1, fx * fy)):
+                if wgt:
+                    p = premultiplied(ix + dx, iy + dy)
+                    for c in range(4):
+                        acc[c] += p[c] * wgt
+            a = round(acc[3])
+            if a:
+                r, g, b = (min(255, round(acc[c] / acc[3])) for c in range(3))
+            else:
+                r = g = b = 0
+            b16, b16_swap = rgb565(r, g, b, a)
+            out.append((b16, b16_swap, (r, g, b, a)))
+    return Frame(name, x1 - x0, y1 - y0, out, x0, y0, w, h)
+
+
+def pack(frames):
+    """Shelves of frames sorted by height, in the narrowest atlas of the smallest area"""
+    order = sorted(frames, key=lambda f: (-f.h, -f.w, f.name))
+    best = None
+    for width in range(max(f.w for f in frames), MAX_WIDTH + 1):
+        x = y = shelf = 0
+        places = []
+        for f in order:
+            if x + f.w > width:
+                x, y, shelf = 0, y + shelf, 0
+            places.append((x, y))
+            x += f.w
+            shelf = max(shelf, f.h)
+        height = y + shelf
+        if best is None or width * height < best[0] * best[1]:
+            best = (width, height, places)
+    width, height, places = best
+    for f, (x, y) in zip(order, places):
+        f.ax, f.ay = x, y
+    return width, height
+
+
+def hex_lines(data):
+    return ''.join('  ' + ''.join('0x{:02x}, '.format(b) for b in data[i:i + BYTES_PER_LINE]).rstrip() + '\n'
+                   for i in range(0, len(data), BYTES_PER_LINE))
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit('usage: img_atlas.py <spec.txt> <output.c> <output.h>')
+    spec, out_c, out_h = sys.argv[1:]
+    base = os.path.dirname(os.path.abspath(spec))
+
+    name = None
+    frames = []
+    zooms = []
+    with open(spec) as f:
+        for number, line in enumerate(f, 1):
+            words = line.split('#', 1)[0].split()
+            try:
+                if not words:
+                    continue
+                if words[0] == 'atlas' and len(words) == 2:
+                    name = words[1]
+                elif words[0] == 'frame' and len(words) == 3:
+                    w, h, pixels = read_image(os.path.join(base, words[2]))
+                    frames.append(Frame(words[1], w, h, pixels))
+                elif words[0] == 'zoom' and len(words) == 6:
+                    w, h, pixels = read_image(os.path.join(base, words[2]))
+                    lo, hi, count = int(words[3]), int(words[4]), int(words[5])
+                    levels = [round(lo + (hi - lo) * i / max(count - 1, 1)) for i in range(count)]
+                    levels[min(range(count), key=lambda i: abs(levels[i] - 256))] = 256
+                    levels = sorted(set(levels))
+                    zooms.append((words[1], levels))
+                    for i, zoom in enumerate(levels):
+                        frames.append(zoomed('{}_{}'.format(words[1], i), w, h, pixels, zoom))
+                else:
+                    raise ValueError('unknown line')
+            except (OSError, ValueError, KeyError, StopIteration) as e:
+                sys.exit('{}:{}: {}'.format(spec, number, e))
+    if name is None or not frames:
+        sys.exit('{}: no atlas name or no frames'.format(spec))
+
+    for frame in frames:
+        frame.trim()
+    width, height = pack(frames)
+
+    empty = (b'\0\0\0', b'\0\0\0', (0, 0, 0, 0))
+    atlas = [empty] * (width * height)
+    for frame in frames:
+        for y in range(frame.h):
+            row = (frame.ay + y) * width + frame.ax
+            atlas[row:row + frame.w] = frame.pixels[y * frame.w:(y + 1) * frame.w]
+
+    upper = name.upper()
+    spec_name = os.path.basename(spec)
+    with open(out_c, 'w') as f:
+        f.write(TEMPLATE_C.format(
+            spec=spec_name, name=name, upper=upper, w=width, h=height, px=width * height,
+            block_16=hex_lines(b''.join(p[0] for p in atlas)),
+            block_16_swap=hex_lines(b''.join(p[1] for p in atlas)),
+            block_32=hex_lines(bytes(v for p in atlas for v in (p[2][2], p[2][1], p[2][0], p[2][3])))))
+
+    enum = ''.join('    {},\n'.format(frame.name.upper()) for frame in frames)
+    zoom_tables = ''
+    for zoom_name, levels in zooms:
+        zoom_tables += '\n#define {}_CNT {}\n'.format(zoom_name.upper(), len(levels))
+        zoom_tables += '#define {}_NATIVE {}_{}\n'.format(zoom_name.upper(), zoom_name.upper(), levels.index(256))
+        zoom_tables += 'static const uint16_t {}_zoom[{}_CNT] = {{{}}};\n'.format(
+            zoom_name, zoom_name.upper(), ', '.join(str(z) for z in levels))
+    rects = ''.join('    [{}] = {{{}, {}, {}, {}, {}, {}, {}, {}}},\n'.format(
+        frame.name.upper(), frame.ax, frame.ay, frame.w, frame.h, frame.x, frame.y, frame.src_w, frame.src_h)
+        for frame in frames)
+    with open(out_h, 'w') as f:
+        f.write(TEMPLATE_H.format(spec=spec_name, name=name, upper=upper, enum=enum, zooms=zoom_tables,
+                                  frames=rects))
+
+    src_px = sum(frame.src_w * frame.src_h for frame in frames)
+    print('img_atlas: {} frames in {} x {} ({} pixels, {} untrimmed)'.format(
+        len(frames), width, height, width * height, src_px))
+
+
+if __name__ == '__main__':
+    main()
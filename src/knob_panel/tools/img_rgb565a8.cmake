@@ -0,0 +1,29 @@
+# Build step converting the LVGL images with an alpha channel to planar RGB565A8,
+# see img_rgb565a8.py. The sources in the tree stay as the LVGL image converter wrote them.
+set(IMG_RGB565A8_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/img_rgb565a8.py)
+
+# img_rgb565a8_convert(<out_var> <python> <src_dir> [IMAGES <image.c>...])
+#
+# Adds a command converting every *.c below <src_dir>, and the generated IMAGES, into the
+# current binary directory and sets <out_var> to the converted sources.
+function(img_rgb565a8_convert out_var python src_dir)
+    cmake_parse_arguments(arg "" "" "IMAGES" ${ARGN})
+    file(GLOB_RECURSE images ${src_dir}/*.c)
+    set(outputs)
+    foreach(image ${images} ${arg_IMAGES})
+        if(image IN_LIST arg_IMAGES)
+            get_filename_component(rel ${image} NAME)
+        else()
+            file(RELATIVE_PATH rel ${src_dir} ${image})
+        endif()
+        set(output ${CMAKE_CURRENT_BINARY_DIR}/img_rgb565a8/${rel})
+        get_filename_component(output_dir ${output} DIRECTORY)
+        add_custom_command(OUTPUT ${output}
+                           COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+                           COMMAND ${python} ${IMG_RGB565A8_SCRIPT} ${image} ${output}
+                           DEPENDS ${image} ${IMG_RGB565A8_SCRIPT}
+                           VERBATIM)
+        list(APPEND outputs ${output})
+    endforeach()
+    set(${out_var} ${outputs} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Convert the LV_IMG_CF_TRUE_COLOR_ALPHA images of the LVGL image converter to
+# LV_IMG_CF_RGB565A8 for 16-bit colour depth: all the RGB565 pixels (in the byte
+# order selected by LV_COLOR_16_SWAP) followed by all the alpha values. LVGL blends
+# such images straight from flash, TRUE_COLOR_ALPHA images are first unpacked into
+# a colour and an alpha buffer on every draw.
+#
+# Other images and other colour depths are copied unchanged.
+#
+# Usage: img_rgb565a8.py <input.c> <output.c>
+
+import re
+import sys
+
+BYTES_PER_LINE = 32
+
+BLOCK_16 = re.compile(r'^#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP [!=]= 0\s*$')
+HEX = re.compile(r'0x([0-9a-fA-F]{2})')
+CF_ALPHA = re.compile(r'^(\s*)\.header\.cf = LV_IMG_CF_TRUE_COLOR_ALPHA,\s*$')
+SIZE = re.compile(r'\.header\.([wh]) = (\d+),')
+
+
+def planar(data):
+    """RGB565 + alpha of every pixel -> all RGB565, then all alpha"""
+    if len(data) % 3:
+        raise ValueError('{} bytes are not RGB565 + alpha pixels'.format(len(data)))
+    colours = bytearray()
+    alpha = bytearray()
+    for i in range(0, len(data), 3):
+        colours += data[i:i + 2]
+        alpha.append(data[i + 2])
+    return colours + alpha
+
+
+def hex_lines(data):
+    for i in range(0, len(data), BYTES_PER_LINE):
+        yield '  ' + ''.join('0x{:02x}, '.format(b) for b in data[i:i + BYTES_PER_LINE]).rstrip() + '\n'
+
+
+def convert(lines):
+    if not any(CF_ALPHA.match(line) for line in lines):
+        return lines
+
+    sizes = dict(SIZE.findall(''.join(lines)))
+    pixels = int(sizes['w']) * int(sizes['h'])
+
+    out = []
+    block = None
+    swapped = False
+    for line in lines:
+        if block is not None:
+            if line.startswith('#endif'):
+                data = bytearray(int(h, 16) for h in HEX.findall(''.join(block)))
+                if len(data) != pixels * 3:
+                    raise ValueError('{} bytes for {} pixels'.format(len(data), pixels))
+                out.append('  /*Pixel format: RGB565 of every pixel, then Alpha 8 bit of every pixel{}*/\n'
+                           .format('  BUT the 2 color bytes are swapped' if swapped else ''))
+                out.extend(hex_lines(planar(data)))
+                out.append(line)
+                block = None
+            else:
+                block.append(line)
+            continue
+
+        cf = CF_ALPHA.match(line)
+        if cf:
+            indent = cf.group(1)
+            out.append('#if LV_COLOR_DEPTH == 16\n')
+            out.append(indent + '.header.cf = LV_IMG_CF_RGB565A8,\n')
+            out.append('#else\n')
+            out.append(line)
+            out.append('#endif\n')
+            continue
+
+        out.append(line)
+        if BLOCK_16.match(line):
+            block = []
+            swapped = '!=' in line
+
+    if block is not None:
+        raise ValueError('unterminated #if')
+    return out
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: {} <input.c> <output.c>'.format(sys.argv[0]))
+    with open(sys.argv[1]) as f:
+        lines = f.readlines()
+    try:
+        lines = convert(lines)
+    except (KeyError, ValueError) as e:
+        sys.exit('{}: {}'.format(sys.argv[1], e))
+    with open(sys.argv[2], 'w') as f:
+        f.writelines(lines)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,38 @@
+# Build step compressing the images to line-addressable RLE after the RGB565A8
+# conversion, see img_rle.py. The images listed in <src_dir>/img_rle_exclude.txt
+# stay uncompressed: LVGL draws decoded rows without zoom and rotation.
+include(${CMAKE_CURRENT_LIST_DIR}/img_rgb565a8.cmake)
+set(IMG_RLE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/img_rle.py)
+
+# img_rle_convert(<out_var> <python> <src_dir> [IMAGES <image.c>...])
+#
+# Converts every *.c below <src_dir>, and the generated IMAGES, to RGB565A8 with
+# img_rgb565a8_convert() and then compresses it into the current binary directory,
+# sets <out_var> to the sources to build.
+function(img_rle_convert out_var python src_dir)
+    img_rgb565a8_convert(converted ${python} ${src_dir} ${ARGN})
+
+    set(exclude)
+    if(EXISTS ${src_dir}/img_rle_exclude.txt)
+        file(STRINGS ${src_dir}/img_rle_exclude.txt exclude REGEX "^[^#]")
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${src_dir}/img_rle_exclude.txt)
+    endif()
+
+    set(outputs)
+    foreach(image ${converted})
+        file(RELATIVE_PATH rel ${CMAKE_CURRENT_BINARY_DIR}/img_rgb565a8 ${image})
+        if(rel IN_LIST exclude)
+            list(APPEND outputs ${image})
+            continue()
+        endif()
+        set(output ${CMAKE_CURRENT_BINARY_DIR}/img_rle/${rel})
+        get_filename_component(output_dir ${output} DIRECTORY)
+        add_custom_command(OUTPUT ${output}
+                           COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+                           COMMAND ${python} ${IMG_RLE_SCRIPT} ${image} ${output}
+                           DEPENDS ${image} ${IMG_RLE_SCRIPT}
+                           VERBATIM)
+        list(APPEND outputs ${output})
+    endforeach()
+    set(${out_var} ${outputs} PARENT_SCOPE)
+endfunction()
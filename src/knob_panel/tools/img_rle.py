@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+#
+# SPDX-FileCopyrightText: 2023 Espressif Systems (Shanghai) CO LTD
+#
+# SPDX-License-Identifier: CC0-1.0
+#
+# Compress the 16-bit colour depth images written by img_rgb565a8.py (LV_IMG_CF_RGB565A8
+# and LV_IMG_CF_TRUE_COLOR) to LV_IMG_CF_USER_ENCODED_0, decoded line by line by
+# main/ui/layer_manage/lv_img_rle.c. The data is:
+#
+#   'R', 'L', flags (bit 0: alpha plane), 0
+#   uint32_t offset of every row of colours, then of every row of alpha (little-endian,
+#            from the start of the data)
+#   the rows, every one compressed on its own so that any row can be decoded alone,
+#            identical rows are stored once and their offsets point to the same bytes
+#
+# A row is a sequence of packets: a control byte n < 128 followed by n + 1 literal
+# pixels, or n >= 128 followed by one pixel repeated n - 125 times (3 to 130). Colours
+# are 2 bytes in the byte order of the block (LV_COLOR_16_SWAP), alpha 1 byte.
+# The colour of the fully transparent pixels is never visible, it is replaced by the
+# colour of its neighbour to make the runs longer.
+#
+# Images which do not shrink below --ratio of their size stay as they are. Other
+# colour depths are copied unchanged.
+#
+# Usage: img_rle.py <input.c> <output.c> [--ratio R]
+
+import argparse
+import re
+import struct
+import sys
+
+BYTES_PER_LINE = 32
+MAX_LITERAL = 128
+MIN_RUN = 3
+MAX_RUN = 130
+
+BLOCK_16 = re.compile(r'^#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP [!=]= 0\s*$')
+HEX = re.compile(r'0x([0-9a-fA-F]{2})')
+CF = re.compile(r'^(\s*)\.header\.cf = (LV_IMG_CF_RGB565A8|LV_IMG_CF_TRUE_COLOR),\s*$')
+SIZE = re.compile(r'\.header\.([wh]) = (\d+),')
+DATA_SIZE = re.compile(r'^(\s*)\.data_size = .*,\s*$')
+MAP = re.compile(r'\buint8_t (\w+)\[\] = \{')
+
+
+def encode_row(pixels):
+    """Packets of one row, pixels is a list of bytes objects of the same size"""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_LITERAL]
+            del literal[:MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(p)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < MAX_RUN and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= MIN_RUN:
+            flush_literal()
+            out.append(run + 125)
+            out += pixels[i]
+        else:
+            literal.extend(pixels[i:i + run])
+        i += run
+    flush_literal()
+    return out
+
+
+def hide_transparent(colours, alpha):
+    """Give the invisible pixels the colour of the previous visible one (or the next one)"""
+    visible = [c for c, a in zip(colours, alpha) if a]
+    if not visible:
+        return [colours[0]] * len(colours) if colours else colours
+    out = []
+    last = visible[0]
+    for c, a in zip(colours, alpha):
+        if a:
+            last = c
+        out.append(last)
+    return out
+
+
+def encode(data, w, h, has_alpha):
+    colour_size = 2 * w * h
+    colours = [bytes(data[i:i + 2]) for i in range(0, colour_size, 2)]
+    alpha = data[colour_size:] if has_alpha else b''
+
+    colour_rows = []
+    alpha_rows = []
+    for y in range(h):
+        row = colours[y * w:(y + 1) * w]
+        if has_alpha:
+            row_alpha = alpha[y * w:(y + 1) * w]
+            row = hide_transparent(row, row_alpha)
+            alpha_rows.append(encode_row([bytes([a]) for a in row_alpha]))
+        colour_rows.append(encode_row(row))
+
+    rows = colour_rows + alpha_rows
+    out = bytearray(b'RL' + bytes([1 if has_alpha else 0, 0]))
+    offset = len(out) + 4 * len(rows)
+    offsets = {}
+    unique = []
+    for row in rows:
+        row = bytes(row)
+        if row not in offsets:
+            offsets[row] = offset
+            offset += len(row)
+            unique.append(row)
+        out += struct.pack('<I', offsets[row])
+    for row in unique:
+        out += row
+    return out
+
+
+def hex_lines(data):
+    for i in range(0, len(data), BYTES_PER_LINE):
+        yield '  ' + ''.join('0x{:02x}, '.format(b) for b in data[i:i + BYTES_PER_LINE]).rstrip() + '\n'
+
+
+def find_cf(lines):
+    """Format of the 16-bit blocks, the one under '#if LV_COLOR_DEPTH == 16' if any"""
+    cf = None
+    in_16 = False
+    for line in lines:
+        if line.startswith('#if LV_COLOR_DEPTH == 16\n'):
+            in_16 = True
+        elif line.startswith('#'):
+            in_16 = False
+        m = CF.match(line)
+        if m and (in_16 or cf is None):
+            cf = m.group(2)
+    return cf
+
+
+def convert(lines, ratio):
+    cf = find_cf(lines)
+    if cf is None:
+        return lines
+
+    sizes = dict(SIZE.findall(''.join(lines)))
+    w, h = int(sizes['w']), int(sizes['h'])
+    has_alpha = cf == 'LV_IMG_CF_RGB565A8'
+    raw_size = w * h * (3 if has_alpha else 2)
+
+    # Compress both byte orders first, keep the image if either does not shrink enough
+    blocks = []
+    block = None
+    for i, line in enumerate(lines):
+        if block is not None:
+            if line.startswith('#endif'):
+                data = bytearray(int(x, 16) for x in HEX.findall(''.join(lines[block + 1:i])))
+                if len(data) != raw_size:
+                    raise ValueError('{} bytes for {} x {} pixels'.format(len(data), w, h))
+                blocks.append((block, i, encode(data, w, h, has_alpha)))
+                block = None
+        elif BLOCK_16.match(line):
+            block = i
+    if block is not None:
+        raise ValueError('unterminated #if')
+    if not blocks or any(len(enc) > raw_size * ratio for _, _, enc in blocks):
+        return lines
+
+    out = []
+    pos = 0
+    for start, end, enc in blocks:
+        out.extend(lines[pos:start + 1])
+        out.append('  /*RLE rows, see tools/img_rle.py{}*/\n'
+                   .format('  BUT the 2 color bytes are swapped' if '!=' in lines[start] else ''))
+        out.extend(hex_lines(enc))
+        pos = end
+    out.extend(lines[pos:])
+
+    map_name = MAP.search(''.join(out)).group(1)
+    lines = out
+    out = []
+    in_16 = False
+    for line in lines:
+        if line.startswith('#if LV_COLOR_DEPTH == 16\n'):
+            in_16 = True
+        elif line.startswith('#'):
+            in_16 = False
+        m = CF.match(line)
+        if m and m.group(2) == cf:
+            indent = m.group(1)
+            if in_16:
+                out.append(indent + '.header.cf = LV_IMG_CF_USER_ENCODED_0,\n')
+            else:
+                out.append('#if LV_COLOR_DEPTH == 16\n')
+                out.append(indent + '.header.cf = LV_IMG_CF_USER_ENCODED_0,\n')
+                out.append('#else\n')
+                out.append(line)
+                out.append('#endif\n')
+            continue
+        m = DATA_SIZE.match(line)
+        if m:
+            out.append('#if LV_COLOR_DEPTH == 16\n')
+            out.append(m.group(1) + '.data_size = sizeof({}),\n'.format(map_name))
+            out.append('#else\n')
+            out.append(line)
+            out.append('#endif\n')
+            continue
+        out.append(line)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compress LVGL images to line-addressable RLE')
+    parser.add_argument('input')
+    parser.add_argument('output')
+    parser.add_argument('--ratio', type=float, default=0.75,
+                        help='keep the image uncompressed above this share of its size')
+    args = parser.parse_args()
+
+    with open(args.input) as f:
+        lines = f.readlines()
+    try:
+        lines = convert(lines, args.ratio)
+    except (KeyError, ValueError) as e:
+        sys.exit('{}: {}'.format(args.input, e))
+    with open(args.output, 'w') as f:
+        f.writelines(lines)
+
+
+if __name__ == '__main__':
+    main()